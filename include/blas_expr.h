@@ -0,0 +1,381 @@
+#ifndef _QUDA_BLAS_EXPR_H
+#define _QUDA_BLAS_EXPR_H
+
+#include <vector>
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+
+/**
+   Lazily fused host BLAS.  A FusedBlas object records a sequence of
+   element-wise updates (y = <expression>) and reductions (norms and
+   dot products of expressions) on cpuColorSpinorFields, and on
+   flush() executes them all in a single sweep over the fields.  The
+   sweep is made in cache-sized chunks, with each recorded operation
+   applied to a chunk in turn (so a field updated by one operation is
+   still in cache when read by the next), and the reductions are
+   summed over all ranks together at the end.  For example, the
+   update of the CG iterate and residual with the new residual norm,
+
+     FusedBlas blas;
+     expr::Field X(x), R(r), P(p), Ap(ap);
+     blas.assign(x, X + alpha*P);
+     blas.assign(r, R - alpha*Ap);
+     blas.norm2(r2, R);
+     blas.flush();
+
+   costs one pass over x, r, p and Ap and a single global sum.  Each
+   element sees the operations in the order they were recorded, so
+   this is equivalent to the unfused sequence of calls, with the
+   proviso that scalars are captured when recorded, so a reduction
+   result may not be used as a coefficient until after the flush.
+*/
+
+namespace quda {
+
+  namespace host {
+
+    /**
+       A complex number as a plain pair of reals.  Unlike std::complex,
+       its multiplication has no special handling of infinities, so it
+       inlines to a few multiply-adds that the compiler can vectorize.
+    */
+    template <typename Float>
+    struct Cplx {
+      Float re;
+      Float im;
+      Cplx() { }
+      Cplx(const Float &re, const Float &im) : re(re), im(im) { }
+      Cplx(const Complex &a) : re(real(a)), im(imag(a)) { }
+    };
+
+    template <typename Float>
+    inline Cplx<Float> operator+(const Cplx<Float> &a, const Cplx<Float> &b)
+    { return Cplx<Float>(a.re + b.re, a.im + b.im); }
+
+    template <typename Float>
+    inline Cplx<Float> operator-(const Cplx<Float> &a, const Cplx<Float> &b)
+    { return Cplx<Float>(a.re - b.re, a.im - b.im); }
+
+    template <typename Float>
+    inline Cplx<Float> operator*(const Float &a, const Cplx<Float> &b)
+    { return Cplx<Float>(a*b.re, a*b.im); }
+
+    template <typename Float>
+    inline Cplx<Float> operator*(const Cplx<Float> &a, const Cplx<Float> &b)
+    { return Cplx<Float>(a.re*b.re - a.im*b.im, a.re*b.im + a.im*b.re); }
+
+    //! Return the L2 norm of a
+    template <typename Float>
+    inline Float norm2_(const Cplx<Float> &a) { return a.re*a.re + a.im*a.im; }
+
+    //! Return the real part of the dot product of a and b
+    template <typename Float>
+    inline Float dot_(const Cplx<Float> &a, const Cplx<Float> &b) { return a.re*b.re + a.im*b.im; }
+
+    //! Return the imaginary part of the complex dot product conj(a)*b
+    template <typename Float>
+    inline Float cdotIm_(const Cplx<Float> &a, const Cplx<Float> &b) { return a.re*b.im - a.im*b.re; }
+
+  } // namespace host
+
+  class FusedBlas;
+
+  namespace expr {
+
+    using host::Cplx;
+
+    //! Base of the expression nodes, which selects the operators below
+    template <typename Derived> struct Expr { };
+
+    /**
+       Leaf of an expression: a field, which is resolved to an index
+       into the field table of the FusedBlas it is recorded in.  In
+       evaluation, p[idx] points to the field data, with complex
+       element i having its real part at offset r and imaginary part at
+       r+im.
+    */
+    class Field : public Expr<Field> {
+      const cpuColorSpinorField *f;
+      int idx;
+
+    public:
+      Field(const cpuColorSpinorField &f) : f(&f), idx(-1) { }
+      inline void bind(FusedBlas &blas);
+
+      template <typename Float>
+      inline Cplx<Float> eval(Float *const *p, const int r, const int im) const
+      { return Cplx<Float>(p[idx][r], p[idx][r+im]); }
+    };
+
+    //! Expressions may be written with bare fields, which are wrapped as leaves
+    template <typename E> struct Wrap { typedef E type; };
+    template <> struct Wrap<cpuColorSpinorField> { typedef Field type; };
+
+    //! The sum of two expressions
+    template <typename L, typename R>
+    class Sum : public Expr<Sum<L,R> > {
+      L l;
+      R r;
+    public:
+      Sum(const L &l, const R &r) : l(l), r(r) { }
+      void bind(FusedBlas &blas) { l.bind(blas); r.bind(blas); }
+      template <typename Float>
+      inline Cplx<Float> eval(Float *const *p, const int i, const int im) const
+      { return l.eval(p, i, im) + r.eval(p, i, im); }
+    };
+
+    //! The difference of two expressions
+    template <typename L, typename R>
+    class Diff : public Expr<Diff<L,R> > {
+      L l;
+      R r;
+    public:
+      Diff(const L &l, const R &r) : l(l), r(r) { }
+      void bind(FusedBlas &blas) { l.bind(blas); r.bind(blas); }
+      template <typename Float>
+      inline Cplx<Float> eval(Float *const *p, const int i, const int im) const
+      { return l.eval(p, i, im) - r.eval(p, i, im); }
+    };
+
+    //! An expression scaled by a real number
+    template <typename E>
+    class Scale : public Expr<Scale<E> > {
+      double a;
+      E e;
+    public:
+      Scale(const double &a, const E &e) : a(a), e(e) { }
+      void bind(FusedBlas &blas) { e.bind(blas); }
+      template <typename Float>
+      inline Cplx<Float> eval(Float *const *p, const int i, const int im) const
+      { return (Float)a * e.eval(p, i, im); }
+    };
+
+    //! An expression scaled by a complex number
+    template <typename E>
+    class CScale : public Expr<CScale<E> > {
+      Cplx<double> a;
+      E e;
+    public:
+      CScale(const Complex &a, const E &e) : a(a), e(e) { }
+      void bind(FusedBlas &blas) { e.bind(blas); }
+      template <typename Float>
+      inline Cplx<Float> eval(Float *const *p, const int i, const int im) const
+      { return Cplx<Float>(a.re, a.im) * e.eval(p, i, im); }
+    };
+
+    template <typename L, typename R>
+    inline Sum<L,R> operator+(const Expr<L> &l, const Expr<R> &r)
+    { return Sum<L,R>(static_cast<const L&>(l), static_cast<const R&>(r)); }
+
+    template <typename L, typename R>
+    inline Diff<L,R> operator-(const Expr<L> &l, const Expr<R> &r)
+    { return Diff<L,R>(static_cast<const L&>(l), static_cast<const R&>(r)); }
+
+    template <typename E>
+    inline Scale<E> operator*(const double &a, const Expr<E> &e)
+    { return Scale<E>(a, static_cast<const E&>(e)); }
+
+    template <typename E>
+    inline CScale<E> operator*(const Complex &a, const Expr<E> &e)
+    { return CScale<E>(a, static_cast<const E&>(e)); }
+
+    /**
+       A recorded operation.  apply() applies it to complex elements
+       [begin, end) of the fields in p, which are laid out in blocks
+       of B as for the host BLAS (1, or QUDA_AOSOA_BLOCK for
+       QUDA_AOSOA_FIELD_ORDER), accumulating any reductions into sum.
+    */
+    class Op {
+    public:
+      virtual ~Op() { }
+      virtual void apply(double *const *p, double *sum, int begin, int end, int B) const = 0;
+      virtual void apply(float *const *p, double *sum, int begin, int end, int B) const = 0;
+    };
+
+    /**
+       Implements the element loop for the operation Derived, which
+       provides elem(p, s0, s1, r, im).  As in the host BLAS driver,
+       the loop over the elements of a chunk is vectorized.
+    */
+    template <typename Derived>
+    class OpBase : public Op {
+    protected:
+      const int slot; // the first reduction slot, if any
+
+      template <typename Float, int B>
+      void run(Float *const *p, double *sum, int begin, int end) const {
+	const Derived &d = static_cast<const Derived&>(*this);
+	double s0 = 0.0, s1 = 0.0;
+	if (B == 1) {
+#ifdef _OPENMP
+#pragma omp simd reduction(+:s0,s1)
+#endif
+	  for (int i=begin; i<end; i++) d.elem(p, s0, s1, 2*i, 1);
+	} else {
+	  for (int b=begin/B; b<end/B; b++) {
+#ifdef _OPENMP
+#pragma omp simd reduction(+:s0,s1)
+#endif
+	    for (int j=0; j<B; j++) d.elem(p, s0, s1, 2*B*b + j, B);
+	  }
+	}
+	if (slot >= 0) {
+	  sum[slot] += s0;
+	  if (Derived::reductions() > 1) sum[slot+1] += s1;
+	}
+      }
+
+    public:
+      OpBase(int slot) : slot(slot) { }
+
+      void apply(double *const *p, double *sum, int begin, int end, int B) const {
+	if (B == 1) run<double,1>(p, sum, begin, end);
+	else run<double,QUDA_AOSOA_BLOCK>(p, sum, begin, end);
+      }
+
+      void apply(float *const *p, double *sum, int begin, int end, int B) const {
+	if (B == 1) run<float,1>(p, sum, begin, end);
+	else run<float,QUDA_AOSOA_BLOCK>(p, sum, begin, end);
+      }
+    };
+
+    //! y = e
+    template <typename E>
+    class Assign : public OpBase<Assign<E> > {
+      const int y;
+      E e;
+    public:
+      Assign(int y, const E &e) : OpBase<Assign<E> >(-1), y(y), e(e) { }
+      template <typename Float>
+      inline void elem(Float *const *p, double &s0, double &s1, const int r, const int im) const {
+	Cplx<Float> v = e.eval(p, r, im);
+	p[y][r] = v.re;
+	p[y][r+im] = v.im;
+      }
+      static int reductions() { return 0; }
+    };
+
+    //! sum += |e|^2
+    template <typename E>
+    class Norm2 : public OpBase<Norm2<E> > {
+      E e;
+    public:
+      Norm2(int slot, const E &e) : OpBase<Norm2<E> >(slot), e(e) { }
+      template <typename Float>
+      inline void elem(Float *const *p, double &s0, double &s1, const int r, const int im) const
+      { s0 += host::norm2_(e.eval(p, r, im)); }
+      static int reductions() { return 1; }
+    };
+
+    //! sum += Re(a^dagger b)
+    template <typename A, typename B>
+    class ReDot : public OpBase<ReDot<A,B> > {
+      A a;
+      B b;
+    public:
+      ReDot(int slot, const A &a, const B &b) : OpBase<ReDot<A,B> >(slot), a(a), b(b) { }
+      template <typename Float>
+      inline void elem(Float *const *p, double &s0, double &s1, const int r, const int im) const
+      { s0 += host::dot_(a.eval(p, r, im), b.eval(p, r, im)); }
+      static int reductions() { return 1; }
+    };
+
+    //! sum += a^dagger b
+    template <typename A, typename B>
+    class CDot : public OpBase<CDot<A,B> > {
+      A a;
+      B b;
+    public:
+      CDot(int slot, const A &a, const B &b) : OpBase<CDot<A,B> >(slot), a(a), b(b) { }
+      template <typename Float>
+      inline void elem(Float *const *p, double &s0, double &s1, const int r, const int im) const {
+	Cplx<Float> A_ = a.eval(p, r, im), B_ = b.eval(p, r, im);
+	s0 += host::dot_(A_, B_);
+	s1 += host::cdotIm_(A_, B_);
+      }
+      static int reductions() { return 2; }
+    };
+
+  } // namespace expr
+
+  class FusedBlas {
+
+  private:
+    std::vector<const cpuColorSpinorField*> fields;
+    std::vector<bool> written;
+    std::vector<expr::Op*> ops;
+    std::vector<double*> results; // where each reduction slot is returned
+
+    // reserve n reduction slots, returned into result[0..n-1]
+    int reserve(double *result, int n) {
+      int slot = results.size();
+      for (int i=0; i<n; i++) results.push_back(result+i);
+      return slot;
+    }
+
+  public:
+    FusedBlas() { }
+    virtual ~FusedBlas();
+
+    /**
+       @return The index of f in the field table, which is added to the
+       table if not yet present
+    */
+    int index(const cpuColorSpinorField &f);
+
+    //! Record y = e
+    template <typename E>
+    void assign(cpuColorSpinorField &y, const E &e) {
+      typename expr::Wrap<E>::type e_(e);
+      e_.bind(*this);
+      int idx = index(y);
+      written[idx] = true;
+      ops.push_back(new expr::Assign<typename expr::Wrap<E>::type>(idx, e_));
+    }
+
+    //! Record result = |e|^2, set on flush
+    template <typename E>
+    void norm2(double &result, const E &e) {
+      typename expr::Wrap<E>::type e_(e);
+      e_.bind(*this);
+      ops.push_back(new expr::Norm2<typename expr::Wrap<E>::type>(reserve(&result, 1), e_));
+    }
+
+    //! Record result = Re(a^dagger b), set on flush
+    template <typename A, typename B>
+    void reDotProduct(double &result, const A &a, const B &b) {
+      typename expr::Wrap<A>::type a_(a);
+      typename expr::Wrap<B>::type b_(b);
+      a_.bind(*this);
+      b_.bind(*this);
+      ops.push_back(new expr::ReDot<typename expr::Wrap<A>::type, typename expr::Wrap<B>::type>
+		    (reserve(&result, 1), a_, b_));
+    }
+
+    //! Record result = a^dagger b, set on flush
+    template <typename A, typename B>
+    void cDotProduct(Complex &result, const A &a, const B &b) {
+      typename expr::Wrap<A>::type a_(a);
+      typename expr::Wrap<B>::type b_(b);
+      a_.bind(*this);
+      b_.bind(*this);
+      ops.push_back(new expr::CDot<typename expr::Wrap<A>::type, typename expr::Wrap<B>::type>
+		    (reserve(reinterpret_cast<double*>(&result), 2), a_, b_));
+    }
+
+    //! @return The number of operations recorded since the last flush
+    int size() const { return ops.size(); }
+
+    /**
+       Execute the recorded operations in a single fused sweep, sum
+       the reductions over all ranks and write them to their results,
+       and clear the record.
+    */
+    void flush();
+  };
+
+  inline void expr::Field::bind(FusedBlas &blas) { idx = blas.index(*f); }
+
+} // namespace quda
+
+#endif // _QUDA_BLAS_EXPR_H
@@ -6,6 +6,9 @@
 
 // ---------- blas_quda.cu ---------- 
 
+// the largest set of fields that the block blas kernels process in one pass
+#define MAX_MULTI_BLAS_N 16
+
 namespace quda {
   // creates and destroys reduction buffers  
   void initBlas(); 
@@ -22,6 +25,66 @@ namespace quda {
 
   double norm2(const ColorSpinorField&);
 
+  /**
+     Location-generic BLAS, used by the solvers.  Each routine
+     dispatches to its CUDA or CPU variant according to the location
+     of the fields, which must all reside in the same place.
+  */
+  namespace blas {
+
+    void zero(ColorSpinorField &a);
+    void copy(ColorSpinorField &dst, const ColorSpinorField &src);
+
+    double axpyNorm(const double &a, ColorSpinorField &x, ColorSpinorField &y);
+    double reDotProduct(ColorSpinorField &a, ColorSpinorField &b);
+    double xmyNorm(ColorSpinorField &a, ColorSpinorField &b);
+
+    void axpby(const double &a, ColorSpinorField &x, const double &b, ColorSpinorField &y);
+    void axpy(const double &a, ColorSpinorField &x, ColorSpinorField &y);
+    void ax(const double &a, ColorSpinorField &x);
+    void xpy(ColorSpinorField &x, ColorSpinorField &y);
+    void xpay(ColorSpinorField &x, const double &a, ColorSpinorField &y);
+    void mxpy(ColorSpinorField &x, ColorSpinorField &y);
+
+    void axpyZpbx(const double &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, const double &b);
+    void axpyBzpcx(const double &a, ColorSpinorField& x, ColorSpinorField& y, const double &b, ColorSpinorField& z, const double &c);
+
+    void caxpby(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y);
+    void caxpy(const Complex &a, ColorSpinorField &x, ColorSpinorField &y);
+    void cxpaypbz(ColorSpinorField &, const Complex &b, ColorSpinorField &y, const Complex &c, ColorSpinorField &z);
+    void caxpbypzYmbw(const Complex &, ColorSpinorField &, const Complex &, ColorSpinorField &, ColorSpinorField &, ColorSpinorField &);
+
+    Complex cDotProduct(ColorSpinorField &, ColorSpinorField &);
+    Complex xpaycDotzy(ColorSpinorField &x, const double &a, ColorSpinorField &y, ColorSpinorField &z);
+
+    double3 cDotProductNormA(ColorSpinorField &a, ColorSpinorField &b);
+    double3 cDotProductNormB(ColorSpinorField &a, ColorSpinorField &b);
+    double3 caxpbypzYmbwcDotProductUYNormY(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y,
+					   ColorSpinorField &z, ColorSpinorField &w, ColorSpinorField &u);
+
+    void cabxpyAx(const double &a, const Complex &b, ColorSpinorField &x, ColorSpinorField &y);
+    double caxpyNorm(const Complex &a, ColorSpinorField &x, ColorSpinorField &y);
+    void caxpyXmaz(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+    double caxpyXmazNormX(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+    double cabxpyAxNorm(const double &a, const Complex &b, ColorSpinorField &x, ColorSpinorField &y);
+
+    void caxpbypz(const Complex &, ColorSpinorField &, const Complex &, ColorSpinorField &, ColorSpinorField &);
+    void caxpbypczpw(const Complex &, ColorSpinorField &, const Complex &, ColorSpinorField &,
+		     const Complex &, ColorSpinorField &, ColorSpinorField &);
+    Complex caxpyDotzy(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+    Complex axpyCGNorm(const double &a, ColorSpinorField &x, ColorSpinorField &y);
+    double3 HeavyQuarkResidualNorm(ColorSpinorField &x, ColorSpinorField &r);
+    double3 xpyHeavyQuarkResidualNorm(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &r);
+
+    void tripleCGUpdate(const double &alpha, const double &beta, ColorSpinorField &q,
+			ColorSpinorField &r, ColorSpinorField &x, ColorSpinorField &p);
+    double3 tripleCGReduction(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+
+    void cDotProduct(Complex *result, ColorSpinorField **x, ColorSpinorField &y, const int N);
+    void caxpy(const Complex *a, ColorSpinorField **x, ColorSpinorField &y, const int N);
+
+  } // namespace blas
+
   // CUDA variants
 
   void zeroCuda(cudaColorSpinorField &a);
@@ -77,6 +140,30 @@ namespace quda {
 			  cudaColorSpinorField &r, cudaColorSpinorField &x, cudaColorSpinorField &p);
   double3 tripleCGReductionCuda(cudaColorSpinorField &x, cudaColorSpinorField &y, cudaColorSpinorField &z);
 
+  // Block variants, which act on a set of N fields in a single pass
+
+  /**
+     Compute the N complex dot products (x_i, y) of each field in the
+     set x with y, reading y only once.  Sets larger than
+     MAX_MULTI_BLAS_N are processed MAX_MULTI_BLAS_N fields at a time.
+     @param result Array of length N, which holds the dot products on return
+     @param x The set of N fields
+     @param y The field the set is reduced against
+     @param N The size of the set
+  */
+  void cDotProductCuda(Complex *result, cudaColorSpinorField **x, cudaColorSpinorField &y, const int N);
+
+  /**
+     Perform the N-term update y += sum_i a_i x_i, reading and writing
+     y only once.  Sets larger than MAX_MULTI_BLAS_N are processed
+     MAX_MULTI_BLAS_N fields at a time.
+     @param a Array of the N coefficients
+     @param x The set of N fields
+     @param y The field to update
+     @param N The size of the set
+  */
+  void caxpyCuda(const Complex *a, cudaColorSpinorField **x, cudaColorSpinorField &y, const int N);
+
   // CPU variants
 
   double axpyNormCpu(const double &a, const cpuColorSpinorField &x, cpuColorSpinorField &y);
@@ -129,6 +216,15 @@ namespace quda {
 			      cpuColorSpinorField &z);
   double3 HeavyQuarkResidualNormCpu(cpuColorSpinorField &x, cpuColorSpinorField &r);
   double3 xpyHeavyQuarkResidualNormCpu(cpuColorSpinorField &x, cpuColorSpinorField &y, cpuColorSpinorField &r);
+  Complex axpyCGNormCpu(const double &a, cpuColorSpinorField &x, cpuColorSpinorField &y);
+
+  void tripleCGUpdateCpu(const double &alpha, const double &beta, cpuColorSpinorField &q,
+			 cpuColorSpinorField &r, cpuColorSpinorField &x, cpuColorSpinorField &p);
+  double3 tripleCGReductionCpu(cpuColorSpinorField &x, cpuColorSpinorField &y, cpuColorSpinorField &z);
+
+  // Block variants (see the CUDA variants above)
+  void cDotProductCpu(Complex *result, cpuColorSpinorField **x, cpuColorSpinorField &y, const int N);
+  void caxpyCpu(const Complex *a, cpuColorSpinorField **x, cpuColorSpinorField &y, const int N);
 
 } // namespace quda
 
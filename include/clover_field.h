@@ -113,7 +113,15 @@ namespace quda {
     friend struct FullClover;
   };
 
-  // this is a place holder for a future host-side clover object
+  /**
+     Host-side clover field.  Either references user memory
+     (QUDA_REFERENCE_FIELD_CREATE) or allocates the direct and/or
+     inverse terms itself (QUDA_NULL_FIELD_CREATE).  The host Dirac
+     operators require QUDA_PACKED_CLOVER_ORDER, i.e., per site and
+     chirality the 6 real diagonal elements followed by the 15 complex
+     elements of the strictly lower triangle in column-major order, in
+     the DeGrand-Rossi basis.
+   */
   class cpuCloverField : public CloverField {
 
   private:
@@ -170,6 +178,31 @@ namespace quda {
   // driver for computing the clover field from the gauge field
   void computeCloverCuda(cudaCloverField &clover, const cudaGaugeField &gauge);
 
+  /**
+     Computes the clover term on the host from the field strength of
+     the gauge field (clover-leaf definition), filling clover.V(false):
+     A = 1 + coeff sum_{mu<nu} sigma_{mu nu} i F_{mu nu}, with
+     sigma_{mu nu} = (i/2)[gamma_mu, gamma_nu] in the DeGrand-Rossi
+     basis and F_{mu nu} the traceless part of (Q_{mu nu} -
+     Q_{mu nu}^dag)/8.  Requires a HOST_DSLASH build, a packed-order
+     clover field and a QDP-ordered gauge field without
+     reconstruction.
+     @param clover The clover field
+     @param gauge The gauge field
+     @param coeff The clover coefficient (kappa * c_sw)
+  */
+  void computeCloverCpu(cpuCloverField &clover, const cpuGaugeField &gauge, double coeff);
+
+  /**
+     Computes the inverse of the clover term on the host, overwriting
+     clover.V(true) with the inverse of clover.V(false).  Each 6x6
+     Hermitian chiral block is Cholesky factorized, with blocks from
+     neighbouring sites processed together, one block per SIMD lane.
+     Requires a HOST_DSLASH build and a packed-order field.
+     @param clover The clover field (both terms must be allocated)
+  */
+  void cloverInvertCpu(cpuCloverField &clover);
+
   // driver for generic clover field copying
   /**
      This function is used for  extracting the gauge ghost zone from a
@@ -24,6 +24,7 @@ namespace quda {
     QudaFieldOrder fieldOrder; // Float, Float2, Float4 etc.
     QudaGammaBasis gammaBasis;
     QudaFieldCreate create; // 
+    QudaFieldLocation location; // where ColorSpinorField::Create allocates the field
 
     void *v; // pointer to field
     void *norm;
@@ -34,14 +35,14 @@ namespace quda {
     : LatticeFieldParam(), nColor(0), nSpin(0), twistFlavor(QUDA_TWIST_INVALID), 
       siteSubset(QUDA_INVALID_SITE_SUBSET), siteOrder(QUDA_INVALID_SITE_ORDER), 
       fieldOrder(QUDA_INVALID_FIELD_ORDER), gammaBasis(QUDA_INVALID_GAMMA_BASIS), 
-      create(QUDA_INVALID_FIELD_CREATE) { ; }
+      create(QUDA_INVALID_FIELD_CREATE), location(QUDA_INVALID_FIELD_LOCATION) { ; }
   
     // used to create cpu params
   ColorSpinorParam(void *V, QudaInvertParam &inv_param, const int *X, const bool pc_solution)
     : LatticeFieldParam(4, X, 0, inv_param.cpu_prec), nColor(3), nSpin(inv_param.dslash_type == QUDA_ASQTAD_DSLASH ? 1 : 4), 
       twistFlavor(inv_param.twist_flavor), siteSubset(QUDA_INVALID_SITE_SUBSET), siteOrder(QUDA_INVALID_SITE_ORDER), 
       fieldOrder(QUDA_INVALID_FIELD_ORDER), gammaBasis(inv_param.gamma_basis), 
-      create(QUDA_REFERENCE_FIELD_CREATE), v(V) { 
+      create(QUDA_REFERENCE_FIELD_CREATE), location(QUDA_CPU_FIELD_LOCATION), v(V) { 
 
         if (nDim > QUDA_MAX_DIM) errorQuda("Number of dimensions too great");
 	for (int d=0; d<nDim; d++) x[d] = X[d];
@@ -90,7 +91,7 @@ namespace quda {
       siteSubset(cpuParam.siteSubset), siteOrder(QUDA_EVEN_ODD_SITE_ORDER), 
       fieldOrder(QUDA_INVALID_FIELD_ORDER), 
       gammaBasis(nSpin == 4? QUDA_UKQCD_GAMMA_BASIS : QUDA_DEGRAND_ROSSI_GAMMA_BASIS), 
-      create(QUDA_COPY_FIELD_CREATE), v(0)
+      create(QUDA_COPY_FIELD_CREATE), location(QUDA_CUDA_FIELD_LOCATION), v(0)
       {
 	fieldOrder = (precision == QUDA_DOUBLE_PRECISION || nSpin == 1) ? 
 	  QUDA_FLOAT2_FIELD_ORDER : QUDA_FLOAT4_FIELD_ORDER; 
@@ -98,6 +99,8 @@ namespace quda {
 
     void setPrecision(QudaPrecision precision) {
       this->precision = precision;
+      // host field orders do not depend on the precision
+      if (location == QUDA_CPU_FIELD_LOCATION) return;
       fieldOrder = (precision == QUDA_DOUBLE_PRECISION || nSpin == 1) ? 
 	QUDA_FLOAT2_FIELD_ORDER : QUDA_FLOAT4_FIELD_ORDER; 
     }
@@ -115,6 +118,7 @@ namespace quda {
       printfQuda("fieldOrder = %d\n", fieldOrder);
       printfQuda("gammaBasis = %d\n", gammaBasis);
       printfQuda("create = %d\n", create);
+      printfQuda("location = %d\n", location);
       printfQuda("v = %lx\n", (unsigned long)v);
       printfQuda("norm = %lx\n", (unsigned long)norm);
     }
@@ -199,6 +203,25 @@ namespace quda {
 
     virtual ColorSpinorField& operator=(const ColorSpinorField &);
 
+    /**
+       Field factory: returns a cpuColorSpinorField or a
+       cudaColorSpinorField according to param.location
+       @param param Parameters of the field to create
+    */
+    static ColorSpinorField* Create(const ColorSpinorParam &param);
+
+    /**
+       Field factory: as above, but with src supplying the contents
+       when param.create is QUDA_COPY_FIELD_CREATE
+       @param src The field to copy
+       @param param Parameters of the field to create
+    */
+    static ColorSpinorField* Create(const ColorSpinorField &src, const ColorSpinorParam &param);
+
+    virtual ColorSpinorField& Even() const = 0;
+    virtual ColorSpinorField& Odd() const = 0;
+    virtual void zero() = 0;
+
     QudaPrecision Precision() const { return precision; }
     int Ncolor() const { return nColor; } 
     int Nspin() const { return nSpin; } 
@@ -354,6 +377,7 @@ namespace quda {
   template <typename Float> class SpaceColorSpinOrder;
   template <typename Float> class SpaceSpinColorOrder;
   template <typename Float> class QOPDomainWallOrder;
+  template <typename Float> class AoSoASpinColorOrder;
 
   // CPU implementation
   class cpuColorSpinorField : public ColorSpinorField {
@@ -363,6 +387,7 @@ namespace quda {
     template <typename Float> friend class SpaceColorSpinOrder;
     template <typename Float> friend class SpaceSpinColorOrder;
     template <typename Float> friend class QOPDomainWallOrder;
+    template <typename Float> friend class AoSoASpinColorOrder;
 
   public:
     static void* fwdGhostFaceBuffer[QUDA_MAX_DIM]; //cpu memory
@@ -377,6 +402,8 @@ namespace quda {
     bool init;
     bool reference; // whether the field is a reference or not
 
+    static size_t ghostFaceBytes[QUDA_MAX_DIM]; // size of each of the ghost buffers
+
     void create(const QudaFieldCreate);
     void destroy();
 
@@ -391,8 +418,8 @@ namespace quda {
     cpuColorSpinorField& operator=(const cpuColorSpinorField&);
     cpuColorSpinorField& operator=(const cudaColorSpinorField&);
 
-    //cpuColorSpinorField& Even() const;
-    //cpuColorSpinorField& Odd() const;
+    cpuColorSpinorField& Even() const;
+    cpuColorSpinorField& Odd() const;
 
     void Source(const QudaSourceType sourceType, const int st=0, const int s=0, const int c=0);
     static int Compare(const cpuColorSpinorField &a, const cpuColorSpinorField &b, const int resolution=1);
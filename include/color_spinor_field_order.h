@@ -105,6 +105,38 @@ namespace quda {
     }
   };
 
+  /**
+     Array-of-structure-of-arrays order: the sites are split into
+     blocks of QUDA_AOSOA_BLOCK, and within a block each
+     spin-color-complex component of the sites is contiguous.
+  */
+  template <typename Float>
+    class AoSoASpinColorOrder : public ColorSpinorFieldOrder<Float> {
+
+  private:
+    cpuColorSpinorField &field;  // convenient to have a "local" reference for code brevity
+
+  public:
+  AoSoASpinColorOrder(cpuColorSpinorField &field) : ColorSpinorFieldOrder<Float>(field), field(field)
+      { ; }
+    virtual ~AoSoASpinColorOrder() { ; }
+
+    const Float& operator()(const int &x, const int &s, const int &c, const int &z) const {
+      return *((Float*)(field.v) + index(x, s, c, z));
+    }
+
+    Float& operator()(const int &x, const int &s, const int &c, const int &z) {
+      return *((Float*)(field.v) + index(x, s, c, z));
+    }
+
+  private:
+    // blocks never straddle the parities, so x may run over both
+    unsigned long index(int x, int s, int c, int z) const {
+      const int B = QUDA_AOSOA_BLOCK;
+      return ((((unsigned long)(x/B)*field.nSpin + s)*field.nColor + c)*2 + z)*B + x%B;
+    }
+  };
+
 template <typename Float, int Ns, int Nc, int N>
 struct FloatNOrder {
   typedef typename mapper<Float>::type RegType;
@@ -192,10 +224,12 @@ template <typename Float, int Ns, int Nc>
 struct SpaceColorSpinorOrder {
   typedef typename mapper<Float>::type RegType;
   Float *field;
+  float *norm; // per-site normalization of half precision fields
   int volumeCB;
   int stride;
-  SpaceColorSpinorOrder(const ColorSpinorField &a, Float *field_=0) 
-  : field(field_ ? field_ : (Float*)a.V()), volumeCB(a.VolumeCB()), stride(a.Stride()) 
+  SpaceColorSpinorOrder(const ColorSpinorField &a, Float *field_=0, float *norm_=0) 
+  : field(field_ ? field_ : (Float*)a.V()), norm(norm_ ? norm_ : (float*)a.Norm()),
+    volumeCB(a.VolumeCB()), stride(a.Stride()) 
   { if (volumeCB != stride) errorQuda("Stride must equal volume for this field order"); }
   virtual ~SpaceColorSpinorOrder() { ; }
 
@@ -204,7 +238,8 @@ struct SpaceColorSpinorOrder {
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  v[(s*Nc+c)*2+z] = field[((x*Nc + c)*Ns + s)*2 + z]; 
+	  copy(v[(s*Nc+c)*2+z], field[((x*Nc + c)*Ns + s)*2 + z]);
+	  if (isHalf<Float>::value) v[(s*Nc+c)*2+z] *= norm[x];
 	}
       }
     }
@@ -212,10 +247,17 @@ struct SpaceColorSpinorOrder {
 
   __device__ __host__ inline void save(const RegType v[Ns*Nc*2], int x) {
     if (x >= volumeCB) return;
+    RegType scale = 1.0;
+    if (isHalf<Float>::value) {
+      RegType max = 0.0;
+      for (int i=0; i<2*Ns*Nc; i++) max = fabs(v[i]) > max ? fabs(v[i]) : max;
+      norm[x] = max;
+      if (max > 0.0) scale = 1.0 / max;
+    }
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  field[((x*Nc + c)*Ns + s)*2 + z] = v[(s*Nc+c)*2+z];
+	  copy(field[((x*Nc + c)*Ns + s)*2 + z], scale*v[(s*Nc+c)*2+z]);
 	}
       }
     }
@@ -342,10 +384,12 @@ template <typename Float, int Ns, int Nc>
 struct SpaceSpinorColorOrder {
   typedef typename mapper<Float>::type RegType;
   Float *field;
+  float *norm; // per-site normalization of half precision fields
   int volumeCB;
   int stride;
-  SpaceSpinorColorOrder(const ColorSpinorField &a, Float *field_=0) 
-  : field(field_ ? field_ : (Float*)a.V()), volumeCB(a.VolumeCB()), stride(a.Stride())
+  SpaceSpinorColorOrder(const ColorSpinorField &a, Float *field_=0, float *norm_=0) 
+  : field(field_ ? field_ : (Float*)a.V()), norm(norm_ ? norm_ : (float*)a.Norm()),
+    volumeCB(a.VolumeCB()), stride(a.Stride())
   { if (volumeCB != stride) errorQuda("Stride must equal volume for this field order"); }
   virtual ~SpaceSpinorColorOrder() { ; }
 
@@ -354,7 +398,8 @@ struct SpaceSpinorColorOrder {
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  v[(s*Nc+c)*2+z] = field[((x*Ns + s)*Nc + c)*2 + z];
+	  copy(v[(s*Nc+c)*2+z], field[((x*Ns + s)*Nc + c)*2 + z]);
+	  if (isHalf<Float>::value) v[(s*Nc+c)*2+z] *= norm[x];
 	}
       }
     }
@@ -362,10 +407,17 @@ struct SpaceSpinorColorOrder {
 
   __device__ __host__ inline void save(const RegType v[Ns*Nc*2], int x) {
     if (x >= volumeCB) return;
+    RegType scale = 1.0;
+    if (isHalf<Float>::value) {
+      RegType max = 0.0;
+      for (int i=0; i<2*Ns*Nc; i++) max = fabs(v[i]) > max ? fabs(v[i]) : max;
+      norm[x] = max;
+      if (max > 0.0) scale = 1.0 / max;
+    }
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  field[((x*Ns + s)*Nc + c)*2 + z] = v[(s*Nc+c)*2+z];
+	  copy(field[((x*Ns + s)*Nc + c)*2 + z], scale*v[(s*Nc+c)*2+z]);
 	}
       }
     }
@@ -384,6 +436,71 @@ struct SpaceSpinorColorOrder {
 };
 
 
+/**
+   Array-of-structure-of-arrays host order (QUDA_AOSOA_FIELD_ORDER):
+   component (s,c,z) of site x is at (((x/B*Ns + s)*Nc + c)*2 + z)*B +
+   x%B, with B = QUDA_AOSOA_BLOCK, so a vector of adjacent sites is a
+   unit-stride load.
+*/
+template <typename Float, int Ns, int Nc>
+struct AoSoASpinorColorOrder {
+  typedef typename mapper<Float>::type RegType;
+  Float *field;
+  float *norm;
+  int volumeCB;
+  int stride;
+  AoSoASpinorColorOrder(const ColorSpinorField &a, Float *field_=0, float *norm_=0)
+  : field(field_ ? field_ : (Float*)a.V()), norm(norm_ ? norm_ : (float*)a.Norm()),
+    volumeCB(a.VolumeCB()), stride(a.Stride())
+  { if (volumeCB != stride) errorQuda("Stride must equal volume for this field order"); }
+  virtual ~AoSoASpinorColorOrder() { ; }
+
+  __device__ __host__ inline int index(int x, int s, int c, int z) const {
+    const int B = QUDA_AOSOA_BLOCK;
+    return ((((x/B)*Ns + s)*Nc + c)*2 + z)*B + x%B;
+  }
+
+  __device__ __host__ inline void load(RegType v[Ns*Nc*2], int x) const {
+    if (x >= volumeCB) return;
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<Nc; c++) {
+	for (int z=0; z<2; z++) {
+	  copy(v[(s*Nc+c)*2+z], field[index(x,s,c,z)]);
+	  if (isHalf<Float>::value) v[(s*Nc+c)*2+z] *= norm[x];
+	}
+      }
+    }
+  }
+
+  __device__ __host__ inline void save(const RegType v[Ns*Nc*2], int x) {
+    if (x >= volumeCB) return;
+    RegType scale = 1.0;
+    if (isHalf<Float>::value) {
+      RegType max = 0.0;
+      for (int i=0; i<2*Ns*Nc; i++) max = fabs(v[i]) > max ? fabs(v[i]) : max;
+      norm[x] = max;
+      if (max > 0.0) scale = 1.0 / max;
+    }
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<Nc; c++) {
+	for (int z=0; z<2; z++) {
+	  copy(field[index(x,s,c,z)], scale*v[(s*Nc+c)*2+z]);
+	}
+      }
+    }
+  }
+
+  __device__ __host__ const RegType& operator()(int x, int s, int c, int z) const {
+    return field[index(x,s,c,z)];
+  }
+
+  __device__ __host__ RegType& operator()(int x, int s, int c, int z) {
+    return field[index(x,s,c,z)];
+  }
+
+  size_t Bytes() const { return volumeCB * Nc * Ns * 2 * sizeof(Float); }
+};
+
 template <typename Float, int Ns, int Nc>
 struct QDPJITDiracOrder {
   typedef typename mapper<Float>::type RegType;
@@ -50,6 +50,9 @@ extern "C" {
   void comm_allreduce_max(double* data);
   void comm_allreduce_array(double* data, size_t size);
   void comm_allreduce_int(int* data);
+  /* nonblocking in-place sum: data is only valid after comm_allreduce_wait() */
+  MsgHandle *comm_iallreduce_array(double* data, size_t size);
+  void comm_allreduce_wait(MsgHandle *mh);
   void comm_broadcast(void *data, size_t nbytes);
   void comm_barrier(void);
   void comm_abort(int status);
@@ -29,6 +29,10 @@ namespace quda {
     cudaGaugeField *fatGauge;  // used by staggered only
     cudaGaugeField *longGauge; // used by staggered only
     cudaCloverField *clover;
+    const cpuGaugeField *hostGauge; // used by the host dslash only (QDP order, no reconstruction)
+    const cpuGaugeField *hostFatGauge;  // used by the host staggered dslash only
+    const cpuGaugeField *hostLongGauge; // used by the host staggered dslash only
+    const cpuCloverField *hostClover;   // used by the host clover dslash only (packed order)
   
     double mu; // used by twisted mass only
     double epsilon; //2nd tm parameter (used by twisted mass only)
@@ -40,7 +44,7 @@ namespace quda {
 
   DiracParam() 
     : type(QUDA_INVALID_DIRAC), kappa(0.0), m5(0.0), matpcType(QUDA_MATPC_INVALID),
-      dagger(QUDA_DAG_INVALID), gauge(0), clover(0), mu(0.0), epsilon(0.0),
+      dagger(QUDA_DAG_INVALID), gauge(0), clover(0), hostGauge(0), hostFatGauge(0), hostLongGauge(0), hostClover(0), mu(0.0), epsilon(0.0),
       tmp1(0), tmp2(0)
     {
 
@@ -91,6 +95,15 @@ namespace quda {
     bool newTmp(cudaColorSpinorField **, const cudaColorSpinorField &) const;
     void deleteTmp(cudaColorSpinorField **, const bool &reset) const;
 
+    const cpuGaugeField *hostGauge; // gauge field used when applying the operator on the host
+    mutable cpuColorSpinorField *hostTmp1;
+    mutable cpuColorSpinorField *hostTmp2;
+
+    bool newTmp(cpuColorSpinorField **, const cpuColorSpinorField &) const;
+    void deleteTmp(cpuColorSpinorField **, const bool &reset) const;
+    cpuColorSpinorField** newTmpBlock(cpuColorSpinorField **, const int nRhs) const;
+    void deleteTmpBlock(cpuColorSpinorField **, const int nRhs) const;
+
     QudaTune tune;
 
     int commDim[QUDA_MAX_DIM]; // whether do comms or not
@@ -123,6 +136,32 @@ namespace quda {
     virtual void reconstruct(cudaColorSpinorField &x, const cudaColorSpinorField &b,
 			     const QudaSolutionType) const = 0;
     void setMass(double mass){ this->mass = mass;}
+
+    // host versions of the operator, only available with a host-dslash build
+    virtual void checkParitySpinor(const cpuColorSpinorField &, const cpuColorSpinorField &) const;
+    virtual void checkFullSpinor(const cpuColorSpinorField &, const cpuColorSpinorField &) const;
+    void checkSpinorAlias(const cpuColorSpinorField &, const cpuColorSpinorField &) const;
+
+    virtual void Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			    const QudaParity parity, const cpuColorSpinorField &x,
+			    const double &k) const;
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void Mdag(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+
+    // block versions, applying the dslash to nRhs fields at once
+    // (by default one field at a time)
+    void checkParityBlock(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+    virtual void Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+    virtual void M(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+    virtual void MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+    void Mdag(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+
     // Dirac operator factory
     static Dirac* create(const DiracParam &param);
 
@@ -150,6 +189,17 @@ namespace quda {
     virtual void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     virtual void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    virtual void Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			    const QudaParity parity, const cpuColorSpinorField &x, const double &k) const;
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+
     virtual void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			 const QudaSolutionType) const;
@@ -171,6 +221,11 @@ namespace quda {
     void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void M(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+    void MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+
     void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 		 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 		 const QudaSolutionType) const;
@@ -183,7 +238,9 @@ namespace quda {
 
   protected:
     cudaCloverField &clover;
+    const cpuCloverField *hostClover; // clover field used when applying the operator on the host
     void checkParitySpinor(const cudaColorSpinorField &, const cudaColorSpinorField &) const;
+    void checkParitySpinor(const cpuColorSpinorField &, const cpuColorSpinorField &) const;
 
   public:
     DiracClover(const DiracParam &param);
@@ -197,6 +254,14 @@ namespace quda {
     virtual void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     virtual void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    void Clover(cpuColorSpinorField &out, const cpuColorSpinorField &in, const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, const QudaParity parity,
+			    const cpuColorSpinorField &x, const double &k) const;
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+
     virtual void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			 const QudaSolutionType) const;
@@ -222,6 +287,21 @@ namespace quda {
     void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    void CloverInv(cpuColorSpinorField &out, const cpuColorSpinorField &in, const QudaParity parity) const;
+    void Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		const QudaParity parity) const;
+    void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		    const QudaParity parity, const cpuColorSpinorField &x, const double &k) const;
+
+    void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+		const QudaParity parity) const;
+    void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+		    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+    void M(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+    void MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+
     void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 		 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 		 const QudaSolutionType) const;
@@ -252,6 +332,17 @@ namespace quda {
     virtual void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     virtual void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    void Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		const QudaParity parity) const;
+    void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		    const QudaParity parity, const cpuColorSpinorField &x, const double &k) const;
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+		const QudaParity parity) const;
+    void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+		    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+
     virtual void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			 const QudaSolutionType) const;
@@ -273,6 +364,9 @@ namespace quda {
     void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+
     void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 		 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 		 const QudaSolutionType) const;
@@ -292,6 +386,10 @@ namespace quda {
     static int initTMFlag;
     void initConstants(const cudaColorSpinorField &in) const;
 
+    // coefficients of the twist as used by the host dslash
+    void hostTwist(double &a, double &b, double &c, const cpuColorSpinorField &in,
+		   const QudaTwistGamma5Type twistType) const;
+
   public:
     DiracTwistedMass(const DiracTwistedMass &dirac);
     DiracTwistedMass(const DiracParam &param, const int nDim);
@@ -303,6 +401,9 @@ namespace quda {
     virtual void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     virtual void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+
     virtual void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			 const QudaSolutionType) const;
@@ -329,6 +430,17 @@ namespace quda {
     void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    virtual void Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			    const QudaParity parity, const cpuColorSpinorField &x, const double &k) const;
+    void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+
     void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 		 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 		 const QudaSolutionType) const;
@@ -342,6 +454,8 @@ namespace quda {
   protected:
     cudaGaugeField &fatGauge;
     cudaGaugeField &longGauge;
+    const cpuGaugeField *hostFatGauge;
+    const cpuGaugeField *hostLongGauge;
     FaceBuffer face; // multi-gpu communication buffers
 
   public:
@@ -359,6 +473,19 @@ namespace quda {
     virtual void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     virtual void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    virtual void checkParitySpinor(const cpuColorSpinorField &, const cpuColorSpinorField &) const;
+
+    virtual void Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			    const QudaParity parity, const cpuColorSpinorField &x, const double &k) const;
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			const QudaParity parity) const;
+    virtual void DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			    const QudaParity parity, cpuColorSpinorField **x, const double &k) const;
+
     virtual void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			 const QudaSolutionType) const;
@@ -380,6 +507,10 @@ namespace quda {
     virtual void M(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
     virtual void MdagM(cudaColorSpinorField &out, const cudaColorSpinorField &in) const;
 
+    virtual void M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const;
+    virtual void MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const;
+
     virtual void prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			 const QudaSolutionType) const;
@@ -404,9 +535,51 @@ namespace quda {
     virtual void operator()(cudaColorSpinorField &out, const cudaColorSpinorField &in,
 			    cudaColorSpinorField &Tmp1, cudaColorSpinorField &Tmp2) const = 0;
 
+    // host versions, which require a Dirac operator with a host gauge field
+    virtual void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in) const = 0;
+    virtual void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in,
+			    cpuColorSpinorField &tmp) const = 0;
+    virtual void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in,
+			    cpuColorSpinorField &Tmp1, cpuColorSpinorField &Tmp2) const = 0;
+
+    // block host version, applying the operator to nRhs fields with the multi-RHS dslash
+    virtual void operator()(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const = 0;
+
+    // location-generic versions used by the solvers, which forward to
+    // the CUDA or host version according to the location of in
+    void operator()(ColorSpinorField &out, const ColorSpinorField &in) const
+    {
+      if (in.Location() == QUDA_CUDA_FIELD_LOCATION) (*this)(Cuda(out), Cuda(in));
+      else (*this)(Cpu(out), Cpu(in));
+    }
+
+    void operator()(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &tmp) const
+    {
+      if (in.Location() == QUDA_CUDA_FIELD_LOCATION) (*this)(Cuda(out), Cuda(in), Cuda(tmp));
+      else (*this)(Cpu(out), Cpu(in), Cpu(tmp));
+    }
+
+    void operator()(ColorSpinorField &out, const ColorSpinorField &in,
+		    ColorSpinorField &Tmp1, ColorSpinorField &Tmp2) const
+    {
+      if (in.Location() == QUDA_CUDA_FIELD_LOCATION) (*this)(Cuda(out), Cuda(in), Cuda(Tmp1), Cuda(Tmp2));
+      else (*this)(Cpu(out), Cpu(in), Cpu(Tmp1), Cpu(Tmp2));
+    }
+
+    // CUDA fields have no multi-RHS dslash and are applied one at a time
+    void operator()(ColorSpinorField **out, ColorSpinorField **in, const int nRhs) const;
+
     unsigned long long flops() const { return dirac->Flops(); }
 
     std::string Type() const { return typeid(*dirac).name(); }
+
+  private:
+    static cudaColorSpinorField& Cuda(ColorSpinorField &a) { return static_cast<cudaColorSpinorField&>(a); }
+    static const cudaColorSpinorField& Cuda(const ColorSpinorField &a)
+    { return static_cast<const cudaColorSpinorField&>(a); }
+    static cpuColorSpinorField& Cpu(ColorSpinorField &a) { return static_cast<cpuColorSpinorField&>(a); }
+    static const cpuColorSpinorField& Cpu(const ColorSpinorField &a)
+    { return static_cast<const cpuColorSpinorField&>(a); }
   };
 
   inline DiracMatrix::~DiracMatrix()
@@ -420,6 +593,8 @@ namespace quda {
   DiracM(const Dirac &d) : DiracMatrix(d) { }
   DiracM(const Dirac *d) : DiracMatrix(d) { }
 
+    using DiracMatrix::operator();
+
     void operator()(cudaColorSpinorField &out, const cudaColorSpinorField &in) const
     {
       dirac->M(out, in);
@@ -441,6 +616,33 @@ namespace quda {
       dirac->tmp2 = NULL;
       dirac->tmp1 = NULL;
     }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+    {
+      dirac->M(out, in);
+    }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in, cpuColorSpinorField &tmp) const
+    {
+      dirac->hostTmp1 = &tmp;
+      dirac->M(out, in);
+      dirac->hostTmp1 = NULL;
+    }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		    cpuColorSpinorField &Tmp1, cpuColorSpinorField &Tmp2) const
+    {
+      dirac->hostTmp1 = &Tmp1;
+      dirac->hostTmp2 = &Tmp2;
+      dirac->M(out, in);
+      dirac->hostTmp2 = NULL;
+      dirac->hostTmp1 = NULL;
+    }
+
+    void operator()(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+    {
+      dirac->M(out, in, nRhs);
+    }
   };
 
   class DiracMdagM : public DiracMatrix {
@@ -452,6 +654,8 @@ namespace quda {
     //! Shift term added onto operator (M^dag M + shift)
     double shift;
 
+    using DiracMatrix::operator();
+
     void operator()(cudaColorSpinorField &out, const cudaColorSpinorField &in) const
     {
       dirac->MdagM(out, in);
@@ -476,6 +680,37 @@ namespace quda {
       dirac->tmp2 = NULL;
       dirac->tmp1 = NULL;
     }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+    {
+      dirac->MdagM(out, in);
+      if (shift != 0.0) axpyCpu(shift, in, out);
+    }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in, cpuColorSpinorField &tmp) const
+    {
+      dirac->hostTmp1 = &tmp;
+      dirac->MdagM(out, in);
+      if (shift != 0.0) axpyCpu(shift, in, out);
+      dirac->hostTmp1 = NULL;
+    }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		    cpuColorSpinorField &Tmp1, cpuColorSpinorField &Tmp2) const
+    {
+      dirac->hostTmp1 = &Tmp1;
+      dirac->hostTmp2 = &Tmp2;
+      dirac->MdagM(out, in);
+      if (shift != 0.0) axpyCpu(shift, in, out);
+      dirac->hostTmp2 = NULL;
+      dirac->hostTmp1 = NULL;
+    }
+
+    void operator()(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+    {
+      dirac->MdagM(out, in, nRhs);
+      if (shift != 0.0) for (int r=0; r<nRhs; r++) axpyCpu(shift, *in[r], *out[r]);
+    }
   };
 
   class DiracMdag : public DiracMatrix {
@@ -484,6 +719,8 @@ namespace quda {
   DiracMdag(const Dirac &d) : DiracMatrix(d) { }
   DiracMdag(const Dirac *d) : DiracMatrix(d) { }
 
+    using DiracMatrix::operator();
+
     void operator()(cudaColorSpinorField &out, const cudaColorSpinorField &in) const
     {
       dirac->Mdag(out, in);
@@ -505,6 +742,33 @@ namespace quda {
       dirac->tmp2 = NULL;
       dirac->tmp1 = NULL;
     }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+    {
+      dirac->Mdag(out, in);
+    }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in, cpuColorSpinorField &tmp) const
+    {
+      dirac->hostTmp1 = &tmp;
+      dirac->Mdag(out, in);
+      dirac->hostTmp1 = NULL;
+    }
+
+    void operator()(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		    cpuColorSpinorField &Tmp1, cpuColorSpinorField &Tmp2) const
+    {
+      dirac->hostTmp1 = &Tmp1;
+      dirac->hostTmp2 = &Tmp2;
+      dirac->Mdag(out, in);
+      dirac->hostTmp2 = NULL;
+      dirac->hostTmp1 = NULL;
+    }
+
+    void operator()(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+    {
+      dirac->Mdag(out, in, nRhs);
+    }
   };
 
 } // namespace quda
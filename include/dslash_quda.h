@@ -28,6 +28,30 @@ namespace quda {
    */
   bool getTwistPack();
 
+  /**
+     @param overlap Sets whether the host dslash computes the interior
+     while the halo is being exchanged (default true)
+   */
+  void setHostDslashOverlap(bool overlap);
+
+  /**
+     @return Whether the host dslash overlaps the halo exchange
+   */
+  bool getHostDslashOverlap();
+
+  /**
+     @param generated Sets whether the host Wilson-type dslash uses
+     the generated kernels, vectorized over sites, or the hand-written
+     ones, which keep the operation order of the reference (default
+     true only in AVX2 and AVX-512 builds)
+   */
+  void setHostDslashGenerated(bool generated);
+
+  /**
+     @return Whether the host dslash uses the generated kernels
+   */
+  bool getHostDslashGenerated();
+
   void setFace(const FaceBuffer &face);
 
   bool getDslashLaunch();
@@ -86,6 +110,168 @@ namespace quda {
                        const double &kappa, const double &mu, const double &epsilon, 
                        const QudaTwistGamma5Type);
 
+  /**
+     Host implementation of the Wilson Dslash (threaded and
+     vectorized, see dslash_cpu.cpp).  Fields must be in
+     SPACE_SPIN_COLOR order with the DeGrand-Rossi basis and the gauge
+     field in QDP order, either uncompressed or with 12 or 8
+     reconstruction.
+     @param out The output field (single parity)
+     @param gauge The gauge field
+     @param in The input field (single parity)
+     @param parity The parity of the output field
+     @param dagger Whether to apply the Hermitian conjugate
+     @param x If non-zero, compute out = x + k * D in
+     @param k The xpay scale factor
+     @param commDim Whether to communicate in each dimension
+   */
+  void wilsonDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+		       const int parity, const int dagger, const cpuColorSpinorField *x,
+		       const double &k, const int *commDim);
+
+  /**
+     Host clover dslash: the Wilson dslash followed by the clover
+     inverse, out = A^-1 D in (or x + k A^-1 D in).  The clover field
+     must be in QUDA_PACKED_CLOVER_ORDER and the same precision as the
+     spinors, which are as for wilsonDslashCpu.
+     @param out The output field (single parity)
+     @param gauge The gauge field
+     @param cloverInv The clover field holding the inverse
+     @param in The input field (single parity)
+     @param parity The parity of the output field
+     @param dagger Whether to apply the Hermitian conjugate
+     @param x If non-zero, compute out = x + k * A^-1 D in
+     @param k The xpay scale factor
+     @param commDim Whether to communicate in each dimension
+   */
+  void cloverDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuCloverField &cloverInv,
+		       const cpuColorSpinorField *in, const int parity, const int dagger,
+		       const cpuColorSpinorField *x, const double &k, const int *commDim);
+
+  /**
+     Asymmetric host clover dslash, out = A x + k D in, as used by the
+     asymmetric even-odd preconditioned operator.  Arguments are as
+     for cloverDslashCpu, with clover holding the clover term itself
+     and x required.
+   */
+  void asymCloverDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuCloverField &clover,
+			   const cpuColorSpinorField *in, const int parity, const int dagger,
+			   const cpuColorSpinorField *x, const double &k, const int *commDim);
+
+  /**
+     Apply the clover term, or its inverse, on the host.
+     @param out The output field (single parity)
+     @param clover The clover field (packed order)
+     @param in The input field (single parity)
+     @param parity The parity of the fields
+     @param inverse Whether to apply the inverse rather than the clover term
+   */
+  void cloverCpu(cpuColorSpinorField *out, const cpuCloverField &clover, const cpuColorSpinorField *in,
+		 const int parity, const bool inverse);
+
+  /**
+     Apply the twisted mass dslash on the host, for a single flavor
+     or (as a 5-d field with two flavors) a flavor doublet.  The twist
+     T = c (1 + i a gamma_5 tau_3 + b tau_1) (b is unused for a single
+     flavor, and a is negated for the dagger) is fused into the
+     hopping term, where type selects where it acts.  Only the
+     hand-written kernel in a build without FMA contraction matches
+     the tm_* references exactly, and then not for the symmetric
+     dagger matpc, where the reference twists and untwists its input
+     in place; otherwise the results agree to rounding.
+     @param out The output field (single parity)
+     @param gauge The gauge field
+     @param in The input field (single parity)
+     @param parity The parity of the output field
+     @param dagger Whether to apply the Hermitian conjugate
+     @param x The xpay field (may be zero unless type is QUDA_DEG_DSLASH_TWIST_XPAY)
+     @param type QUDA_DEG_TWIST_INV_DSLASH: D T in;
+     QUDA_DEG_DSLASH_TWIST_INV: T D in; QUDA_DEG_DSLASH_TWIST_XPAY:
+     T x + k D in.  With the first two, x + k times the result is
+     computed if x is non-zero.
+     @param a, b, c The twist coefficients
+     @param k The xpay scale factor
+     @param commDim Whether to communicate in each dimension
+   */
+  void twistedMassDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+			    const int parity, const int dagger, const cpuColorSpinorField *x,
+			    const QudaTwistDslashType type, const double &a, const double &b, const double &c,
+			    const double &k, const int *commDim);
+
+  /**
+     Apply the improved staggered dslash on the host.  The fields
+     must be in the same precision, the spinors in space-spin-color
+     order and the links in QDP order with any phases already applied.
+     The long links may be compressed with 13 or 9 reconstruction.
+     @param out The output field (single parity)
+     @param fatGauge The one-hop (fat) links
+     @param longGauge The three-hop (Naik) links
+     @param in The input field (single parity)
+     @param parity The parity of the output field
+     @param dagger Whether to apply the Hermitian conjugate
+     @param x If non-zero, compute out = k * x - D in
+     @param k The xpay scale factor
+     @param commDim Whether to communicate in each dimension
+   */
+  void staggeredDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &fatGauge, const cpuGaugeField &longGauge,
+			  const cpuColorSpinorField *in, const int parity, const int dagger,
+			  const cpuColorSpinorField *x, const double &k, const int *commDim);
+
+  /**
+     Apply the domain wall dslash (4-d hopping term plus the hops in
+     the fifth dimension) on the host.  Field requirements are as for
+     wilsonDslashCpu, with 5-d spinors.  The hand-written kernel
+     reproduces dw_dslash bit for bit, provided both are compiled
+     without FMA contraction; the generated one agrees to rounding.
+     @param out The output field (single parity)
+     @param gauge The gauge field
+     @param in The input field (single parity)
+     @param parity The parity of the output field
+     @param dagger Whether to apply the Hermitian conjugate
+     @param x If non-zero, compute out = x + k * D in
+     @param m_f The fermion mass, which enters at the walls
+     @param k The xpay scale factor
+     @param commDim Whether to communicate in each dimension
+   */
+  void domainWallDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+			   const int parity, const int dagger, const cpuColorSpinorField *x, const double &m_f,
+			   const double &k, const int *commDim);
+
+  /**
+     Block versions of the host Wilson, clover and staggered dslash,
+     which apply the operator to nRhs fields (e.g., the columns of a
+     propagator) in a single sweep.  The lanes of the host vectors run
+     over the fields, so the links (and clover term) at each site are
+     loaded once for the whole block rather than once per field, with
+     the input fields interleaved per site in a buffer that is reused
+     between calls (see freeHostDslashBuffer).  The fields must be
+     4-d, and are otherwise as for the single-field versions above,
+     with out[r], in[r] and x[r] (if x is non-zero) the r-th field of
+     each block.
+   */
+  void wilsonDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &gauge, cpuColorSpinorField **in,
+		       const int nRhs, const int parity, const int dagger, cpuColorSpinorField **x,
+		       const double &k, const int *commDim);
+
+  void cloverDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &gauge, const cpuCloverField &cloverInv,
+		       cpuColorSpinorField **in, const int nRhs, const int parity, const int dagger,
+		       cpuColorSpinorField **x, const double &k, const int *commDim);
+
+  void asymCloverDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &gauge, const cpuCloverField &clover,
+			   cpuColorSpinorField **in, const int nRhs, const int parity, const int dagger,
+			   cpuColorSpinorField **x, const double &k, const int *commDim);
+
+  void staggeredDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &fatGauge, const cpuGaugeField &longGauge,
+			  cpuColorSpinorField **in, const int nRhs, const int parity, const int dagger,
+			  cpuColorSpinorField **x, const double &k, const int *commDim);
+
+  /**
+     Free the buffers kept between calls by the host dslash: the
+     interleaved input fields of the block dslash, and the site lists
+     used to overlap the halo exchange
+   */
+  void freeHostDslashBuffer();
+
   // face packing routines
   void packFace(void *ghost_buf, cudaColorSpinorField &in, const int dagger, const int parity, const cudaStream_t &stream);
 
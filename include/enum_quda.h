@@ -34,6 +34,7 @@ extern "C" {
     QUDA_CPS_WILSON_GAUGE_ORDER, // expect *gauge, even-odd, mu, spacetime, column-row color
     QUDA_MILC_GAUGE_ORDER, // expect *gauge, even-odd, mu, spacetime, row-column order
     QUDA_BQCD_GAUGE_ORDER, // expect *gauge, mu, even-odd, spacetime+halos, column-row order
+    QUDA_AOSOA_GAUGE_ORDER, // expect *gauge[mu], even-odd, spacetime/B, row-column-complex, spacetime%B (B = QUDA_AOSOA_BLOCK)
     QUDA_INVALID_GAUGE_ORDER = QUDA_INVALID_ENUM
   } QudaGaugeFieldOrder;
 
@@ -84,6 +85,10 @@ extern "C" {
     QUDA_BICGSTAB_INVERTER,
     QUDA_GCR_INVERTER,
     QUDA_MR_INVERTER,
+    QUDA_PIPELINED_CG_INVERTER,
+    QUDA_SSTEP_CG_INVERTER,
+    QUDA_BLOCK_CG_INVERTER,
+    QUDA_EIGCG_INVERTER,
     QUDA_INVALID_INVERTER = QUDA_INVALID_ENUM
   } QudaInverterType;
 
@@ -257,6 +262,7 @@ extern "C" {
     QUDA_SPACE_COLOR_SPIN_FIELD_ORDER, // QLA ordering (spin inside color)
     QUDA_QDPJIT_FIELD_ORDER, // QDP field ordering (complex-color-spin-spacetime)
     QUDA_QOP_DOMAIN_WALL_FIELD_ORDER, // QOP domain-wall ordering
+    QUDA_AOSOA_FIELD_ORDER, // (space/B)-spin-color-complex-(space%B), B = QUDA_AOSOA_BLOCK (host only)
     QUDA_INVALID_FIELD_ORDER = QUDA_INVALID_ENUM
   } QudaFieldOrder;
   
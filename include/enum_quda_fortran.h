@@ -36,6 +36,7 @@
 #define QUDA_CPS_WILSON_GAUGE_ORDER 7 //expect *gauge even-odd spacetime column-row color
 #define QUDA_MILC_GAUGE_ORDER 8 //expect *gauge even-odd mu spacetime row-column order
 #define QUDA_BQCD_GAUGE_ORDER 9 //expect *gauge mu even-odd spacetime row-column order
+#define QUDA_AOSOA_GAUGE_ORDER 10 //expect *gauge[4] even-odd spacetime/B row-column-complex spacetime%B
 #define QUDA_INVALID_GAUGE_ORDER QUDA_INVALID_ENUM
 
 #define QudaTboundary integer(4)
@@ -78,6 +79,10 @@
 #define QUDA_BICGSTAB_INVERTER 1
 #define QUDA_GCR_INVERTER 2
 #define QUDA_MR_INVERTER 3
+#define QUDA_PIPELINED_CG_INVERTER 4
+#define QUDA_SSTEP_CG_INVERTER 5
+#define QUDA_BLOCK_CG_INVERTER 6
+#define QUDA_EIGCG_INVERTER 7
 #define QUDA_INVALID_INVERTER QUDA_INVALID_ENUM
 
 #define QudaSolutionType integer(4)
@@ -229,6 +234,7 @@
 #define QUDA_SPACE_COLOR_SPIN_FIELD_ORDER 6 // QLA ordering (spin inside color)
 #define QUDA_QDPJIT_FIELD_ORDER 7 // QDP field ordering (complex-color-spin-spacetime)
 #define QUDA_QOP_DOMAIN_WALL_FIELD_ORDER 8 // QOP domain-wall ordering
+#define QUDA_AOSOA_FIELD_ORDER 9 // (space/B)-spin-color-complex-(space%B), B = QUDA_AOSOA_BLOCK
 #define QUDA_INVALID_FIELD_ORDER QUDA_INVALID_ENUM
   
 #define QudaFieldCreate integer(4)
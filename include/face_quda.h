@@ -44,6 +44,12 @@ namespace quda {
     MsgHandle* mh_recv_back[QUDA_MAX_DIM];
     MsgHandle* mh_send_fwd[QUDA_MAX_DIM];
     MsgHandle* mh_send_back[QUDA_MAX_DIM];
+
+    // Message handles of the host spinor exchange (see exchangeCpuSpinorStart)
+    MsgHandle* mh_cpu_recv_fwd[QUDA_MAX_DIM];
+    MsgHandle* mh_cpu_recv_back[QUDA_MAX_DIM];
+    MsgHandle* mh_cpu_send_fwd[QUDA_MAX_DIM];
+    MsgHandle* mh_cpu_send_back[QUDA_MAX_DIM];
    
     int Ninternal; // number of internal degrees of freedom (12 for spin projected Wilson, 6 for staggered)
     QudaPrecision precision;
@@ -99,6 +105,29 @@ namespace quda {
     void scatter(quda::cudaColorSpinorField &out, int dagger, int dir);
     
     void exchangeCpuSpinor(quda::cpuColorSpinorField &in, int parity, int dagger);
+
+    /**
+       Non-blocking form of exchangeCpuSpinor, so that the host dslash
+       can work on the interior while the faces are in flight.
+       @param in The cpuColorSpinorField whose faces are sent
+       @param parity The parity of this field
+       @param dagger Whether the operator for which we are applying is the Hermitian conjugate or not
+     */
+    void exchangeCpuSpinorStart(quda::cpuColorSpinorField &in, int parity, int dagger);
+
+    /**
+       @param dim The dimension to test
+       @return Whether the exchange started by exchangeCpuSpinorStart
+       has completed in dimension dim (always true if it is not
+       partitioned)
+     */
+    int exchangeCpuSpinorQuery(int dim);
+
+    /**
+       Complete the exchange started by exchangeCpuSpinorStart, which
+       must be called before the FaceBuffer or the field is reused
+     */
+    void exchangeCpuSpinorWait();
     
     void exchangeLink(void** ghost_link, void** link_sendbuf, QudaFieldLocation location);
     
@@ -109,6 +138,8 @@ namespace quda {
 void reduceMaxDouble(double &);
 void reduceDouble(double &);
 void reduceDoubleArray(double *, const int len);
+void reduceDoubleArrayStart(double *, const int len);
+void reduceDoubleArrayWait();
 int commDim(int);
 int commCoords(int);
 int commDimPartitioned(int dir);
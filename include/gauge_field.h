@@ -245,6 +245,14 @@ namespace quda {
 
     void exchangeGhost();
 
+    /**
+       Copies (and if necessary reorders and converts the precision
+       of) a host gauge field into this field, and then recomputes
+       the ghost zone.
+       @param src The source field (must be a cpuGaugeField)
+    */
+    void copy(const GaugeField &src);
+
     void* Gauge_p() { return gauge; }
     const void* Gauge_p() const { return gauge; }
     void setGauge(void** _gauge); //only allowed when create== QUDA_REFERENCE_FIELD_CREATE
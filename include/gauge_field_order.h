@@ -469,23 +469,28 @@ size_t Bytes() const { return reconLen * sizeof(Float); }
 
 /** 
   The LegacyOrder defines the ghost zone storage and ordering for
-  all cpuGaugeFields, which use the same ghost zone storage.
+  all cpuGaugeFields, which use the same ghost zone storage.  Links
+  are stored as reconLen reals: with reconstruction (QDP order only)
+  these are the packed link, followed for 13 and 9 by its phase.
   */
-template <typename Float, int length> 
+template <typename Float, int length, int reconLen=length> 
 struct LegacyOrder {
   typedef typename mapper<Float>::type RegType;
+  Reconstruct<reconLen,Float> reconstruct;
   Float *ghost[QUDA_MAX_DIM];
   int faceVolumeCB[QUDA_MAX_DIM];
   const int volumeCB;
   const int stride;
   const int hasPhase;
-LegacyOrder(const GaugeField &u, Float **ghost_) : volumeCB(u.VolumeCB()), stride(u.Stride()), hasPhase(0) {
+LegacyOrder(const GaugeField &u, Float **ghost_) : reconstruct(u), volumeCB(u.VolumeCB()), stride(u.Stride()), 
+    hasPhase((reconLen == 13 || reconLen == 9) ? 1 : 0) {
     for (int i=0; i<4; i++) {
       ghost[i] = (ghost_) ? ghost_[i] : (Float*)(u.Ghost()[i]);
       faceVolumeCB[i] = u.SurfaceCB(i)*u.Nface(); // face volume equals surface * depth
     }
   }
-LegacyOrder(const LegacyOrder &order) : volumeCB(order.volumeCB), stride(order.stride), hasPhase(0) {
+LegacyOrder(const LegacyOrder &order) : reconstruct(order.reconstruct), volumeCB(order.volumeCB), 
+    stride(order.stride), hasPhase(order.hasPhase) {
     for (int i=0; i<4; i++) {
       ghost[i] = order.ghost[i];
       faceVolumeCB[i] = order.faceVolumeCB[i];
@@ -493,12 +498,26 @@ LegacyOrder(const LegacyOrder &order) : volumeCB(order.volumeCB), stride(order.s
   }
   virtual ~LegacyOrder() { ; }
 
+  /** Unpack the link stored at u, whose checkerboard index is x */
+  __device__ __host__ inline void unpack(RegType v[length], const Float *u, int x, int dir) const {
+    RegType tmp[reconLen];
+    for (int i=0; i<reconLen; i++) tmp[i] = (RegType)u[i];
+    reconstruct.Unpack(v, tmp, x, dir, hasPhase ? tmp[reconLen-1] : static_cast<RegType>(0.0));
+  }
+
+  __device__ __host__ inline void pack(Float *u, const RegType v[length], int x) {
+    RegType tmp[reconLen];
+    reconstruct.Pack(tmp, v, x);
+    if (hasPhase) reconstruct.getPhase(&tmp[reconLen-1], v);
+    for (int i=0; i<reconLen; i++) u[i] = (Float)tmp[i];
+  }
+
   __device__ __host__ inline void loadGhost(RegType v[length], int x, int dir, int parity) const {
-    for (int i=0; i<length; i++) v[i] = ghost[dir][(parity*faceVolumeCB[dir] + x)*length + i];
+    unpack(v, ghost[dir] + (parity*faceVolumeCB[dir] + x)*reconLen, x, dir);
   }
 
   __device__ __host__ inline void saveGhost(const RegType v[length], int x, int dir, int parity) {
-    for (int i=0; i<length; i++) ghost[dir][(parity*faceVolumeCB[dir] + x)*length + i] = v[i];
+    pack(ghost[dir] + (parity*faceVolumeCB[dir] + x)*reconLen, v, x);
   }
 };
 
@@ -506,31 +525,70 @@ LegacyOrder(const LegacyOrder &order) : volumeCB(order.volumeCB), stride(order.s
   struct to define QDP ordered gauge fields: 
   [[dim]] [[parity][volumecb][row][col]]
   */
-template <typename Float, int length> struct QDPOrder : public LegacyOrder<Float,length> {
+template <typename Float, int length, int reconLen=length> 
+struct QDPOrder : public LegacyOrder<Float,length,reconLen> {
   typedef typename mapper<Float>::type RegType;
   Float *gauge[QUDA_MAX_DIM];
   const int volumeCB;
   QDPOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) 
-    : LegacyOrder<Float,length>(u, ghost_), volumeCB(u.VolumeCB())
+    : LegacyOrder<Float,length,reconLen>(u, ghost_), volumeCB(u.VolumeCB())
   { for (int i=0; i<4; i++) gauge[i] = gauge_ ? ((Float**)gauge_)[i] : ((Float**)u.Gauge_p())[i]; }
-  QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length>(order), volumeCB(order.volumeCB) {
+  QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length,reconLen>(order), volumeCB(order.volumeCB) {
     for(int i=0; i<4; i++) gauge[i] = order.gauge[i];
   }
   virtual ~QDPOrder() { ; }
 
   __device__ __host__ inline void load(RegType v[length], int x, int dir, int parity) const {
-    for (int i=0; i<length; i++) {
-      v[i] = (RegType)gauge[dir][(parity*volumeCB + x)*length + i];
-    }
+    this->unpack(v, gauge[dir] + (parity*volumeCB + x)*reconLen, x, dir);
   }
 
   __device__ __host__ inline void save(const RegType v[length], int x, int dir, int parity) {
-    for (int i=0; i<length; i++) {
-      gauge[dir][(parity*volumeCB + x)*length + i] = (Float)v[i];
-    }
+    this->pack(gauge[dir] + (parity*volumeCB + x)*reconLen, v, x);
   }
 
-  size_t Bytes() const { return length * sizeof(Float); }
+  // the phase, if any, is accounted for by hasPhase
+  size_t Bytes() const { return (reconLen - this->hasPhase) * sizeof(Float); }
+};
+
+/**
+  struct to define AoSoA ordered host gauge fields, which are as QDP
+  order but with each component stored contiguously over blocks of
+  B = QUDA_AOSOA_BLOCK sites:
+  [[dim]] [[parity][volumecb/B][reconLen][volumecb%B]]
+  */
+template <typename Float, int length, int reconLen=length> 
+struct AoSoAOrder : public LegacyOrder<Float,length,reconLen> {
+  typedef typename mapper<Float>::type RegType;
+  Float *gauge[QUDA_MAX_DIM];
+  const int volumeCB;
+  AoSoAOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) 
+    : LegacyOrder<Float,length,reconLen>(u, ghost_), volumeCB(u.VolumeCB())
+  { for (int i=0; i<4; i++) gauge[i] = gauge_ ? ((Float**)gauge_)[i] : ((Float**)u.Gauge_p())[i]; }
+  AoSoAOrder(const AoSoAOrder &order) : LegacyOrder<Float,length,reconLen>(order), volumeCB(order.volumeCB) {
+    for(int i=0; i<4; i++) gauge[i] = order.gauge[i];
+  }
+  virtual ~AoSoAOrder() { ; }
+
+  __device__ __host__ inline const Float* block(int x, int dir, int parity) const {
+    const int B = QUDA_AOSOA_BLOCK;
+    return gauge[dir] + (parity*volumeCB + (x/B)*B)*reconLen + x%B;
+  }
+
+  __device__ __host__ inline void load(RegType v[length], int x, int dir, int parity) const {
+    const Float *u = block(x, dir, parity);
+    Float tmp[reconLen];
+    for (int i=0; i<reconLen; i++) tmp[i] = u[i*QUDA_AOSOA_BLOCK];
+    this->unpack(v, tmp, x, dir);
+  }
+
+  __device__ __host__ inline void save(const RegType v[length], int x, int dir, int parity) {
+    Float *u = const_cast<Float*>(block(x, dir, parity));
+    Float tmp[reconLen];
+    this->pack(tmp, v, x);
+    for (int i=0; i<reconLen; i++) u[i*QUDA_AOSOA_BLOCK] = tmp[i];
+  }
+
+  size_t Bytes() const { return (reconLen - this->hasPhase) * sizeof(Float); }
 };
 
 /**
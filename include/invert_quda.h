@@ -8,6 +8,8 @@
 
 namespace quda {
 
+  class DeflationSpace;
+
   /**
      SolverParam is the meta data used to define linear solvers.
    */
@@ -42,6 +44,18 @@ namespace quda {
     /**< Enable pipeline solver */
     int pipeline;
 
+    /**< Number of CG steps per global reduction in the s-step solver */
+    int s_step;
+
+    /**< Number of eigenvectors harvested per solve by eigCG */
+    int nev;
+
+    /**< Size of the eigCG search space */
+    int max_search_dim;
+
+    /**< The persistent deflation space used by eigCG */
+    DeflationSpace *deflation;
+
     /**< Solver tolerance in the L2 residual norm */
     double tol;             
 
@@ -131,7 +145,8 @@ namespace quda {
     SolverParam(QudaInvertParam &param) : inv_type(param.inv_type), 
       inv_type_precondition(param.inv_type_precondition), 
       residual_type(param.residual_type), use_init_guess(param.use_init_guess),
-      delta(param.reliable_delta), pipeline(param.pipeline), tol(param.tol), tol_hq(param.tol_hq), 
+      delta(param.reliable_delta), pipeline(param.pipeline), s_step(param.s_step),
+      nev(param.nev), max_search_dim(param.max_search_dim), deflation(0), tol(param.tol), tol_hq(param.tol_hq), 
       true_res(param.true_res), true_res_hq(param.true_res_hq),
       maxiter(param.maxiter), iter(param.iter), 
       precision(param.cuda_prec), precision_sloppy(param.cuda_prec_sloppy), 
@@ -182,7 +197,7 @@ namespace quda {
     Solver(SolverParam &param, TimeProfile &profile) : param(param), profile(profile) { ; }
     virtual ~Solver() { ; }
 
-    virtual void operator()(cudaColorSpinorField &out, cudaColorSpinorField &in) = 0;
+    virtual void operator()(ColorSpinorField &out, ColorSpinorField &in) = 0;
 
     // solver factory
     static Solver* create(SolverParam &param, DiracMatrix &mat, DiracMatrix &matSloppy,
@@ -206,6 +221,29 @@ namespace quda {
 
   };
 
+  // Small dense linear algebra for the block and deflated solvers.
+  // Matrices are n x n and stored row major.
+
+  /**
+     In-place Cholesky factorisation A = L L^dag of a Hermitian matrix,
+     leaving L in the lower triangle.
+     @return false if A is not positive definite
+   */
+  bool cholesky(Complex *A, const int n);
+
+  /**
+     Solves L L^dag X = B in place for the m columns of the n x m
+     matrix B, with L from cholesky().
+   */
+  void choleskySolve(const Complex *L, const int n, Complex *B, const int m);
+
+  /**
+     Eigendecomposition of a real symmetric matrix by cyclic Jacobi
+     rotations.  The eigenvalues are returned in ascending order, with
+     eigenvector j in column j of evec.
+   */
+  void symmetricEigensolve(double *eval, double *evec, const double *A, const int n);
+
   class CG : public Solver {
 
   private:
@@ -216,7 +254,167 @@ namespace quda {
     CG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
     virtual ~CG();
 
-    void operator()(cudaColorSpinorField &out, cudaColorSpinorField &in);
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
+  /**
+     Pipelined CG (Ghysels and Vanroose): the two inner products of
+     each iteration are fused into one nonblocking global reduction
+     that is overlapped with the next application of the operator.
+     The recurrences drift faster than for CG, so the residual is
+     replaced by the true residual using the reliable update delta.
+   */
+  class PipelinedCG : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+    const DiracMatrix &matSloppy;
+
+  public:
+    PipelinedCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
+    virtual ~PipelinedCG();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
+  /**
+     Communication-avoiding s-step CG (Chronopoulos and Gear, Carson
+     and Demmel).  Each outer iteration builds the monomial basis
+     [p, Ap, ..., A^s p, r, Ar, ..., A^(s-1) r] and its Gram matrix
+     with a single global reduction, then performs s CG steps on the
+     basis coordinates.  The monomial basis loses rank quickly, so s
+     should be kept small (s <= 8), with the reliable update delta
+     controlling residual replacement.
+   */
+  class SStepCG : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+    const DiracMatrix &matSloppy;
+
+  public:
+    SStepCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
+    virtual ~SStepCG();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
+  /**
+     Block CG (O'Leary), in the breakdown-free form of Ji and Li, for
+     solving N Hermitian positive-definite systems with a shared
+     Krylov space.  The search directions are orthonormalised with a
+     rank-revealing pivoted Cholesky factorisation, which drops
+     dependent directions, and converged columns are deflated from the
+     block.  The operator is applied to the whole block at once, which
+     uses the multi-RHS dslash for host fields.  All work is done in
+     the precision of the solution.
+   */
+  class BlockCG : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+
+  public:
+    BlockCG(DiracMatrix &mat, SolverParam &param, TimeProfile &profile);
+    virtual ~BlockCG();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+    void operator()(ColorSpinorField **out, ColorSpinorField **in, const int nRhs);
+  };
+
+  /**
+     A set of approximate low eigenvectors of a Hermitian
+     positive-definite operator, accumulated by EigCG over a sequence
+     of solves with the same operator and used to deflate the later
+     ones.  The basis U is kept orthonormal, together with the
+     projected matrix H = U^dag A U.
+   */
+  class DeflationSpace {
+
+  private:
+    ColorSpinorField **U;
+    Complex *H;
+    int size;
+    const int max_size;
+
+  public:
+    DeflationSpace(const int max_size);
+    virtual ~DeflationSpace();
+
+    int Size() const { return size; }
+    bool Full() const { return size == max_size; }
+
+    /**
+       Galerkin projection onto the space, x += U H^-1 U^dag r, which
+       removes the low modes from the error of x.
+     */
+    void deflate(ColorSpinorField &x, ColorSpinorField &r) const;
+
+    /**
+       Orthonormalise the n vectors v against the space and append
+       the ones that remain independent, while there is room.
+     */
+    void add(ColorSpinorField **v, const int n, const DiracMatrix &mat);
+  };
+
+  /**
+     Incremental eigCG (Stathopoulos and Orginos).  The first solves
+     with an operator run CG while harvesting approximate low
+     eigenvectors from the Lanczos matrix built from the CG
+     coefficients, and accumulate them in a persistent
+     DeflationSpace.  Every solve starts from the deflated initial
+     guess, so the low modes no longer slow down convergence once the
+     space is built.  All work is done in the precision of the
+     solution.
+   */
+  class EigCG : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+
+  public:
+    EigCG(DiracMatrix &mat, SolverParam &param, TimeProfile &profile);
+    virtual ~EigCG();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
+  /**
+     Thick-restart Lanczos (Wu and Simon) for the lowest eigenpairs of
+     a Hermitian positive-definite operator.  The Lanczos iteration is
+     run on the Chebyshev polynomial of the operator that maps the
+     unwanted interval [eig_amin, eig_amax] of the spectrum to [-1,1]
+     and amplifies everything below it, so the wanted low modes
+     become the best separated ones.  With eig_poly_deg = 0 the
+     iteration is run on the operator itself.
+   */
+  class ThickRestartLanczos {
+
+  private:
+    const DiracMatrix &mat;
+    QudaInvertParam &param;
+    TimeProfile &profile;
+
+    // work fields for the operator and the polynomial recurrence
+    ColorSpinorField *tmp, *tmp2, *w0, *w1;
+
+    /**
+       Applies the polynomial filter, out = p(A) in.
+     */
+    void filter(ColorSpinorField &out, ColorSpinorField &in, const double amin, const double amax);
+
+  public:
+    ThickRestartLanczos(DiracMatrix &mat, QudaInvertParam &param, TimeProfile &profile);
+    virtual ~ThickRestartLanczos();
+
+    /**
+       Computes the param.nev lowest eigenpairs of the operator.
+       @param evecs The param.nev eigenvectors, in ascending order of eigenvalue
+       @param evals The corresponding eigenvalues
+       @param v0 Starting vector of the Krylov space (overwritten)
+       @return The number of converged eigenpairs
+     */
+    int operator()(ColorSpinorField **evecs, double *evals, ColorSpinorField &v0);
   };
 
   class BiCGstab : public Solver {
@@ -227,7 +425,7 @@ namespace quda {
     const DiracMatrix &matPrecon;
 
     // pointers to fields to avoid multiple creation overhead
-    cudaColorSpinorField *yp, *rp, *pp, *vp, *tmpp, *tp;
+    ColorSpinorField *yp, *rp, *pp, *vp, *tmpp, *tp;
     bool init;
 
   public:
@@ -235,7 +433,7 @@ namespace quda {
 	     SolverParam &param, TimeProfile &profile);
     virtual ~BiCGstab();
 
-    void operator()(cudaColorSpinorField &out, cudaColorSpinorField &in);
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
   };
 
   class GCR : public Solver {
@@ -253,16 +451,16 @@ namespace quda {
 	SolverParam &param, TimeProfile &profile);
     virtual ~GCR();
 
-    void operator()(cudaColorSpinorField &out, cudaColorSpinorField &in);
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
   };
 
   class MR : public Solver {
 
   private:
     const DiracMatrix &mat;
-    cudaColorSpinorField *rp;
-    cudaColorSpinorField *Arp;
-    cudaColorSpinorField *tmpp;
+    ColorSpinorField *rp;
+    ColorSpinorField *Arp;
+    ColorSpinorField *tmpp;
     bool init;
     bool allocate_r;
 
@@ -270,7 +468,7 @@ namespace quda {
     MR(DiracMatrix &mat, SolverParam &param, TimeProfile &profile);
     virtual ~MR();
 
-    void operator()(cudaColorSpinorField &out, cudaColorSpinorField &in);
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
   };
 
   // multigrid solver
@@ -283,7 +481,7 @@ namespace quda {
     alphaSA(DiracMatrix &mat, SolverParam &param, TimeProfile &profile);
     virtual ~alphaSA() { ; }
 
-    void operator()(cudaColorSpinorField **out, cudaColorSpinorField &in);
+    void operator()(ColorSpinorField **out, ColorSpinorField &in);
   };
 
   class MultiShiftSolver {
@@ -297,7 +495,7 @@ namespace quda {
     param(param), profile(profile) { ; }
     virtual ~MultiShiftSolver() { ; }
 
-    virtual void operator()(cudaColorSpinorField **out, cudaColorSpinorField &in) = 0;
+    virtual void operator()(ColorSpinorField **out, ColorSpinorField &in) = 0;
   };
 
   class MultiShiftCG : public MultiShiftSolver {
@@ -310,7 +508,7 @@ namespace quda {
     MultiShiftCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
     virtual ~MultiShiftCG();
 
-    void operator()(cudaColorSpinorField **out, cudaColorSpinorField &in);
+    void operator()(ColorSpinorField **out, ColorSpinorField &in);
   };
 
   /**
@@ -337,10 +535,62 @@ namespace quda {
        param p The basis vectors in which we are building the guess
        param q The basis vectors multipled by A
        param N The number of basis vectors
+       param orthonormal Whether p is already orthonormal, in which case it is not modified
        return The residue of this guess.
     */  
-    void operator()(cudaColorSpinorField &x, cudaColorSpinorField &b, cudaColorSpinorField **p,
-		    cudaColorSpinorField **q, int N);
+    void operator()(ColorSpinorField &x, ColorSpinorField &b, ColorSpinorField **p,
+		    ColorSpinorField **q, int N, bool orthonormal=false);
+  };
+
+  /**
+     The solutions of previous solves with one operator, from which
+     MinResExt builds the initial guess of the next solve.  The
+     solutions X are stored through their QR factorisation X = P R, so
+     only the orthonormal basis P is kept in memory, and the oldest
+     solution is discarded once max_dim are held by downdating the
+     factorisation.
+  */
+  class ChronoHistory {
+
+  private:
+    ColorSpinorField **p;
+    Complex *R;
+    int size;
+    const int max_dim;
+
+    /**
+       Projects the basis out of v, storing the size coefficients in
+       coeff, and returns the squared norm of the remainder.
+    */
+    double project(Complex *coeff, ColorSpinorField &v);
+
+  public:
+    ChronoHistory(const int max_dim);
+    virtual ~ChronoHistory();
+
+    int Size() const { return size; }
+
+    /**
+       @return The memory held by the stored solutions in bytes
+    */
+    size_t Bytes() const;
+
+    /**
+       Sets x to the minimum residual guess for mat x = b from the
+       stored solutions.  b is preserved.
+    */
+    void guess(ColorSpinorField &x, ColorSpinorField &b, DiracMatrix &mat, TimeProfile &profile);
+
+    /**
+       Adds the solution x to the history, unless it is already
+       contained in the span of the stored solutions.
+    */
+    void add(ColorSpinorField &x);
+
+    /**
+       Discards the oldest solution.
+    */
+    void pop();
   };
 
 } // namespace quda
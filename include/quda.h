@@ -38,6 +38,18 @@
  */
 #define QUDA_MAX_MULTI_SHIFT 32
 
+/**
+ * @def QUDA_AOSOA_BLOCK
+ * @brief Number of consecutive sites whose components are stored
+ *        contiguously in QUDA_AOSOA_FIELD_ORDER and
+ *        QUDA_AOSOA_GAUGE_ORDER host fields.  This is the widest host
+ *        vector length (16 single-precision lanes), so any narrower
+ *        vector loads a single component of adjacent sites with unit
+ *        stride.  The checkerboard volume of such fields must be a
+ *        multiple of the block length.
+ */
+#define QUDA_AOSOA_BLOCK 16
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -96,6 +108,7 @@ extern "C" {
 
     QudaFieldLocation input_location; /**< The location of the input field */
     QudaFieldLocation output_location; /**< The location of the output field */
+    QudaFieldLocation compute_location; /**< Where to apply the Dirac operator (requires a host gauge field if CPU) */
 
     QudaDslashType dslash_type; /**< The Dirac Dslash type that is being used */
     QudaInverterType inv_type; /**< Which linear solver to use */
@@ -119,6 +132,22 @@ extern "C" {
     double reliable_delta; /**< Reliable update tolerance */
 
     int pipeline; /**< Whether to use a pipelined solver with less global sums */
+    int s_step; /**< Number of CG steps per global reduction in the s-step solver */
+    int num_src; /**< Number of sources in the multi-source solver */
+
+    int nev; /**< Number of eigenvectors harvested per solve by eigCG */
+    int max_search_dim; /**< Size of the eigCG search space (must exceed 2*nev) */
+    int deflation_grid; /**< Number of solves whose eigenvectors are kept in the eigCG deflation space */
+
+    int eig_nkrylov; /**< Size of the Krylov space in the Lanczos eigensolver (must be at least nev+2) */
+    int eig_poly_deg; /**< Degree of the Chebyshev acceleration polynomial in the Lanczos eigensolver (0 disables it) */
+    double eig_amin; /**< Lower end of the part of the spectrum suppressed by the Chebyshev polynomial */
+    double eig_amax; /**< Upper end of the part of the spectrum suppressed by the Chebyshev polynomial (estimated if not positive) */
+    double eig_tol; /**< Relative residual tolerance of the Lanczos eigenpairs */
+    int eig_max_restarts; /**< Maximum number of restarts in the Lanczos eigensolver */
+
+    int chrono_max_dim; /**< Number of previous solutions kept for the chronological initial guess (0 disables it) */
+    double chrono_max_gib; /**< Cap on the memory held by all chronological solution histories in GiB (0 for no cap) */
 
     int num_offset; /**< Number of offsets in the multi-shift solver */
 
@@ -162,6 +191,7 @@ extern "C" {
     QudaPrecision clover_cuda_prec_precondition; /**< The precision used for the clover field in the QUDA preconditioner */
 
     QudaCloverFieldOrder clover_order;     /**< The order of the input clover field */
+    double clover_coeff;                   /**< Coefficient of the clover term (kappa * c_sw), used by computeCloverQuda() */
     QudaUseInitGuess use_init_guess;       /**< Whether to use an initial guess in the solver or not */
 
     QudaVerbosity verbosity;               /**< The verbosity setting to use in the solver */
@@ -389,6 +419,16 @@ extern "C" {
   void loadCloverQuda(void *h_clover, void *h_clovinv,
 		      QudaInvertParam *inv_param);
 
+  /**
+   * Compute the clover term and its inverse from the gauge field
+   * loaded with loadGaugeQuda() and load them as loadCloverQuda()
+   * does.  The computation is done on the host, so this requires a
+   * host-dslash build and a gauge field loaded from the CPU.
+   * @param inv_param   Contains all metadata regarding host and device
+   *                    storage, and the clover coefficient
+   */
+  void computeCloverQuda(QudaInvertParam *inv_param);
+
   /**
    * Free QUDA's internal copy of the clover term and/or clover inverse.
    */
@@ -414,6 +454,37 @@ extern "C" {
    */
   void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param);
 
+  /**
+   * Solve for multiple sources with the same operator.  With the
+   * block CG inverter the sources are solved simultaneously,
+   * otherwise one at a time.
+   * @param _hp_x    Array of param->num_src solution spinor fields
+   * @param _hp_b    Array of param->num_src source spinor fields
+   * @param param  Contains all metadata regarding host and device
+   *               storage and solver parameters
+   */
+  void invertMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param);
+
+  /**
+   * Compute the param->nev lowest eigenpairs of the normal operator
+   * with the thick-restart Lanczos eigensolver.  The eigenvectors are
+   * also kept as the eigCG deflation space of the operator.
+   * @param host_evecs Array of param->nev eigenvector fields (may be NULL)
+   * @param evals      Array of param->nev eigenvalues, in ascending order
+   * @param param  Contains all metadata regarding host and device
+   *               storage and eigensolver parameters
+   */
+  void eigensolveQuda(void **host_evecs, double *evals, QudaInvertParam *param);
+
+  /**
+   * Discard the solution histories used for the chronological initial
+   * guess (see chrono_max_dim).  The histories are kept across gauge
+   * field updates, so this should be called whenever the guess would
+   * be extrapolated from unrelated solutions, e.g., at the start of a
+   * trajectory or after a rejected one.
+   */
+  void flushChronoQuda(void);
+
   /**
    * Apply the Dslash operator (D_{eo} or D_{oe}).
    * @param h_out  Result spinor field
@@ -72,6 +72,14 @@ extern "C" {
   void load_clover_quda_(void *h_clover, void *h_clovinv,
 			 QudaInvertParam *inv_param);
 
+  /**
+   * Compute the clover term and its inverse from the loaded gauge
+   * field on the host and load them into QUDA.
+   * @param inv_param Contains all metadata regarding host and device
+   *                  storage and the clover coefficient
+   */
+  void compute_clover_quda_(QudaInvertParam *inv_param);
+
   /**
    * Free QUDA's internal copy of the clover term and/or clover inverse.
    */
@@ -69,7 +69,8 @@ namespace quda {
 
   protected:
     virtual long long flops() const = 0;
-    virtual long long bytes() const { return 0; } // FIXME
+    // bytes moved by one launch, or 0 if the kernel does not account them
+    virtual long long bytes() const { return 0; }
 
     // the minimum number of shared bytes per thread
     virtual unsigned int sharedBytesPerThread() const = 0;
@@ -179,8 +180,8 @@ namespace quda {
 	float gflops = flops() / (1e9 * time);
 	float gbytes = bytes() / (1e9 * time);
 	std::stringstream ss;
-	ss << std::setiosflags(std::ios::fixed) << std::setprecision(2) << gflops << " Gflop/s, ";
-	ss << gbytes << " GB/s";
+	ss << std::setiosflags(std::ios::fixed) << std::setprecision(2) << gflops << " Gflop/s";
+	if (bytes() > 0) ss << ", " << gbytes << " GB/s";
 	return ss.str();
       }
 
@@ -1,357 +1,1004 @@
+#include <math.h>
+
 #include <color_spinor_field.h>
 #include <blas_quda.h>
+#include <blas_expr.h>
 #include <face_quda.h>
 
+/**
+   Host (CPU) BLAS.  Mirroring blas_quda.cu and reduce_quda.cu, each
+   routine is a functor applied element by element by a generic
+   driver, so the fused routines (e.g., caxpyXmazNormX) make a single
+   pass over their fields, with any reduction computed as the fields
+   are updated.  The drivers thread the element loop with OpenMP and
+   ask the compiler to vectorize it, and the reductions are summed
+   over all ranks at the end.
+*/
+
+#define checkSpinor(a, b)						\
+  {									\
+    if (a.Precision() != b.Precision())					\
+      errorQuda("precisions do not match: %d %d", a.Precision(), b.Precision()); \
+    if (a.Length() != b.Length())					\
+      errorQuda("lengths do not match: %d %d", a.Length(), b.Length());	\
+    if (a.FieldOrder() != b.FieldOrder())				\
+      errorQuda("orders do not match: %d %d", a.FieldOrder(), b.FieldOrder()); \
+  }
+
 namespace quda {
 
-  template <typename Float>
-  void axpby(const Float &a, const Float *x, const Float &b, Float *y, const int N) {
-    for (int i=0; i<N; i++) y[i] = a*x[i] + b*y[i];
-  }
+  namespace host {
+
+    /**
+       Sites of a half precision field, stored as shorts scaled by a
+       per-site norm.  Half precision kernels unpack each site to float,
+       apply the single precision functor to it, and repack the result
+       with a fresh norm, so the field is only ever streamed as 16-bit
+       data.
+    */
+    class HalfSites {
+      short *v;
+      float *norm;
+
+    public:
+      const int nInt;  // reals per site
+      const int nSite;
+
+      HalfSites(const cpuColorSpinorField &f)
+	: v((short*)f.V()), norm((float*)f.Norm()), nInt(2*f.Nspin()*f.Ncolor()),
+	  nSite(f.Length()/nInt) { }
+
+      inline void load(float *s, int i) const {
+	const float scale = norm[i] / MAX_SHORT;
+	for (int j=0; j<nInt; j++) s[j] = scale * v[i*nInt+j];
+      }
+
+      inline void save(const float *s, int i) {
+	float max = 0.0f;
+	for (int j=0; j<nInt; j++) max = fabsf(s[j]) > max ? fabsf(s[j]) : max;
+	norm[i] = max;
+	const float scale = max > 0.0f ? MAX_SHORT / max : 0.0f;
+	for (int j=0; j<nInt; j++) v[i*nInt+j] = (short)(scale * s[j]);
+      }
+    };
+
+    static const int maxSiteReals = 24; // largest site: 4 spins and 3 colors
+
+    /**
+       Applies f to complex element i of each field, whose real part is
+       at offset r and imaginary part at offset r+im, writing back the
+       fields that f updates.
+    */
+    template <int writeX, int writeY, int writeZ, int writeW, int writeV, typename Float, typename Functor>
+    inline void apply(Functor &f, double &s0, double &s1, double &s2, Float *x, Float *y, Float *z,
+		      Float *w, Float *v, const int r, const int im) {
+      Cplx<Float> X(x[r], x[r+im]), Y(y[r], y[r+im]), Z(z[r], z[r+im]), W(w[r], w[r+im]), V(v[r], v[r+im]);
+      f(s0, s1, s2, X, Y, Z, W, V);
+      if (writeX) { x[r] = X.re; x[r+im] = X.im; }
+      if (writeY) { y[r] = Y.re; y[r+im] = Y.im; }
+      if (writeZ) { z[r] = Z.re; z[r+im] = Z.im; }
+      if (writeW) { w[r] = W.re; w[r+im] = W.im; }
+      if (writeV) { v[r] = V.re; v[r+im] = V.im; }
+    }
+
+    /**
+       Applies f to the N complex elements of the fields, which hold
+       their real and imaginary parts in alternating blocks of B (1 for
+       the site-contiguous orders, QUDA_AOSOA_BLOCK for
+       QUDA_AOSOA_FIELD_ORDER).  The blocks are shared out between the
+       threads and the elements of each block are vectorized.
+    */
+    template <int B, int writeX, int writeY, int writeZ, int writeW, int writeV, typename Float, typename Functor>
+    void blasKernel(Functor &f, double sum[3], Float *x, Float *y, Float *z, Float *w, Float *v, const int N) {
+      double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+      if (B == 1) {
+#ifdef _OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:s0,s1,s2)
+#endif
+	for (int i=0; i<N; i++)
+	  apply<writeX,writeY,writeZ,writeW,writeV>(f, s0, s1, s2, x, y, z, w, v, 2*i, 1);
+      } else {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:s0,s1,s2)
+#endif
+	for (int b=0; b<N/B; b++) {
+#ifdef _OPENMP
+#pragma omp simd reduction(+:s0,s1,s2)
+#endif
+	  for (int j=0; j<B; j++)
+	    apply<writeX,writeY,writeZ,writeW,writeV>(f, s0, s1, s2, x, y, z, w, v, 2*B*b + j, B);
+	}
+      }
+      sum[0] = s0; sum[1] = s1; sum[2] = s2;
+    }
+
+    // The half precision variant of blasKernel, applied site by site
+    template <int writeX, int writeY, int writeZ, int writeW, int writeV, typename Functor>
+    void blasKernelHalf(Functor &f, double sum[3], const cpuColorSpinorField &x, const cpuColorSpinorField &y,
+			const cpuColorSpinorField &z, const cpuColorSpinorField &w, const cpuColorSpinorField &v) {
+      HalfSites X(x), Y(y), Z(z), W(w), V(v);
+      double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:s0,s1,s2)
+#endif
+      for (int i=0; i<X.nSite; i++) {
+	float xs[maxSiteReals], ys[maxSiteReals], zs[maxSiteReals], ws[maxSiteReals], vs[maxSiteReals];
+	X.load(xs, i);
+	Y.load(ys, i);
+	Z.load(zs, i);
+	W.load(ws, i);
+	V.load(vs, i);
+	for (int j=0; j<X.nInt/2; j++)
+	  apply<writeX,writeY,writeZ,writeW,writeV>(f, s0, s1, s2, xs, ys, zs, ws, vs, 2*j, 1);
+	if (writeX) X.save(xs, i);
+	if (writeY) Y.save(ys, i);
+	if (writeZ) Z.save(zs, i);
+	if (writeW) W.save(ws, i);
+	if (writeV) V.save(vs, i);
+      }
+      sum[0] = s0; sum[1] = s1; sum[2] = s2;
+    }
+
+    /**
+       Generic host BLAS driver, the counterpart of blasCuda and
+       reduceCuda: applies Functor<Float> (constructed from a, b and c)
+       to the fields in a single pass, writing back those selected by
+       the write template arguments.  Any reductions the functor
+       computes are summed over all ranks and returned.
+    */
+    template <template <typename> class Functor, int writeX, int writeY, int writeZ, int writeW, int writeV>
+    double3 blas(const Complex &a, const Complex &b, const Complex &c,
+		 const cpuColorSpinorField &x, const cpuColorSpinorField &y, const cpuColorSpinorField &z,
+		 const cpuColorSpinorField &w, const cpuColorSpinorField &v) {
+      checkSpinor(x, y);
+      checkSpinor(x, z);
+      checkSpinor(x, w);
+      checkSpinor(x, v);
+
+      double sum[3];
+      const bool aosoa = x.FieldOrder() == QUDA_AOSOA_FIELD_ORDER;
+      const int N = x.Length()/2;
+
+      if (x.Precision() == QUDA_DOUBLE_PRECISION) {
+	Functor<double> f(a, b, c);
+	double *X = (double*)x.V(), *Y = (double*)y.V(), *Z = (double*)z.V(), *W = (double*)w.V(), *V = (double*)v.V();
+	if (aosoa) blasKernel<QUDA_AOSOA_BLOCK,writeX,writeY,writeZ,writeW,writeV>(f, sum, X, Y, Z, W, V, N);
+	else blasKernel<1,writeX,writeY,writeZ,writeW,writeV>(f, sum, X, Y, Z, W, V, N);
+      } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
+	Functor<float> f(a, b, c);
+	float *X = (float*)x.V(), *Y = (float*)y.V(), *Z = (float*)z.V(), *W = (float*)w.V(), *V = (float*)v.V();
+	if (aosoa) blasKernel<QUDA_AOSOA_BLOCK,writeX,writeY,writeZ,writeW,writeV>(f, sum, X, Y, Z, W, V, N);
+	else blasKernel<1,writeX,writeY,writeZ,writeW,writeV>(f, sum, X, Y, Z, W, V, N);
+      } else if (x.Precision() == QUDA_HALF_PRECISION) {
+	Functor<float> f(a, b, c);
+	blasKernelHalf<writeX,writeY,writeZ,writeW,writeV>(f, sum, x, y, z, w, v);
+      } else {
+	errorQuda("Precision type %d not implemented", x.Precision());
+      }
+
+      if (Functor<double>::reductions() > 0) reduceDoubleArray(sum, Functor<double>::reductions());
+      return make_double3(sum[0], sum[1], sum[2]);
+    }
 
-  void axpbyCpu(const double &a, const cpuColorSpinorField &x, 
+    /**
+       Functor to perform the operation y = a*x + b*y
+    */
+    template <typename Float>
+    struct axpby {
+      const Float a;
+      const Float b;
+      axpby(const Complex &a, const Complex &b, const Complex &c) : a(real(a)), b(real(b)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + b*y; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation y += a*x
+    */
+    template <typename Float>
+    struct axpy {
+      const Float a;
+      axpy(const Complex &a, const Complex &b, const Complex &c) : a(real(a)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation y = x + a*y
+    */
+    template <typename Float>
+    struct xpay {
+      const Float a;
+      xpay(const Complex &a, const Complex &b, const Complex &c) : a(real(a)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = x + a*y; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation x = a*x
+    */
+    template <typename Float>
+    struct ax {
+      const Float a;
+      ax(const Complex &a, const Complex &b, const Complex &c) : a(real(a)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { x = a*x; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operations y += a*x and x = b*z + c*x
+    */
+    template <typename Float>
+    struct axpyBzpcx {
+      const Float a;
+      const Float b;
+      const Float c;
+      axpyBzpcx(const Complex &a, const Complex &b, const Complex &c) : a(real(a)), b(real(b)), c(real(c)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; x = b*z + c*x; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operations y += a*x and x = z + b*x
+    */
+    template <typename Float>
+    struct axpyZpbx {
+      const Float a;
+      const Float b;
+      axpyZpbx(const Complex &a, const Complex &b, const Complex &c) : a(real(a)), b(real(b)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; x = z + b*x; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation y = a*x + b*y
+    */
+    template <typename Float>
+    struct caxpby {
+      const Cplx<Float> a;
+      const Cplx<Float> b;
+      caxpby(const Complex &a, const Complex &b, const Complex &c) : a(a), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + b*y; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation y += a*x
+    */
+    template <typename Float>
+    struct caxpy {
+      const Cplx<Float> a;
+      caxpy(const Complex &a, const Complex &b, const Complex &c) : a(a) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation z = x + a*y + b*z
+    */
+    template <typename Float>
+    struct cxpaypbz {
+      const Cplx<Float> a;
+      const Cplx<Float> b;
+      cxpaypbz(const Complex &a, const Complex &b, const Complex &c) : a(a), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { z = x + a*y + b*z; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operations z += a*x + b*y and y -= b*w
+    */
+    template <typename Float>
+    struct caxpbypzYmbw {
+      const Cplx<Float> a;
+      const Cplx<Float> b;
+      caxpbypzYmbw(const Complex &a, const Complex &b, const Complex &c) : a(a), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { z = a*x + b*y + z; y = y - b*w; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operations x = a*x and y += b*x
+    */
+    template <typename Float>
+    struct cabxpyAx {
+      const Float a;
+      const Cplx<Float> b;
+      cabxpyAx(const Complex &a, const Complex &b, const Complex &c) : a(real(a)), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { x = a*x; y = b*x + y; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operations y += a*x and x -= a*z
+    */
+    template <typename Float>
+    struct caxpyXmaz {
+      const Cplx<Float> a;
+      caxpyXmaz(const Complex &a, const Complex &b, const Complex &c) : a(a) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; x = x - a*z; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation z += a*x + b*y
+    */
+    template <typename Float>
+    struct caxpbypz {
+      const Cplx<Float> a;
+      const Cplx<Float> b;
+      caxpbypz(const Complex &a, const Complex &b, const Complex &c) : a(a), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { z = a*x + b*y + z; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Functor to perform the operation w += a*x + b*y + c*z
+    */
+    template <typename Float>
+    struct caxpbypczpw {
+      const Cplx<Float> a;
+      const Cplx<Float> b;
+      const Cplx<Float> c;
+      caxpbypczpw(const Complex &a, const Complex &b, const Complex &c) : a(a), b(b), c(c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { w = a*x + b*y + c*z + w; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Return the L2 norm of x
+    */
+    template <typename Float>
+    struct Norm2 {
+      Norm2(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { s0 += norm2_(x); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       Return the real dot product of x and y
+    */
+    template <typename Float>
+    struct Dot {
+      Dot(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { s0 += dot_(x, y); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operation y += a*x
+       Return the norm of y
+    */
+    template <typename Float>
+    struct axpyNorm2 {
+      const Float a;
+      axpyNorm2(const Complex &a, const Complex &b, const Complex &c) : a(real(a)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; s0 += norm2_(y); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operation y += a*x
+       Return the norm of the new y and its real dot product with the
+       change in y, for CG with the alternative beta computation
+    */
+    template <typename Float>
+    struct axpyCGNorm2 {
+      const Float a;
+      axpyCGNorm2(const Complex &a, const Complex &b, const Complex &c) : a(real(a)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { Cplx<Float> y_new = a*x + y; s0 += norm2_(y_new); s1 += dot_(y_new, y_new - y); y = y_new; }
+      static int reductions() { return 2; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operation y = x - y
+       Return the norm of y
+    */
+    template <typename Float>
+    struct xmyNorm2 {
+      xmyNorm2(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = x - y; s0 += norm2_(y); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       Return the complex dot product of x and y
+    */
+    template <typename Float>
+    struct Cdot {
+      Cdot(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { s0 += dot_(x, y); s1 += cdotIm_(x, y); }
+      static int reductions() { return 2; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operation y = x + a*y
+       Return the complex dot product of z and y
+    */
+    template <typename Float>
+    struct xpaycdotzy {
+      const Float a;
+      xpaycdotzy(const Complex &a, const Complex &b, const Complex &c) : a(real(a)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { y = x + a*y; s0 += dot_(z, y); s1 += cdotIm_(z, y); }
+      static int reductions() { return 2; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operation y += a*x
+       Return the complex dot product of z and y
+    */
+    template <typename Float>
+    struct caxpydotzy {
+      const Cplx<Float> a;
+      caxpydotzy(const Complex &a, const Complex &b, const Complex &c) : a(a) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { y = a*x + y; s0 += dot_(z, y); s1 += cdotIm_(z, y); }
+      static int reductions() { return 2; } //! number of reductions computed
+    };
+
+    /**
+       Return the complex dot product of x and y, and the norm of x
+    */
+    template <typename Float>
+    struct CdotNormA {
+      CdotNormA(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { s0 += dot_(x, y); s1 += cdotIm_(x, y); s2 += norm2_(x); }
+      static int reductions() { return 3; } //! number of reductions computed
+    };
+
+    /**
+       Return the complex dot product of x and y, and the norm of y
+    */
+    template <typename Float>
+    struct CdotNormB {
+      CdotNormB(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { s0 += dot_(x, y); s1 += cdotIm_(x, y); s2 += norm2_(y); }
+      static int reductions() { return 3; } //! number of reductions computed
+    };
+
+    /**
+       This convoluted kernel does the following:
+       z += a*x + b*y, y -= b*w, norm = (y,y), dot = (v, y)
+    */
+    template <typename Float>
+    struct caxpbypzYmbwcDotProductUYNormY {
+      const Cplx<Float> a;
+      const Cplx<Float> b;
+      caxpbypzYmbwcDotProductUYNormY(const Complex &a, const Complex &b, const Complex &c) : a(a), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { z = a*x + b*y + z; y = y - b*w; s0 += dot_(v, y); s1 += cdotIm_(v, y); s2 += norm2_(y); }
+      static int reductions() { return 3; } //! number of reductions computed
+    };
+
+    /**
+       Performs the operations y -= a*x, z += a*w and w = y + b*w, which
+       are the updates of the pipelined CG iteration
+    */
+    template <typename Float>
+    struct tripleCGUpdate {
+      const Float a;
+      const Float b;
+      tripleCGUpdate(const Complex &a, const Complex &b, const Complex &c) : a(real(a)), b(real(b)) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { y = y - a*x; z = z + a*w; w = y + b*w; }
+      static int reductions() { return 0; } //! number of reductions computed
+    };
+
+    /**
+       Return the norms of x and y, and the real dot product of y and z
+    */
+    template <typename Float>
+    struct tripleCGReduction {
+      tripleCGReduction(const Complex &a, const Complex &b, const Complex &c) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { s0 += norm2_(x); s1 += norm2_(y); s2 += dot_(y, z); }
+      static int reductions() { return 3; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operation y += a*x
+       Return the norm of y
+    */
+    template <typename Float>
+    struct caxpyNorm2 {
+      const Cplx<Float> a;
+      caxpyNorm2(const Complex &a, const Complex &b, const Complex &c) : a(a) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v) { y = a*x + y; s0 += norm2_(y); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operations y += a*x and x -= a*z
+       Return the norm of x
+    */
+    template <typename Float>
+    struct caxpyxmaznormx {
+      const Cplx<Float> a;
+      caxpyxmaznormx(const Complex &a, const Complex &b, const Complex &c) : a(a) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { y = a*x + y; x = x - a*z; s0 += norm2_(x); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       First performs the operations x = a*x and y += b*x
+       Return the norm of y
+    */
+    template <typename Float>
+    struct cabxpyaxnorm {
+      const Float a;
+      const Cplx<Float> b;
+      cabxpyaxnorm(const Complex &a, const Complex &b, const Complex &c) : a(real(a)), b(b) { ; }
+      void operator()(double &s0, double &s1, double &s2, Cplx<Float> &x, Cplx<Float> &y,
+		      Cplx<Float> &z, Cplx<Float> &w, Cplx<Float> &v)
+      { x = a*x; y = b*x + y; s0 += norm2_(y); }
+      static int reductions() { return 1; } //! number of reductions computed
+    };
+
+    /**
+       The heavy quark residual norm, which needs the norms of x (or
+       x+y) and r site by site: 1 / N * \sum_i (r, r)_i / (x, x)_i,
+       where i is the site index.  Sites are taken B at a time, in the
+       block layout of blasKernel, with the norms of the B sites of a
+       block vectorized.  The sum over sites of the ratio is returned
+       in sum[2], and is normalized by the caller.
+    */
+    template <int B, bool xpy, typename Float>
+    void heavyQuarkKernel(double sum[3], const Float *x, const Float *y, const Float *r,
+			  const int nSite, const int nInt) {
+      double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:s0,s1,s2)
+#endif
+      for (int b=0; b<nSite/B; b++) {
+	double x2[B], r2[B];
+	for (int j=0; j<B; j++) { x2[j] = 0.0; r2[j] = 0.0; }
+
+	for (int k=0; k<nInt; k++) { // loop over internal degrees of freedom
+	  const int o = (b*nInt + k)*B;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+	  for (int j=0; j<B; j++) {
+	    const Float xk = xpy ? x[o+j] + y[o+j] : x[o+j];
+	    x2[j] += xk*xk;
+	    r2[j] += r[o+j]*r[o+j];
+	  }
+	}
+
+	for (int j=0; j<B; j++) {
+	  s0 += x2[j];
+	  s1 += r2[j];
+	  s2 += (x2[j] > 0.0) ? (r2[j] / x2[j]) : 1.0;
+	}
+      }
+      sum[0] = s0; sum[1] = s1; sum[2] = s2;
+    }
+
+    template <bool xpy>
+    void heavyQuarkKernelHalf(double sum[3], const cpuColorSpinorField &x, const cpuColorSpinorField &y,
+			      const cpuColorSpinorField &r) {
+      const HalfSites X(x), Y(y), R(r);
+      double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:s0,s1,s2)
+#endif
+      for (int i=0; i<X.nSite; i++) {
+	float xs[maxSiteReals], ys[maxSiteReals], rs[maxSiteReals];
+	X.load(xs, i);
+	if (xpy) Y.load(ys, i);
+	R.load(rs, i);
+	double x2 = 0.0, r2 = 0.0;
+	for (int k=0; k<X.nInt; k++) {
+	  const float xk = xpy ? xs[k] + ys[k] : xs[k];
+	  x2 += xk*xk;
+	  r2 += rs[k]*rs[k];
+	}
+	s0 += x2;
+	s1 += r2;
+	s2 += (x2 > 0.0) ? (r2 / x2) : 1.0;
+      }
+      sum[0] = s0; sum[1] = s1; sum[2] = s2;
+    }
+
+    template <bool xpy>
+    double3 heavyQuarkResidualNorm(const cpuColorSpinorField &x, const cpuColorSpinorField &y,
+				   const cpuColorSpinorField &r) {
+      checkSpinor(x, y);
+      checkSpinor(x, r);
+
+      double sum[3];
+      const bool aosoa = x.FieldOrder() == QUDA_AOSOA_FIELD_ORDER;
+      const int nInt = 2*x.Ncolor()*x.Nspin();
+      const int nSite = x.Length()/nInt;
+
+      if (x.Precision() == QUDA_DOUBLE_PRECISION) {
+	const double *X = (const double*)x.V(), *Y = (const double*)y.V(), *R = (const double*)r.V();
+	if (aosoa) heavyQuarkKernel<QUDA_AOSOA_BLOCK,xpy>(sum, X, Y, R, nSite, nInt);
+	else heavyQuarkKernel<1,xpy>(sum, X, Y, R, nSite, nInt);
+      } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
+	const float *X = (const float*)x.V(), *Y = (const float*)y.V(), *R = (const float*)r.V();
+	if (aosoa) heavyQuarkKernel<QUDA_AOSOA_BLOCK,xpy>(sum, X, Y, R, nSite, nInt);
+	else heavyQuarkKernel<1,xpy>(sum, X, Y, R, nSite, nInt);
+      } else if (x.Precision() == QUDA_HALF_PRECISION) {
+	heavyQuarkKernelHalf<xpy>(sum, x, y, r);
+      } else {
+	errorQuda("Precision type %d not implemented", x.Precision());
+      }
+
+      reduceDoubleArray(sum, 3);
+      double3 rtn = make_double3(sum[0], sum[1], sum[2]);
+#ifdef MULTI_GPU
+      rtn.z /= (x.Volume()*comm_size());
+#else
+      rtn.z /= x.Volume();
+#endif
+      return rtn;
+    }
+
+  } // namespace host
+
+  static const Complex zero(0.0, 0.0);
+
+  void axpbyCpu(const double &a, const cpuColorSpinorField &x,
 		const double &b, cpuColorSpinorField &y) {
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      axpby(a, (double*)x.V(), b, (double*)y.V(), x.Length());
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      axpby((float)a, (float*)x.V(), (float)b, (float*)y.V(), x.Length());
-    else
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::axpby,0,1,0,0,0>(a, b, zero, x, y, x, x, x);
   }
 
   void xpyCpu(const cpuColorSpinorField &x, cpuColorSpinorField &y) {
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      axpby(1.0, (double*)x.V(), 1.0, (double*)y.V(), x.Length());
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      axpby(1.0f, (float*)x.V(), 1.0f, (float*)y.V(), x.Length());
-    else
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::axpy,0,1,0,0,0>(1.0, zero, zero, x, y, x, x, x);
   }
 
-  void axpyCpu(const double &a, const cpuColorSpinorField &x, 
+  void axpyCpu(const double &a, const cpuColorSpinorField &x,
 	       cpuColorSpinorField &y) {
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      axpby(a, (double*)x.V(), 1.0, (double*)y.V(), x.Length());
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      axpby((float)a, (float*)x.V(), 1.0f, (float*)y.V(), x.Length());
-    else
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::axpy,0,1,0,0,0>(a, zero, zero, x, y, x, x, x);
   }
 
-  void xpayCpu(const cpuColorSpinorField &x, const double &a, 
+  void xpayCpu(const cpuColorSpinorField &x, const double &a,
 	       cpuColorSpinorField &y) {
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      axpby(1.0, (double*)x.V(), a, (double*)y.V(), x.Length());
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      axpby(1.0f, (float*)x.V(), (float)a, (float*)y.V(), x.Length());
-    else
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::xpay,0,1,0,0,0>(a, zero, zero, x, y, x, x, x);
   }
 
   void mxpyCpu(const cpuColorSpinorField &x, cpuColorSpinorField &y) {
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      axpby(-1.0, (double*)x.V(), 1.0, (double*)y.V(), x.Length());
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      axpby(-1.0f, (float*)x.V(), 1.0f, (float*)y.V(), x.Length());
-    else
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::axpy,0,1,0,0,0>(-1.0, zero, zero, x, y, x, x, x);
   }
 
   void axCpu(const double &a, cpuColorSpinorField &x) {
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      axpby(0.0, (double*)x.V(), a, (double*)x.V(), x.Length());
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      axpby(0.0f, (float*)x.V(), (float)a, (float*)x.V(), x.Length());
-    else
-      errorQuda("Precision type %d not implemented", x.Precision());
-  }
-
-  template <typename Float>
-  void caxpby(const std::complex<Float> &a, const std::complex<Float> *x,
-	      const std::complex<Float> &b, std::complex<Float> *y, int N) {
-
-    for (int i=0; i<N; i++) {
-      y[i] = a*x[i] + b*y[i];
-    }
-
+    host::blas<host::ax,1,0,0,0,0>(a, zero, zero, x, x, x, x, x);
   }
 
   void caxpyCpu(const Complex &a, const cpuColorSpinorField &x,
 		cpuColorSpinorField &y) {
-
-    if ( x.Precision() == QUDA_DOUBLE_PRECISION)
-      caxpby(a, (Complex*)x.V(), Complex(1.0), 
-	     (Complex*)y.V(), x.Length()/2);
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      caxpby((std::complex<float>)a, (std::complex<float>*)x.V(), std::complex<float>(1.0), 
-	     (std::complex<float>*)y.V(), x.Length()/2);
-    else 
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::caxpy,0,1,0,0,0>(a, zero, zero, x, y, x, x, x);
   }
 
   void caxpbyCpu(const Complex &a, const cpuColorSpinorField &x,
 		 const Complex &b, cpuColorSpinorField &y) {
-
-    if ( x.Precision() == QUDA_DOUBLE_PRECISION)
-      caxpby(a, (Complex*)x.V(), b, (Complex*)y.V(), x.Length()/2);
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      caxpby((std::complex<float>)a, (std::complex<float>*)x.V(), (std::complex<float>)b, 
-	     (std::complex<float>*)y.V(), x.Length()/2);
-    else 
-      errorQuda("Precision type %d not implemented", x.Precision());
-  }
-
-  template <typename Float>
-  void caxpbypcz(const std::complex<Float> &a, const std::complex<Float> *x,
-		 const std::complex<Float> &b, const std::complex<Float> *y, 
-		 const std::complex<Float> &c, std::complex<Float> *z, int N) {
-
-    for (int i=0; i<N; i++) {
-      z[i] = a*x[i] + b*y[i] + c*z[i];
-    }
-
+    host::blas<host::caxpby,0,1,0,0,0>(a, b, zero, x, y, x, x, x);
   }
 
-  void cxpaypbzCpu(const cpuColorSpinorField &x, const Complex &a, 
+  void cxpaypbzCpu(const cpuColorSpinorField &x, const Complex &a,
 		   const cpuColorSpinorField &y, const Complex &b,
 		   cpuColorSpinorField &z) {
-
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      caxpbypcz(Complex(1, 0), (Complex*)x.V(), a, (Complex*)y.V(), 
-		b, (Complex*)z.V(), x.Length()/2);
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      caxpbypcz(std::complex<float>(1, 0), (std::complex<float>*)x.V(), (std::complex<float>)a, (std::complex<float>*)y.V(), 
-		(std::complex<float>)b, (std::complex<float>*)z.V(), x.Length()/2);
-    else 
-      errorQuda("Precision type %d not implemented", x.Precision());
+    host::blas<host::cxpaypbz,0,0,1,0,0>(a, b, zero, x, y, z, x, x);
   }
 
-  void axpyBzpcxCpu(const double &a, cpuColorSpinorField& x, cpuColorSpinorField& y, 
+  // performs the operations: {y[i] = a*x[i] + y[i]; x[i] = b*z[i] + c*x[i]}
+  void axpyBzpcxCpu(const double &a, cpuColorSpinorField& x, cpuColorSpinorField& y,
 		    const double &b, const cpuColorSpinorField& z, const double &c) {
-    axpyCpu(a, x, y);
-    axpbyCpu(b, z, c, x);
+    host::blas<host::axpyBzpcx,1,1,0,0,0>(a, b, c, x, y, z, x, x);
   }
 
   // performs the operations: {y[i] = a*x[i] + y[i]; x[i] = z[i] + b*x[i]}
-  void axpyZpbxCpu(const double &a, cpuColorSpinorField &x, cpuColorSpinorField &y, 
+  void axpyZpbxCpu(const double &a, cpuColorSpinorField &x, cpuColorSpinorField &y,
 		   const cpuColorSpinorField &z, const double &b) {
-    axpyCpu(a, x, y);
-    xpayCpu(z, b, x);
+    host::blas<host::axpyZpbx,1,1,0,0,0>(a, b, zero, x, y, z, x, x);
   }
 
   // performs the operation z[i] = a*x[i] + b*y[i] + z[i] and y[i] -= b*w[i]
-  void caxpbypzYmbwCpu(const Complex &a, const cpuColorSpinorField &x, const Complex &b, 
+  void caxpbypzYmbwCpu(const Complex &a, const cpuColorSpinorField &x, const Complex &b,
 		       cpuColorSpinorField &y, cpuColorSpinorField &z, const cpuColorSpinorField &w) {
-
-    if (x.Precision() == QUDA_DOUBLE_PRECISION)
-      caxpbypcz(a, (Complex*)x.V(), b, (Complex*)y.V(), 
-		Complex(1, 0), (Complex*)z.V(), x.Length()/2);
-    else if (x.Precision() == QUDA_SINGLE_PRECISION)
-      caxpbypcz((std::complex<float>)a, (std::complex<float>*)x.V(), 
-		(std::complex<float>)b, (std::complex<float>*)y.V(), 
-		(std::complex<float>)(1.0f), (std::complex<float>*)z.V(), x.Length()/2);
-    else 
-      errorQuda("Precision type %d not implemented", x.Precision());
-
-    caxpyCpu(-b, w, y);
-  }
-
-  template <typename Float>
-  double norm(const Float *a, const int N) {
-    double norm2 = 0;
-    for (int i=0; i<N; i++) norm2 += a[i]*a[i];
-    return norm2;
+    host::blas<host::caxpbypzYmbw,0,1,1,0,0>(a, b, zero, x, y, z, w, x);
   }
 
   double normCpu(const cpuColorSpinorField &a) {
-    double norm2 = 0.0;
-    if (a.Precision() == QUDA_DOUBLE_PRECISION)
-      norm2 = norm((double*)a.V(), a.Length());
-    else if (a.Precision() == QUDA_SINGLE_PRECISION)
-      norm2 = norm((float*)a.V(), a.Length());
-    else
-      errorQuda("Precision type %d not implemented", a.Precision());
-    reduceDouble(norm2);
-    return norm2;
-  }
-
-  double axpyNormCpu(const double &a, const cpuColorSpinorField &x, 
-		     cpuColorSpinorField &y) {
-    axpyCpu(a, x, y);
-    return normCpu(y);
+    return host::blas<host::Norm2,0,0,0,0,0>(zero, zero, zero, a, a, a, a, a).x;
   }
 
-  template <typename Float>
-  double reDotProduct(const Float *a, const Float *b, const int N) {
-    double dot = 0;
-    for (int i=0; i<N; i++) dot += a[i]*b[i];
-    return dot;
+  double axpyNormCpu(const double &a, const cpuColorSpinorField &x,
+		     cpuColorSpinorField &y) {
+    return host::blas<host::axpyNorm2,0,1,0,0,0>(a, zero, zero, x, y, x, x, x).x;
   }
 
   double reDotProductCpu(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
-    double dot = 0.0;
-    if (a.Precision() == QUDA_DOUBLE_PRECISION)
-      dot = reDotProduct((double*)a.V(), (double*)b.V(), a.Length());
-    else if (a.Precision() == QUDA_SINGLE_PRECISION)
-      dot = reDotProduct((float*)a.V(), (float*)b.V(), a.Length());
-    else
-      errorQuda("Precision type %d not implemented", a.Precision());
-    reduceDouble(dot);
-    return dot;
+    return host::blas<host::Dot,0,0,0,0,0>(zero, zero, zero, a, b, a, a, a).x;
   }
 
   // First performs the operation y[i] = x[i] - y[i]
   // Second returns the norm of y
   double xmyNormCpu(const cpuColorSpinorField &x, cpuColorSpinorField &y) {
-    xpayCpu(x, -1, y);
-    return normCpu(y);
-  }
-
-  template <typename Float>
-  Complex cDotProduct(const std::complex<Float> *a, const std::complex<Float> *b, const int N) {
-    quda::Complex dot = 0;
-    for (int i=0; i<N; i++) dot += conj(a[i])*b[i];
-    return dot;
+    return host::blas<host::xmyNorm2,0,1,0,0,0>(zero, zero, zero, x, y, x, x, x).x;
   }
 
   Complex cDotProductCpu(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
-    Complex dot = 0.0;
-    if (a.Precision() == QUDA_DOUBLE_PRECISION)
-      dot = cDotProduct((Complex*)a.V(), (Complex*)b.V(), a.Length()/2);
-    else if (a.Precision() == QUDA_SINGLE_PRECISION)
-      dot = cDotProduct((std::complex<float>*)a.V(), (std::complex<float>*)b.V(), a.Length()/2);
-    else
-      errorQuda("Precision type %d not implemented", a.Precision());
-    reduceDoubleArray((double*)&dot, 2);
-    return dot;
+    double3 dot = host::blas<host::Cdot,0,0,0,0,0>(zero, zero, zero, a, b, a, a, a);
+    return Complex(dot.x, dot.y);
   }
 
   // First performs the operation y = x + a*y
   // Second returns complex dot product (z,y)
-  Complex xpaycDotzyCpu(const cpuColorSpinorField &x, const double &a, 
+  Complex xpaycDotzyCpu(const cpuColorSpinorField &x, const double &a,
 			      cpuColorSpinorField &y, const cpuColorSpinorField &z) {
-    xpayCpu(x, a, y);
-    return cDotProductCpu(z,y);
+    double3 dot = host::blas<host::xpaycdotzy,0,1,0,0,0>(a, zero, zero, x, y, z, x, x);
+    return Complex(dot.x, dot.y);
   }
 
   double3 cDotProductNormACpu(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
-    Complex dot = cDotProductCpu(a, b);
-    double norm = normCpu(a);
-    return make_double3(real(dot), imag(dot), norm);
+    return host::blas<host::CdotNormA,0,0,0,0,0>(zero, zero, zero, a, b, a, a, a);
   }
 
   double3 cDotProductNormBCpu(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
-    Complex dot = cDotProductCpu(a, b);
-    double norm = normCpu(b);
-    return make_double3(real(dot), imag(dot), norm);
+    return host::blas<host::CdotNormB,0,0,0,0,0>(zero, zero, zero, a, b, a, a, a);
   }
 
   // This convoluted kernel does the following: z += a*x + b*y, y -= b*w, norm = (y,y), dot = (u, y)
-  double3 caxpbypzYmbwcDotProductUYNormYCpu(const Complex &a, const cpuColorSpinorField &x, 
-					    const Complex &b, cpuColorSpinorField &y, 
-					    cpuColorSpinorField &z, const cpuColorSpinorField &w, 
+  double3 caxpbypzYmbwcDotProductUYNormYCpu(const Complex &a, const cpuColorSpinorField &x,
+					    const Complex &b, cpuColorSpinorField &y,
+					    cpuColorSpinorField &z, const cpuColorSpinorField &w,
 					    const cpuColorSpinorField &u) {
-
-    caxpbypzYmbwCpu(a, x, b, y, z, w);
-    return cDotProductNormBCpu(u, y);
+    return host::blas<host::caxpbypzYmbwcDotProductUYNormY,0,1,1,0,0>(a, b, zero, x, y, z, w, u);
   }
 
   void cabxpyAxCpu(const double &a, const Complex &b, cpuColorSpinorField &x, cpuColorSpinorField &y) {
-    axCpu(a, x);
-    caxpyCpu(b, x, y);
+    host::blas<host::cabxpyAx,1,1,0,0,0>(a, b, zero, x, y, x, x, x);
   }
 
-  double caxpyNormCpu(const Complex &a, cpuColorSpinorField &x, 
+  double caxpyNormCpu(const Complex &a, cpuColorSpinorField &x,
 		      cpuColorSpinorField &y) {
-    caxpyCpu(a, x, y);
-    return norm2(y);
+    return host::blas<host::caxpyNorm2,0,1,0,0,0>(a, zero, zero, x, y, x, x, x).x;
   }
 
-  double caxpyXmazNormXCpu(const Complex &a, cpuColorSpinorField &x, 
+  double caxpyXmazNormXCpu(const Complex &a, cpuColorSpinorField &x,
 			   cpuColorSpinorField &y, cpuColorSpinorField &z) {
-    caxpyCpu(a, x, y);
-    caxpyCpu(-a, z, x);
-    return norm2(x);
+    return host::blas<host::caxpyxmaznormx,1,1,0,0,0>(a, zero, zero, x, y, z, x, x).x;
   }
 
-  void caxpyXmazCpu(const Complex &a, cpuColorSpinorField &x, 
+  void caxpyXmazCpu(const Complex &a, cpuColorSpinorField &x,
 		    cpuColorSpinorField &y, cpuColorSpinorField &z) {
-    caxpyCpu(a, x, y);
-    caxpyCpu(-a, z, x);
+    host::blas<host::caxpyXmaz,1,1,0,0,0>(a, zero, zero, x, y, z, x, x);
   }
 
   double cabxpyAxNormCpu(const double &a, const Complex &b, cpuColorSpinorField &x, cpuColorSpinorField &y) {
-    axCpu(a, x);
-    caxpyCpu(b, x, y);
-    return norm2(y);
+    return host::blas<host::cabxpyaxnorm,1,1,0,0,0>(a, b, zero, x, y, x, x, x).x;
   }
 
-  void caxpbypzCpu(const Complex &a, cpuColorSpinorField &x, const Complex &b, cpuColorSpinorField &y, 
+  void caxpbypzCpu(const Complex &a, cpuColorSpinorField &x, const Complex &b, cpuColorSpinorField &y,
 		   cpuColorSpinorField &z) {
-    caxpyCpu(a, x, z);
-    caxpyCpu(b, y, z);
+    host::blas<host::caxpbypz,0,0,1,0,0>(a, b, zero, x, y, z, x, x);
   }
 
-  void caxpbypczpwCpu(const Complex &a, cpuColorSpinorField &x, const Complex &b, cpuColorSpinorField &y, 
+  void caxpbypczpwCpu(const Complex &a, cpuColorSpinorField &x, const Complex &b, cpuColorSpinorField &y,
 		      const Complex &c, cpuColorSpinorField &z, cpuColorSpinorField &w) {
-    caxpyCpu(a, x, w);
-    caxpyCpu(b, y, w);
-    caxpyCpu(c, z, w);
-
+    host::blas<host::caxpbypczpw,0,0,0,1,0>(a, b, c, x, y, z, w, x);
   }
 
   Complex caxpyDotzyCpu(const Complex &a, cpuColorSpinorField &x, cpuColorSpinorField &y,
 			cpuColorSpinorField &z) {
-    caxpyCpu(a, x, y);
-    return cDotProductCpu(z, y);
-  }
-  
-  template <typename Float>
-  double3 HeavyQuarkResidualNorm(const Float *x, const Float *r, const int volume, const int Nint) {
-    
-    double3 sum = make_double3(0.0, 0.0, 0.0);
-    for (int i = 0; i<volume; i++) {
-      double x2 = 0;
-      double r2 = 0;
-      
-      for (int j=0; j<Nint; j++) { // loop over internal degrees of freedom
-	int k = i*Nint + j;
-	x2 += x[k]*x[k];
-	r2 += r[k]*r[k];
-      }
-      
-      sum.x += x2;
-      sum.y += r2;
-      sum.z += (x2 > 0.0) ? (r2 / x2) : 1.0; 
-    }
-    return sum;
+    double3 dot = host::blas<host::caxpydotzy,0,1,0,0,0>(a, zero, zero, x, y, z, x, x);
+    return Complex(dot.x, dot.y);
   }
-  
-  
+
   double3 HeavyQuarkResidualNormCpu(cpuColorSpinorField &x, cpuColorSpinorField &r) {
-    double3 rtn;
-    if (x.Precision() == QUDA_DOUBLE_PRECISION) {
-      rtn = HeavyQuarkResidualNorm<double>((const double*)(x.V()), (const double*)(r.V()), 
-					   x.Volume(), 2*x.Ncolor()*x.Nspin());
-    } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
-      rtn = HeavyQuarkResidualNorm<float>((const float*)(x.V()), (const float*)(r.V()), 
-					  x.Volume(), 2*x.Ncolor()*x.Nspin());
-    } else {
-      errorQuda("Precision type %d not implemented", x.Precision());
+    return host::heavyQuarkResidualNorm<false>(x, x, r);
+  }
+
+  double3 xpyHeavyQuarkResidualNormCpu(cpuColorSpinorField &x, cpuColorSpinorField &y, cpuColorSpinorField &r) {
+    return host::heavyQuarkResidualNorm<true>(x, y, r);
+  }
+
+  Complex axpyCGNormCpu(const double &a, cpuColorSpinorField &x, cpuColorSpinorField &y) {
+    double3 cg_norm = host::blas<host::axpyCGNorm2,0,1,0,0,0>(a, zero, zero, x, y, x, x, x);
+    return Complex(cg_norm.x, cg_norm.y);
+  }
+
+  void tripleCGUpdateCpu(const double &a, const double &b, cpuColorSpinorField &x,
+			 cpuColorSpinorField &y, cpuColorSpinorField &z, cpuColorSpinorField &w) {
+    host::blas<host::tripleCGUpdate,0,1,1,1,0>(a, b, zero, x, y, z, w, x);
+  }
+
+  double3 tripleCGReductionCpu(cpuColorSpinorField &x, cpuColorSpinorField &y, cpuColorSpinorField &z) {
+    return host::blas<host::tripleCGReduction,0,0,0,0,0>(zero, zero, zero, x, y, z, x, x);
+  }
+
+  // The block variants are recorded as fused operations, so that y is
+  // streamed once per chunk of the set.  Full half precision fields
+  // are not supported by the fused sweep, so these are split by parity.
+
+  void cDotProductCpu(Complex *result, cpuColorSpinorField **x, cpuColorSpinorField &y, const int N) {
+    if (y.Precision() == QUDA_HALF_PRECISION && y.SiteSubset() == QUDA_FULL_SITE_SUBSET) {
+      std::vector<cpuColorSpinorField*> xp(N);
+      std::vector<Complex> odd(N);
+      for (int i=0; i<N; i++) xp[i] = &x[i]->Even();
+      cDotProductCpu(result, &xp[0], y.Even(), N);
+      for (int i=0; i<N; i++) xp[i] = &x[i]->Odd();
+      cDotProductCpu(&odd[0], &xp[0], y.Odd(), N);
+      for (int i=0; i<N; i++) result[i] += odd[i];
+      return;
     }
-#ifdef MULTI_GPU
-    rtn.z /= (x.Volume()*comm_size());
-#else
-    rtn.z /= x.Volume();
-#endif
-    return rtn;
+
+    FusedBlas fused;
+    for (int i=0; i<N; i++) fused.cDotProduct(result[i], *x[i], y);
+    fused.flush();
   }
-  
-  double3 HeavyQuarkResidualNormCpu(cpuColorSpinorField &x, cpuColorSpinorField &y, cpuColorSpinorField &r) {
-    cpuColorSpinorField tmp(x);
-    xpyCpu(y, tmp);
-    return HeavyQuarkResidualNormCpu(tmp, r);
+
+  void caxpyCpu(const Complex *a, cpuColorSpinorField **x, cpuColorSpinorField &y, const int N) {
+    if (y.Precision() == QUDA_HALF_PRECISION && y.SiteSubset() == QUDA_FULL_SITE_SUBSET) {
+      std::vector<cpuColorSpinorField*> xp(N);
+      for (int i=0; i<N; i++) xp[i] = &x[i]->Even();
+      caxpyCpu(a, &xp[0], y.Even(), N);
+      for (int i=0; i<N; i++) xp[i] = &x[i]->Odd();
+      caxpyCpu(a, &xp[0], y.Odd(), N);
+      return;
+    }
+
+    FusedBlas fused;
+    for (int i=0; i<N; i++) fused.assign(y, expr::Field(y) + a[i]*expr::Field(*x[i]));
+    fused.flush();
   }
 
-} // namespace quda
+  // FusedBlas (see blas_expr.h)
+
+  // complex elements per chunk of the fused sweep: a multiple of the
+  // AoSoA block and of the Wilson and staggered site sizes
+  static const int fusedChunk = 384;
+
+  FusedBlas::~FusedBlas() {
+    if (ops.size() > 0) warningQuda("Discarding %d unflushed fused blas operations", (int)ops.size());
+    for (unsigned int i=0; i<ops.size(); i++) delete ops[i];
+  }
 
+  int FusedBlas::index(const cpuColorSpinorField &f) {
+    for (unsigned int i=0; i<fields.size(); i++) if (fields[i] == &f) return i;
+    if (fields.size() > 0) checkSpinor(f, (*fields[0]));
+    if (f.Precision() == QUDA_HALF_PRECISION && f.SiteSubset() == QUDA_FULL_SITE_SUBSET)
+      errorQuda("Half precision fused blas requires single parity fields");
+    fields.push_back(&f);
+    written.push_back(false);
+    return fields.size() - 1;
+  }
+
+  namespace host {
+
+    // Apply the operations to each chunk of the fields in turn
+    template <typename Float>
+    void fusedSweep(const std::vector<expr::Op*> &ops, const std::vector<const cpuColorSpinorField*> &fields,
+		    double *sum, const int nSum) {
+      const int nField = fields.size();
+      const int B = fields[0]->FieldOrder() == QUDA_AOSOA_FIELD_ORDER ? QUDA_AOSOA_BLOCK : 1;
+      const int N = fields[0]->Length()/2;
+      const int nChunk = (N + fusedChunk - 1) / fusedChunk;
+
+      std::vector<Float*> p(nField);
+      for (int f=0; f<nField; f++) p[f] = (Float*)fields[f]->V();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+	std::vector<double> local(nSum, 0.0);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+	for (int c=0; c<nChunk; c++) {
+	  const int end = (c+1)*fusedChunk < N ? (c+1)*fusedChunk : N;
+	  for (unsigned int k=0; k<ops.size(); k++) ops[k]->apply(&p[0], &local[0], c*fusedChunk, end, B);
+	}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+	for (int i=0; i<nSum; i++) sum[i] += local[i];
+      }
+    }
+
+    // The half precision sweep, which unpacks each chunk of sites to float
+    void fusedSweepHalf(const std::vector<expr::Op*> &ops, const std::vector<const cpuColorSpinorField*> &fields,
+			const std::vector<bool> &written, double *sum, const int nSum) {
+      const int nField = fields.size();
+      const int nInt = 2*fields[0]->Nspin()*fields[0]->Ncolor();
+      const int chunkSites = 2*fusedChunk / nInt;
+      const int nSite = fields[0]->Length() / nInt;
+      const int nChunk = (nSite + chunkSites - 1) / chunkSites;
+
+      std::vector<HalfSites> sites;
+      for (int f=0; f<nField; f++) sites.push_back(HalfSites(*fields[f]));
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+	std::vector<double> local(nSum, 0.0);
+	std::vector<float> buf(nField*2*fusedChunk);
+	std::vector<float*> p(nField);
+	for (int f=0; f<nField; f++) p[f] = &buf[f*2*fusedChunk];
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+	for (int c=0; c<nChunk; c++) {
+	  const int begin = c*chunkSites;
+	  const int end = (c+1)*chunkSites < nSite ? (c+1)*chunkSites : nSite;
+	  for (int f=0; f<nField; f++)
+	    for (int i=begin; i<end; i++) sites[f].load(p[f] + (i-begin)*nInt, i);
+	  for (unsigned int k=0; k<ops.size(); k++) ops[k]->apply(&p[0], &local[0], 0, (end-begin)*nInt/2, 1);
+	  for (int f=0; f<nField; f++)
+	    if (written[f]) for (int i=begin; i<end; i++) sites[f].save(p[f] + (i-begin)*nInt, i);
+	}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+	for (int i=0; i<nSum; i++) sum[i] += local[i];
+      }
+    }
+
+  } // namespace host
+
+  void FusedBlas::flush() {
+    if (ops.size() == 0) return;
+
+    const int nSum = results.size();
+    std::vector<double> sum(nSum > 0 ? nSum : 1, 0.0);
+
+    if (fields[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      host::fusedSweep<double>(ops, fields, &sum[0], nSum);
+    } else if (fields[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      host::fusedSweep<float>(ops, fields, &sum[0], nSum);
+    } else if (fields[0]->Precision() == QUDA_HALF_PRECISION) {
+      host::fusedSweepHalf(ops, fields, written, &sum[0], nSum);
+    } else {
+      errorQuda("Precision type %d not implemented", fields[0]->Precision());
+    }
+
+    if (nSum > 0) reduceDoubleArray(&sum[0], nSum);
+    for (int i=0; i<nSum; i++) *results[i] = sum[i];
+
+    for (unsigned int i=0; i<ops.size(); i++) delete ops[i];
+    ops.clear();
+    fields.clear();
+    written.clear();
+    results.clear();
+  }
+
+} // namespace quda
@@ -0,0 +1,265 @@
+#include <vector>
+
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+
+/**
+   Location-generic BLAS: each routine checks that its fields reside
+   in the same place and forwards to the corresponding routine of
+   blas_quda.cu / reduce_quda.cu or blas_cpu.cpp.
+*/
+
+namespace quda {
+
+  namespace blas {
+
+    static QudaFieldLocation location(const ColorSpinorField &a, const ColorSpinorField &b) {
+      if (a.Location() != b.Location())
+	errorQuda("Field locations do not match: %d %d", a.Location(), b.Location());
+      return a.Location();
+    }
+
+    static QudaFieldLocation location(const ColorSpinorField &a, const ColorSpinorField &b,
+				      const ColorSpinorField &c) {
+      location(a, b);
+      return location(a, c);
+    }
+
+    static QudaFieldLocation location(const ColorSpinorField &a, const ColorSpinorField &b,
+				      const ColorSpinorField &c, const ColorSpinorField &d) {
+      location(a, b, c);
+      return location(a, d);
+    }
+
+    static QudaFieldLocation location(const ColorSpinorField &a, const ColorSpinorField &b,
+				      const ColorSpinorField &c, const ColorSpinorField &d,
+				      const ColorSpinorField &e) {
+      location(a, b, c, d);
+      return location(a, e);
+    }
+
+    static inline cudaColorSpinorField& Cuda(ColorSpinorField &a)
+    { return static_cast<cudaColorSpinorField&>(a); }
+    static inline const cudaColorSpinorField& Cuda(const ColorSpinorField &a)
+    { return static_cast<const cudaColorSpinorField&>(a); }
+    static inline cpuColorSpinorField& Cpu(ColorSpinorField &a)
+    { return static_cast<cpuColorSpinorField&>(a); }
+    static inline const cpuColorSpinorField& Cpu(const ColorSpinorField &a)
+    { return static_cast<const cpuColorSpinorField&>(a); }
+
+    void zero(ColorSpinorField &a) {
+      if (a.Location() == QUDA_CUDA_FIELD_LOCATION) zeroCuda(Cuda(a));
+      else a.zero();
+    }
+
+    void copy(ColorSpinorField &dst, const ColorSpinorField &src) {
+      if (location(dst, src) == QUDA_CUDA_FIELD_LOCATION) copyCuda(Cuda(dst), Cuda(src));
+      else Cpu(dst).copy(Cpu(src));
+    }
+
+    double axpyNorm(const double &a, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) return axpyNormCuda(a, Cuda(x), Cuda(y));
+      else return axpyNormCpu(a, Cpu(x), Cpu(y));
+    }
+
+    double reDotProduct(ColorSpinorField &a, ColorSpinorField &b) {
+      if (location(a, b) == QUDA_CUDA_FIELD_LOCATION) return reDotProductCuda(Cuda(a), Cuda(b));
+      else return reDotProductCpu(Cpu(a), Cpu(b));
+    }
+
+    double xmyNorm(ColorSpinorField &a, ColorSpinorField &b) {
+      if (location(a, b) == QUDA_CUDA_FIELD_LOCATION) return xmyNormCuda(Cuda(a), Cuda(b));
+      else return xmyNormCpu(Cpu(a), Cpu(b));
+    }
+
+    void axpby(const double &a, ColorSpinorField &x, const double &b, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) axpbyCuda(a, Cuda(x), b, Cuda(y));
+      else axpbyCpu(a, Cpu(x), b, Cpu(y));
+    }
+
+    void axpy(const double &a, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) axpyCuda(a, Cuda(x), Cuda(y));
+      else axpyCpu(a, Cpu(x), Cpu(y));
+    }
+
+    void ax(const double &a, ColorSpinorField &x) {
+      if (x.Location() == QUDA_CUDA_FIELD_LOCATION) axCuda(a, Cuda(x));
+      else axCpu(a, Cpu(x));
+    }
+
+    void xpy(ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) xpyCuda(Cuda(x), Cuda(y));
+      else xpyCpu(Cpu(x), Cpu(y));
+    }
+
+    void xpay(ColorSpinorField &x, const double &a, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) xpayCuda(Cuda(x), a, Cuda(y));
+      else xpayCpu(Cpu(x), a, Cpu(y));
+    }
+
+    void mxpy(ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) mxpyCuda(Cuda(x), Cuda(y));
+      else mxpyCpu(Cpu(x), Cpu(y));
+    }
+
+    void axpyZpbx(const double &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, const double &b) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) axpyZpbxCuda(a, Cuda(x), Cuda(y), Cuda(z), b);
+      else axpyZpbxCpu(a, Cpu(x), Cpu(y), Cpu(z), b);
+    }
+
+    void axpyBzpcx(const double &a, ColorSpinorField& x, ColorSpinorField& y, const double &b,
+		   ColorSpinorField& z, const double &c) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) axpyBzpcxCuda(a, Cuda(x), Cuda(y), b, Cuda(z), c);
+      else axpyBzpcxCpu(a, Cpu(x), Cpu(y), b, Cpu(z), c);
+    }
+
+    void caxpby(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) caxpbyCuda(a, Cuda(x), b, Cuda(y));
+      else caxpbyCpu(a, Cpu(x), b, Cpu(y));
+    }
+
+    void caxpy(const Complex &a, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) caxpyCuda(a, Cuda(x), Cuda(y));
+      else caxpyCpu(a, Cpu(x), Cpu(y));
+    }
+
+    void cxpaypbz(ColorSpinorField &x, const Complex &b, ColorSpinorField &y, const Complex &c, ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) cxpaypbzCuda(Cuda(x), b, Cuda(y), c, Cuda(z));
+      else cxpaypbzCpu(Cpu(x), b, Cpu(y), c, Cpu(z));
+    }
+
+    void caxpbypzYmbw(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y,
+		      ColorSpinorField &z, ColorSpinorField &w) {
+      if (location(x, y, z, w) == QUDA_CUDA_FIELD_LOCATION)
+	caxpbypzYmbwCuda(a, Cuda(x), b, Cuda(y), Cuda(z), Cuda(w));
+      else caxpbypzYmbwCpu(a, Cpu(x), b, Cpu(y), Cpu(z), Cpu(w));
+    }
+
+    Complex cDotProduct(ColorSpinorField &a, ColorSpinorField &b) {
+      if (location(a, b) == QUDA_CUDA_FIELD_LOCATION) return cDotProductCuda(Cuda(a), Cuda(b));
+      else return cDotProductCpu(Cpu(a), Cpu(b));
+    }
+
+    Complex xpaycDotzy(ColorSpinorField &x, const double &a, ColorSpinorField &y, ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) return xpaycDotzyCuda(Cuda(x), a, Cuda(y), Cuda(z));
+      else return xpaycDotzyCpu(Cpu(x), a, Cpu(y), Cpu(z));
+    }
+
+    double3 cDotProductNormA(ColorSpinorField &a, ColorSpinorField &b) {
+      if (location(a, b) == QUDA_CUDA_FIELD_LOCATION) return cDotProductNormACuda(Cuda(a), Cuda(b));
+      else return cDotProductNormACpu(Cpu(a), Cpu(b));
+    }
+
+    double3 cDotProductNormB(ColorSpinorField &a, ColorSpinorField &b) {
+      if (location(a, b) == QUDA_CUDA_FIELD_LOCATION) return cDotProductNormBCuda(Cuda(a), Cuda(b));
+      else return cDotProductNormBCpu(Cpu(a), Cpu(b));
+    }
+
+    double3 caxpbypzYmbwcDotProductUYNormY(const Complex &a, ColorSpinorField &x, const Complex &b,
+					   ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w,
+					   ColorSpinorField &u) {
+      if (location(x, y, z, w, u) == QUDA_CUDA_FIELD_LOCATION)
+	return caxpbypzYmbwcDotProductUYNormYCuda(a, Cuda(x), b, Cuda(y), Cuda(z), Cuda(w), Cuda(u));
+      else return caxpbypzYmbwcDotProductUYNormYCpu(a, Cpu(x), b, Cpu(y), Cpu(z), Cpu(w), Cpu(u));
+    }
+
+    void cabxpyAx(const double &a, const Complex &b, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) cabxpyAxCuda(a, b, Cuda(x), Cuda(y));
+      else cabxpyAxCpu(a, b, Cpu(x), Cpu(y));
+    }
+
+    double caxpyNorm(const Complex &a, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) return caxpyNormCuda(a, Cuda(x), Cuda(y));
+      else return caxpyNormCpu(a, Cpu(x), Cpu(y));
+    }
+
+    void caxpyXmaz(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) caxpyXmazCuda(a, Cuda(x), Cuda(y), Cuda(z));
+      else caxpyXmazCpu(a, Cpu(x), Cpu(y), Cpu(z));
+    }
+
+    double caxpyXmazNormX(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) return caxpyXmazNormXCuda(a, Cuda(x), Cuda(y), Cuda(z));
+      else return caxpyXmazNormXCpu(a, Cpu(x), Cpu(y), Cpu(z));
+    }
+
+    double cabxpyAxNorm(const double &a, const Complex &b, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) return cabxpyAxNormCuda(a, b, Cuda(x), Cuda(y));
+      else return cabxpyAxNormCpu(a, b, Cpu(x), Cpu(y));
+    }
+
+    void caxpbypz(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y,
+		  ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) caxpbypzCuda(a, Cuda(x), b, Cuda(y), Cuda(z));
+      else caxpbypzCpu(a, Cpu(x), b, Cpu(y), Cpu(z));
+    }
+
+    void caxpbypczpw(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y,
+		     const Complex &c, ColorSpinorField &z, ColorSpinorField &w) {
+      if (location(x, y, z, w) == QUDA_CUDA_FIELD_LOCATION)
+	caxpbypczpwCuda(a, Cuda(x), b, Cuda(y), c, Cuda(z), Cuda(w));
+      else caxpbypczpwCpu(a, Cpu(x), b, Cpu(y), c, Cpu(z), Cpu(w));
+    }
+
+    Complex caxpyDotzy(const Complex &a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) return caxpyDotzyCuda(a, Cuda(x), Cuda(y), Cuda(z));
+      else return caxpyDotzyCpu(a, Cpu(x), Cpu(y), Cpu(z));
+    }
+
+    Complex axpyCGNorm(const double &a, ColorSpinorField &x, ColorSpinorField &y) {
+      if (location(x, y) == QUDA_CUDA_FIELD_LOCATION) return axpyCGNormCuda(a, Cuda(x), Cuda(y));
+      else return axpyCGNormCpu(a, Cpu(x), Cpu(y));
+    }
+
+    double3 HeavyQuarkResidualNorm(ColorSpinorField &x, ColorSpinorField &r) {
+      if (location(x, r) == QUDA_CUDA_FIELD_LOCATION) return HeavyQuarkResidualNormCuda(Cuda(x), Cuda(r));
+      else return HeavyQuarkResidualNormCpu(Cpu(x), Cpu(r));
+    }
+
+    double3 xpyHeavyQuarkResidualNorm(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &r) {
+      if (location(x, y, r) == QUDA_CUDA_FIELD_LOCATION)
+	return xpyHeavyQuarkResidualNormCuda(Cuda(x), Cuda(y), Cuda(r));
+      else return xpyHeavyQuarkResidualNormCpu(Cpu(x), Cpu(y), Cpu(r));
+    }
+
+    void tripleCGUpdate(const double &alpha, const double &beta, ColorSpinorField &q,
+			ColorSpinorField &r, ColorSpinorField &x, ColorSpinorField &p) {
+      if (location(q, r, x, p) == QUDA_CUDA_FIELD_LOCATION)
+	tripleCGUpdateCuda(alpha, beta, Cuda(q), Cuda(r), Cuda(x), Cuda(p));
+      else tripleCGUpdateCpu(alpha, beta, Cpu(q), Cpu(r), Cpu(x), Cpu(p));
+    }
+
+    double3 tripleCGReduction(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z) {
+      if (location(x, y, z) == QUDA_CUDA_FIELD_LOCATION) return tripleCGReductionCuda(Cuda(x), Cuda(y), Cuda(z));
+      else return tripleCGReductionCpu(Cpu(x), Cpu(y), Cpu(z));
+    }
+
+    void cDotProduct(Complex *result, ColorSpinorField **x, ColorSpinorField &y, const int N) {
+      for (int i=0; i<N; i++) location(*x[i], y);
+      if (y.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	std::vector<cudaColorSpinorField*> X(N);
+	for (int i=0; i<N; i++) X[i] = &Cuda(*x[i]);
+	cDotProductCuda(result, &X[0], Cuda(y), N);
+      } else {
+	std::vector<cpuColorSpinorField*> X(N);
+	for (int i=0; i<N; i++) X[i] = &Cpu(*x[i]);
+	cDotProductCpu(result, &X[0], Cpu(y), N);
+      }
+    }
+
+    void caxpy(const Complex *a, ColorSpinorField **x, ColorSpinorField &y, const int N) {
+      for (int i=0; i<N; i++) location(*x[i], y);
+      if (y.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	std::vector<cudaColorSpinorField*> X(N);
+	for (int i=0; i<N; i++) X[i] = &Cuda(*x[i]);
+	caxpyCuda(a, &X[0], Cuda(y), N);
+      } else {
+	std::vector<cpuColorSpinorField*> X(N);
+	for (int i=0; i<N; i++) X[i] = &Cpu(*x[i]);
+	caxpyCpu(a, &X[0], Cpu(y), N);
+      }
+    }
+
+  } // namespace blas
+
+} // namespace quda
@@ -194,6 +194,36 @@ namespace quda {
 			    make_double2(0.0, 0.0), x, y, x, x);
   }
 
+#if (__COMPUTE_CAPABILITY__ >= 200)
+
+#include <multi_blas_core.h>
+
+  /**
+     Functor to perform the operation y += a_i * x_i (complex-valued),
+     with x_i running over a set of fields (see multiBlasCuda)
+  */
+  template <typename Float2, typename FloatN>
+  struct multicaxpy {
+    __device__ void operator()(const Float2 &a, const FloatN &x, FloatN &y) { caxpy_(a, x, y); }
+    static int flops() { return 4; } //! flops per element
+  };
+
+  void caxpyCuda(const Complex *a, cudaColorSpinorField **x, cudaColorSpinorField &y, const int N) {
+    for (int i=0; i<N; i+=MAX_MULTI_BLAS_N) {
+      const int n = (N-i < MAX_MULTI_BLAS_N) ? N-i : MAX_MULTI_BLAS_N;
+      multiBlasCuda<multicaxpy>(a+i, x+i, y, n);
+    }
+  }
+
+#else
+
+  // the kernel arguments of the block update exceed the Tesla limit
+  void caxpyCuda(const Complex *a, cudaColorSpinorField **x, cudaColorSpinorField &y, const int N) {
+    for (int i=0; i<N; i++) caxpyCuda(a[i], *x[i], y);
+  }
+
+#endif
+
   /**
      Functor to perform the operation y = a*x + b*y  (complex-valued)
   */
@@ -192,10 +192,12 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(input_location, QUDA_CPU_FIELD_LOCATION);
   P(output_location, QUDA_CPU_FIELD_LOCATION);
   P(clover_location, QUDA_CPU_FIELD_LOCATION);
+  P(compute_location, QUDA_CUDA_FIELD_LOCATION);
 #else
   P(input_location, QUDA_INVALID_FIELD_LOCATION);
   P(output_location, QUDA_INVALID_FIELD_LOCATION);
   P(clover_location, QUDA_INVALID_FIELD_LOCATION);
+  P(compute_location, QUDA_INVALID_FIELD_LOCATION);
 #endif
 
 #if defined INIT_PARAM
@@ -219,6 +221,49 @@ void printQudaInvertParam(QudaInvertParam *param) {
   }
 #endif
 
+#if defined INIT_PARAM
+  P(s_step, INVALID_INT);
+#else
+  if (param->inv_type == QUDA_SSTEP_CG_INVERTER) {
+    P(s_step, INVALID_INT);
+  }
+#endif
+
+#if defined INIT_PARAM
+  P(num_src, INVALID_INT);
+#else
+  if (param->inv_type == QUDA_BLOCK_CG_INVERTER) {
+    P(num_src, INVALID_INT);
+  }
+#endif
+
+#if defined INIT_PARAM
+  P(nev, INVALID_INT);
+  P(max_search_dim, INVALID_INT);
+  P(deflation_grid, INVALID_INT);
+#else
+  if (param->inv_type == QUDA_EIGCG_INVERTER) {
+    P(nev, INVALID_INT);
+    P(max_search_dim, INVALID_INT);
+    P(deflation_grid, INVALID_INT);
+  }
+#endif
+
+  // Lanczos eigensolver parameters, checked by eigensolveQuda()
+#ifndef CHECK_PARAM
+  P(eig_nkrylov, INVALID_INT);
+  P(eig_poly_deg, INVALID_INT);
+  P(eig_amin, INVALID_DOUBLE);
+  P(eig_amax, INVALID_DOUBLE);
+  P(eig_tol, INVALID_DOUBLE);
+  P(eig_max_restarts, INVALID_INT);
+#endif
+
+#ifndef CHECK_PARAM
+  P(chrono_max_dim, 0); /**< Chronological initial guess disabled by default */
+  P(chrono_max_gib, 0.0); /**< No cap on the solution histories */
+#endif
+
   // domain decomposition parameters
   //P(inv_type_sloppy, QUDA_INVALID_INVERTER); // disable since invalid means no preconditioner
 #if defined INIT_PARAM
@@ -264,6 +309,9 @@ void printQudaInvertParam(QudaInvertParam *param) {
     param->clover_cuda_prec_precondition = param->clover_cuda_prec_sloppy;
 #endif
     P(clover_order, QUDA_INVALID_CLOVER_ORDER);
+#ifndef CHECK_PARAM
+    P(clover_coeff, INVALID_DOUBLE); // only checked by computeCloverQuda()
+#endif
     P(cl_pad, INVALID_INT);
 #ifndef INIT_PARAM
   }
@@ -0,0 +1,434 @@
+#include <math.h>
+
+#include <quda_internal.h>
+#include <clover_field.h>
+#include <gauge_field.h>
+#include <face_quda.h>
+
+#ifdef HOST_DSLASH
+#include <host_simd.h>
+#endif
+
+/**
+   Host (CPU) routines that compute clover fields.  The fields are in
+   QUDA_PACKED_CLOVER_ORDER: each site holds two chiral 6x6 Hermitian
+   blocks of 36 reals, the 6 diagonal elements followed by the 15
+   complex elements of the strictly lower triangle in column-major
+   order.  Spinor indices are in the DeGrand-Rossi basis, where
+   gamma_5 = diag(1,1,-1,-1), so the blocks act on spins (0,1) and
+   (2,3), and the element index within a block is 3*spin + color.
+ */
+
+namespace quda {
+
+#ifdef HOST_DSLASH
+
+  /** Offset of the lower-triangular element (i,j), i > j, in a packed block */
+  static inline int packedOffset(int i, int j) { return 6 + 2*(j*(11-j)/2 + i-j-1); }
+
+  /**
+     Inverts W packed blocks held in structure-of-arrays form (element
+     first, block in the lane index) so that every operation is a loop
+     over the W lanes which the compiler vectorizes.  With A = L L^dag
+     (L lower triangular with a real diagonal), A^-1 = L^-dag L^-1.
+     Returns false if any block is not positive definite.
+   */
+  template <typename Float, int W>
+  bool invertBlocks(Float re[6][6][W], Float im[6][6][W]) {
+    Float d[6][W]; // inverse diagonal of L
+    bool ok = true;
+
+    // Cholesky factorization, L overwrites the lower triangle of A
+    for (int j=0; j<6; j++) {
+      Float djj[W];
+#pragma omp simd
+      for (int w=0; w<W; w++) djj[w] = re[j][j][w];
+      for (int k=0; k<j; k++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) djj[w] -= re[j][k][w]*re[j][k][w] + im[j][k][w]*im[j][k][w];
+      }
+      for (int w=0; w<W; w++) if (!(djj[w] > 0)) ok = false;
+#pragma omp simd
+      for (int w=0; w<W; w++) d[j][w] = 1.0 / sqrt(djj[w]);
+
+      for (int i=j+1; i<6; i++) {
+	for (int k=0; k<j; k++) { // A_ij -= L_ik conj(L_jk)
+#pragma omp simd
+	  for (int w=0; w<W; w++) {
+	    re[i][j][w] -= re[i][k][w]*re[j][k][w] + im[i][k][w]*im[j][k][w];
+	    im[i][j][w] -= im[i][k][w]*re[j][k][w] - re[i][k][w]*im[j][k][w];
+	  }
+	}
+#pragma omp simd
+	for (int w=0; w<W; w++) { re[i][j][w] *= d[j][w]; im[i][j][w] *= d[j][w]; }
+      }
+    }
+
+    // M = L^-1 (lower triangular), column by column
+    Float mre[6][6][W], mim[6][6][W];
+    for (int j=0; j<6; j++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) { mre[j][j][w] = d[j][w]; mim[j][j][w] = 0.0; }
+      for (int i=j+1; i<6; i++) {
+	Float sre[W], sim[W];
+#pragma omp simd
+	for (int w=0; w<W; w++) sre[w] = sim[w] = 0.0;
+	for (int k=j; k<i; k++) {
+#pragma omp simd
+	  for (int w=0; w<W; w++) {
+	    sre[w] += re[i][k][w]*mre[k][j][w] - im[i][k][w]*mim[k][j][w];
+	    sim[w] += re[i][k][w]*mim[k][j][w] + im[i][k][w]*mre[k][j][w];
+	  }
+	}
+#pragma omp simd
+	for (int w=0; w<W; w++) { mre[i][j][w] = -d[i][w]*sre[w]; mim[i][j][w] = -d[i][w]*sim[w]; }
+      }
+    }
+
+    // A^-1_ij = sum_{k >= i} conj(M_ki) M_kj for i >= j
+    for (int j=0; j<6; j++) {
+      for (int i=j; i<6; i++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) { re[i][j][w] = 0.0; im[i][j][w] = 0.0; }
+	for (int k=i; k<6; k++) {
+#pragma omp simd
+	  for (int w=0; w<W; w++) {
+	    re[i][j][w] += mre[k][i][w]*mre[k][j][w] + mim[k][i][w]*mim[k][j][w];
+	    im[i][j][w] += mre[k][i][w]*mim[k][j][w] - mim[k][i][w]*mre[k][j][w];
+	  }
+	}
+      }
+    }
+
+    return ok;
+  }
+
+  template <typename Float>
+  void cloverInvertHost(Float *inv[2], const Float *clover[2], int volumeCB) {
+    const int W = 2*NativeLanes<Float>::value; // one real per lane
+    const int nBlocks = 2*volumeCB; // two chiral blocks per site
+    const int nBatch = (nBlocks + W - 1) / W;
+    int fail = 0;
+
+    for (int parity=0; parity<2; parity++) {
+#pragma omp parallel for schedule(static) reduction(+:fail)
+      for (int batch=0; batch<nBatch; batch++) {
+	Float re[6][6][W], im[6][6][W];
+	const int b0 = batch*W;
+	const int n = (nBlocks - b0 < W) ? nBlocks - b0 : W;
+
+	for (int w=0; w<W; w++) {
+	  // the tail of the last batch is padded with the identity
+	  const Float *a = clover[parity] + (b0 + (w < n ? w : 0))*36;
+	  for (int i=0; i<6; i++) {
+	    re[i][i][w] = (w < n) ? a[i] : 1.0;
+	    im[i][i][w] = 0.0;
+	    for (int j=0; j<i; j++) {
+	      re[i][j][w] = (w < n) ? a[packedOffset(i,j)] : 0.0;
+	      im[i][j][w] = (w < n) ? a[packedOffset(i,j)+1] : 0.0;
+	    }
+	  }
+	}
+
+	if (!invertBlocks<Float,W>(re, im)) fail++;
+
+	for (int w=0; w<n; w++) {
+	  Float *a = inv[parity] + (b0 + w)*36;
+	  for (int i=0; i<6; i++) {
+	    a[i] = re[i][i][w];
+	    for (int j=0; j<i; j++) {
+	      a[packedOffset(i,j)] = re[i][j][w];
+	      a[packedOffset(i,j)+1] = im[i][j][w];
+	    }
+	  }
+	}
+      }
+    }
+
+    if (fail) errorQuda("Clover term is not positive definite on %d batches of sites", fail);
+  }
+
+  /** Products of 3x3 complex matrices (18 reals, row major as in QDP order) */
+  static inline void matMul(double *c, const double *a, bool aDag, const double *b, bool bDag) {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	double re = 0.0, im = 0.0;
+	for (int k=0; k<3; k++) {
+	  const int ia = aDag ? k*3+i : i*3+k, ib = bDag ? j*3+k : k*3+j;
+	  const double ar = a[2*ia], ai = aDag ? -a[2*ia+1] : a[2*ia+1];
+	  const double br = b[2*ib], bi = bDag ? -b[2*ib+1] : b[2*ib+1];
+	  re += ar*br - ai*bi;
+	  im += ar*bi + ai*br;
+	}
+	c[2*(i*3+j)] = re;
+	c[2*(i*3+j)+1] = im;
+      }
+    }
+  }
+
+  /** Product of four links, each optionally conjugated, accumulated into Q */
+  static inline void addLeaf(double *Q, const double *U[4], const bool dag[4]) {
+    double t1[18], t2[18], t3[18];
+    matMul(t1, U[0], dag[0], U[1], dag[1]);
+    matMul(t2, t1, false, U[2], dag[2]);
+    matMul(t3, t2, false, U[3], dag[3]);
+    for (int i=0; i<18; i++) Q[i] += t3[i];
+  }
+
+  /**
+     sigma_{mu nu} = (i/2) [gamma_mu, gamma_nu] = i gamma_mu gamma_nu
+     (mu != nu) for the six planes mu > nu, ordered (1,0), (2,0),
+     (2,1), (3,0), (3,1), (3,2), with the DeGrand-Rossi gamma matrices
+     of the reference dslash.
+   */
+  static void sigmaMatrices(double sigma[6][4][4][2]) {
+    static const double gamma[4][4][4][2] = {
+      { {{0,0},{0,0},{0,0},{0,1}}, {{0,0},{0,0},{0,1},{0,0}}, {{0,0},{0,-1},{0,0},{0,0}}, {{0,-1},{0,0},{0,0},{0,0}} },
+      { {{0,0},{0,0},{0,0},{-1,0}}, {{0,0},{0,0},{1,0},{0,0}}, {{0,0},{1,0},{0,0},{0,0}}, {{-1,0},{0,0},{0,0},{0,0}} },
+      { {{0,0},{0,0},{0,1},{0,0}}, {{0,0},{0,0},{0,0},{0,-1}}, {{0,-1},{0,0},{0,0},{0,0}}, {{0,0},{0,1},{0,0},{0,0}} },
+      { {{0,0},{0,0},{1,0},{0,0}}, {{0,0},{0,0},{0,0},{1,0}}, {{1,0},{0,0},{0,0},{0,0}}, {{0,0},{1,0},{0,0},{0,0}} }
+    };
+
+    for (int mu=1, p=0; mu<4; mu++) {
+      for (int nu=0; nu<mu; nu++, p++) {
+	for (int s=0; s<4; s++) {
+	  for (int t=0; t<4; t++) {
+	    double re = 0.0, im = 0.0;
+	    for (int u=0; u<4; u++) {
+	      re += gamma[mu][s][u][0]*gamma[nu][u][t][0] - gamma[mu][s][u][1]*gamma[nu][u][t][1];
+	      im += gamma[mu][s][u][0]*gamma[nu][u][t][1] + gamma[mu][s][u][1]*gamma[nu][u][t][0];
+	    }
+	    sigma[p][s][t][0] = -im; // times i
+	    sigma[p][s][t][1] = re;
+	  }
+	}
+      }
+    }
+  }
+
+  /**
+     Local lattice extended by one site in every direction, so that
+     all the links of the clover leaves at a local site are at hand.
+     The halo is filled from the neighbouring processes in the
+     partitioned dimensions and by periodic wrapping otherwise.
+   */
+  struct ExtendedLinks {
+    int X[4], E[4];
+    int volumeCB;
+    double *link[4];
+
+    ExtendedLinks(const cpuGaugeField &gauge) {
+      int volume = 1;
+      for (int d=0; d<4; d++) { X[d] = gauge.X()[d]; E[d] = X[d] + 2; volume *= E[d]; }
+      volumeCB = volume / 2;
+      for (int d=0; d<4; d++) link[d] = (double*)safe_malloc(volume*18*sizeof(double));
+
+      if (gauge.Precision() == QUDA_DOUBLE_PRECISION) fill((const double**)gauge.Gauge_p(), gauge.VolumeCB());
+      else fill((const float**)gauge.Gauge_p(), gauge.VolumeCB());
+
+#ifdef MULTI_GPU
+      int R[4] = {1, 1, 1, 1};
+      exchange_cpu_sitelink_ex(X, R, (void**)link, QUDA_QDP_GAUGE_ORDER, QUDA_DOUBLE_PRECISION, 0);
+#endif
+    }
+
+    ~ExtendedLinks() { for (int d=0; d<4; d++) host_free(link[d]); }
+
+    /** Checkerboard offset (including the parity) of local site x shifted by dx */
+    inline int index(const int x[4], const int dx[4]) const {
+      int y[4];
+      for (int d=0; d<4; d++) y[d] = x[d] + dx[d] + 1;
+      const int parity = (y[0] + y[1] + y[2] + y[3]) & 1;
+      return parity*volumeCB + ((((y[3]*E[2] + y[2])*E[1] + y[1])*E[0] + y[0]) >> 1);
+    }
+
+    template <typename Float>
+    void fill(const Float **gauge, int localVolumeCB) {
+      // the halo is only filled here when there is no exchange to do it
+#ifdef MULTI_GPU
+      const bool wrap = false;
+#else
+      const bool wrap = true;
+#endif
+#pragma omp parallel for schedule(static)
+      for (int i=0; i<2*volumeCB; i++) {
+	int y[4], r = i;
+	for (int d=0; d<4; d++) { y[d] = r % E[d]; r /= E[d]; }
+	bool halo = false;
+	int x[4];
+	for (int d=0; d<4; d++) {
+	  if (y[d] == 0 || y[d] == E[d]-1) halo = true;
+	  x[d] = (y[d] - 1 + X[d]) % X[d];
+	}
+	if (halo && !wrap) continue;
+
+	const int parity = (y[0] + y[1] + y[2] + y[3]) & 1;
+	const int dst = parity*volumeCB + (i >> 1);
+	const int src = parity*localVolumeCB + ((((x[3]*X[2] + x[2])*X[1] + x[1])*X[0] + x[0]) >> 1);
+	for (int d=0; d<4; d++)
+	  for (int j=0; j<18; j++) link[d][dst*18 + j] = gauge[d][src*18 + j];
+      }
+    }
+  };
+
+  /**
+     Computes the clover term at every site of the local lattice,
+
+     A = 1 + coeff sum_{mu<nu} sigma_{mu nu} (i F_{mu nu}),
+
+     with F_{mu nu} = (Q_{mu nu} - Q_{mu nu}^dag) / 8, projected to
+     be traceless, where Q_{mu nu} is the sum of the four plaquettes
+     in the mu-nu plane which start and end at x (the clover leaves).
+   */
+  template <typename Float>
+  void computeCloverHost(Float *clover[2], const ExtendedLinks &U, double coeff) {
+    double sigma[6][4][4][2];
+    sigmaMatrices(sigma);
+
+    const int *X = U.X;
+    const int volumeCB = X[0]*X[1]*X[2]*X[3] / 2;
+
+    for (int parity=0; parity<2; parity++) {
+#pragma omp parallel for schedule(static)
+      for (int i=0; i<volumeCB; i++) {
+	int x[4];
+	int za = i / (X[0]/2);
+	int x1h = i - za*(X[0]/2);
+	int zb = za / X[1];
+	x[1] = za - zb*X[1];
+	x[3] = zb / X[2];
+	x[2] = zb - x[3]*X[2];
+	x[0] = 2*x1h + ((x[1] + x[2] + x[3] + parity) & 1);
+
+	double H[6][18]; // i F_{mu nu} for each plane
+	for (int mu=1, p=0; mu<4; mu++) {
+	  for (int nu=0; nu<mu; nu++, p++) {
+	    int d0[4] = {0,0,0,0}, dm[4] = {0,0,0,0}, dn[4] = {0,0,0,0};
+	    int dmpn[4] = {0,0,0,0}, dpmn[4] = {0,0,0,0}, dmmn[4] = {0,0,0,0}, dpm[4] = {0,0,0,0}, dpn[4] = {0,0,0,0};
+	    dpm[mu] = 1; dpn[nu] = 1; dm[mu] = -1; dn[nu] = -1;
+	    dmpn[mu] = -1; dmpn[nu] = 1;  // x - mu + nu
+	    dpmn[mu] = 1; dpmn[nu] = -1;  // x + mu - nu
+	    dmmn[mu] = -1; dmmn[nu] = -1; // x - mu - nu
+
+	    const double *Umu = U.link[mu], *Unu = U.link[nu];
+	    double Q[18];
+	    for (int j=0; j<18; j++) Q[j] = 0.0;
+
+	    { // U_mu(x) U_nu(x+mu) U_mu^dag(x+nu) U_nu^dag(x)
+	      const double *L[4] = { Umu + U.index(x,d0)*18, Unu + U.index(x,dpm)*18,
+				     Umu + U.index(x,dpn)*18, Unu + U.index(x,d0)*18 };
+	      const bool dag[4] = { false, false, true, true };
+	      addLeaf(Q, L, dag);
+	    }
+	    { // U_nu(x) U_mu^dag(x-mu+nu) U_nu^dag(x-mu) U_mu(x-mu)
+	      const double *L[4] = { Unu + U.index(x,d0)*18, Umu + U.index(x,dmpn)*18,
+				     Unu + U.index(x,dm)*18, Umu + U.index(x,dm)*18 };
+	      const bool dag[4] = { false, true, true, false };
+	      addLeaf(Q, L, dag);
+	    }
+	    { // U_mu^dag(x-mu) U_nu^dag(x-mu-nu) U_mu(x-mu-nu) U_nu(x-nu)
+	      const double *L[4] = { Umu + U.index(x,dm)*18, Unu + U.index(x,dmmn)*18,
+				     Umu + U.index(x,dmmn)*18, Unu + U.index(x,dn)*18 };
+	      const bool dag[4] = { true, true, false, false };
+	      addLeaf(Q, L, dag);
+	    }
+	    { // U_nu^dag(x-nu) U_mu(x-nu) U_nu(x+mu-nu) U_mu^dag(x)
+	      const double *L[4] = { Unu + U.index(x,dn)*18, Umu + U.index(x,dn)*18,
+				     Unu + U.index(x,dpmn)*18, Umu + U.index(x,d0)*18 };
+	      const bool dag[4] = { true, false, false, true };
+	      addLeaf(Q, L, dag);
+	    }
+
+	    // H = i (Q - Q^dag) / 8, then remove the trace
+	    for (int a=0; a<3; a++) {
+	      for (int b=0; b<3; b++) {
+		const double re = Q[2*(a*3+b)] - Q[2*(b*3+a)];
+		const double im = Q[2*(a*3+b)+1] + Q[2*(b*3+a)+1];
+		H[p][2*(a*3+b)] = -im / 8.0;
+		H[p][2*(a*3+b)+1] = re / 8.0;
+	      }
+	    }
+	    const double tr = (H[p][0] + H[p][8] + H[p][16]) / 3.0;
+	    for (int a=0; a<3; a++) H[p][2*(a*3+a)] -= tr;
+	  }
+	}
+
+	Float *A = clover[parity] + i*72;
+	for (int chi=0; chi<2; chi++) {
+	  for (int col=0; col<6; col++) {
+	    for (int row=col; row<6; row++) {
+	      const int s = 2*chi + row/3, t = 2*chi + col/3, a = row%3, b = col%3;
+	      double re = (row == col) ? 1.0 : 0.0, im = 0.0;
+	      for (int p=0; p<6; p++) {
+		const double sr = sigma[p][s][t][0], si = sigma[p][s][t][1];
+		const double hr = H[p][2*(a*3+b)], hi = H[p][2*(a*3+b)+1];
+		re += coeff*(sr*hr - si*hi);
+		im += coeff*(sr*hi + si*hr);
+	      }
+	      if (row == col) {
+		A[36*chi + row] = re;
+	      } else {
+		A[36*chi + packedOffset(row,col)] = re;
+		A[36*chi + packedOffset(row,col) + 1] = im;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+#endif // HOST_DSLASH
+
+  void cloverInvertCpu(cpuCloverField &clover) {
+#ifdef HOST_DSLASH
+    if (clover.Order() != QUDA_PACKED_CLOVER_ORDER)
+      errorQuda("Clover order %d not supported by the host clover inversion", clover.Order());
+    if (!clover.V(false) || !clover.V(true)) errorQuda("Clover term and inverse must both be allocated");
+
+    // parity halves are laid out as in QDPOrder
+    if (clover.Precision() == QUDA_DOUBLE_PRECISION) {
+      const double *in[2] = { (const double*)clover.V(false),
+			      (const double*)((const char*)clover.V(false) + clover.Bytes()/2) };
+      double *out[2] = { (double*)clover.V(true), (double*)((char*)clover.V(true) + clover.Bytes()/2) };
+      cloverInvertHost<double>(out, in, clover.VolumeCB());
+    } else if (clover.Precision() == QUDA_SINGLE_PRECISION) {
+      const float *in[2] = { (const float*)clover.V(false),
+			     (const float*)((const char*)clover.V(false) + clover.Bytes()/2) };
+      float *out[2] = { (float*)clover.V(true), (float*)((char*)clover.V(true) + clover.Bytes()/2) };
+      cloverInvertHost<float>(out, in, clover.VolumeCB());
+    } else {
+      errorQuda("Precision %d not supported by the host clover inversion", clover.Precision());
+    }
+#else
+    errorQuda("Host clover routines have not been built");
+#endif
+  }
+
+  void computeCloverCpu(cpuCloverField &clover, const cpuGaugeField &gauge, double coeff) {
+#ifdef HOST_DSLASH
+    if (clover.Order() != QUDA_PACKED_CLOVER_ORDER)
+      errorQuda("Clover order %d not supported by the host clover computation", clover.Order());
+    if (!clover.V(false)) errorQuda("Clover term has not been allocated");
+    if (gauge.Order() != QUDA_QDP_GAUGE_ORDER || gauge.Reconstruct() != QUDA_RECONSTRUCT_NO)
+      errorQuda("Host clover computation requires a QDP-ordered gauge field without reconstruction");
+    if (gauge.VolumeCB() != clover.VolumeCB())
+      errorQuda("Gauge and clover volumes differ (%d,%d)", gauge.VolumeCB(), clover.VolumeCB());
+
+    ExtendedLinks U(gauge);
+
+    if (clover.Precision() == QUDA_DOUBLE_PRECISION) {
+      double *A[2] = { (double*)clover.V(false), (double*)((char*)clover.V(false) + clover.Bytes()/2) };
+      computeCloverHost<double>(A, U, coeff);
+    } else if (clover.Precision() == QUDA_SINGLE_PRECISION) {
+      float *A[2] = { (float*)clover.V(false), (float*)((char*)clover.V(false) + clover.Bytes()/2) };
+      computeCloverHost<float>(A, U, coeff);
+    } else {
+      errorQuda("Precision %d not supported by the host clover computation", clover.Precision());
+    }
+#else
+    errorQuda("Host clover routines have not been built");
+#endif
+  }
+
+} // namespace quda
@@ -265,6 +265,7 @@ namespace quda {
     param.fieldOrder = fieldOrder;
     param.gammaBasis = gammaBasis;
     param.create = QUDA_INVALID_FIELD_CREATE;
+    param.location = Location();
   }
 
   // For kernels with precision conversion built in
@@ -318,6 +319,42 @@ namespace quda {
     return ghostNorm[i];
   }
 
+  ColorSpinorField* ColorSpinorField::Create(const ColorSpinorParam &param) {
+
+    ColorSpinorField *field = NULL;
+    if (param.location == QUDA_CPU_FIELD_LOCATION) {
+      field = new cpuColorSpinorField(param);
+    } else if (param.location == QUDA_CUDA_FIELD_LOCATION) {
+      field = new cudaColorSpinorField(param);
+    } else {
+      errorQuda("Invalid field location %d", param.location);
+    }
+
+    return field;
+  }
+
+  ColorSpinorField* ColorSpinorField::Create(const ColorSpinorField &src, const ColorSpinorParam &param) {
+
+    ColorSpinorField *field = NULL;
+    if (param.location == QUDA_CPU_FIELD_LOCATION) {
+      ColorSpinorParam cpuParam(param);
+      if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
+	cpuParam.v = const_cast<void*>(src.V());
+	cpuParam.norm = const_cast<void*>(src.Norm());
+      } else if (param.create == QUDA_COPY_FIELD_CREATE) {
+	cpuParam.create = QUDA_NULL_FIELD_CREATE;
+      }
+      field = new cpuColorSpinorField(cpuParam);
+      if (param.create == QUDA_COPY_FIELD_CREATE) *field = src;
+    } else if (param.location == QUDA_CUDA_FIELD_LOCATION) {
+      field = new cudaColorSpinorField(src, param);
+    } else {
+      errorQuda("Invalid field location %d", param.location);
+    }
+
+    return field;
+  }
+
   double norm2(const ColorSpinorField &a) {
 
     double rtn = 0.0;
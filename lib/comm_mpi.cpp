@@ -188,6 +188,31 @@ void comm_allreduce_int(int* data)
 }
 
 
+/**
+ * Start a nonblocking in-place sum over all ranks.  The returned
+ * handle is completed and released by comm_allreduce_wait().  Falls
+ * back to a blocking reduction for pre-MPI-3 implementations.
+ */
+MsgHandle *comm_iallreduce_array(double* data, size_t size)
+{
+  MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
+#if (MPI_VERSION >= 3)
+  MPI_CHECK( MPI_Iallreduce(MPI_IN_PLACE, data, size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &(mh->request)) );
+#else
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, data, size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
+  mh->request = MPI_REQUEST_NULL;
+#endif
+  return mh;
+}
+
+
+void comm_allreduce_wait(MsgHandle *mh)
+{
+  MPI_CHECK( MPI_Wait(&(mh->request), MPI_STATUS_IGNORE) );
+  host_free(mh);
+}
+
+
 /**  broadcast from rank 0 */
 void comm_broadcast(void *data, size_t nbytes)
 {
@@ -158,6 +158,20 @@ void comm_allreduce_int(int* data)
 }
 
 
+/**
+ * QMP has no nonblocking reductions, so the sum is completed here and
+ * comm_allreduce_wait() is a no-op.
+ */
+MsgHandle *comm_iallreduce_array(double* data, size_t size)
+{
+  QMP_CHECK( QMP_sum_double_array(data, size) );
+  return NULL;
+}
+
+
+void comm_allreduce_wait(MsgHandle *mh) {}
+
+
 void comm_broadcast(void *data, size_t nbytes)
 {
   QMP_CHECK( QMP_broadcast(data, nbytes) );
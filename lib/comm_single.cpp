@@ -37,6 +37,10 @@ void comm_allreduce_array(double* data, size_t size) {}
 
 void comm_allreduce_int(int* data) {}
 
+MsgHandle *comm_iallreduce_array(double* data, size_t size) { return NULL; }
+
+void comm_allreduce_wait(MsgHandle *mh) {}
+
 void comm_broadcast(void *data, size_t nbytes) {}
 
 void comm_barrier(void) {}
@@ -215,11 +215,15 @@ namespace quda {
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
 	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
     } else if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      SpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, Out);
+      SpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
 	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
     } else if (out.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
-      SpaceColorSpinorOrder<FloatOut, Ns, Nc> outOrder(out, Out);
+      SpaceColorSpinorOrder<FloatOut, Ns, Nc> outOrder(out, Out, outNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
+    } else if (out.FieldOrder() == QUDA_AOSOA_FIELD_ORDER) {
+      AoSoASpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
 	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
     } else if (out.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
@@ -250,10 +254,13 @@ namespace quda {
       FloatNOrder<FloatIn, Ns, Nc, 2> inOrder(in, In, inNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
     } else if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      SpaceSpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, In);
+      SpaceSpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, In, inNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
     } else if (in.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
-      SpaceColorSpinorOrder<FloatIn, Ns, Nc> inOrder(in, In);
+      SpaceColorSpinorOrder<FloatIn, Ns, Nc> inOrder(in, In, inNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
+    } else if (in.FieldOrder() == QUDA_AOSOA_FIELD_ORDER) {
+      AoSoASpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, In, inNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
     } else if (in.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
 
@@ -264,12 +264,47 @@ namespace quda {
     } else if (out.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>
-	(QDPOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length,12>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length,8>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_13) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length,13>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_9) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length,9>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
 
+    } else if (out.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length,12>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length,8>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_13) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length,13>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_9) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length,9>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
     } else if (out.Order() == QUDA_QDPJIT_GAUGE_ORDER) {
 
 #ifdef BUILD_QDPJIT_INTERFACE
@@ -319,7 +354,7 @@ namespace quda {
 
     bool doGhost = in.GhostInit() && out.GhostInit();
 
-    // reconstruction only supported on FloatN fields currently
+    // reconstruction only supported on FloatN, QDP and AoSoA fields currently
     if (in.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
       if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 	if (typeid(FloatIn)==typeid(short) && in.LinkType() == QUDA_ASQTAD_FAT_LINKS) {
@@ -367,12 +402,47 @@ namespace quda {
     } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In, inGhost), 
-					 out, location, Out, outGhost, type, doGhost);
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,12>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,8>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_13) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,13>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_9) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,9>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
 
+    } else if (in.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,12>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,8>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_13) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,13>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_9) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,9>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
     } else if (in.Order() == QUDA_QDPJIT_GAUGE_ORDER) {
 
 #ifdef BUILD_QDPJIT_INTERFACE
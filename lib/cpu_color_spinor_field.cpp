@@ -36,17 +36,24 @@ namespace quda {
   void* cpuColorSpinorField::backGhostFaceBuffer[QUDA_MAX_DIM];
   void* cpuColorSpinorField::fwdGhostFaceSendBuffer[QUDA_MAX_DIM]; 
   void* cpuColorSpinorField::backGhostFaceSendBuffer[QUDA_MAX_DIM];
+  size_t cpuColorSpinorField::ghostFaceBytes[QUDA_MAX_DIM];
 
   cpuColorSpinorField::cpuColorSpinorField(const ColorSpinorParam &param) :
     ColorSpinorField(param), init(false), reference(false) {
+    // a reference field must know its data pointer before the parity
+    // subsets are created
+    if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
+      v = param.v;
+      if (precision == QUDA_HALF_PRECISION) norm = param.norm;
+      reference = true;
+    }
     create(param.create);
     if (param.create == QUDA_NULL_FIELD_CREATE) {
       // do nothing
     } else if (param.create == QUDA_ZERO_FIELD_CREATE) {
       zero();
     } else if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
-      v = param.v;
-      reference = true;
+      // do nothing
     } else {
       errorQuda("Creation type %d not supported", param.create);
     }
@@ -56,6 +63,7 @@ namespace quda {
     ColorSpinorField(src), init(false), reference(false) {
     create(QUDA_COPY_FIELD_CREATE);
     memcpy(v,src.v,bytes);
+    if (precision == QUDA_HALF_PRECISION) memcpy(norm, src.norm, norm_bytes);
   }
 
   cpuColorSpinorField::cpuColorSpinorField(const ColorSpinorField &src) : 
@@ -63,6 +71,8 @@ namespace quda {
     create(QUDA_COPY_FIELD_CREATE);
     if (typeid(src) == typeid(cpuColorSpinorField)) {
       memcpy(v, dynamic_cast<const cpuColorSpinorField&>(src).v, bytes);
+      if (precision == QUDA_HALF_PRECISION)
+	memcpy(norm, dynamic_cast<const cpuColorSpinorField&>(src).norm, norm_bytes);
     } else if (typeid(src) == typeid(cudaColorSpinorField)) {
       dynamic_cast<const cudaColorSpinorField&>(src).saveSpinorField(*this);
     } else {
@@ -120,16 +130,30 @@ namespace quda {
     bytes = total_length * precision; // includes pads and ghost zones
     bytes = ALIGNMENT_ADJUST(bytes);
 
+    // half precision stores a float norm per site, with the odd sites
+    // of a full field following the even ones
+    norm_bytes = (precision == QUDA_HALF_PRECISION) ? total_norm_length * sizeof(float) : 0;
+
     if (pad != 0) errorQuda("Non-zero pad not supported");  
-    if (precision == QUDA_HALF_PRECISION) errorQuda("Half precision not supported");
+    if (precision == QUDA_HALF_PRECISION && fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+	fieldOrder != QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+      errorQuda("Half precision not supported for field order %d", fieldOrder);
+    }
 
     if (fieldOrder != QUDA_SPACE_COLOR_SPIN_FIELD_ORDER && 
 	fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
 	fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER &&
-	fieldOrder != QUDA_QDPJIT_FIELD_ORDER) {
+	fieldOrder != QUDA_QDPJIT_FIELD_ORDER &&
+	fieldOrder != QUDA_AOSOA_FIELD_ORDER) {
       errorQuda("Field order %d not supported", fieldOrder);
     }
 
+    // site blocks may not straddle the parities
+    if (fieldOrder == QUDA_AOSOA_FIELD_ORDER &&
+	(siteSubset == QUDA_FULL_SITE_SUBSET ? volume/2 : volume) % QUDA_AOSOA_BLOCK != 0) {
+      errorQuda("Checkerboard volume must be a multiple of %d for field order %d", QUDA_AOSOA_BLOCK, fieldOrder);
+    }
+
     if (create != QUDA_REFERENCE_FIELD_CREATE) {
       // array of 4-d fields
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
@@ -139,8 +163,25 @@ namespace quda {
       } else {
 	v = safe_malloc(bytes);
       }
+      if (precision == QUDA_HALF_PRECISION) norm = safe_malloc(norm_bytes);
       init = true;
     }
+
+    // create the associated even and odd subsets
+    if (siteSubset == QUDA_FULL_SITE_SUBSET && siteOrder == QUDA_EVEN_ODD_SITE_ORDER &&
+	fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
+      ColorSpinorParam param;
+      fill(param);
+      param.siteSubset = QUDA_PARITY_SITE_SUBSET;
+      param.x[0] /= 2; // set single parity dimensions
+      param.create = QUDA_REFERENCE_FIELD_CREATE;
+      param.v = v;
+      param.norm = norm;
+      even = new cpuColorSpinorField(param);
+      param.v = (void*)((char*)v + (length/2)*precision);
+      param.norm = (void*)((char*)norm + norm_bytes/2);
+      odd = new cpuColorSpinorField(param);
+    }
  
   }
 
@@ -150,18 +191,43 @@ namespace quda {
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
 	for (int i=0; i<x[nDim-1]; i++) host_free(((void**)v)[i]);
       host_free(v);
+      if (precision == QUDA_HALF_PRECISION) host_free(norm);
       init = false;
     }
 
+    if (siteSubset == QUDA_FULL_SITE_SUBSET) {
+      delete even; even = 0;
+      delete odd; odd = 0;
+    }
+
+  }
+
+  cpuColorSpinorField& cpuColorSpinorField::Even() const { 
+    if (siteSubset == QUDA_FULL_SITE_SUBSET && even) {
+      return *(dynamic_cast<cpuColorSpinorField*>(even)); 
+    }
+
+    errorQuda("Cannot return even subset of %d subset", siteSubset);
+    exit(-1);
+  }
+
+  cpuColorSpinorField& cpuColorSpinorField::Odd() const {
+    if (siteSubset == QUDA_FULL_SITE_SUBSET && odd) {
+      return *(dynamic_cast<cpuColorSpinorField*>(odd)); 
+    }
+
+    errorQuda("Cannot return odd subset of %d subset", siteSubset);
+    exit(-1);
   }
 
   void cpuColorSpinorField::copy(const cpuColorSpinorField &src) {
     checkField(*this, src);
-    if (fieldOrder == src.fieldOrder) {
+    if (fieldOrder == src.fieldOrder && precision == src.precision && gammaBasis == src.gammaBasis) {
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
 	for (int i=0; i<x[nDim-1]; i++) memcpy(((void**)v)[i], ((void**)src.v)[i], bytes);
       else 
 	memcpy(v, src.v, bytes);
+      if (precision == QUDA_HALF_PRECISION) memcpy(norm, src.norm, norm_bytes);
     } else {
       copyGenericColorSpinor(*this, src, QUDA_CPU_FIELD_LOCATION);
     }
@@ -170,25 +236,58 @@ namespace quda {
   void cpuColorSpinorField::zero() {
     if (fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) memset(v, '\0', bytes);
     else for (int i=0; i<x[nDim-1]; i++) memset(((void**)v)[i], '\0', bytes/x[nDim-1]);
+    if (precision == QUDA_HALF_PRECISION) memset(norm, '\0', norm_bytes);
+  }
+
+  // The generic accessors need addressable elements, so half
+  // precision fields are handled through a single precision copy
+  static cpuColorSpinorField* singleCopy(const cpuColorSpinorField &a) {
+    ColorSpinorParam param(a);
+    param.precision = QUDA_SINGLE_PRECISION;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    cpuColorSpinorField *b = new cpuColorSpinorField(param);
+    b->copy(a);
+    return b;
   }
 
   void cpuColorSpinorField::Source(QudaSourceType source_type, int x, int s, int c) {
-    genericSource(*this, source_type, x, s, c);
+    if (precision == QUDA_HALF_PRECISION) {
+      cpuColorSpinorField *tmp = singleCopy(*this);
+      tmp->Source(source_type, x, s, c);
+      copy(*tmp);
+      delete tmp;
+    } else {
+      genericSource(*this, source_type, x, s, c);
+    }
   }
 
   int cpuColorSpinorField::Compare(const cpuColorSpinorField &a, const cpuColorSpinorField &b, 
 				   const int tol) {    
     checkField(a,b);
+    if (a.Precision() == QUDA_HALF_PRECISION || b.Precision() == QUDA_HALF_PRECISION) {
+      cpuColorSpinorField *A = a.Precision() == QUDA_HALF_PRECISION ? singleCopy(a) : 0;
+      cpuColorSpinorField *B = b.Precision() == QUDA_HALF_PRECISION ? singleCopy(b) : 0;
+      int ret = genericCompare(A ? *A : a, B ? *B : b, tol);
+      if (A) delete A;
+      if (B) delete B;
+      return ret;
+    }
     return genericCompare(a, b, tol);
   }
 
   // print out the vector at volume point x
-  void cpuColorSpinorField::PrintVector(unsigned int x) { genericPrintVector(*this, x); }
+  void cpuColorSpinorField::PrintVector(unsigned int x) {
+    if (precision == QUDA_HALF_PRECISION) {
+      cpuColorSpinorField *tmp = singleCopy(*this);
+      genericPrintVector(*tmp, x);
+      delete tmp;
+    } else {
+      genericPrintVector(*this, x);
+    }
+  }
 
   void cpuColorSpinorField::allocateGhostBuffer(void)
   {
-    if (initGhostFaceBuffer) return;
-
     if (this->siteSubset == QUDA_FULL_SITE_SUBSET){
       errorQuda("Full spinor is not supported in alllocateGhostBuffer\n");
     }
@@ -208,6 +307,16 @@ namespace quda {
     if(this->nSpin == 1) num_faces = 3; // staggered
 
     int spinor_size = 2*this->nSpin*this->nColor*this->precision;
+
+    // the buffers are shared by all fields, so only reallocate if
+    // this field needs more space than the existing allocation
+    bool resize = !initGhostFaceBuffer;
+    for (int i=0; i<4; i++) 
+      if ((size_t)num_faces*Vsh[i]*spinor_size > ghostFaceBytes[i]) resize = true;
+    if (!resize) return;
+
+    freeGhostBuffer();
+
     for (int i=0; i<4; i++) {
       size_t nbytes = num_faces*Vsh[i]*spinor_size;
 
@@ -215,6 +324,7 @@ namespace quda {
       backGhostFaceBuffer[i] = safe_malloc(nbytes);
       fwdGhostFaceSendBuffer[i] = safe_malloc(nbytes);
       backGhostFaceSendBuffer[i] = safe_malloc(nbytes);
+      ghostFaceBytes[i] = nbytes;
     }
     initGhostFaceBuffer = 1;
   }
@@ -229,6 +339,7 @@ namespace quda {
       host_free(backGhostFaceBuffer[i]); backGhostFaceBuffer[i] = NULL;
       host_free(fwdGhostFaceSendBuffer[i]); fwdGhostFaceSendBuffer[i] = NULL;
       host_free(backGhostFaceSendBuffer[i]);  backGhostFaceSendBuffer[i] = NULL;
+      ghostFaceBytes[i] = 0;
     } 
     initGhostFaceBuffer = 0;
   }
@@ -241,10 +352,12 @@ namespace quda {
       errorQuda("Full spinor is not supported in packGhost for cpu");
     }
   
-    if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
+    if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER || fieldOrder == QUDA_AOSOA_FIELD_ORDER) {
       errorQuda("Field order %d not supported", fieldOrder);
     }
 
+    if (precision == QUDA_HALF_PRECISION) errorQuda("Half precision not supported in packGhost for cpu");
+
     int num_faces=1;
     if(this->nSpin == 1){ //staggered
       num_faces=3;
@@ -257,6 +370,10 @@ namespace quda {
     int X4 = this->x[3];
     int X5 = this->nDim == 5 ? this->x[4]: 1;
 
+    // the fifth dimension of a domain wall field is checkerboarded,
+    // whereas the two flavors of a twisted mass doublet are both 4-d
+    // fields of the given parity
+    bool doublet = (twistFlavor == QUDA_TWIST_NONDEG_DOUBLET || twistFlavor == QUDA_TWIST_DEG_DOUBLET);
 
     for(int i=0;i < this->volume;i++){ 
     
@@ -271,7 +388,7 @@ namespace quda {
       int x3 = zb - zc*X3;
       int x5 = zc / X4; //this->nDim == 5 ? zz / X4 : 0;
       int x4 = zc - x5*X4;
-      int x1odd = (x2 + x3 + x4 + x5 + oddBit) & 1;
+      int x1odd = (x2 + x3 + x4 + (doublet ? 0 : x5) + oddBit) & 1;
       int x1 = 2*x1h + x1odd;
 
       int ghost_face_idx ;
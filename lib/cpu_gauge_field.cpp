@@ -3,6 +3,7 @@
 #include <face_quda.h>
 #include <assert.h>
 #include <string.h>
+#include <typeinfo>
 
 namespace quda {
 
@@ -15,14 +16,25 @@ namespace quda {
     if (pad != 0) {
       errorQuda("CPU fields do not support non-zero padding");
     }
-    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_10) {
+    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_10 &&
+	reconstruct != QUDA_RECONSTRUCT_12 && reconstruct != QUDA_RECONSTRUCT_8 &&
+	reconstruct != QUDA_RECONSTRUCT_13 && reconstruct != QUDA_RECONSTRUCT_9) {
       errorQuda("Reconstruction type %d not supported", reconstruct);
     }
     if (reconstruct == QUDA_RECONSTRUCT_10 && order != QUDA_MILC_GAUGE_ORDER) {
       errorQuda("10-reconstruction only supported with MILC gauge order");
     }
+    // compressed links are packed and unpacked by QDPOrder and AoSoAOrder (gauge_field_order.h)
+    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_10 &&
+	order != QUDA_QDP_GAUGE_ORDER && order != QUDA_AOSOA_GAUGE_ORDER) {
+      errorQuda("%d-reconstruction only supported with QDP and AoSoA gauge orders", reconstruct);
+    }
+    // site blocks may not straddle the parities
+    if (order == QUDA_AOSOA_GAUGE_ORDER && (volume/2) % QUDA_AOSOA_BLOCK != 0) {
+      errorQuda("Checkerboard volume must be a multiple of %d for gauge order %d", QUDA_AOSOA_BLOCK, order);
+    }
 
-    if (order == QUDA_QDP_GAUGE_ORDER) {
+    if (order == QUDA_QDP_GAUGE_ORDER || order == QUDA_AOSOA_GAUGE_ORDER) {
 
       gauge = (void**) safe_malloc(nDim * sizeof(void*));
 
@@ -77,7 +89,7 @@ namespace quda {
   cpuGaugeField::~cpuGaugeField()
   {
     if (create == QUDA_NULL_FIELD_CREATE || create == QUDA_ZERO_FIELD_CREATE) {
-      if (order == QUDA_QDP_GAUGE_ORDER) {
+      if (order == QUDA_QDP_GAUGE_ORDER || order == QUDA_AOSOA_GAUGE_ORDER) {
 	for (int d=0; d<nDim; d++) {
 	  if (gauge[d]) host_free(gauge[d]);
 	}
@@ -86,7 +98,7 @@ namespace quda {
 	if (gauge) host_free(gauge);
       }
     } else { // QUDA_REFERENCE_FIELD_CREATE 
-      if (order == QUDA_QDP_GAUGE_ORDER){
+      if (order == QUDA_QDP_GAUGE_ORDER || order == QUDA_AOSOA_GAUGE_ORDER) {
 	if (gauge) host_free(gauge);
       }
     }
@@ -118,6 +130,21 @@ namespace quda {
     ghostExchange = true;
   }
 
+  void cpuGaugeField::copy(const GaugeField &src) {
+    checkField(src);
+
+    if (typeid(src) == typeid(cpuGaugeField)) {
+      copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION, gauge, 
+		       static_cast<const cpuGaugeField&>(src).gauge);
+    } else {
+      errorQuda("Invalid gauge field type");
+    }
+
+    // the ghost zone must be recomputed from the new links
+    ghostExchange = false;
+    exchangeGhost();
+  }
+
   void cpuGaugeField::setGauge(void **gauge_)
   {
     if(create != QUDA_REFERENCE_FIELD_CREATE) {
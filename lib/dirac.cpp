@@ -11,7 +11,8 @@ namespace quda {
 
   Dirac::Dirac(const DiracParam &param) 
     : gauge(*(param.gauge)), kappa(param.kappa), mass(param.mass), matpcType(param.matpcType), 
-      dagger(param.dagger), flops(0), tmp1(param.tmp1), tmp2(param.tmp2), tune(QUDA_TUNE_NO),
+      dagger(param.dagger), flops(0), tmp1(param.tmp1), tmp2(param.tmp2),
+      hostGauge(param.hostGauge), hostTmp1(0), hostTmp2(0), tune(QUDA_TUNE_NO),
       profile("Dirac")
   {
     for (int i=0; i<4; i++) commDim[i] = param.commDim[i];
@@ -22,7 +23,8 @@ namespace quda {
 
   Dirac::Dirac(const Dirac &dirac) 
     : gauge(dirac.gauge), kappa(dirac.kappa), matpcType(dirac.matpcType), 
-      dagger(dirac.dagger), flops(0), tmp1(dirac.tmp1), tmp2(dirac.tmp2), tune(QUDA_TUNE_NO),
+      dagger(dirac.dagger), flops(0), tmp1(dirac.tmp1), tmp2(dirac.tmp2),
+      hostGauge(dirac.hostGauge), hostTmp1(0), hostTmp2(0), tune(QUDA_TUNE_NO),
       profile("Dirac")
   {
     for (int i=0; i<4; i++) commDim[i] = dirac.commDim[i];
@@ -45,6 +47,7 @@ namespace quda {
       flops = 0;
       tmp1 = dirac.tmp1;
       tmp2 = dirac.tmp2;
+      hostGauge = dirac.hostGauge;
       tune = dirac.tune;
 
       for (int i=0; i<4; i++) commDim[i] = dirac.commDim[i];
@@ -69,6 +72,36 @@ namespace quda {
     }
   }
 
+  bool Dirac::newTmp(cpuColorSpinorField **tmp, const cpuColorSpinorField &a) const {
+    if (*tmp) return false;
+    ColorSpinorParam param(a);
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    *tmp = new cpuColorSpinorField(param);
+    return true;
+  }
+
+  void Dirac::deleteTmp(cpuColorSpinorField **a, const bool &reset) const {
+    if (reset) {
+      delete *a;
+      *a = NULL;
+    }
+  }
+
+  cpuColorSpinorField** Dirac::newTmpBlock(cpuColorSpinorField **a, const int nRhs) const {
+    cpuColorSpinorField **tmp = new cpuColorSpinorField*[nRhs];
+    for (int r=0; r<nRhs; r++) {
+      ColorSpinorParam param(*a[r]);
+      param.create = QUDA_ZERO_FIELD_CREATE;
+      tmp[r] = new cpuColorSpinorField(param);
+    }
+    return tmp;
+  }
+
+  void Dirac::deleteTmpBlock(cpuColorSpinorField **a, const int nRhs) const {
+    for (int r=0; r<nRhs; r++) delete a[r];
+    delete []a;
+  }
+
 #define flip(x) (x) = ((x) == QUDA_DAG_YES ? QUDA_DAG_NO : QUDA_DAG_YES)
 
   void Dirac::Mdag(cudaColorSpinorField &out, const cudaColorSpinorField &in) const
@@ -78,6 +111,20 @@ namespace quda {
     flip(dagger);
   }
 
+  void Dirac::Mdag(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    flip(dagger);
+    M(out, in);
+    flip(dagger);
+  }
+
+  void Dirac::Mdag(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    flip(dagger);
+    M(out, in, nRhs);
+    flip(dagger);
+  }
+
 #undef flip
 
   void Dirac::checkParitySpinor(const cudaColorSpinorField &out, const cudaColorSpinorField &in) const
@@ -129,6 +176,110 @@ namespace quda {
     if (a.V() == b.V()) errorQuda("Aliasing pointers");
   }
 
+  void Dirac::checkParitySpinor(const cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    if (!hostGauge) errorQuda("Host Dirac operator requires a host gauge field");
+
+    if (in.Precision() != out.Precision() || in.Precision() != hostGauge->Precision()) {
+      errorQuda("Precisions don't match in host dslash: out = %d, in = %d, gauge = %d",
+		out.Precision(), in.Precision(), hostGauge->Precision());
+    }
+
+    if (in.SiteSubset() != QUDA_PARITY_SITE_SUBSET || out.SiteSubset() != QUDA_PARITY_SITE_SUBSET) {
+      errorQuda("ColorSpinorFields are not single parity: in = %d, out = %d", 
+		in.SiteSubset(), out.SiteSubset());
+    }
+
+    if (out.Ndim() != 5 && out.Volume() != hostGauge->VolumeCB()) {
+      errorQuda("Spinor volume %d doesn't match gauge volume %d", out.Volume(), hostGauge->VolumeCB());
+    }
+  }
+
+  void Dirac::checkFullSpinor(const cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    if (in.SiteSubset() != QUDA_FULL_SITE_SUBSET || out.SiteSubset() != QUDA_FULL_SITE_SUBSET) {
+      errorQuda("ColorSpinorFields are not full fields: in = %d, out = %d", 
+		in.SiteSubset(), out.SiteSubset());
+    } 
+  }
+
+  void Dirac::checkSpinorAlias(const cpuColorSpinorField &a, const cpuColorSpinorField &b) const {
+    if (a.V() == b.V()) errorQuda("Aliasing pointers");
+  }
+
+  // the host operator is opt-in per Dirac type
+  void Dirac::Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+		     const QudaParity parity) const
+  {
+    errorQuda("Host Dslash not implemented for %s", typeid(*this).name());
+  }
+
+  void Dirac::DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			 const QudaParity parity, const cpuColorSpinorField &x,
+			 const double &k) const
+  {
+    errorQuda("Host DslashXpay not implemented for %s", typeid(*this).name());
+  }
+
+  void Dirac::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    errorQuda("Host M not implemented for %s", typeid(*this).name());
+  }
+
+  void Dirac::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    errorQuda("Host MdagM not implemented for %s", typeid(*this).name());
+  }
+
+  void Dirac::checkParityBlock(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    if (nRhs < 1) errorQuda("Invalid number of right-hand sides %d", nRhs);
+    for (int r=0; r<nRhs; r++) {
+      checkParitySpinor(*out[r], *in[r]);
+      checkSpinorAlias(*in[r], *out[r]);
+    }
+  }
+
+  // operators without a block kernel apply the dslash field by field
+  void Dirac::Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+		     const QudaParity parity) const
+  {
+    for (int r=0; r<nRhs; r++) Dslash(*out[r], *in[r], parity);
+  }
+
+  void Dirac::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			 const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    for (int r=0; r<nRhs; r++) DslashXpay(*out[r], *in[r], parity, *x[r], k);
+  }
+
+  void Dirac::M(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    for (int r=0; r<nRhs; r++) M(*out[r], *in[r]);
+  }
+
+  void Dirac::MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    for (int r=0; r<nRhs; r++) MdagM(*out[r], *in[r]);
+  }
+
+  void DiracMatrix::operator()(ColorSpinorField **out, ColorSpinorField **in, const int nRhs) const
+  {
+    if (in[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
+      for (int r=0; r<nRhs; r++) (*this)(*out[r], *in[r]);
+    } else {
+      cpuColorSpinorField **out_h = new cpuColorSpinorField*[nRhs];
+      cpuColorSpinorField **in_h = new cpuColorSpinorField*[nRhs];
+      for (int r=0; r<nRhs; r++) {
+	out_h[r] = &Cpu(*out[r]);
+	in_h[r] = &Cpu(*in[r]);
+      }
+      (*this)(out_h, in_h, nRhs);
+      delete []in_h;
+      delete []out_h;
+    }
+  }
+
   // Dirac operator factory
   Dirac* Dirac::create(const DiracParam &param)
   {
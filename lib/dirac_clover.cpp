@@ -1,17 +1,18 @@
 #include <iostream>
 #include <dirac_quda.h>
+#include <dslash_quda.h>
 #include <blas_quda.h>
 
 namespace quda {
 
   DiracClover::DiracClover(const DiracParam &param)
-    : DiracWilson(param), clover(*(param.clover))
+    : DiracWilson(param), clover(*(param.clover)), hostClover(param.hostClover)
   {
     initCloverConstants(clover, profile);
   }
 
   DiracClover::DiracClover(const DiracClover &dirac) 
-    : DiracWilson(dirac), clover(dirac.clover)
+    : DiracWilson(dirac), clover(dirac.clover), hostClover(dirac.hostClover)
   {
     initCloverConstants(clover, profile);
   }
@@ -23,6 +24,7 @@ namespace quda {
     if (&dirac != this) {
       DiracWilson::operator=(dirac);
       clover = dirac.clover;
+      hostClover = dirac.hostClover;
     }
     return *this;
   }
@@ -37,6 +39,17 @@ namespace quda {
     }
   }
 
+  void DiracClover::checkParitySpinor(const cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    Dirac::checkParitySpinor(out, in);
+
+    if (!hostClover) errorQuda("Host clover field not set");
+    if (out.Volume() != hostClover->VolumeCB()) {
+      errorQuda("Parity spinor volume %d doesn't match clover checkboard volume %d",
+		out.Volume(), hostClover->VolumeCB());
+    }
+  }
+
   /** Applies the operator (A + k D) */
   void DiracClover::DslashXpay(cudaColorSpinorField &out, const cudaColorSpinorField &in, 
 			       const QudaParity parity, const cudaColorSpinorField &x,
@@ -87,6 +100,57 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracClover::DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			       const QudaParity parity, const cpuColorSpinorField &x,
+			       const double &k) const
+  {
+    checkParitySpinor(in, out);
+    checkSpinorAlias(in, out);
+
+    asymCloverDslashCpu(&out, *hostGauge, *hostClover, &in, parity, dagger, &x, k, commDim);
+
+    flops += 1872ll*in.Volume();
+  }
+
+  void DiracClover::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			       const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    asymCloverDslashCpu(out, *hostGauge, *hostClover, in, nRhs, parity, dagger, x, k, commDim);
+
+    flops += 1872ll*in[0]->Volume()*nRhs;
+  }
+
+  void DiracClover::Clover(cpuColorSpinorField &out, const cpuColorSpinorField &in, const QudaParity parity) const
+  {
+    checkParitySpinor(in, out);
+
+    cloverCpu(&out, *hostClover, &in, parity, false);
+
+    flops += 504ll*in.Volume();
+  }
+
+  void DiracClover::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+    DslashXpay(out.Odd(), in.Even(), QUDA_ODD_PARITY, in.Odd(), -kappa);
+    DslashXpay(out.Even(), in.Odd(), QUDA_EVEN_PARITY, in.Even(), -kappa);
+  }
+
+  void DiracClover::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+
+    bool reset = newTmp(&hostTmp1, in);
+    checkFullSpinor(*hostTmp1, in);
+
+    M(*hostTmp1, in);
+    Mdag(out, *hostTmp1);
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
   void DiracClover::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			    cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			    const QudaSolutionType solType) const
@@ -226,6 +290,145 @@ namespace quda {
     deleteTmp(&tmp2, reset);
   }
 
+  void DiracCloverPC::CloverInv(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+				const QudaParity parity) const
+  {
+    checkParitySpinor(in, out);
+
+    cloverCpu(&out, *hostClover, &in, parity, true);
+
+    flops += 504ll*in.Volume();
+  }
+
+  void DiracCloverPC::Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			     const QudaParity parity) const
+  {
+    checkParitySpinor(in, out);
+    checkSpinorAlias(in, out);
+
+    cloverDslashCpu(&out, *hostGauge, *hostClover, &in, parity, dagger, 0, 0.0, commDim);
+
+    flops += 1824ll*in.Volume();
+  }
+
+  void DiracCloverPC::DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+				 const QudaParity parity, const cpuColorSpinorField &x,
+				 const double &k) const
+  {
+    checkParitySpinor(in, out);
+    checkSpinorAlias(in, out);
+
+    cloverDslashCpu(&out, *hostGauge, *hostClover, &in, parity, dagger, &x, k, commDim);
+
+    flops += 1872ll*in.Volume();
+  }
+
+  void DiracCloverPC::Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			     const QudaParity parity) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    cloverDslashCpu(out, *hostGauge, *hostClover, in, nRhs, parity, dagger, 0, 0.0, commDim);
+
+    flops += 1824ll*in[0]->Volume()*nRhs;
+  }
+
+  void DiracCloverPC::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+				 const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    cloverDslashCpu(out, *hostGauge, *hostClover, in, nRhs, parity, dagger, x, k, commDim);
+
+    flops += 1872ll*in[0]->Volume()*nRhs;
+  }
+
+  // host version of the above, with the same sequence of operators
+  void DiracCloverPC::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    double kappa2 = -kappa*kappa;
+    bool reset1 = newTmp(&hostTmp1, in);
+
+    if (matpcType == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC) {
+      Dslash(*hostTmp1, in, QUDA_ODD_PARITY);
+      DiracClover::DslashXpay(out, *hostTmp1, QUDA_EVEN_PARITY, in, kappa2);
+    } else if (matpcType == QUDA_MATPC_ODD_ODD_ASYMMETRIC) {
+      Dslash(*hostTmp1, in, QUDA_EVEN_PARITY);
+      DiracClover::DslashXpay(out, *hostTmp1, QUDA_ODD_PARITY, in, kappa2);
+    } else if (!dagger) { // symmetric preconditioning
+      if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+	Dslash(*hostTmp1, in, QUDA_ODD_PARITY);
+	DslashXpay(out, *hostTmp1, QUDA_EVEN_PARITY, in, kappa2); 
+      } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+	Dslash(*hostTmp1, in, QUDA_EVEN_PARITY);
+	DslashXpay(out, *hostTmp1, QUDA_ODD_PARITY, in, kappa2); 
+      } else {
+	errorQuda("Invalid matpcType");
+      }
+    } else { // symmetric preconditioning, dagger
+      if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+	CloverInv(out, in, QUDA_EVEN_PARITY); 
+	Dslash(*hostTmp1, out, QUDA_ODD_PARITY);
+	DiracWilson::DslashXpay(out, *hostTmp1, QUDA_EVEN_PARITY, in, kappa2); 
+      } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+	CloverInv(out, in, QUDA_ODD_PARITY); 
+	Dslash(*hostTmp1, out, QUDA_EVEN_PARITY);
+	DiracWilson::DslashXpay(out, *hostTmp1, QUDA_ODD_PARITY, in, kappa2); 
+      } else {
+	errorQuda("MatPCType %d not valid for DiracCloverPC", matpcType);
+      }
+    }
+  
+    deleteTmp(&hostTmp1, reset1);
+  }
+
+  void DiracCloverPC::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    // the host dslash cannot work in place, so always use a temporary
+    bool reset = newTmp(&hostTmp2, in);
+    M(*hostTmp2, in);
+    Mdag(out, *hostTmp2);
+    deleteTmp(&hostTmp2, reset);
+  }
+
+  void DiracCloverPC::M(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    // the symmetric dagger operator applies the clover inverse first, field by field
+    if (dagger && (matpcType == QUDA_MATPC_EVEN_EVEN || matpcType == QUDA_MATPC_ODD_ODD)) {
+      Dirac::M(out, in, nRhs);
+      return;
+    }
+
+    double kappa2 = -kappa*kappa;
+    cpuColorSpinorField **tmp = newTmpBlock(in, nRhs);
+
+    if (matpcType == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC) {
+      Dslash(tmp, in, nRhs, QUDA_ODD_PARITY);
+      DiracClover::DslashXpay(out, tmp, nRhs, QUDA_EVEN_PARITY, in, kappa2);
+    } else if (matpcType == QUDA_MATPC_ODD_ODD_ASYMMETRIC) {
+      Dslash(tmp, in, nRhs, QUDA_EVEN_PARITY);
+      DiracClover::DslashXpay(out, tmp, nRhs, QUDA_ODD_PARITY, in, kappa2);
+    } else if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      Dslash(tmp, in, nRhs, QUDA_ODD_PARITY);
+      DslashXpay(out, tmp, nRhs, QUDA_EVEN_PARITY, in, kappa2); 
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      Dslash(tmp, in, nRhs, QUDA_EVEN_PARITY);
+      DslashXpay(out, tmp, nRhs, QUDA_ODD_PARITY, in, kappa2); 
+    } else {
+      errorQuda("MatPCType %d not valid for DiracCloverPC", matpcType);
+    }
+
+    deleteTmpBlock(tmp, nRhs);
+  }
+
+  void DiracCloverPC::MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    cpuColorSpinorField **tmp = newTmpBlock(in, nRhs);
+    M(tmp, in, nRhs);
+    Mdag(out, tmp, nRhs);
+    deleteTmpBlock(tmp, nRhs);
+  }
+
   void DiracCloverPC::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol, 
 			      cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			      const QudaSolutionType solType) const
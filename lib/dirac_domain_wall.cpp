@@ -1,5 +1,6 @@
 #include <iostream>
 #include <dirac_quda.h>
+#include <dslash_quda.h>
 #include <blas_quda.h>
 
 namespace quda {
@@ -79,6 +80,70 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracDomainWall::Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			       const QudaParity parity) const
+  {
+    if ( in.Ndim() != 5 || out.Ndim() != 5) errorQuda("Wrong number of dimensions\n");
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+
+    domainWallDslashCpu(&out, *hostGauge, &in, parity, dagger, 0, mass, 0.0, commDim);
+
+    long long Ls = in.X(4);
+    long long bulk = (Ls-2)*(in.Volume()/Ls);
+    long long wall = 2*in.Volume()/Ls;
+    flops += 1320LL*(long long)in.Volume() + 96LL*bulk + 120LL*wall;
+  }
+
+  void DiracDomainWall::DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+				   const QudaParity parity, const cpuColorSpinorField &x,
+				   const double &k) const
+  {
+    if ( in.Ndim() != 5 || out.Ndim() != 5) errorQuda("Wrong number of dimensions\n");
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+
+    domainWallDslashCpu(&out, *hostGauge, &in, parity, dagger, &x, mass, k, commDim);
+
+    long long Ls = in.X(4);
+    long long bulk = (Ls-2)*(in.Volume()/Ls);
+    long long wall = 2*in.Volume()/Ls;
+    flops += (1320LL+48LL)*(long long)in.Volume() + 96LL*bulk + 120LL*wall;
+  }
+
+  // DiracWilson's block kernel does not apply here, so go field by field
+  void DiracDomainWall::Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			       const QudaParity parity) const
+  {
+    Dirac::Dslash(out, in, nRhs, parity);
+  }
+
+  void DiracDomainWall::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+				   const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    Dirac::DslashXpay(out, in, nRhs, parity, x, k);
+  }
+
+  void DiracDomainWall::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+    DslashXpay(out.Odd(), in.Even(), QUDA_ODD_PARITY, in.Odd(), -kappa5);
+    DslashXpay(out.Even(), in.Odd(), QUDA_EVEN_PARITY, in.Even(), -kappa5);
+  }
+
+  void DiracDomainWall::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+
+    bool reset = newTmp(&hostTmp1, in);
+    checkFullSpinor(*hostTmp1, in);
+
+    M(*hostTmp1, in);
+    Mdag(out, *hostTmp1);
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
   void DiracDomainWall::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 				cudaColorSpinorField &x, cudaColorSpinorField &b, 
 				const QudaSolutionType solType) const
@@ -157,6 +222,35 @@ namespace quda {
 #endif
   }
 
+  void DiracDomainWallPC::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    if ( in.Ndim() != 5 || out.Ndim() != 5) errorQuda("Wrong number of dimensions\n");
+    double kappa2 = -kappa5*kappa5;
+
+    bool reset = newTmp(&hostTmp1, in);
+
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      Dslash(*hostTmp1, in, QUDA_ODD_PARITY);
+      DslashXpay(out, *hostTmp1, QUDA_EVEN_PARITY, in, kappa2); 
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      Dslash(*hostTmp1, in, QUDA_EVEN_PARITY);
+      DslashXpay(out, *hostTmp1, QUDA_ODD_PARITY, in, kappa2); 
+    } else {
+      errorQuda("MatPCType %d not valid for DiracDomainWallPC", matpcType);
+    }
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
+  void DiracDomainWallPC::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    // the host dslash cannot work in place, so always use a temporary
+    bool reset = newTmp(&hostTmp2, in);
+    M(*hostTmp2, in);
+    Mdag(out, *hostTmp2);
+    deleteTmp(&hostTmp2, reset);
+  }
+
   void DiracDomainWallPC::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 				  cudaColorSpinorField &x, cudaColorSpinorField &b, 
 				  const QudaSolutionType solType) const
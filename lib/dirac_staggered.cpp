@@ -1,10 +1,12 @@
 #include <dirac_quda.h>
 #include <blas_quda.h>
+#include <dslash_quda.h>
 
 namespace quda {
 
   DiracStaggered::DiracStaggered(const DiracParam &param) : 
     Dirac(param), fatGauge(*(param.fatGauge)), longGauge(*(param.longGauge)), 
+    hostFatGauge(param.hostFatGauge), hostLongGauge(param.hostLongGauge),
     face(param.fatGauge->X(), 4, 6, 3, param.fatGauge->Precision()) 
     //FIXME: this may break mixed precision multishift solver since may not have fatGauge initializeed yet
   {
@@ -12,7 +14,9 @@ namespace quda {
   }
 
   DiracStaggered::DiracStaggered(const DiracStaggered &dirac) : Dirac(dirac),
-								fatGauge(dirac.fatGauge), longGauge(dirac.longGauge), face(dirac.face)
+								fatGauge(dirac.fatGauge), longGauge(dirac.longGauge),
+								hostFatGauge(dirac.hostFatGauge), hostLongGauge(dirac.hostLongGauge),
+								face(dirac.face)
   {
     initStaggeredConstants(fatGauge, longGauge, profile);
   }
@@ -25,6 +29,8 @@ namespace quda {
       Dirac::operator=(dirac);
       fatGauge = dirac.fatGauge;
       longGauge = dirac.longGauge;
+      hostFatGauge = dirac.hostFatGauge;
+      hostLongGauge = dirac.hostLongGauge;
       face = dirac.face;
     }
     return *this;
@@ -109,6 +115,92 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracStaggered::checkParitySpinor(const cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    if (!hostFatGauge || !hostLongGauge) errorQuda("Host staggered operator requires host fat and long links");
+
+    if (in.Precision() != out.Precision() || in.Precision() != hostFatGauge->Precision()) {
+      errorQuda("Precisions don't match in host dslash: out = %d, in = %d, gauge = %d",
+		out.Precision(), in.Precision(), hostFatGauge->Precision());
+    }
+
+    if (in.SiteSubset() != QUDA_PARITY_SITE_SUBSET || out.SiteSubset() != QUDA_PARITY_SITE_SUBSET) {
+      errorQuda("ColorSpinorFields are not single parity, in = %d, out = %d", 
+		in.SiteSubset(), out.SiteSubset());
+    }
+
+    if (out.Volume() != hostFatGauge->VolumeCB()) {
+      errorQuda("Spinor volume %d doesn't match gauge volume %d", out.Volume(), hostFatGauge->VolumeCB());
+    }
+  }
+
+  void DiracStaggered::Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			      const QudaParity parity) const
+  {
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+
+    staggeredDslashCpu(&out, *hostFatGauge, *hostLongGauge, &in, parity, dagger, 0, 0.0, commDim);
+  
+    flops += 1146ll*in.Volume();
+  }
+
+  void DiracStaggered::DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+				  const QudaParity parity, const cpuColorSpinorField &x,
+				  const double &k) const
+  {    
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+
+    staggeredDslashCpu(&out, *hostFatGauge, *hostLongGauge, &in, parity, dagger, &x, k, commDim);
+  
+    flops += 1158ll*in.Volume();
+  }
+
+  void DiracStaggered::Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			      const QudaParity parity) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    staggeredDslashCpu(out, *hostFatGauge, *hostLongGauge, in, nRhs, parity, dagger, 0, 0.0, commDim);
+
+    flops += 1146ll*in[0]->Volume()*nRhs;
+  }
+
+  void DiracStaggered::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+				  const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    staggeredDslashCpu(out, *hostFatGauge, *hostLongGauge, in, nRhs, parity, dagger, x, k, commDim);
+
+    flops += 1158ll*in[0]->Volume()*nRhs;
+  }
+
+  void DiracStaggered::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+    DslashXpay(out.Even(), in.Odd(), QUDA_EVEN_PARITY, in.Even(), 2*mass);  
+    DslashXpay(out.Odd(), in.Even(), QUDA_ODD_PARITY, in.Odd(), 2*mass);
+  }
+
+  void DiracStaggered::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+
+    bool reset = newTmp(&hostTmp1, in.Even());
+
+    //even
+    Dslash(*hostTmp1, in.Even(), QUDA_ODD_PARITY);  
+    DslashXpay(out.Even(), *hostTmp1, QUDA_EVEN_PARITY, in.Even(), 4*mass*mass);
+  
+    //odd
+    Dslash(*hostTmp1, in.Odd(), QUDA_EVEN_PARITY);  
+    DslashXpay(out.Odd(), *hostTmp1, QUDA_ODD_PARITY, in.Odd(), 4*mass*mass);    
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
   void DiracStaggered::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			       cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			       const QudaSolutionType solType) const
@@ -180,6 +272,52 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracStaggeredPC::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    errorQuda("DiracStaggeredPC::M() is not implemented\n");
+  }
+
+  void DiracStaggeredPC::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    bool reset = newTmp(&hostTmp1, in);
+  
+    QudaParity parity = QUDA_INVALID_PARITY;
+    QudaParity other_parity = QUDA_INVALID_PARITY;
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      parity = QUDA_EVEN_PARITY;
+      other_parity = QUDA_ODD_PARITY;
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      parity = QUDA_ODD_PARITY;
+      other_parity = QUDA_EVEN_PARITY;
+    } else {
+      errorQuda("Invalid matpcType(%d) in function\n", matpcType);    
+    }
+    Dslash(*hostTmp1, in, other_parity);  
+    DslashXpay(out, *hostTmp1, parity, in, 4*mass*mass);
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
+  void DiracStaggeredPC::MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    QudaParity parity = QUDA_INVALID_PARITY;
+    QudaParity other_parity = QUDA_INVALID_PARITY;
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      parity = QUDA_EVEN_PARITY;
+      other_parity = QUDA_ODD_PARITY;
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      parity = QUDA_ODD_PARITY;
+      other_parity = QUDA_EVEN_PARITY;
+    } else {
+      errorQuda("Invalid matpcType(%d) in function\n", matpcType);    
+    }
+
+    cpuColorSpinorField **tmp = newTmpBlock(in, nRhs);
+    Dslash(tmp, in, nRhs, other_parity);  
+    DslashXpay(out, tmp, nRhs, parity, in, 4*mass*mass);
+    deleteTmpBlock(tmp, nRhs);
+  }
+
   void DiracStaggeredPC::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 				 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 				 const QudaSolutionType solType) const
@@ -1,4 +1,5 @@
 #include <dirac_quda.h>
+#include <dslash_quda.h>
 #include <blas_quda.h>
 #include <iostream>
 
@@ -112,6 +113,60 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  // Twist coefficients for the host dslash, which applies c (1 + i a gamma_5 tau_3 + b tau_1)
+  void DiracTwistedMass::hostTwist(double &a, double &b, double &c, const cpuColorSpinorField &in,
+				   const QudaTwistGamma5Type twistType) const
+  {
+    if (in.TwistFlavor() == QUDA_TWIST_PLUS || in.TwistFlavor() == QUDA_TWIST_MINUS) {
+      a = 2.0 * kappa * in.TwistFlavor() * mu;
+      b = 0.0;
+    } else if (in.TwistFlavor() == QUDA_TWIST_NONDEG_DOUBLET) {
+      a = 2.0 * kappa * mu;
+      b = -2.0 * kappa * epsilon;
+    } else {
+      errorQuda("Twist flavor not set %d\n", in.TwistFlavor());
+    }
+
+    if (twistType == QUDA_TWIST_GAMMA5_INVERSE) {
+      a = -a;
+      b = -b;
+      c = 1.0 / (1.0 + a*a - b*b);
+    } else {
+      c = 1.0;
+    }
+  }
+
+  void DiracTwistedMass::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+    if (in.TwistFlavor() != out.TwistFlavor()) 
+      errorQuda("Twist flavors %d %d don't match", in.TwistFlavor(), out.TwistFlavor());
+
+    double a, b, c;
+    hostTwist(a, b, c, in, QUDA_TWIST_GAMMA5_DIRECT);
+
+    // out = T in + (-kappa) D in, with the twist fused into the dslash
+    twistedMassDslashCpu(&out.Odd(), *hostGauge, &in.Even(), QUDA_ODD_PARITY, dagger, &in.Odd(),
+			 QUDA_DEG_DSLASH_TWIST_XPAY, a, b, c, -kappa, commDim);
+    twistedMassDslashCpu(&out.Even(), *hostGauge, &in.Odd(), QUDA_EVEN_PARITY, dagger, &in.Even(),
+			 QUDA_DEG_DSLASH_TWIST_XPAY, a, b, c, -kappa, commDim);
+
+    if (in.TwistFlavor() == QUDA_TWIST_NONDEG_DOUBLET) flops += (1320ll+72ll+24ll)*in.Volume();
+    else flops += (1320ll+72ll)*in.Volume();
+  }
+
+  void DiracTwistedMass::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+    bool reset = newTmp(&hostTmp1, in);
+    checkFullSpinor(*hostTmp1, in);
+
+    M(*hostTmp1, in);
+    Mdag(out, *hostTmp1);
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
   void DiracTwistedMass::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 				 cudaColorSpinorField &x, cudaColorSpinorField &b, 
 				 const QudaSolutionType solType) const
@@ -310,6 +365,103 @@ namespace quda {
     deleteTmp(&tmp2, reset);
   }
 
+  // Host versions: the inverse twist (including the flavor mixing of
+  // the doublet) is applied inside the dslash rather than as a
+  // separate pass, to the output or, for the symmetric dagger, to the
+  // input as it is loaded.
+  void DiracTwistedMassPC::Dslash
+  (cpuColorSpinorField &out, const cpuColorSpinorField &in, const QudaParity parity) const
+  {
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+    if (in.TwistFlavor() != out.TwistFlavor()) 
+      errorQuda("Twist flavors %d %d don't match", in.TwistFlavor(), out.TwistFlavor());
+
+    double a, b, c;
+    hostTwist(a, b, c, in, QUDA_TWIST_GAMMA5_INVERSE);
+
+    bool asymmetric = (matpcType == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC || matpcType == QUDA_MATPC_ODD_ODD_ASYMMETRIC);
+    QudaTwistDslashType type = (!dagger || asymmetric) ? QUDA_DEG_DSLASH_TWIST_INV : QUDA_DEG_TWIST_INV_DSLASH;
+    twistedMassDslashCpu(&out, *hostGauge, &in, parity, dagger, 0, type, a, b, c, 0.0, commDim);
+
+    if (in.TwistFlavor() == QUDA_TWIST_NONDEG_DOUBLET) flops += 1440ll*in.Volume();
+    else flops += 1392ll*in.Volume();
+  }
+
+  void DiracTwistedMassPC::DslashXpay
+  (cpuColorSpinorField &out, const cpuColorSpinorField &in, const QudaParity parity, 
+   const cpuColorSpinorField &x, const double &k) const
+  {
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+    if (in.TwistFlavor() != out.TwistFlavor()) 
+      errorQuda("Twist flavors %d %d don't match", in.TwistFlavor(), out.TwistFlavor());
+
+    double a, b, c;
+    hostTwist(a, b, c, in, QUDA_TWIST_GAMMA5_INVERSE);
+
+    bool asymmetric = (matpcType == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC || matpcType == QUDA_MATPC_ODD_ODD_ASYMMETRIC);
+    QudaTwistDslashType type = (!dagger || asymmetric) ? QUDA_DEG_DSLASH_TWIST_INV : QUDA_DEG_TWIST_INV_DSLASH;
+    twistedMassDslashCpu(&out, *hostGauge, &in, parity, dagger, &x, type, a, b, c, k, commDim);
+
+    if (in.TwistFlavor() == QUDA_TWIST_NONDEG_DOUBLET) flops += 1464ll*in.Volume();
+    else flops += 1416ll*in.Volume();
+  }
+
+  // DiracWilson's block kernel does not apply here, so go field by field
+  void DiracTwistedMassPC::Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+				  const QudaParity parity) const
+  {
+    Dirac::Dslash(out, in, nRhs, parity);
+  }
+
+  void DiracTwistedMassPC::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+				      const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    Dirac::DslashXpay(out, in, nRhs, parity, x, k);
+  }
+
+  void DiracTwistedMassPC::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    double kappa2 = -kappa*kappa;
+
+    bool reset = newTmp(&hostTmp1, in);
+
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      Dslash(*hostTmp1, in, QUDA_ODD_PARITY);
+      DslashXpay(out, *hostTmp1, QUDA_EVEN_PARITY, in, kappa2); 
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      Dslash(*hostTmp1, in, QUDA_EVEN_PARITY);
+      DslashXpay(out, *hostTmp1, QUDA_ODD_PARITY, in, kappa2); 
+    } else if (matpcType == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC || matpcType == QUDA_MATPC_ODD_ODD_ASYMMETRIC) {
+      // out = T in + kappa2 D T^-1 D in
+      QudaParity parity = (matpcType == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC) ? QUDA_EVEN_PARITY : QUDA_ODD_PARITY;
+      QudaParity other = (parity == QUDA_EVEN_PARITY) ? QUDA_ODD_PARITY : QUDA_EVEN_PARITY;
+      double a, b, c;
+      hostTwist(a, b, c, in, QUDA_TWIST_GAMMA5_DIRECT);
+
+      Dslash(*hostTmp1, in, other);
+      twistedMassDslashCpu(&out, *hostGauge, hostTmp1, parity, dagger, &in,
+			   QUDA_DEG_DSLASH_TWIST_XPAY, a, b, c, kappa2, commDim);
+
+      if (in.TwistFlavor() == QUDA_TWIST_NONDEG_DOUBLET) flops += 1464ll*in.Volume();
+      else flops += (1320ll+96ll)*in.Volume();
+    } else {
+      errorQuda("MatPCType %d not valid for DiracTwistedMassPC", matpcType);
+    }
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
+  void DiracTwistedMassPC::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    // need extra temporary because of symmetric preconditioning dagger
+    bool reset = newTmp(&hostTmp2, in);
+    M(*hostTmp2, in);
+    Mdag(out, *hostTmp2);
+    deleteTmp(&hostTmp2, reset);
+  }
+
   void DiracTwistedMassPC::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 				   cudaColorSpinorField &x, cudaColorSpinorField &b, 
 				   const QudaSolutionType solType) const
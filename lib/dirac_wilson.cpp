@@ -73,6 +73,69 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracWilson::Dslash(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			   const QudaParity parity) const
+  {
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+
+    wilsonDslashCpu(&out, *hostGauge, &in, parity, dagger, 0, 0.0, commDim);
+
+    flops += 1320ll*in.Volume();
+  }
+
+  void DiracWilson::DslashXpay(cpuColorSpinorField &out, const cpuColorSpinorField &in, 
+			       const QudaParity parity, const cpuColorSpinorField &x,
+			       const double &k) const
+  {
+    checkParitySpinor(out, in);
+    checkSpinorAlias(in, out);
+
+    wilsonDslashCpu(&out, *hostGauge, &in, parity, dagger, &x, k, commDim);
+
+    flops += 1368ll*in.Volume();
+  }
+
+  void DiracWilson::Dslash(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			   const QudaParity parity) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    wilsonDslashCpu(out, *hostGauge, in, nRhs, parity, dagger, 0, 0.0, commDim);
+
+    flops += 1320ll*in[0]->Volume()*nRhs;
+  }
+
+  void DiracWilson::DslashXpay(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs,
+			       const QudaParity parity, cpuColorSpinorField **x, const double &k) const
+  {
+    checkParityBlock(out, in, nRhs);
+
+    wilsonDslashCpu(out, *hostGauge, in, nRhs, parity, dagger, x, k, commDim);
+
+    flops += 1368ll*in[0]->Volume()*nRhs;
+  }
+
+  void DiracWilson::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+    DslashXpay(out.Odd(), in.Even(), QUDA_ODD_PARITY, in.Odd(), -kappa);
+    DslashXpay(out.Even(), in.Odd(), QUDA_EVEN_PARITY, in.Even(), -kappa);
+  }
+
+  void DiracWilson::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    checkFullSpinor(out, in);
+
+    bool reset = newTmp(&hostTmp1, in);
+    checkFullSpinor(*hostTmp1, in);
+
+    M(*hostTmp1, in);
+    Mdag(out, *hostTmp1);
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
   void DiracWilson::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			    cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			    const QudaSolutionType solType) const
@@ -148,6 +211,61 @@ namespace quda {
 #endif
   }
 
+  void DiracWilsonPC::M(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    double kappa2 = -kappa*kappa;
+
+    bool reset = newTmp(&hostTmp1, in);
+
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      Dslash(*hostTmp1, in, QUDA_ODD_PARITY);
+      DslashXpay(out, *hostTmp1, QUDA_EVEN_PARITY, in, kappa2); 
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      Dslash(*hostTmp1, in, QUDA_EVEN_PARITY);
+      DslashXpay(out, *hostTmp1, QUDA_ODD_PARITY, in, kappa2); 
+    } else {
+      errorQuda("MatPCType %d not valid for DiracWilsonPC", matpcType);
+    }
+
+    deleteTmp(&hostTmp1, reset);
+  }
+
+  void DiracWilsonPC::MdagM(cpuColorSpinorField &out, const cpuColorSpinorField &in) const
+  {
+    // the host dslash cannot work in place, so always use a temporary
+    bool reset = newTmp(&hostTmp2, in);
+    M(*hostTmp2, in);
+    Mdag(out, *hostTmp2);
+    deleteTmp(&hostTmp2, reset);
+  }
+
+  void DiracWilsonPC::M(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    double kappa2 = -kappa*kappa;
+
+    cpuColorSpinorField **tmp = newTmpBlock(in, nRhs);
+
+    if (matpcType == QUDA_MATPC_EVEN_EVEN) {
+      Dslash(tmp, in, nRhs, QUDA_ODD_PARITY);
+      DslashXpay(out, tmp, nRhs, QUDA_EVEN_PARITY, in, kappa2); 
+    } else if (matpcType == QUDA_MATPC_ODD_ODD) {
+      Dslash(tmp, in, nRhs, QUDA_EVEN_PARITY);
+      DslashXpay(out, tmp, nRhs, QUDA_ODD_PARITY, in, kappa2); 
+    } else {
+      errorQuda("MatPCType %d not valid for DiracWilsonPC", matpcType);
+    }
+
+    deleteTmpBlock(tmp, nRhs);
+  }
+
+  void DiracWilsonPC::MdagM(cpuColorSpinorField **out, cpuColorSpinorField **in, const int nRhs) const
+  {
+    cpuColorSpinorField **tmp = newTmpBlock(in, nRhs);
+    M(tmp, in, nRhs);
+    Mdag(out, tmp, nRhs);
+    deleteTmpBlock(tmp, nRhs);
+  }
+
   void DiracWilsonPC::prepare(cudaColorSpinorField* &src, cudaColorSpinorField* &sol,
 			      cudaColorSpinorField &x, cudaColorSpinorField &b, 
 			      const QudaSolutionType solType) const
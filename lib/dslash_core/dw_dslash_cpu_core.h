@@ -0,0 +1,1526 @@
+// *** CPU DOMAIN WALL DSLASH ***
+
+// Body of the host kernels in dslash_cpu.cpp, in the DeGrand-Rossi basis.
+// spinorFloat is a RealVec holding one 4-d site of slice xs per lane,
+// and the READ_* and WRITE_SPINOR macros, which gather and scatter the
+// lanes, are defined there.
+
+// input (neighbor) spinor and accumulator
+#define i00_re I[0]
+#define i00_im I[1]
+#define i01_re I[2]
+#define i01_im I[3]
+#define i02_re I[4]
+#define i02_im I[5]
+#define i10_re I[6]
+#define i10_im I[7]
+#define i11_re I[8]
+#define i11_im I[9]
+#define i12_re I[10]
+#define i12_im I[11]
+#define i20_re I[12]
+#define i20_im I[13]
+#define i21_re I[14]
+#define i21_im I[15]
+#define i22_re I[16]
+#define i22_im I[17]
+#define i30_re I[18]
+#define i30_im I[19]
+#define i31_re I[20]
+#define i31_im I[21]
+#define i32_re I[22]
+#define i32_im I[23]
+#define acc00_re ACC[0]
+#define acc00_im ACC[1]
+#define acc01_re ACC[2]
+#define acc01_im ACC[3]
+#define acc02_re ACC[4]
+#define acc02_im ACC[5]
+#define acc10_re ACC[6]
+#define acc10_im ACC[7]
+#define acc11_re ACC[8]
+#define acc11_im ACC[9]
+#define acc12_re ACC[10]
+#define acc12_im ACC[11]
+#define acc20_re ACC[12]
+#define acc20_im ACC[13]
+#define acc21_re ACC[14]
+#define acc21_im ACC[15]
+#define acc22_re ACC[16]
+#define acc22_im ACC[17]
+#define acc30_re ACC[18]
+#define acc30_im ACC[19]
+#define acc31_re ACC[20]
+#define acc31_im ACC[21]
+#define acc32_re ACC[22]
+#define acc32_im ACC[23]
+
+// gauge link
+#define g00_re G[0]
+#define g00_im G[1]
+#define g01_re G[2]
+#define g01_im G[3]
+#define g02_re G[4]
+#define g02_im G[5]
+#define g10_re G[6]
+#define g10_im G[7]
+#define g11_re G[8]
+#define g11_im G[9]
+#define g12_re G[10]
+#define g12_im G[11]
+#define g20_re G[12]
+#define g20_im G[13]
+#define g21_re G[14]
+#define g21_im G[15]
+#define g22_re G[16]
+#define g22_im G[17]
+
+// conjugated gauge link
+#define gT00_re (+g00_re)
+#define gT00_im (-g00_im)
+#define gT01_re (+g10_re)
+#define gT01_im (-g10_im)
+#define gT02_re (+g20_re)
+#define gT02_im (-g20_im)
+#define gT10_re (+g01_re)
+#define gT10_im (-g01_im)
+#define gT11_re (+g11_re)
+#define gT11_im (-g11_im)
+#define gT12_re (+g21_re)
+#define gT12_im (-g21_im)
+#define gT20_re (+g02_re)
+#define gT20_im (-g02_im)
+#define gT21_re (+g12_re)
+#define gT21_im (-g12_im)
+#define gT22_re (+g22_re)
+#define gT22_im (-g22_im)
+
+// output spinor
+#define o00_re O[0]
+#define o00_im O[1]
+#define o01_re O[2]
+#define o01_im O[3]
+#define o02_re O[4]
+#define o02_im O[5]
+#define o10_re O[6]
+#define o10_im O[7]
+#define o11_re O[8]
+#define o11_im O[9]
+#define o12_re O[10]
+#define o12_im O[11]
+#define o20_re O[12]
+#define o20_im O[13]
+#define o21_re O[14]
+#define o21_im O[15]
+#define o22_re O[16]
+#define o22_im O[17]
+#define o30_re O[18]
+#define o30_im O[19]
+#define o31_re O[20]
+#define o31_im O[21]
+#define o32_re O[22]
+#define o32_im O[23]
+
+spinorFloat I[24], G[18], O[24];
+
+o00_re = 0;  o00_im = 0;
+o01_re = 0;  o01_im = 0;
+o02_re = 0;  o02_im = 0;
+o10_re = 0;  o10_im = 0;
+o11_re = 0;  o11_im = 0;
+o12_re = 0;  o12_im = 0;
+o20_re = 0;  o20_im = 0;
+o21_re = 0;  o21_im = 0;
+o22_re = 0;  o22_im = 0;
+o30_re = 0;  o30_im = 0;
+o31_re = 0;  o31_im = 0;
+o32_re = 0;  o32_im = 0;
+
+// Projector P0-
+//  1  0  0 -i
+//  0  1 -i  0
+//  0  i  1  0
+//  i  0  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 0);
+ READ_GAUGE_MATRIX(G, 0);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re+i30_im;
+ a0_im = +i00_im-i30_re;
+ a1_re = +i01_re+i31_im;
+ a1_im = +i01_im-i31_re;
+ a2_re = +i02_re+i32_im;
+ a2_im = +i02_im-i32_re;
+ b0_re = +i10_re+i20_im;
+ b0_im = +i10_im-i20_re;
+ b1_re = +i11_re+i21_im;
+ b1_im = +i11_im-i21_re;
+ b2_re = +i12_re+i22_im;
+ b2_im = +i12_im-i22_re;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += g00_re * a0_re;
+ A0_re -= g00_im * a0_im;
+ A0_re += g01_re * a1_re;
+ A0_re -= g01_im * a1_im;
+ A0_re += g02_re * a2_re;
+ A0_re -= g02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += g00_re * a0_im;
+ A0_im += g00_im * a0_re;
+ A0_im += g01_re * a1_im;
+ A0_im += g01_im * a1_re;
+ A0_im += g02_re * a2_im;
+ A0_im += g02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += g00_re * b0_re;
+ B0_re -= g00_im * b0_im;
+ B0_re += g01_re * b1_re;
+ B0_re -= g01_im * b1_im;
+ B0_re += g02_re * b2_re;
+ B0_re -= g02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += g00_re * b0_im;
+ B0_im += g00_im * b0_re;
+ B0_im += g01_re * b1_im;
+ B0_im += g01_im * b1_re;
+ B0_im += g02_re * b2_im;
+ B0_im += g02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += g10_re * a0_re;
+ A1_re -= g10_im * a0_im;
+ A1_re += g11_re * a1_re;
+ A1_re -= g11_im * a1_im;
+ A1_re += g12_re * a2_re;
+ A1_re -= g12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += g10_re * a0_im;
+ A1_im += g10_im * a0_re;
+ A1_im += g11_re * a1_im;
+ A1_im += g11_im * a1_re;
+ A1_im += g12_re * a2_im;
+ A1_im += g12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += g10_re * b0_re;
+ B1_re -= g10_im * b0_im;
+ B1_re += g11_re * b1_re;
+ B1_re -= g11_im * b1_im;
+ B1_re += g12_re * b2_re;
+ B1_re -= g12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += g10_re * b0_im;
+ B1_im += g10_im * b0_re;
+ B1_im += g11_re * b1_im;
+ B1_im += g11_im * b1_re;
+ B1_im += g12_re * b2_im;
+ B1_im += g12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += g20_re * a0_re;
+ A2_re -= g20_im * a0_im;
+ A2_re += g21_re * a1_re;
+ A2_re -= g21_im * a1_im;
+ A2_re += g22_re * a2_re;
+ A2_re -= g22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += g20_re * a0_im;
+ A2_im += g20_im * a0_re;
+ A2_im += g21_re * a1_im;
+ A2_im += g21_im * a1_re;
+ A2_im += g22_re * a2_im;
+ A2_im += g22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += g20_re * b0_re;
+ B2_re -= g20_im * b0_im;
+ B2_re += g21_re * b1_re;
+ B2_re -= g21_im * b1_im;
+ B2_re += g22_re * b2_re;
+ B2_re -= g22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += g20_re * b0_im;
+ B2_im += g20_im * b0_re;
+ B2_im += g21_re * b1_im;
+ B2_im += g21_im * b1_re;
+ B2_im += g22_re * b2_im;
+ B2_im += g22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re -= B0_im;
+ o20_im += B0_re;
+ o30_re -= A0_im;
+ o30_im += A0_re;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re -= B1_im;
+ o21_im += B1_re;
+ o31_re -= A1_im;
+ o31_im += A1_re;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re -= B2_im;
+ o22_im += B2_re;
+ o32_re -= A2_im;
+ o32_im += A2_re;
+}
+
+// Projector P0+
+//  1  0  0  i
+//  0  1  i  0
+//  0 -i  1  0
+// -i  0  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 1);
+ READ_GAUGE_MATRIX(G, 1);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re-i30_im;
+ a0_im = +i00_im+i30_re;
+ a1_re = +i01_re-i31_im;
+ a1_im = +i01_im+i31_re;
+ a2_re = +i02_re-i32_im;
+ a2_im = +i02_im+i32_re;
+ b0_re = +i10_re-i20_im;
+ b0_im = +i10_im+i20_re;
+ b1_re = +i11_re-i21_im;
+ b1_im = +i11_im+i21_re;
+ b2_re = +i12_re-i22_im;
+ b2_im = +i12_im+i22_re;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += gT00_re * a0_re;
+ A0_re -= gT00_im * a0_im;
+ A0_re += gT01_re * a1_re;
+ A0_re -= gT01_im * a1_im;
+ A0_re += gT02_re * a2_re;
+ A0_re -= gT02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += gT00_re * a0_im;
+ A0_im += gT00_im * a0_re;
+ A0_im += gT01_re * a1_im;
+ A0_im += gT01_im * a1_re;
+ A0_im += gT02_re * a2_im;
+ A0_im += gT02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += gT00_re * b0_re;
+ B0_re -= gT00_im * b0_im;
+ B0_re += gT01_re * b1_re;
+ B0_re -= gT01_im * b1_im;
+ B0_re += gT02_re * b2_re;
+ B0_re -= gT02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += gT00_re * b0_im;
+ B0_im += gT00_im * b0_re;
+ B0_im += gT01_re * b1_im;
+ B0_im += gT01_im * b1_re;
+ B0_im += gT02_re * b2_im;
+ B0_im += gT02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += gT10_re * a0_re;
+ A1_re -= gT10_im * a0_im;
+ A1_re += gT11_re * a1_re;
+ A1_re -= gT11_im * a1_im;
+ A1_re += gT12_re * a2_re;
+ A1_re -= gT12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += gT10_re * a0_im;
+ A1_im += gT10_im * a0_re;
+ A1_im += gT11_re * a1_im;
+ A1_im += gT11_im * a1_re;
+ A1_im += gT12_re * a2_im;
+ A1_im += gT12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += gT10_re * b0_re;
+ B1_re -= gT10_im * b0_im;
+ B1_re += gT11_re * b1_re;
+ B1_re -= gT11_im * b1_im;
+ B1_re += gT12_re * b2_re;
+ B1_re -= gT12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += gT10_re * b0_im;
+ B1_im += gT10_im * b0_re;
+ B1_im += gT11_re * b1_im;
+ B1_im += gT11_im * b1_re;
+ B1_im += gT12_re * b2_im;
+ B1_im += gT12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += gT20_re * a0_re;
+ A2_re -= gT20_im * a0_im;
+ A2_re += gT21_re * a1_re;
+ A2_re -= gT21_im * a1_im;
+ A2_re += gT22_re * a2_re;
+ A2_re -= gT22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += gT20_re * a0_im;
+ A2_im += gT20_im * a0_re;
+ A2_im += gT21_re * a1_im;
+ A2_im += gT21_im * a1_re;
+ A2_im += gT22_re * a2_im;
+ A2_im += gT22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += gT20_re * b0_re;
+ B2_re -= gT20_im * b0_im;
+ B2_re += gT21_re * b1_re;
+ B2_re -= gT21_im * b1_im;
+ B2_re += gT22_re * b2_re;
+ B2_re -= gT22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += gT20_re * b0_im;
+ B2_im += gT20_im * b0_re;
+ B2_im += gT21_re * b1_im;
+ B2_im += gT21_im * b1_re;
+ B2_im += gT22_re * b2_im;
+ B2_im += gT22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re += B0_im;
+ o20_im -= B0_re;
+ o30_re += A0_im;
+ o30_im -= A0_re;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re += B1_im;
+ o21_im -= B1_re;
+ o31_re += A1_im;
+ o31_im -= A1_re;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re += B2_im;
+ o22_im -= B2_re;
+ o32_re += A2_im;
+ o32_im -= A2_re;
+}
+
+// Projector P1-
+//  1  0  0  1
+//  0  1 -1  0
+//  0 -1  1  0
+//  1  0  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 2);
+ READ_GAUGE_MATRIX(G, 2);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re+i30_re;
+ a0_im = +i00_im+i30_im;
+ a1_re = +i01_re+i31_re;
+ a1_im = +i01_im+i31_im;
+ a2_re = +i02_re+i32_re;
+ a2_im = +i02_im+i32_im;
+ b0_re = +i10_re-i20_re;
+ b0_im = +i10_im-i20_im;
+ b1_re = +i11_re-i21_re;
+ b1_im = +i11_im-i21_im;
+ b2_re = +i12_re-i22_re;
+ b2_im = +i12_im-i22_im;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += g00_re * a0_re;
+ A0_re -= g00_im * a0_im;
+ A0_re += g01_re * a1_re;
+ A0_re -= g01_im * a1_im;
+ A0_re += g02_re * a2_re;
+ A0_re -= g02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += g00_re * a0_im;
+ A0_im += g00_im * a0_re;
+ A0_im += g01_re * a1_im;
+ A0_im += g01_im * a1_re;
+ A0_im += g02_re * a2_im;
+ A0_im += g02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += g00_re * b0_re;
+ B0_re -= g00_im * b0_im;
+ B0_re += g01_re * b1_re;
+ B0_re -= g01_im * b1_im;
+ B0_re += g02_re * b2_re;
+ B0_re -= g02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += g00_re * b0_im;
+ B0_im += g00_im * b0_re;
+ B0_im += g01_re * b1_im;
+ B0_im += g01_im * b1_re;
+ B0_im += g02_re * b2_im;
+ B0_im += g02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += g10_re * a0_re;
+ A1_re -= g10_im * a0_im;
+ A1_re += g11_re * a1_re;
+ A1_re -= g11_im * a1_im;
+ A1_re += g12_re * a2_re;
+ A1_re -= g12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += g10_re * a0_im;
+ A1_im += g10_im * a0_re;
+ A1_im += g11_re * a1_im;
+ A1_im += g11_im * a1_re;
+ A1_im += g12_re * a2_im;
+ A1_im += g12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += g10_re * b0_re;
+ B1_re -= g10_im * b0_im;
+ B1_re += g11_re * b1_re;
+ B1_re -= g11_im * b1_im;
+ B1_re += g12_re * b2_re;
+ B1_re -= g12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += g10_re * b0_im;
+ B1_im += g10_im * b0_re;
+ B1_im += g11_re * b1_im;
+ B1_im += g11_im * b1_re;
+ B1_im += g12_re * b2_im;
+ B1_im += g12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += g20_re * a0_re;
+ A2_re -= g20_im * a0_im;
+ A2_re += g21_re * a1_re;
+ A2_re -= g21_im * a1_im;
+ A2_re += g22_re * a2_re;
+ A2_re -= g22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += g20_re * a0_im;
+ A2_im += g20_im * a0_re;
+ A2_im += g21_re * a1_im;
+ A2_im += g21_im * a1_re;
+ A2_im += g22_re * a2_im;
+ A2_im += g22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += g20_re * b0_re;
+ B2_re -= g20_im * b0_im;
+ B2_re += g21_re * b1_re;
+ B2_re -= g21_im * b1_im;
+ B2_re += g22_re * b2_re;
+ B2_re -= g22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += g20_re * b0_im;
+ B2_im += g20_im * b0_re;
+ B2_im += g21_re * b1_im;
+ B2_im += g21_im * b1_re;
+ B2_im += g22_re * b2_im;
+ B2_im += g22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re -= B0_re;
+ o20_im -= B0_im;
+ o30_re += A0_re;
+ o30_im += A0_im;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re -= B1_re;
+ o21_im -= B1_im;
+ o31_re += A1_re;
+ o31_im += A1_im;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re -= B2_re;
+ o22_im -= B2_im;
+ o32_re += A2_re;
+ o32_im += A2_im;
+}
+
+// Projector P1+
+//  1  0  0 -1
+//  0  1  1  0
+//  0  1  1  0
+// -1  0  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 3);
+ READ_GAUGE_MATRIX(G, 3);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re-i30_re;
+ a0_im = +i00_im-i30_im;
+ a1_re = +i01_re-i31_re;
+ a1_im = +i01_im-i31_im;
+ a2_re = +i02_re-i32_re;
+ a2_im = +i02_im-i32_im;
+ b0_re = +i10_re+i20_re;
+ b0_im = +i10_im+i20_im;
+ b1_re = +i11_re+i21_re;
+ b1_im = +i11_im+i21_im;
+ b2_re = +i12_re+i22_re;
+ b2_im = +i12_im+i22_im;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += gT00_re * a0_re;
+ A0_re -= gT00_im * a0_im;
+ A0_re += gT01_re * a1_re;
+ A0_re -= gT01_im * a1_im;
+ A0_re += gT02_re * a2_re;
+ A0_re -= gT02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += gT00_re * a0_im;
+ A0_im += gT00_im * a0_re;
+ A0_im += gT01_re * a1_im;
+ A0_im += gT01_im * a1_re;
+ A0_im += gT02_re * a2_im;
+ A0_im += gT02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += gT00_re * b0_re;
+ B0_re -= gT00_im * b0_im;
+ B0_re += gT01_re * b1_re;
+ B0_re -= gT01_im * b1_im;
+ B0_re += gT02_re * b2_re;
+ B0_re -= gT02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += gT00_re * b0_im;
+ B0_im += gT00_im * b0_re;
+ B0_im += gT01_re * b1_im;
+ B0_im += gT01_im * b1_re;
+ B0_im += gT02_re * b2_im;
+ B0_im += gT02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += gT10_re * a0_re;
+ A1_re -= gT10_im * a0_im;
+ A1_re += gT11_re * a1_re;
+ A1_re -= gT11_im * a1_im;
+ A1_re += gT12_re * a2_re;
+ A1_re -= gT12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += gT10_re * a0_im;
+ A1_im += gT10_im * a0_re;
+ A1_im += gT11_re * a1_im;
+ A1_im += gT11_im * a1_re;
+ A1_im += gT12_re * a2_im;
+ A1_im += gT12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += gT10_re * b0_re;
+ B1_re -= gT10_im * b0_im;
+ B1_re += gT11_re * b1_re;
+ B1_re -= gT11_im * b1_im;
+ B1_re += gT12_re * b2_re;
+ B1_re -= gT12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += gT10_re * b0_im;
+ B1_im += gT10_im * b0_re;
+ B1_im += gT11_re * b1_im;
+ B1_im += gT11_im * b1_re;
+ B1_im += gT12_re * b2_im;
+ B1_im += gT12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += gT20_re * a0_re;
+ A2_re -= gT20_im * a0_im;
+ A2_re += gT21_re * a1_re;
+ A2_re -= gT21_im * a1_im;
+ A2_re += gT22_re * a2_re;
+ A2_re -= gT22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += gT20_re * a0_im;
+ A2_im += gT20_im * a0_re;
+ A2_im += gT21_re * a1_im;
+ A2_im += gT21_im * a1_re;
+ A2_im += gT22_re * a2_im;
+ A2_im += gT22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += gT20_re * b0_re;
+ B2_re -= gT20_im * b0_im;
+ B2_re += gT21_re * b1_re;
+ B2_re -= gT21_im * b1_im;
+ B2_re += gT22_re * b2_re;
+ B2_re -= gT22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += gT20_re * b0_im;
+ B2_im += gT20_im * b0_re;
+ B2_im += gT21_re * b1_im;
+ B2_im += gT21_im * b1_re;
+ B2_im += gT22_re * b2_im;
+ B2_im += gT22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re += B0_re;
+ o20_im += B0_im;
+ o30_re -= A0_re;
+ o30_im -= A0_im;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re += B1_re;
+ o21_im += B1_im;
+ o31_re -= A1_re;
+ o31_im -= A1_im;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re += B2_re;
+ o22_im += B2_im;
+ o32_re -= A2_re;
+ o32_im -= A2_im;
+}
+
+// Projector P2-
+//  1  0 -i  0
+//  0  1  0  i
+//  i  0  1  0
+//  0 -i  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 4);
+ READ_GAUGE_MATRIX(G, 4);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re+i20_im;
+ a0_im = +i00_im-i20_re;
+ a1_re = +i01_re+i21_im;
+ a1_im = +i01_im-i21_re;
+ a2_re = +i02_re+i22_im;
+ a2_im = +i02_im-i22_re;
+ b0_re = +i10_re-i30_im;
+ b0_im = +i10_im+i30_re;
+ b1_re = +i11_re-i31_im;
+ b1_im = +i11_im+i31_re;
+ b2_re = +i12_re-i32_im;
+ b2_im = +i12_im+i32_re;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += g00_re * a0_re;
+ A0_re -= g00_im * a0_im;
+ A0_re += g01_re * a1_re;
+ A0_re -= g01_im * a1_im;
+ A0_re += g02_re * a2_re;
+ A0_re -= g02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += g00_re * a0_im;
+ A0_im += g00_im * a0_re;
+ A0_im += g01_re * a1_im;
+ A0_im += g01_im * a1_re;
+ A0_im += g02_re * a2_im;
+ A0_im += g02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += g00_re * b0_re;
+ B0_re -= g00_im * b0_im;
+ B0_re += g01_re * b1_re;
+ B0_re -= g01_im * b1_im;
+ B0_re += g02_re * b2_re;
+ B0_re -= g02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += g00_re * b0_im;
+ B0_im += g00_im * b0_re;
+ B0_im += g01_re * b1_im;
+ B0_im += g01_im * b1_re;
+ B0_im += g02_re * b2_im;
+ B0_im += g02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += g10_re * a0_re;
+ A1_re -= g10_im * a0_im;
+ A1_re += g11_re * a1_re;
+ A1_re -= g11_im * a1_im;
+ A1_re += g12_re * a2_re;
+ A1_re -= g12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += g10_re * a0_im;
+ A1_im += g10_im * a0_re;
+ A1_im += g11_re * a1_im;
+ A1_im += g11_im * a1_re;
+ A1_im += g12_re * a2_im;
+ A1_im += g12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += g10_re * b0_re;
+ B1_re -= g10_im * b0_im;
+ B1_re += g11_re * b1_re;
+ B1_re -= g11_im * b1_im;
+ B1_re += g12_re * b2_re;
+ B1_re -= g12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += g10_re * b0_im;
+ B1_im += g10_im * b0_re;
+ B1_im += g11_re * b1_im;
+ B1_im += g11_im * b1_re;
+ B1_im += g12_re * b2_im;
+ B1_im += g12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += g20_re * a0_re;
+ A2_re -= g20_im * a0_im;
+ A2_re += g21_re * a1_re;
+ A2_re -= g21_im * a1_im;
+ A2_re += g22_re * a2_re;
+ A2_re -= g22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += g20_re * a0_im;
+ A2_im += g20_im * a0_re;
+ A2_im += g21_re * a1_im;
+ A2_im += g21_im * a1_re;
+ A2_im += g22_re * a2_im;
+ A2_im += g22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += g20_re * b0_re;
+ B2_re -= g20_im * b0_im;
+ B2_re += g21_re * b1_re;
+ B2_re -= g21_im * b1_im;
+ B2_re += g22_re * b2_re;
+ B2_re -= g22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += g20_re * b0_im;
+ B2_im += g20_im * b0_re;
+ B2_im += g21_re * b1_im;
+ B2_im += g21_im * b1_re;
+ B2_im += g22_re * b2_im;
+ B2_im += g22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re -= A0_im;
+ o20_im += A0_re;
+ o30_re += B0_im;
+ o30_im -= B0_re;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re -= A1_im;
+ o21_im += A1_re;
+ o31_re += B1_im;
+ o31_im -= B1_re;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re -= A2_im;
+ o22_im += A2_re;
+ o32_re += B2_im;
+ o32_im -= B2_re;
+}
+
+// Projector P2+
+//  1  0  i  0
+//  0  1  0 -i
+// -i  0  1  0
+//  0  i  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 5);
+ READ_GAUGE_MATRIX(G, 5);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re-i20_im;
+ a0_im = +i00_im+i20_re;
+ a1_re = +i01_re-i21_im;
+ a1_im = +i01_im+i21_re;
+ a2_re = +i02_re-i22_im;
+ a2_im = +i02_im+i22_re;
+ b0_re = +i10_re+i30_im;
+ b0_im = +i10_im-i30_re;
+ b1_re = +i11_re+i31_im;
+ b1_im = +i11_im-i31_re;
+ b2_re = +i12_re+i32_im;
+ b2_im = +i12_im-i32_re;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += gT00_re * a0_re;
+ A0_re -= gT00_im * a0_im;
+ A0_re += gT01_re * a1_re;
+ A0_re -= gT01_im * a1_im;
+ A0_re += gT02_re * a2_re;
+ A0_re -= gT02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += gT00_re * a0_im;
+ A0_im += gT00_im * a0_re;
+ A0_im += gT01_re * a1_im;
+ A0_im += gT01_im * a1_re;
+ A0_im += gT02_re * a2_im;
+ A0_im += gT02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += gT00_re * b0_re;
+ B0_re -= gT00_im * b0_im;
+ B0_re += gT01_re * b1_re;
+ B0_re -= gT01_im * b1_im;
+ B0_re += gT02_re * b2_re;
+ B0_re -= gT02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += gT00_re * b0_im;
+ B0_im += gT00_im * b0_re;
+ B0_im += gT01_re * b1_im;
+ B0_im += gT01_im * b1_re;
+ B0_im += gT02_re * b2_im;
+ B0_im += gT02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += gT10_re * a0_re;
+ A1_re -= gT10_im * a0_im;
+ A1_re += gT11_re * a1_re;
+ A1_re -= gT11_im * a1_im;
+ A1_re += gT12_re * a2_re;
+ A1_re -= gT12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += gT10_re * a0_im;
+ A1_im += gT10_im * a0_re;
+ A1_im += gT11_re * a1_im;
+ A1_im += gT11_im * a1_re;
+ A1_im += gT12_re * a2_im;
+ A1_im += gT12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += gT10_re * b0_re;
+ B1_re -= gT10_im * b0_im;
+ B1_re += gT11_re * b1_re;
+ B1_re -= gT11_im * b1_im;
+ B1_re += gT12_re * b2_re;
+ B1_re -= gT12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += gT10_re * b0_im;
+ B1_im += gT10_im * b0_re;
+ B1_im += gT11_re * b1_im;
+ B1_im += gT11_im * b1_re;
+ B1_im += gT12_re * b2_im;
+ B1_im += gT12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += gT20_re * a0_re;
+ A2_re -= gT20_im * a0_im;
+ A2_re += gT21_re * a1_re;
+ A2_re -= gT21_im * a1_im;
+ A2_re += gT22_re * a2_re;
+ A2_re -= gT22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += gT20_re * a0_im;
+ A2_im += gT20_im * a0_re;
+ A2_im += gT21_re * a1_im;
+ A2_im += gT21_im * a1_re;
+ A2_im += gT22_re * a2_im;
+ A2_im += gT22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += gT20_re * b0_re;
+ B2_re -= gT20_im * b0_im;
+ B2_re += gT21_re * b1_re;
+ B2_re -= gT21_im * b1_im;
+ B2_re += gT22_re * b2_re;
+ B2_re -= gT22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += gT20_re * b0_im;
+ B2_im += gT20_im * b0_re;
+ B2_im += gT21_re * b1_im;
+ B2_im += gT21_im * b1_re;
+ B2_im += gT22_re * b2_im;
+ B2_im += gT22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re += A0_im;
+ o20_im -= A0_re;
+ o30_re -= B0_im;
+ o30_im += B0_re;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re += A1_im;
+ o21_im -= A1_re;
+ o31_re -= B1_im;
+ o31_im += B1_re;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re += A2_im;
+ o22_im -= A2_re;
+ o32_re -= B2_im;
+ o32_im += B2_re;
+}
+
+// Projector P3-
+//  1  0 -1  0
+//  0  1  0 -1
+// -1  0  1  0
+//  0 -1  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 6);
+ READ_GAUGE_MATRIX(G, 6);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re-i20_re;
+ a0_im = +i00_im-i20_im;
+ a1_re = +i01_re-i21_re;
+ a1_im = +i01_im-i21_im;
+ a2_re = +i02_re-i22_re;
+ a2_im = +i02_im-i22_im;
+ b0_re = +i10_re-i30_re;
+ b0_im = +i10_im-i30_im;
+ b1_re = +i11_re-i31_re;
+ b1_im = +i11_im-i31_im;
+ b2_re = +i12_re-i32_re;
+ b2_im = +i12_im-i32_im;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += g00_re * a0_re;
+ A0_re -= g00_im * a0_im;
+ A0_re += g01_re * a1_re;
+ A0_re -= g01_im * a1_im;
+ A0_re += g02_re * a2_re;
+ A0_re -= g02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += g00_re * a0_im;
+ A0_im += g00_im * a0_re;
+ A0_im += g01_re * a1_im;
+ A0_im += g01_im * a1_re;
+ A0_im += g02_re * a2_im;
+ A0_im += g02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += g00_re * b0_re;
+ B0_re -= g00_im * b0_im;
+ B0_re += g01_re * b1_re;
+ B0_re -= g01_im * b1_im;
+ B0_re += g02_re * b2_re;
+ B0_re -= g02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += g00_re * b0_im;
+ B0_im += g00_im * b0_re;
+ B0_im += g01_re * b1_im;
+ B0_im += g01_im * b1_re;
+ B0_im += g02_re * b2_im;
+ B0_im += g02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += g10_re * a0_re;
+ A1_re -= g10_im * a0_im;
+ A1_re += g11_re * a1_re;
+ A1_re -= g11_im * a1_im;
+ A1_re += g12_re * a2_re;
+ A1_re -= g12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += g10_re * a0_im;
+ A1_im += g10_im * a0_re;
+ A1_im += g11_re * a1_im;
+ A1_im += g11_im * a1_re;
+ A1_im += g12_re * a2_im;
+ A1_im += g12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += g10_re * b0_re;
+ B1_re -= g10_im * b0_im;
+ B1_re += g11_re * b1_re;
+ B1_re -= g11_im * b1_im;
+ B1_re += g12_re * b2_re;
+ B1_re -= g12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += g10_re * b0_im;
+ B1_im += g10_im * b0_re;
+ B1_im += g11_re * b1_im;
+ B1_im += g11_im * b1_re;
+ B1_im += g12_re * b2_im;
+ B1_im += g12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += g20_re * a0_re;
+ A2_re -= g20_im * a0_im;
+ A2_re += g21_re * a1_re;
+ A2_re -= g21_im * a1_im;
+ A2_re += g22_re * a2_re;
+ A2_re -= g22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += g20_re * a0_im;
+ A2_im += g20_im * a0_re;
+ A2_im += g21_re * a1_im;
+ A2_im += g21_im * a1_re;
+ A2_im += g22_re * a2_im;
+ A2_im += g22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += g20_re * b0_re;
+ B2_re -= g20_im * b0_im;
+ B2_re += g21_re * b1_re;
+ B2_re -= g21_im * b1_im;
+ B2_re += g22_re * b2_re;
+ B2_re -= g22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += g20_re * b0_im;
+ B2_im += g20_im * b0_re;
+ B2_im += g21_re * b1_im;
+ B2_im += g21_im * b1_re;
+ B2_im += g22_re * b2_im;
+ B2_im += g22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re -= A0_re;
+ o20_im -= A0_im;
+ o30_re -= B0_re;
+ o30_im -= B0_im;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re -= A1_re;
+ o21_im -= A1_im;
+ o31_re -= B1_re;
+ o31_im -= B1_im;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re -= A2_re;
+ o22_im -= A2_im;
+ o32_re -= B2_re;
+ o32_im -= B2_im;
+}
+
+// Projector P3+
+//  1  0  1  0
+//  0  1  0  1
+//  1  0  1  0
+//  0  1  0  1
+
+{
+ // read spinor and gauge matrix
+ READ_SPINOR(I, 7);
+ READ_GAUGE_MATRIX(G, 7);
+
+ spinorFloat a0_re, a0_im;
+ spinorFloat a1_re, a1_im;
+ spinorFloat a2_re, a2_im;
+ spinorFloat b0_re, b0_im;
+ spinorFloat b1_re, b1_im;
+ spinorFloat b2_re, b2_im;
+
+ // project spinor into half spinors
+ a0_re = +i00_re+i20_re;
+ a0_im = +i00_im+i20_im;
+ a1_re = +i01_re+i21_re;
+ a1_im = +i01_im+i21_im;
+ a2_re = +i02_re+i22_re;
+ a2_im = +i02_im+i22_im;
+ b0_re = +i10_re+i30_re;
+ b0_im = +i10_im+i30_im;
+ b1_re = +i11_re+i31_re;
+ b1_im = +i11_im+i31_im;
+ b2_re = +i12_re+i32_re;
+ b2_im = +i12_im+i32_im;
+
+ // multiply row 0
+ spinorFloat A0_re = 0;
+ A0_re += gT00_re * a0_re;
+ A0_re -= gT00_im * a0_im;
+ A0_re += gT01_re * a1_re;
+ A0_re -= gT01_im * a1_im;
+ A0_re += gT02_re * a2_re;
+ A0_re -= gT02_im * a2_im;
+ spinorFloat A0_im = 0;
+ A0_im += gT00_re * a0_im;
+ A0_im += gT00_im * a0_re;
+ A0_im += gT01_re * a1_im;
+ A0_im += gT01_im * a1_re;
+ A0_im += gT02_re * a2_im;
+ A0_im += gT02_im * a2_re;
+ spinorFloat B0_re = 0;
+ B0_re += gT00_re * b0_re;
+ B0_re -= gT00_im * b0_im;
+ B0_re += gT01_re * b1_re;
+ B0_re -= gT01_im * b1_im;
+ B0_re += gT02_re * b2_re;
+ B0_re -= gT02_im * b2_im;
+ spinorFloat B0_im = 0;
+ B0_im += gT00_re * b0_im;
+ B0_im += gT00_im * b0_re;
+ B0_im += gT01_re * b1_im;
+ B0_im += gT01_im * b1_re;
+ B0_im += gT02_re * b2_im;
+ B0_im += gT02_im * b2_re;
+
+ // multiply row 1
+ spinorFloat A1_re = 0;
+ A1_re += gT10_re * a0_re;
+ A1_re -= gT10_im * a0_im;
+ A1_re += gT11_re * a1_re;
+ A1_re -= gT11_im * a1_im;
+ A1_re += gT12_re * a2_re;
+ A1_re -= gT12_im * a2_im;
+ spinorFloat A1_im = 0;
+ A1_im += gT10_re * a0_im;
+ A1_im += gT10_im * a0_re;
+ A1_im += gT11_re * a1_im;
+ A1_im += gT11_im * a1_re;
+ A1_im += gT12_re * a2_im;
+ A1_im += gT12_im * a2_re;
+ spinorFloat B1_re = 0;
+ B1_re += gT10_re * b0_re;
+ B1_re -= gT10_im * b0_im;
+ B1_re += gT11_re * b1_re;
+ B1_re -= gT11_im * b1_im;
+ B1_re += gT12_re * b2_re;
+ B1_re -= gT12_im * b2_im;
+ spinorFloat B1_im = 0;
+ B1_im += gT10_re * b0_im;
+ B1_im += gT10_im * b0_re;
+ B1_im += gT11_re * b1_im;
+ B1_im += gT11_im * b1_re;
+ B1_im += gT12_re * b2_im;
+ B1_im += gT12_im * b2_re;
+
+ // multiply row 2
+ spinorFloat A2_re = 0;
+ A2_re += gT20_re * a0_re;
+ A2_re -= gT20_im * a0_im;
+ A2_re += gT21_re * a1_re;
+ A2_re -= gT21_im * a1_im;
+ A2_re += gT22_re * a2_re;
+ A2_re -= gT22_im * a2_im;
+ spinorFloat A2_im = 0;
+ A2_im += gT20_re * a0_im;
+ A2_im += gT20_im * a0_re;
+ A2_im += gT21_re * a1_im;
+ A2_im += gT21_im * a1_re;
+ A2_im += gT22_re * a2_im;
+ A2_im += gT22_im * a2_re;
+ spinorFloat B2_re = 0;
+ B2_re += gT20_re * b0_re;
+ B2_re -= gT20_im * b0_im;
+ B2_re += gT21_re * b1_re;
+ B2_re -= gT21_im * b1_im;
+ B2_re += gT22_re * b2_re;
+ B2_re -= gT22_im * b2_im;
+ spinorFloat B2_im = 0;
+ B2_im += gT20_re * b0_im;
+ B2_im += gT20_im * b0_re;
+ B2_im += gT21_re * b1_im;
+ B2_im += gT21_im * b1_re;
+ B2_im += gT22_re * b2_im;
+ B2_im += gT22_im * b2_re;
+
+ o00_re += A0_re;
+ o00_im += A0_im;
+ o10_re += B0_re;
+ o10_im += B0_im;
+ o20_re += A0_re;
+ o20_im += A0_im;
+ o30_re += B0_re;
+ o30_im += B0_im;
+
+ o01_re += A1_re;
+ o01_im += A1_im;
+ o11_re += B1_re;
+ o11_im += B1_im;
+ o21_re += A1_re;
+ o21_im += A1_im;
+ o31_re += B1_re;
+ o31_im += B1_im;
+
+ o02_re += A2_re;
+ o02_im += A2_im;
+ o12_re += B2_re;
+ o12_im += B2_im;
+ o22_re += A2_re;
+ o22_im += A2_im;
+ o32_re += B2_re;
+ o32_im += B2_im;
+}
+
+// 5th dimension
+// 2 P_L
+{
+ const int sp_s = (xs == arg.Ls-1 ? xs-(arg.Ls-1) : xs+1);
+ READ_SPINOR_5D(I, sp_s);
+
+ if (xs != arg.Ls-1) {
+  o20_re += +2*i20_re;  o20_im += +2*i20_im;
+  o21_re += +2*i21_re;  o21_im += +2*i21_im;
+  o22_re += +2*i22_re;  o22_im += +2*i22_im;
+  o30_re += +2*i30_re;  o30_im += +2*i30_im;
+  o31_re += +2*i31_re;  o31_im += +2*i31_im;
+  o32_re += +2*i32_re;  o32_im += +2*i32_im;
+ } else {
+  o20_re += -arg.mferm*(+2*i20_re);  o20_im += -arg.mferm*(+2*i20_im);
+  o21_re += -arg.mferm*(+2*i21_re);  o21_im += -arg.mferm*(+2*i21_im);
+  o22_re += -arg.mferm*(+2*i22_re);  o22_im += -arg.mferm*(+2*i22_im);
+  o30_re += -arg.mferm*(+2*i30_re);  o30_im += -arg.mferm*(+2*i30_im);
+  o31_re += -arg.mferm*(+2*i31_re);  o31_im += -arg.mferm*(+2*i31_im);
+  o32_re += -arg.mferm*(+2*i32_re);  o32_im += -arg.mferm*(+2*i32_im);
+ }
+}
+
+// 2 P_R
+{
+ const int sp_s = (xs == 0 ? xs+(arg.Ls-1) : xs-1);
+ READ_SPINOR_5D(I, sp_s);
+
+ if (xs != 0) {
+  o00_re += +2*i00_re;  o00_im += +2*i00_im;
+  o01_re += +2*i01_re;  o01_im += +2*i01_im;
+  o02_re += +2*i02_re;  o02_im += +2*i02_im;
+  o10_re += +2*i10_re;  o10_im += +2*i10_im;
+  o11_re += +2*i11_re;  o11_im += +2*i11_im;
+  o12_re += +2*i12_re;  o12_im += +2*i12_im;
+ } else {
+  o00_re += -arg.mferm*(+2*i00_re);  o00_im += -arg.mferm*(+2*i00_im);
+  o01_re += -arg.mferm*(+2*i01_re);  o01_im += -arg.mferm*(+2*i01_im);
+  o02_re += -arg.mferm*(+2*i02_re);  o02_im += -arg.mferm*(+2*i02_im);
+  o10_re += -arg.mferm*(+2*i10_re);  o10_im += -arg.mferm*(+2*i10_im);
+  o11_re += -arg.mferm*(+2*i11_re);  o11_im += -arg.mferm*(+2*i11_im);
+  o12_re += -arg.mferm*(+2*i12_re);  o12_im += -arg.mferm*(+2*i12_im);
+ }
+}
+
+// out = x + k * D in
+if (arg.x) {
+ spinorFloat ACC[24];
+ READ_ACCUM(ACC);
+
+ o00_re = acc00_re + arg.k*o00_re;
+ o00_im = acc00_im + arg.k*o00_im;
+ o01_re = acc01_re + arg.k*o01_re;
+ o01_im = acc01_im + arg.k*o01_im;
+ o02_re = acc02_re + arg.k*o02_re;
+ o02_im = acc02_im + arg.k*o02_im;
+ o10_re = acc10_re + arg.k*o10_re;
+ o10_im = acc10_im + arg.k*o10_im;
+ o11_re = acc11_re + arg.k*o11_re;
+ o11_im = acc11_im + arg.k*o11_im;
+ o12_re = acc12_re + arg.k*o12_re;
+ o12_im = acc12_im + arg.k*o12_im;
+ o20_re = acc20_re + arg.k*o20_re;
+ o20_im = acc20_im + arg.k*o20_im;
+ o21_re = acc21_re + arg.k*o21_re;
+ o21_im = acc21_im + arg.k*o21_im;
+ o22_re = acc22_re + arg.k*o22_re;
+ o22_im = acc22_im + arg.k*o22_im;
+ o30_re = acc30_re + arg.k*o30_re;
+ o30_im = acc30_im + arg.k*o30_im;
+ o31_re = acc31_re + arg.k*o31_re;
+ o31_im = acc31_im + arg.k*o31_im;
+ o32_re = acc32_re + arg.k*o32_re;
+ o32_im = acc32_im + arg.k*o32_im;
+}
+
+// write spinor field back to host memory
+WRITE_SPINOR(O);
+
+// undefine to prevent warnings when the core is included again
+#undef i00_re
+#undef i00_im
+#undef i01_re
+#undef i01_im
+#undef i02_re
+#undef i02_im
+#undef i10_re
+#undef i10_im
+#undef i11_re
+#undef i11_im
+#undef i12_re
+#undef i12_im
+#undef i20_re
+#undef i20_im
+#undef i21_re
+#undef i21_im
+#undef i22_re
+#undef i22_im
+#undef i30_re
+#undef i30_im
+#undef i31_re
+#undef i31_im
+#undef i32_re
+#undef i32_im
+#undef acc00_re
+#undef acc00_im
+#undef acc01_re
+#undef acc01_im
+#undef acc02_re
+#undef acc02_im
+#undef acc10_re
+#undef acc10_im
+#undef acc11_re
+#undef acc11_im
+#undef acc12_re
+#undef acc12_im
+#undef acc20_re
+#undef acc20_im
+#undef acc21_re
+#undef acc21_im
+#undef acc22_re
+#undef acc22_im
+#undef acc30_re
+#undef acc30_im
+#undef acc31_re
+#undef acc31_im
+#undef acc32_re
+#undef acc32_im
+#undef g00_re
+#undef g00_im
+#undef g01_re
+#undef g01_im
+#undef g02_re
+#undef g02_im
+#undef g10_re
+#undef g10_im
+#undef g11_re
+#undef g11_im
+#undef g12_re
+#undef g12_im
+#undef g20_re
+#undef g20_im
+#undef g21_re
+#undef g21_im
+#undef g22_re
+#undef g22_im
+#undef gT00_re
+#undef gT00_im
+#undef gT01_re
+#undef gT01_im
+#undef gT02_re
+#undef gT02_im
+#undef gT10_re
+#undef gT10_im
+#undef gT11_re
+#undef gT11_im
+#undef gT12_re
+#undef gT12_im
+#undef gT20_re
+#undef gT20_im
+#undef gT21_re
+#undef gT21_im
+#undef gT22_re
+#undef gT22_im
+#undef o00_re
+#undef o00_im
+#undef o01_re
+#undef o01_im
+#undef o02_re
+#undef o02_im
+#undef o10_re
+#undef o10_im
+#undef o11_re
+#undef o11_im
+#undef o12_re
+#undef o12_im
+#undef o20_re
+#undef o20_im
+#undef o21_re
+#undef o21_im
+#undef o22_re
+#undef o22_im
+#undef o30_re
+#undef o30_im
+#undef o31_re
+#undef o31_im
+#undef o32_re
+#undef o32_im
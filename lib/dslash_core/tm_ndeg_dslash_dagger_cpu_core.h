@@ -0,0 +1,3520 @@
+// *** CPU NDEG TWISTED MASS DSLASH DAGGER ***
+
+// Body of the host kernels in dslash_cpu.cpp, in the DeGrand-Rossi basis.
+// spinorFloat is a RealVec holding one site per lane, and the READ_*
+// and WRITE_SPINOR_FLAVOR macros, which gather and scatter the lanes,
+// are defined there.  arg.type selects where the twist is applied.
+
+// input (neighbor) spinors and accumulators for both flavors
+#define i00_re I[0]
+#define i00_im I[1]
+#define i01_re I[2]
+#define i01_im I[3]
+#define i02_re I[4]
+#define i02_im I[5]
+#define i10_re I[6]
+#define i10_im I[7]
+#define i11_re I[8]
+#define i11_im I[9]
+#define i12_re I[10]
+#define i12_im I[11]
+#define i20_re I[12]
+#define i20_im I[13]
+#define i21_re I[14]
+#define i21_im I[15]
+#define i22_re I[16]
+#define i22_im I[17]
+#define i30_re I[18]
+#define i30_im I[19]
+#define i31_re I[20]
+#define i31_im I[21]
+#define i32_re I[22]
+#define i32_im I[23]
+#define i2_00_re I2[0]
+#define i2_00_im I2[1]
+#define i2_01_re I2[2]
+#define i2_01_im I2[3]
+#define i2_02_re I2[4]
+#define i2_02_im I2[5]
+#define i2_10_re I2[6]
+#define i2_10_im I2[7]
+#define i2_11_re I2[8]
+#define i2_11_im I2[9]
+#define i2_12_re I2[10]
+#define i2_12_im I2[11]
+#define i2_20_re I2[12]
+#define i2_20_im I2[13]
+#define i2_21_re I2[14]
+#define i2_21_im I2[15]
+#define i2_22_re I2[16]
+#define i2_22_im I2[17]
+#define i2_30_re I2[18]
+#define i2_30_im I2[19]
+#define i2_31_re I2[20]
+#define i2_31_im I2[21]
+#define i2_32_re I2[22]
+#define i2_32_im I2[23]
+#define acc1_00_re ACC1[0]
+#define acc1_00_im ACC1[1]
+#define acc1_01_re ACC1[2]
+#define acc1_01_im ACC1[3]
+#define acc1_02_re ACC1[4]
+#define acc1_02_im ACC1[5]
+#define acc1_10_re ACC1[6]
+#define acc1_10_im ACC1[7]
+#define acc1_11_re ACC1[8]
+#define acc1_11_im ACC1[9]
+#define acc1_12_re ACC1[10]
+#define acc1_12_im ACC1[11]
+#define acc1_20_re ACC1[12]
+#define acc1_20_im ACC1[13]
+#define acc1_21_re ACC1[14]
+#define acc1_21_im ACC1[15]
+#define acc1_22_re ACC1[16]
+#define acc1_22_im ACC1[17]
+#define acc1_30_re ACC1[18]
+#define acc1_30_im ACC1[19]
+#define acc1_31_re ACC1[20]
+#define acc1_31_im ACC1[21]
+#define acc1_32_re ACC1[22]
+#define acc1_32_im ACC1[23]
+#define acc2_00_re ACC2[0]
+#define acc2_00_im ACC2[1]
+#define acc2_01_re ACC2[2]
+#define acc2_01_im ACC2[3]
+#define acc2_02_re ACC2[4]
+#define acc2_02_im ACC2[5]
+#define acc2_10_re ACC2[6]
+#define acc2_10_im ACC2[7]
+#define acc2_11_re ACC2[8]
+#define acc2_11_im ACC2[9]
+#define acc2_12_re ACC2[10]
+#define acc2_12_im ACC2[11]
+#define acc2_20_re ACC2[12]
+#define acc2_20_im ACC2[13]
+#define acc2_21_re ACC2[14]
+#define acc2_21_im ACC2[15]
+#define acc2_22_re ACC2[16]
+#define acc2_22_im ACC2[17]
+#define acc2_30_re ACC2[18]
+#define acc2_30_im ACC2[19]
+#define acc2_31_re ACC2[20]
+#define acc2_31_im ACC2[21]
+#define acc2_32_re ACC2[22]
+#define acc2_32_im ACC2[23]
+
+// gauge link
+#define g00_re G[0]
+#define g00_im G[1]
+#define g01_re G[2]
+#define g01_im G[3]
+#define g02_re G[4]
+#define g02_im G[5]
+#define g10_re G[6]
+#define g10_im G[7]
+#define g11_re G[8]
+#define g11_im G[9]
+#define g12_re G[10]
+#define g12_im G[11]
+#define g20_re G[12]
+#define g20_im G[13]
+#define g21_re G[14]
+#define g21_im G[15]
+#define g22_re G[16]
+#define g22_im G[17]
+
+// conjugated gauge link
+#define gT00_re (+g00_re)
+#define gT00_im (-g00_im)
+#define gT01_re (+g10_re)
+#define gT01_im (-g10_im)
+#define gT02_re (+g20_re)
+#define gT02_im (-g20_im)
+#define gT10_re (+g01_re)
+#define gT10_im (-g01_im)
+#define gT11_re (+g11_re)
+#define gT11_im (-g11_im)
+#define gT12_re (+g21_re)
+#define gT12_im (-g21_im)
+#define gT20_re (+g02_re)
+#define gT20_im (-g02_im)
+#define gT21_re (+g12_re)
+#define gT21_im (-g12_im)
+#define gT22_re (+g22_re)
+#define gT22_im (-g22_im)
+
+// output spinors for both flavors
+#define o1_00_re O1[0]
+#define o1_00_im O1[1]
+#define o1_01_re O1[2]
+#define o1_01_im O1[3]
+#define o1_02_re O1[4]
+#define o1_02_im O1[5]
+#define o1_10_re O1[6]
+#define o1_10_im O1[7]
+#define o1_11_re O1[8]
+#define o1_11_im O1[9]
+#define o1_12_re O1[10]
+#define o1_12_im O1[11]
+#define o1_20_re O1[12]
+#define o1_20_im O1[13]
+#define o1_21_re O1[14]
+#define o1_21_im O1[15]
+#define o1_22_re O1[16]
+#define o1_22_im O1[17]
+#define o1_30_re O1[18]
+#define o1_30_im O1[19]
+#define o1_31_re O1[20]
+#define o1_31_im O1[21]
+#define o1_32_re O1[22]
+#define o1_32_im O1[23]
+#define o2_00_re O2[0]
+#define o2_00_im O2[1]
+#define o2_01_re O2[2]
+#define o2_01_im O2[3]
+#define o2_02_re O2[4]
+#define o2_02_im O2[5]
+#define o2_10_re O2[6]
+#define o2_10_im O2[7]
+#define o2_11_re O2[8]
+#define o2_11_im O2[9]
+#define o2_12_re O2[10]
+#define o2_12_im O2[11]
+#define o2_20_re O2[12]
+#define o2_20_im O2[13]
+#define o2_21_re O2[14]
+#define o2_21_im O2[15]
+#define o2_22_re O2[16]
+#define o2_22_im O2[17]
+#define o2_30_re O2[18]
+#define o2_30_im O2[19]
+#define o2_31_re O2[20]
+#define o2_31_im O2[21]
+#define o2_32_re O2[22]
+#define o2_32_im O2[23]
+
+spinorFloat I[24], I2[24], G[18], O1[24], O2[24];
+
+o1_00_re = 0;  o1_00_im = 0;
+o1_01_re = 0;  o1_01_im = 0;
+o1_02_re = 0;  o1_02_im = 0;
+o1_10_re = 0;  o1_10_im = 0;
+o1_11_re = 0;  o1_11_im = 0;
+o1_12_re = 0;  o1_12_im = 0;
+o1_20_re = 0;  o1_20_im = 0;
+o1_21_re = 0;  o1_21_im = 0;
+o1_22_re = 0;  o1_22_im = 0;
+o1_30_re = 0;  o1_30_im = 0;
+o1_31_re = 0;  o1_31_im = 0;
+o1_32_re = 0;  o1_32_im = 0;
+
+o2_00_re = 0;  o2_00_im = 0;
+o2_01_re = 0;  o2_01_im = 0;
+o2_02_re = 0;  o2_02_im = 0;
+o2_10_re = 0;  o2_10_im = 0;
+o2_11_re = 0;  o2_11_im = 0;
+o2_12_re = 0;  o2_12_im = 0;
+o2_20_re = 0;  o2_20_im = 0;
+o2_21_re = 0;  o2_21_im = 0;
+o2_22_re = 0;  o2_22_im = 0;
+o2_30_re = 0;  o2_30_im = 0;
+o2_31_re = 0;  o2_31_im = 0;
+o2_32_re = 0;  o2_32_im = 0;
+
+{
+  // Projector P0+
+  // 1 0 0 i 
+  // 0 1 i 0 
+  // 0 -i 1 0 
+  // -i 0 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 0, 0);
+  READ_SPINOR_FLAVOR(I2, 0, 1);
+  READ_GAUGE_MATRIX(G, 0);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re-i30_im;
+    a0_im = +i00_im+i30_re;
+    a1_re = +i01_re-i31_im;
+    a1_im = +i01_im+i31_re;
+    a2_re = +i02_re-i32_im;
+    a2_im = +i02_im+i32_re;
+    b0_re = +i10_re-i20_im;
+    b0_im = +i10_im+i20_re;
+    b1_re = +i11_re-i21_im;
+    b1_im = +i11_im+i21_re;
+    b2_re = +i12_re-i22_im;
+    b2_im = +i12_im+i22_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re += B0_im;
+    o1_20_im -= B0_re;
+    o1_30_re += A0_im;
+    o1_30_im -= A0_re;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re += B1_im;
+    o1_21_im -= B1_re;
+    o1_31_re += A1_im;
+    o1_31_im -= A1_re;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re += B2_im;
+    o1_22_im -= B2_re;
+    o1_32_re += A2_im;
+    o1_32_im -= A2_re;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re-i2_30_im;
+    a0_im = +i2_00_im+i2_30_re;
+    a1_re = +i2_01_re-i2_31_im;
+    a1_im = +i2_01_im+i2_31_re;
+    a2_re = +i2_02_re-i2_32_im;
+    a2_im = +i2_02_im+i2_32_re;
+    b0_re = +i2_10_re-i2_20_im;
+    b0_im = +i2_10_im+i2_20_re;
+    b1_re = +i2_11_re-i2_21_im;
+    b1_im = +i2_11_im+i2_21_re;
+    b2_re = +i2_12_re-i2_22_im;
+    b2_im = +i2_12_im+i2_22_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re += B0_im;
+    o2_20_im -= B0_re;
+    o2_30_re += A0_im;
+    o2_30_im -= A0_re;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re += B1_im;
+    o2_21_im -= B1_re;
+    o2_31_re += A1_im;
+    o2_31_im -= A1_re;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re += B2_im;
+    o2_22_im -= B2_re;
+    o2_32_re += A2_im;
+    o2_32_im -= A2_re;
+    
+  }
+}
+
+{
+  // Projector P0-
+  // 1 0 0 -i 
+  // 0 1 -i 0 
+  // 0 i 1 0 
+  // i 0 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 1, 0);
+  READ_SPINOR_FLAVOR(I2, 1, 1);
+  READ_GAUGE_MATRIX(G, 1);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re+i30_im;
+    a0_im = +i00_im-i30_re;
+    a1_re = +i01_re+i31_im;
+    a1_im = +i01_im-i31_re;
+    a2_re = +i02_re+i32_im;
+    a2_im = +i02_im-i32_re;
+    b0_re = +i10_re+i20_im;
+    b0_im = +i10_im-i20_re;
+    b1_re = +i11_re+i21_im;
+    b1_im = +i11_im-i21_re;
+    b2_re = +i12_re+i22_im;
+    b2_im = +i12_im-i22_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re -= B0_im;
+    o1_20_im += B0_re;
+    o1_30_re -= A0_im;
+    o1_30_im += A0_re;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re -= B1_im;
+    o1_21_im += B1_re;
+    o1_31_re -= A1_im;
+    o1_31_im += A1_re;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re -= B2_im;
+    o1_22_im += B2_re;
+    o1_32_re -= A2_im;
+    o1_32_im += A2_re;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re+i2_30_im;
+    a0_im = +i2_00_im-i2_30_re;
+    a1_re = +i2_01_re+i2_31_im;
+    a1_im = +i2_01_im-i2_31_re;
+    a2_re = +i2_02_re+i2_32_im;
+    a2_im = +i2_02_im-i2_32_re;
+    b0_re = +i2_10_re+i2_20_im;
+    b0_im = +i2_10_im-i2_20_re;
+    b1_re = +i2_11_re+i2_21_im;
+    b1_im = +i2_11_im-i2_21_re;
+    b2_re = +i2_12_re+i2_22_im;
+    b2_im = +i2_12_im-i2_22_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re -= B0_im;
+    o2_20_im += B0_re;
+    o2_30_re -= A0_im;
+    o2_30_im += A0_re;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re -= B1_im;
+    o2_21_im += B1_re;
+    o2_31_re -= A1_im;
+    o2_31_im += A1_re;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re -= B2_im;
+    o2_22_im += B2_re;
+    o2_32_re -= A2_im;
+    o2_32_im += A2_re;
+    
+  }
+}
+
+{
+  // Projector P1+
+  // 1 0 0 -1 
+  // 0 1 1 0 
+  // 0 1 1 0 
+  // -1 0 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 2, 0);
+  READ_SPINOR_FLAVOR(I2, 2, 1);
+  READ_GAUGE_MATRIX(G, 2);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re-i30_re;
+    a0_im = +i00_im-i30_im;
+    a1_re = +i01_re-i31_re;
+    a1_im = +i01_im-i31_im;
+    a2_re = +i02_re-i32_re;
+    a2_im = +i02_im-i32_im;
+    b0_re = +i10_re+i20_re;
+    b0_im = +i10_im+i20_im;
+    b1_re = +i11_re+i21_re;
+    b1_im = +i11_im+i21_im;
+    b2_re = +i12_re+i22_re;
+    b2_im = +i12_im+i22_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re += B0_re;
+    o1_20_im += B0_im;
+    o1_30_re -= A0_re;
+    o1_30_im -= A0_im;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re += B1_re;
+    o1_21_im += B1_im;
+    o1_31_re -= A1_re;
+    o1_31_im -= A1_im;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re += B2_re;
+    o1_22_im += B2_im;
+    o1_32_re -= A2_re;
+    o1_32_im -= A2_im;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re-i2_30_re;
+    a0_im = +i2_00_im-i2_30_im;
+    a1_re = +i2_01_re-i2_31_re;
+    a1_im = +i2_01_im-i2_31_im;
+    a2_re = +i2_02_re-i2_32_re;
+    a2_im = +i2_02_im-i2_32_im;
+    b0_re = +i2_10_re+i2_20_re;
+    b0_im = +i2_10_im+i2_20_im;
+    b1_re = +i2_11_re+i2_21_re;
+    b1_im = +i2_11_im+i2_21_im;
+    b2_re = +i2_12_re+i2_22_re;
+    b2_im = +i2_12_im+i2_22_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re += B0_re;
+    o2_20_im += B0_im;
+    o2_30_re -= A0_re;
+    o2_30_im -= A0_im;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re += B1_re;
+    o2_21_im += B1_im;
+    o2_31_re -= A1_re;
+    o2_31_im -= A1_im;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re += B2_re;
+    o2_22_im += B2_im;
+    o2_32_re -= A2_re;
+    o2_32_im -= A2_im;
+    
+  }
+}
+
+{
+  // Projector P1-
+  // 1 0 0 1 
+  // 0 1 -1 0 
+  // 0 -1 1 0 
+  // 1 0 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 3, 0);
+  READ_SPINOR_FLAVOR(I2, 3, 1);
+  READ_GAUGE_MATRIX(G, 3);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re+i30_re;
+    a0_im = +i00_im+i30_im;
+    a1_re = +i01_re+i31_re;
+    a1_im = +i01_im+i31_im;
+    a2_re = +i02_re+i32_re;
+    a2_im = +i02_im+i32_im;
+    b0_re = +i10_re-i20_re;
+    b0_im = +i10_im-i20_im;
+    b1_re = +i11_re-i21_re;
+    b1_im = +i11_im-i21_im;
+    b2_re = +i12_re-i22_re;
+    b2_im = +i12_im-i22_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re -= B0_re;
+    o1_20_im -= B0_im;
+    o1_30_re += A0_re;
+    o1_30_im += A0_im;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re -= B1_re;
+    o1_21_im -= B1_im;
+    o1_31_re += A1_re;
+    o1_31_im += A1_im;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re -= B2_re;
+    o1_22_im -= B2_im;
+    o1_32_re += A2_re;
+    o1_32_im += A2_im;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re+i2_30_re;
+    a0_im = +i2_00_im+i2_30_im;
+    a1_re = +i2_01_re+i2_31_re;
+    a1_im = +i2_01_im+i2_31_im;
+    a2_re = +i2_02_re+i2_32_re;
+    a2_im = +i2_02_im+i2_32_im;
+    b0_re = +i2_10_re-i2_20_re;
+    b0_im = +i2_10_im-i2_20_im;
+    b1_re = +i2_11_re-i2_21_re;
+    b1_im = +i2_11_im-i2_21_im;
+    b2_re = +i2_12_re-i2_22_re;
+    b2_im = +i2_12_im-i2_22_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re -= B0_re;
+    o2_20_im -= B0_im;
+    o2_30_re += A0_re;
+    o2_30_im += A0_im;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re -= B1_re;
+    o2_21_im -= B1_im;
+    o2_31_re += A1_re;
+    o2_31_im += A1_im;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re -= B2_re;
+    o2_22_im -= B2_im;
+    o2_32_re += A2_re;
+    o2_32_im += A2_im;
+    
+  }
+}
+
+{
+  // Projector P2+
+  // 1 0 i 0 
+  // 0 1 0 -i 
+  // -i 0 1 0 
+  // 0 i 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 4, 0);
+  READ_SPINOR_FLAVOR(I2, 4, 1);
+  READ_GAUGE_MATRIX(G, 4);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re-i20_im;
+    a0_im = +i00_im+i20_re;
+    a1_re = +i01_re-i21_im;
+    a1_im = +i01_im+i21_re;
+    a2_re = +i02_re-i22_im;
+    a2_im = +i02_im+i22_re;
+    b0_re = +i10_re+i30_im;
+    b0_im = +i10_im-i30_re;
+    b1_re = +i11_re+i31_im;
+    b1_im = +i11_im-i31_re;
+    b2_re = +i12_re+i32_im;
+    b2_im = +i12_im-i32_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re += A0_im;
+    o1_20_im -= A0_re;
+    o1_30_re -= B0_im;
+    o1_30_im += B0_re;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re += A1_im;
+    o1_21_im -= A1_re;
+    o1_31_re -= B1_im;
+    o1_31_im += B1_re;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re += A2_im;
+    o1_22_im -= A2_re;
+    o1_32_re -= B2_im;
+    o1_32_im += B2_re;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re-i2_20_im;
+    a0_im = +i2_00_im+i2_20_re;
+    a1_re = +i2_01_re-i2_21_im;
+    a1_im = +i2_01_im+i2_21_re;
+    a2_re = +i2_02_re-i2_22_im;
+    a2_im = +i2_02_im+i2_22_re;
+    b0_re = +i2_10_re+i2_30_im;
+    b0_im = +i2_10_im-i2_30_re;
+    b1_re = +i2_11_re+i2_31_im;
+    b1_im = +i2_11_im-i2_31_re;
+    b2_re = +i2_12_re+i2_32_im;
+    b2_im = +i2_12_im-i2_32_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re += A0_im;
+    o2_20_im -= A0_re;
+    o2_30_re -= B0_im;
+    o2_30_im += B0_re;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re += A1_im;
+    o2_21_im -= A1_re;
+    o2_31_re -= B1_im;
+    o2_31_im += B1_re;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re += A2_im;
+    o2_22_im -= A2_re;
+    o2_32_re -= B2_im;
+    o2_32_im += B2_re;
+    
+  }
+}
+
+{
+  // Projector P2-
+  // 1 0 -i 0 
+  // 0 1 0 i 
+  // i 0 1 0 
+  // 0 -i 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 5, 0);
+  READ_SPINOR_FLAVOR(I2, 5, 1);
+  READ_GAUGE_MATRIX(G, 5);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re+i20_im;
+    a0_im = +i00_im-i20_re;
+    a1_re = +i01_re+i21_im;
+    a1_im = +i01_im-i21_re;
+    a2_re = +i02_re+i22_im;
+    a2_im = +i02_im-i22_re;
+    b0_re = +i10_re-i30_im;
+    b0_im = +i10_im+i30_re;
+    b1_re = +i11_re-i31_im;
+    b1_im = +i11_im+i31_re;
+    b2_re = +i12_re-i32_im;
+    b2_im = +i12_im+i32_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re -= A0_im;
+    o1_20_im += A0_re;
+    o1_30_re += B0_im;
+    o1_30_im -= B0_re;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re -= A1_im;
+    o1_21_im += A1_re;
+    o1_31_re += B1_im;
+    o1_31_im -= B1_re;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re -= A2_im;
+    o1_22_im += A2_re;
+    o1_32_re += B2_im;
+    o1_32_im -= B2_re;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re+i2_20_im;
+    a0_im = +i2_00_im-i2_20_re;
+    a1_re = +i2_01_re+i2_21_im;
+    a1_im = +i2_01_im-i2_21_re;
+    a2_re = +i2_02_re+i2_22_im;
+    a2_im = +i2_02_im-i2_22_re;
+    b0_re = +i2_10_re-i2_30_im;
+    b0_im = +i2_10_im+i2_30_re;
+    b1_re = +i2_11_re-i2_31_im;
+    b1_im = +i2_11_im+i2_31_re;
+    b2_re = +i2_12_re-i2_32_im;
+    b2_im = +i2_12_im+i2_32_re;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re -= A0_im;
+    o2_20_im += A0_re;
+    o2_30_re += B0_im;
+    o2_30_im -= B0_re;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re -= A1_im;
+    o2_21_im += A1_re;
+    o2_31_re += B1_im;
+    o2_31_im -= B1_re;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re -= A2_im;
+    o2_22_im += A2_re;
+    o2_32_re += B2_im;
+    o2_32_im -= B2_re;
+    
+  }
+}
+
+{
+  // Projector P3+
+  // 1 0 1 0 
+  // 0 1 0 1 
+  // 1 0 1 0 
+  // 0 1 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 6, 0);
+  READ_SPINOR_FLAVOR(I2, 6, 1);
+  READ_GAUGE_MATRIX(G, 6);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re+i20_re;
+    a0_im = +i00_im+i20_im;
+    a1_re = +i01_re+i21_re;
+    a1_im = +i01_im+i21_im;
+    a2_re = +i02_re+i22_re;
+    a2_im = +i02_im+i22_im;
+    b0_re = +i10_re+i30_re;
+    b0_im = +i10_im+i30_im;
+    b1_re = +i11_re+i31_re;
+    b1_im = +i11_im+i31_im;
+    b2_re = +i12_re+i32_re;
+    b2_im = +i12_im+i32_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re += A0_re;
+    o1_20_im += A0_im;
+    o1_30_re += B0_re;
+    o1_30_im += B0_im;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re += A1_re;
+    o1_21_im += A1_im;
+    o1_31_re += B1_re;
+    o1_31_im += B1_im;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re += A2_re;
+    o1_22_im += A2_im;
+    o1_32_re += B2_re;
+    o1_32_im += B2_im;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re+i2_20_re;
+    a0_im = +i2_00_im+i2_20_im;
+    a1_re = +i2_01_re+i2_21_re;
+    a1_im = +i2_01_im+i2_21_im;
+    a2_re = +i2_02_re+i2_22_re;
+    a2_im = +i2_02_im+i2_22_im;
+    b0_re = +i2_10_re+i2_30_re;
+    b0_im = +i2_10_im+i2_30_im;
+    b1_re = +i2_11_re+i2_31_re;
+    b1_im = +i2_11_im+i2_31_im;
+    b2_re = +i2_12_re+i2_32_re;
+    b2_im = +i2_12_im+i2_32_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += g00_re * a0_re;
+    A0_re -= g00_im * a0_im;
+    A0_re += g01_re * a1_re;
+    A0_re -= g01_im * a1_im;
+    A0_re += g02_re * a2_re;
+    A0_re -= g02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += g00_re * a0_im;
+    A0_im += g00_im * a0_re;
+    A0_im += g01_re * a1_im;
+    A0_im += g01_im * a1_re;
+    A0_im += g02_re * a2_im;
+    A0_im += g02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += g00_re * b0_re;
+    B0_re -= g00_im * b0_im;
+    B0_re += g01_re * b1_re;
+    B0_re -= g01_im * b1_im;
+    B0_re += g02_re * b2_re;
+    B0_re -= g02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += g00_re * b0_im;
+    B0_im += g00_im * b0_re;
+    B0_im += g01_re * b1_im;
+    B0_im += g01_im * b1_re;
+    B0_im += g02_re * b2_im;
+    B0_im += g02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += g10_re * a0_re;
+    A1_re -= g10_im * a0_im;
+    A1_re += g11_re * a1_re;
+    A1_re -= g11_im * a1_im;
+    A1_re += g12_re * a2_re;
+    A1_re -= g12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += g10_re * a0_im;
+    A1_im += g10_im * a0_re;
+    A1_im += g11_re * a1_im;
+    A1_im += g11_im * a1_re;
+    A1_im += g12_re * a2_im;
+    A1_im += g12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += g10_re * b0_re;
+    B1_re -= g10_im * b0_im;
+    B1_re += g11_re * b1_re;
+    B1_re -= g11_im * b1_im;
+    B1_re += g12_re * b2_re;
+    B1_re -= g12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += g10_re * b0_im;
+    B1_im += g10_im * b0_re;
+    B1_im += g11_re * b1_im;
+    B1_im += g11_im * b1_re;
+    B1_im += g12_re * b2_im;
+    B1_im += g12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += g20_re * a0_re;
+    A2_re -= g20_im * a0_im;
+    A2_re += g21_re * a1_re;
+    A2_re -= g21_im * a1_im;
+    A2_re += g22_re * a2_re;
+    A2_re -= g22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += g20_re * a0_im;
+    A2_im += g20_im * a0_re;
+    A2_im += g21_re * a1_im;
+    A2_im += g21_im * a1_re;
+    A2_im += g22_re * a2_im;
+    A2_im += g22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += g20_re * b0_re;
+    B2_re -= g20_im * b0_im;
+    B2_re += g21_re * b1_re;
+    B2_re -= g21_im * b1_im;
+    B2_re += g22_re * b2_re;
+    B2_re -= g22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += g20_re * b0_im;
+    B2_im += g20_im * b0_re;
+    B2_im += g21_re * b1_im;
+    B2_im += g21_im * b1_re;
+    B2_im += g22_re * b2_im;
+    B2_im += g22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re += A0_re;
+    o2_20_im += A0_im;
+    o2_30_re += B0_re;
+    o2_30_im += B0_im;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re += A1_re;
+    o2_21_im += A1_im;
+    o2_31_re += B1_re;
+    o2_31_im += B1_im;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re += A2_re;
+    o2_22_im += A2_im;
+    o2_32_re += B2_re;
+    o2_32_im += B2_im;
+    
+  }
+}
+
+{
+  // Projector P3-
+  // 1 0 -1 0 
+  // 0 1 0 -1 
+  // -1 0 1 0 
+  // 0 -1 0 1 
+  
+  // read both flavors and the gauge matrix
+  READ_SPINOR_FLAVOR(I, 7, 0);
+  READ_SPINOR_FLAVOR(I2, 7, 1);
+  READ_GAUGE_MATRIX(G, 7);
+  
+  if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) {
+    spinorFloat tmp00_re = i00_re;  spinorFloat tmp00_im = i00_im;
+    spinorFloat tmp2_00_re = i2_00_re;  spinorFloat tmp2_00_im = i2_00_im;
+    spinorFloat tmp01_re = i01_re;  spinorFloat tmp01_im = i01_im;
+    spinorFloat tmp2_01_re = i2_01_re;  spinorFloat tmp2_01_im = i2_01_im;
+    spinorFloat tmp02_re = i02_re;  spinorFloat tmp02_im = i02_im;
+    spinorFloat tmp2_02_re = i2_02_re;  spinorFloat tmp2_02_im = i2_02_im;
+    spinorFloat tmp10_re = i10_re;  spinorFloat tmp10_im = i10_im;
+    spinorFloat tmp2_10_re = i2_10_re;  spinorFloat tmp2_10_im = i2_10_im;
+    spinorFloat tmp11_re = i11_re;  spinorFloat tmp11_im = i11_im;
+    spinorFloat tmp2_11_re = i2_11_re;  spinorFloat tmp2_11_im = i2_11_im;
+    spinorFloat tmp12_re = i12_re;  spinorFloat tmp12_im = i12_im;
+    spinorFloat tmp2_12_re = i2_12_re;  spinorFloat tmp2_12_im = i2_12_im;
+    spinorFloat tmp20_re = i20_re;  spinorFloat tmp20_im = i20_im;
+    spinorFloat tmp2_20_re = i2_20_re;  spinorFloat tmp2_20_im = i2_20_im;
+    spinorFloat tmp21_re = i21_re;  spinorFloat tmp21_im = i21_im;
+    spinorFloat tmp2_21_re = i2_21_re;  spinorFloat tmp2_21_im = i2_21_im;
+    spinorFloat tmp22_re = i22_re;  spinorFloat tmp22_im = i22_im;
+    spinorFloat tmp2_22_re = i2_22_re;  spinorFloat tmp2_22_im = i2_22_im;
+    spinorFloat tmp30_re = i30_re;  spinorFloat tmp30_im = i30_im;
+    spinorFloat tmp2_30_re = i2_30_re;  spinorFloat tmp2_30_im = i2_30_im;
+    spinorFloat tmp31_re = i31_re;  spinorFloat tmp31_im = i31_im;
+    spinorFloat tmp2_31_re = i2_31_re;  spinorFloat tmp2_31_im = i2_31_im;
+    spinorFloat tmp32_re = i32_re;  spinorFloat tmp32_im = i32_im;
+    spinorFloat tmp2_32_re = i2_32_re;  spinorFloat tmp2_32_im = i2_32_im;
+    
+    i00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    i00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    i01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    i01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    i02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    i02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    i10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    i10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    i11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    i11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    i12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    i12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    i20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    i20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    i21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    i21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    i22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    i22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    i30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    i30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    i31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    i31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    i32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    i32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    i2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    i2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    i2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    i2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    i2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    i2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    i2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    i2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    i2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    i2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    i2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    i2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    i2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    i2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    i2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    i2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    i2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    i2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    i2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    i2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    i2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    i2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    i2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    i2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  spinorFloat a0_re, a0_im;
+  spinorFloat a1_re, a1_im;
+  spinorFloat a2_re, a2_im;
+  spinorFloat b0_re, b0_im;
+  spinorFloat b1_re, b1_im;
+  spinorFloat b2_re, b2_im;
+  
+  {
+    // project spinor into half spinors
+    a0_re = +i00_re-i20_re;
+    a0_im = +i00_im-i20_im;
+    a1_re = +i01_re-i21_re;
+    a1_im = +i01_im-i21_im;
+    a2_re = +i02_re-i22_re;
+    a2_im = +i02_im-i22_im;
+    b0_re = +i10_re-i30_re;
+    b0_im = +i10_im-i30_im;
+    b1_re = +i11_re-i31_re;
+    b1_im = +i11_im-i31_im;
+    b2_re = +i12_re-i32_re;
+    b2_im = +i12_im-i32_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o1_00_re += A0_re;
+    o1_00_im += A0_im;
+    o1_10_re += B0_re;
+    o1_10_im += B0_im;
+    o1_20_re -= A0_re;
+    o1_20_im -= A0_im;
+    o1_30_re -= B0_re;
+    o1_30_im -= B0_im;
+    
+    o1_01_re += A1_re;
+    o1_01_im += A1_im;
+    o1_11_re += B1_re;
+    o1_11_im += B1_im;
+    o1_21_re -= A1_re;
+    o1_21_im -= A1_im;
+    o1_31_re -= B1_re;
+    o1_31_im -= B1_im;
+    
+    o1_02_re += A2_re;
+    o1_02_im += A2_im;
+    o1_12_re += B2_re;
+    o1_12_im += B2_im;
+    o1_22_re -= A2_re;
+    o1_22_im -= A2_im;
+    o1_32_re -= B2_re;
+    o1_32_im -= B2_im;
+    
+  }
+  {
+    // project spinor into half spinors
+    a0_re = +i2_00_re-i2_20_re;
+    a0_im = +i2_00_im-i2_20_im;
+    a1_re = +i2_01_re-i2_21_re;
+    a1_im = +i2_01_im-i2_21_im;
+    a2_re = +i2_02_re-i2_22_re;
+    a2_im = +i2_02_im-i2_22_im;
+    b0_re = +i2_10_re-i2_30_re;
+    b0_im = +i2_10_im-i2_30_im;
+    b1_re = +i2_11_re-i2_31_re;
+    b1_im = +i2_11_im-i2_31_im;
+    b2_re = +i2_12_re-i2_32_re;
+    b2_im = +i2_12_im-i2_32_im;
+    
+    // multiply row 0
+    spinorFloat A0_re = 0;
+    A0_re += gT00_re * a0_re;
+    A0_re -= gT00_im * a0_im;
+    A0_re += gT01_re * a1_re;
+    A0_re -= gT01_im * a1_im;
+    A0_re += gT02_re * a2_re;
+    A0_re -= gT02_im * a2_im;
+    spinorFloat A0_im = 0;
+    A0_im += gT00_re * a0_im;
+    A0_im += gT00_im * a0_re;
+    A0_im += gT01_re * a1_im;
+    A0_im += gT01_im * a1_re;
+    A0_im += gT02_re * a2_im;
+    A0_im += gT02_im * a2_re;
+    spinorFloat B0_re = 0;
+    B0_re += gT00_re * b0_re;
+    B0_re -= gT00_im * b0_im;
+    B0_re += gT01_re * b1_re;
+    B0_re -= gT01_im * b1_im;
+    B0_re += gT02_re * b2_re;
+    B0_re -= gT02_im * b2_im;
+    spinorFloat B0_im = 0;
+    B0_im += gT00_re * b0_im;
+    B0_im += gT00_im * b0_re;
+    B0_im += gT01_re * b1_im;
+    B0_im += gT01_im * b1_re;
+    B0_im += gT02_re * b2_im;
+    B0_im += gT02_im * b2_re;
+    
+    // multiply row 1
+    spinorFloat A1_re = 0;
+    A1_re += gT10_re * a0_re;
+    A1_re -= gT10_im * a0_im;
+    A1_re += gT11_re * a1_re;
+    A1_re -= gT11_im * a1_im;
+    A1_re += gT12_re * a2_re;
+    A1_re -= gT12_im * a2_im;
+    spinorFloat A1_im = 0;
+    A1_im += gT10_re * a0_im;
+    A1_im += gT10_im * a0_re;
+    A1_im += gT11_re * a1_im;
+    A1_im += gT11_im * a1_re;
+    A1_im += gT12_re * a2_im;
+    A1_im += gT12_im * a2_re;
+    spinorFloat B1_re = 0;
+    B1_re += gT10_re * b0_re;
+    B1_re -= gT10_im * b0_im;
+    B1_re += gT11_re * b1_re;
+    B1_re -= gT11_im * b1_im;
+    B1_re += gT12_re * b2_re;
+    B1_re -= gT12_im * b2_im;
+    spinorFloat B1_im = 0;
+    B1_im += gT10_re * b0_im;
+    B1_im += gT10_im * b0_re;
+    B1_im += gT11_re * b1_im;
+    B1_im += gT11_im * b1_re;
+    B1_im += gT12_re * b2_im;
+    B1_im += gT12_im * b2_re;
+    
+    // multiply row 2
+    spinorFloat A2_re = 0;
+    A2_re += gT20_re * a0_re;
+    A2_re -= gT20_im * a0_im;
+    A2_re += gT21_re * a1_re;
+    A2_re -= gT21_im * a1_im;
+    A2_re += gT22_re * a2_re;
+    A2_re -= gT22_im * a2_im;
+    spinorFloat A2_im = 0;
+    A2_im += gT20_re * a0_im;
+    A2_im += gT20_im * a0_re;
+    A2_im += gT21_re * a1_im;
+    A2_im += gT21_im * a1_re;
+    A2_im += gT22_re * a2_im;
+    A2_im += gT22_im * a2_re;
+    spinorFloat B2_re = 0;
+    B2_re += gT20_re * b0_re;
+    B2_re -= gT20_im * b0_im;
+    B2_re += gT21_re * b1_re;
+    B2_re -= gT21_im * b1_im;
+    B2_re += gT22_re * b2_re;
+    B2_re -= gT22_im * b2_im;
+    spinorFloat B2_im = 0;
+    B2_im += gT20_re * b0_im;
+    B2_im += gT20_im * b0_re;
+    B2_im += gT21_re * b1_im;
+    B2_im += gT21_im * b1_re;
+    B2_im += gT22_re * b2_im;
+    B2_im += gT22_im * b2_re;
+    
+    o2_00_re += A0_re;
+    o2_00_im += A0_im;
+    o2_10_re += B0_re;
+    o2_10_im += B0_im;
+    o2_20_re -= A0_re;
+    o2_20_im -= A0_im;
+    o2_30_re -= B0_re;
+    o2_30_im -= B0_im;
+    
+    o2_01_re += A1_re;
+    o2_01_im += A1_im;
+    o2_11_re += B1_re;
+    o2_11_im += B1_im;
+    o2_21_re -= A1_re;
+    o2_21_im -= A1_im;
+    o2_31_re -= B1_re;
+    o2_31_im -= B1_im;
+    
+    o2_02_re += A2_re;
+    o2_02_im += A2_im;
+    o2_12_re += B2_re;
+    o2_12_im += B2_im;
+    o2_22_re -= A2_re;
+    o2_22_im -= A2_im;
+    o2_32_re -= B2_re;
+    o2_32_im -= B2_im;
+    
+  }
+}
+
+if (arg.type == QUDA_DEG_DSLASH_TWIST_INV) {
+  spinorFloat tmp00_re = o1_00_re;  spinorFloat tmp00_im = o1_00_im;
+  spinorFloat tmp2_00_re = o2_00_re;  spinorFloat tmp2_00_im = o2_00_im;
+  spinorFloat tmp01_re = o1_01_re;  spinorFloat tmp01_im = o1_01_im;
+  spinorFloat tmp2_01_re = o2_01_re;  spinorFloat tmp2_01_im = o2_01_im;
+  spinorFloat tmp02_re = o1_02_re;  spinorFloat tmp02_im = o1_02_im;
+  spinorFloat tmp2_02_re = o2_02_re;  spinorFloat tmp2_02_im = o2_02_im;
+  spinorFloat tmp10_re = o1_10_re;  spinorFloat tmp10_im = o1_10_im;
+  spinorFloat tmp2_10_re = o2_10_re;  spinorFloat tmp2_10_im = o2_10_im;
+  spinorFloat tmp11_re = o1_11_re;  spinorFloat tmp11_im = o1_11_im;
+  spinorFloat tmp2_11_re = o2_11_re;  spinorFloat tmp2_11_im = o2_11_im;
+  spinorFloat tmp12_re = o1_12_re;  spinorFloat tmp12_im = o1_12_im;
+  spinorFloat tmp2_12_re = o2_12_re;  spinorFloat tmp2_12_im = o2_12_im;
+  spinorFloat tmp20_re = o1_20_re;  spinorFloat tmp20_im = o1_20_im;
+  spinorFloat tmp2_20_re = o2_20_re;  spinorFloat tmp2_20_im = o2_20_im;
+  spinorFloat tmp21_re = o1_21_re;  spinorFloat tmp21_im = o1_21_im;
+  spinorFloat tmp2_21_re = o2_21_re;  spinorFloat tmp2_21_im = o2_21_im;
+  spinorFloat tmp22_re = o1_22_re;  spinorFloat tmp22_im = o1_22_im;
+  spinorFloat tmp2_22_re = o2_22_re;  spinorFloat tmp2_22_im = o2_22_im;
+  spinorFloat tmp30_re = o1_30_re;  spinorFloat tmp30_im = o1_30_im;
+  spinorFloat tmp2_30_re = o2_30_re;  spinorFloat tmp2_30_im = o2_30_im;
+  spinorFloat tmp31_re = o1_31_re;  spinorFloat tmp31_im = o1_31_im;
+  spinorFloat tmp2_31_re = o2_31_re;  spinorFloat tmp2_31_im = o2_31_im;
+  spinorFloat tmp32_re = o1_32_re;  spinorFloat tmp32_im = o1_32_im;
+  spinorFloat tmp2_32_re = o2_32_re;  spinorFloat tmp2_32_im = o2_32_im;
+  
+  o1_00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+  o1_00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+  o1_01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+  o1_01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+  o1_02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+  o1_02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+  o1_10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+  o1_10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+  o1_11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+  o1_11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+  o1_12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+  o1_12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+  o1_20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+  o1_20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+  o1_21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+  o1_21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+  o1_22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+  o1_22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+  o1_30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+  o1_30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+  o1_31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+  o1_31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+  o1_32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+  o1_32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+  o2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+  o2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+  o2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+  o2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+  o2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+  o2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+  o2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+  o2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+  o2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+  o2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+  o2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+  o2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+  o2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+  o2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+  o2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+  o2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+  o2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+  o2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+  o2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+  o2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+  o2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+  o2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+  o2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+  o2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+}
+
+// out = x + k * D in, or T x + k * D in
+if (arg.x) {
+  spinorFloat ACC1[24], ACC2[24];
+  READ_ACCUM_FLAVOR(ACC1, 0);
+  READ_ACCUM_FLAVOR(ACC2, 1);
+  
+  if (arg.type == QUDA_DEG_DSLASH_TWIST_XPAY) {
+    spinorFloat tmp00_re = acc1_00_re;  spinorFloat tmp00_im = acc1_00_im;
+    spinorFloat tmp2_00_re = acc2_00_re;  spinorFloat tmp2_00_im = acc2_00_im;
+    spinorFloat tmp01_re = acc1_01_re;  spinorFloat tmp01_im = acc1_01_im;
+    spinorFloat tmp2_01_re = acc2_01_re;  spinorFloat tmp2_01_im = acc2_01_im;
+    spinorFloat tmp02_re = acc1_02_re;  spinorFloat tmp02_im = acc1_02_im;
+    spinorFloat tmp2_02_re = acc2_02_re;  spinorFloat tmp2_02_im = acc2_02_im;
+    spinorFloat tmp10_re = acc1_10_re;  spinorFloat tmp10_im = acc1_10_im;
+    spinorFloat tmp2_10_re = acc2_10_re;  spinorFloat tmp2_10_im = acc2_10_im;
+    spinorFloat tmp11_re = acc1_11_re;  spinorFloat tmp11_im = acc1_11_im;
+    spinorFloat tmp2_11_re = acc2_11_re;  spinorFloat tmp2_11_im = acc2_11_im;
+    spinorFloat tmp12_re = acc1_12_re;  spinorFloat tmp12_im = acc1_12_im;
+    spinorFloat tmp2_12_re = acc2_12_re;  spinorFloat tmp2_12_im = acc2_12_im;
+    spinorFloat tmp20_re = acc1_20_re;  spinorFloat tmp20_im = acc1_20_im;
+    spinorFloat tmp2_20_re = acc2_20_re;  spinorFloat tmp2_20_im = acc2_20_im;
+    spinorFloat tmp21_re = acc1_21_re;  spinorFloat tmp21_im = acc1_21_im;
+    spinorFloat tmp2_21_re = acc2_21_re;  spinorFloat tmp2_21_im = acc2_21_im;
+    spinorFloat tmp22_re = acc1_22_re;  spinorFloat tmp22_im = acc1_22_im;
+    spinorFloat tmp2_22_re = acc2_22_re;  spinorFloat tmp2_22_im = acc2_22_im;
+    spinorFloat tmp30_re = acc1_30_re;  spinorFloat tmp30_im = acc1_30_im;
+    spinorFloat tmp2_30_re = acc2_30_re;  spinorFloat tmp2_30_im = acc2_30_im;
+    spinorFloat tmp31_re = acc1_31_re;  spinorFloat tmp31_im = acc1_31_im;
+    spinorFloat tmp2_31_re = acc2_31_re;  spinorFloat tmp2_31_im = acc2_31_im;
+    spinorFloat tmp32_re = acc1_32_re;  spinorFloat tmp32_im = acc1_32_im;
+    spinorFloat tmp2_32_re = acc2_32_re;  spinorFloat tmp2_32_im = acc2_32_im;
+    
+    acc1_00_re = arg.c*((tmp00_re - arg.a*tmp00_im) + arg.b*tmp2_00_re);
+    acc1_00_im = arg.c*((tmp00_im + arg.a*tmp00_re) + arg.b*tmp2_00_im);
+    acc1_01_re = arg.c*((tmp01_re - arg.a*tmp01_im) + arg.b*tmp2_01_re);
+    acc1_01_im = arg.c*((tmp01_im + arg.a*tmp01_re) + arg.b*tmp2_01_im);
+    acc1_02_re = arg.c*((tmp02_re - arg.a*tmp02_im) + arg.b*tmp2_02_re);
+    acc1_02_im = arg.c*((tmp02_im + arg.a*tmp02_re) + arg.b*tmp2_02_im);
+    acc1_10_re = arg.c*((tmp10_re - arg.a*tmp10_im) + arg.b*tmp2_10_re);
+    acc1_10_im = arg.c*((tmp10_im + arg.a*tmp10_re) + arg.b*tmp2_10_im);
+    acc1_11_re = arg.c*((tmp11_re - arg.a*tmp11_im) + arg.b*tmp2_11_re);
+    acc1_11_im = arg.c*((tmp11_im + arg.a*tmp11_re) + arg.b*tmp2_11_im);
+    acc1_12_re = arg.c*((tmp12_re - arg.a*tmp12_im) + arg.b*tmp2_12_re);
+    acc1_12_im = arg.c*((tmp12_im + arg.a*tmp12_re) + arg.b*tmp2_12_im);
+    acc1_20_re = arg.c*((tmp20_re + arg.a*tmp20_im) + arg.b*tmp2_20_re);
+    acc1_20_im = arg.c*((tmp20_im - arg.a*tmp20_re) + arg.b*tmp2_20_im);
+    acc1_21_re = arg.c*((tmp21_re + arg.a*tmp21_im) + arg.b*tmp2_21_re);
+    acc1_21_im = arg.c*((tmp21_im - arg.a*tmp21_re) + arg.b*tmp2_21_im);
+    acc1_22_re = arg.c*((tmp22_re + arg.a*tmp22_im) + arg.b*tmp2_22_re);
+    acc1_22_im = arg.c*((tmp22_im - arg.a*tmp22_re) + arg.b*tmp2_22_im);
+    acc1_30_re = arg.c*((tmp30_re + arg.a*tmp30_im) + arg.b*tmp2_30_re);
+    acc1_30_im = arg.c*((tmp30_im - arg.a*tmp30_re) + arg.b*tmp2_30_im);
+    acc1_31_re = arg.c*((tmp31_re + arg.a*tmp31_im) + arg.b*tmp2_31_re);
+    acc1_31_im = arg.c*((tmp31_im - arg.a*tmp31_re) + arg.b*tmp2_31_im);
+    acc1_32_re = arg.c*((tmp32_re + arg.a*tmp32_im) + arg.b*tmp2_32_re);
+    acc1_32_im = arg.c*((tmp32_im - arg.a*tmp32_re) + arg.b*tmp2_32_im);
+    acc2_00_re = arg.c*((tmp2_00_re + arg.a*tmp2_00_im) + arg.b*tmp00_re);
+    acc2_00_im = arg.c*((tmp2_00_im - arg.a*tmp2_00_re) + arg.b*tmp00_im);
+    acc2_01_re = arg.c*((tmp2_01_re + arg.a*tmp2_01_im) + arg.b*tmp01_re);
+    acc2_01_im = arg.c*((tmp2_01_im - arg.a*tmp2_01_re) + arg.b*tmp01_im);
+    acc2_02_re = arg.c*((tmp2_02_re + arg.a*tmp2_02_im) + arg.b*tmp02_re);
+    acc2_02_im = arg.c*((tmp2_02_im - arg.a*tmp2_02_re) + arg.b*tmp02_im);
+    acc2_10_re = arg.c*((tmp2_10_re + arg.a*tmp2_10_im) + arg.b*tmp10_re);
+    acc2_10_im = arg.c*((tmp2_10_im - arg.a*tmp2_10_re) + arg.b*tmp10_im);
+    acc2_11_re = arg.c*((tmp2_11_re + arg.a*tmp2_11_im) + arg.b*tmp11_re);
+    acc2_11_im = arg.c*((tmp2_11_im - arg.a*tmp2_11_re) + arg.b*tmp11_im);
+    acc2_12_re = arg.c*((tmp2_12_re + arg.a*tmp2_12_im) + arg.b*tmp12_re);
+    acc2_12_im = arg.c*((tmp2_12_im - arg.a*tmp2_12_re) + arg.b*tmp12_im);
+    acc2_20_re = arg.c*((tmp2_20_re - arg.a*tmp2_20_im) + arg.b*tmp20_re);
+    acc2_20_im = arg.c*((tmp2_20_im + arg.a*tmp2_20_re) + arg.b*tmp20_im);
+    acc2_21_re = arg.c*((tmp2_21_re - arg.a*tmp2_21_im) + arg.b*tmp21_re);
+    acc2_21_im = arg.c*((tmp2_21_im + arg.a*tmp2_21_re) + arg.b*tmp21_im);
+    acc2_22_re = arg.c*((tmp2_22_re - arg.a*tmp2_22_im) + arg.b*tmp22_re);
+    acc2_22_im = arg.c*((tmp2_22_im + arg.a*tmp2_22_re) + arg.b*tmp22_im);
+    acc2_30_re = arg.c*((tmp2_30_re - arg.a*tmp2_30_im) + arg.b*tmp30_re);
+    acc2_30_im = arg.c*((tmp2_30_im + arg.a*tmp2_30_re) + arg.b*tmp30_im);
+    acc2_31_re = arg.c*((tmp2_31_re - arg.a*tmp2_31_im) + arg.b*tmp31_re);
+    acc2_31_im = arg.c*((tmp2_31_im + arg.a*tmp2_31_re) + arg.b*tmp31_im);
+    acc2_32_re = arg.c*((tmp2_32_re - arg.a*tmp2_32_im) + arg.b*tmp32_re);
+    acc2_32_im = arg.c*((tmp2_32_im + arg.a*tmp2_32_re) + arg.b*tmp32_im);
+  }
+  
+  o1_00_re = acc1_00_re + arg.k*o1_00_re;
+  o1_00_im = acc1_00_im + arg.k*o1_00_im;
+  o1_01_re = acc1_01_re + arg.k*o1_01_re;
+  o1_01_im = acc1_01_im + arg.k*o1_01_im;
+  o1_02_re = acc1_02_re + arg.k*o1_02_re;
+  o1_02_im = acc1_02_im + arg.k*o1_02_im;
+  o1_10_re = acc1_10_re + arg.k*o1_10_re;
+  o1_10_im = acc1_10_im + arg.k*o1_10_im;
+  o1_11_re = acc1_11_re + arg.k*o1_11_re;
+  o1_11_im = acc1_11_im + arg.k*o1_11_im;
+  o1_12_re = acc1_12_re + arg.k*o1_12_re;
+  o1_12_im = acc1_12_im + arg.k*o1_12_im;
+  o1_20_re = acc1_20_re + arg.k*o1_20_re;
+  o1_20_im = acc1_20_im + arg.k*o1_20_im;
+  o1_21_re = acc1_21_re + arg.k*o1_21_re;
+  o1_21_im = acc1_21_im + arg.k*o1_21_im;
+  o1_22_re = acc1_22_re + arg.k*o1_22_re;
+  o1_22_im = acc1_22_im + arg.k*o1_22_im;
+  o1_30_re = acc1_30_re + arg.k*o1_30_re;
+  o1_30_im = acc1_30_im + arg.k*o1_30_im;
+  o1_31_re = acc1_31_re + arg.k*o1_31_re;
+  o1_31_im = acc1_31_im + arg.k*o1_31_im;
+  o1_32_re = acc1_32_re + arg.k*o1_32_re;
+  o1_32_im = acc1_32_im + arg.k*o1_32_im;
+  o2_00_re = acc2_00_re + arg.k*o2_00_re;
+  o2_00_im = acc2_00_im + arg.k*o2_00_im;
+  o2_01_re = acc2_01_re + arg.k*o2_01_re;
+  o2_01_im = acc2_01_im + arg.k*o2_01_im;
+  o2_02_re = acc2_02_re + arg.k*o2_02_re;
+  o2_02_im = acc2_02_im + arg.k*o2_02_im;
+  o2_10_re = acc2_10_re + arg.k*o2_10_re;
+  o2_10_im = acc2_10_im + arg.k*o2_10_im;
+  o2_11_re = acc2_11_re + arg.k*o2_11_re;
+  o2_11_im = acc2_11_im + arg.k*o2_11_im;
+  o2_12_re = acc2_12_re + arg.k*o2_12_re;
+  o2_12_im = acc2_12_im + arg.k*o2_12_im;
+  o2_20_re = acc2_20_re + arg.k*o2_20_re;
+  o2_20_im = acc2_20_im + arg.k*o2_20_im;
+  o2_21_re = acc2_21_re + arg.k*o2_21_re;
+  o2_21_im = acc2_21_im + arg.k*o2_21_im;
+  o2_22_re = acc2_22_re + arg.k*o2_22_re;
+  o2_22_im = acc2_22_im + arg.k*o2_22_im;
+  o2_30_re = acc2_30_re + arg.k*o2_30_re;
+  o2_30_im = acc2_30_im + arg.k*o2_30_im;
+  o2_31_re = acc2_31_re + arg.k*o2_31_re;
+  o2_31_im = acc2_31_im + arg.k*o2_31_im;
+  o2_32_re = acc2_32_re + arg.k*o2_32_re;
+  o2_32_im = acc2_32_im + arg.k*o2_32_im;
+}
+
+// write both flavors back to host memory
+WRITE_SPINOR_FLAVOR(O1, 0);
+WRITE_SPINOR_FLAVOR(O2, 1);
+
+// undefine to prevent warnings when the core is included again
+#undef i00_re
+#undef i00_im
+#undef i01_re
+#undef i01_im
+#undef i02_re
+#undef i02_im
+#undef i10_re
+#undef i10_im
+#undef i11_re
+#undef i11_im
+#undef i12_re
+#undef i12_im
+#undef i20_re
+#undef i20_im
+#undef i21_re
+#undef i21_im
+#undef i22_re
+#undef i22_im
+#undef i30_re
+#undef i30_im
+#undef i31_re
+#undef i31_im
+#undef i32_re
+#undef i32_im
+#undef i2_00_re
+#undef i2_00_im
+#undef i2_01_re
+#undef i2_01_im
+#undef i2_02_re
+#undef i2_02_im
+#undef i2_10_re
+#undef i2_10_im
+#undef i2_11_re
+#undef i2_11_im
+#undef i2_12_re
+#undef i2_12_im
+#undef i2_20_re
+#undef i2_20_im
+#undef i2_21_re
+#undef i2_21_im
+#undef i2_22_re
+#undef i2_22_im
+#undef i2_30_re
+#undef i2_30_im
+#undef i2_31_re
+#undef i2_31_im
+#undef i2_32_re
+#undef i2_32_im
+#undef acc1_00_re
+#undef acc1_00_im
+#undef acc1_01_re
+#undef acc1_01_im
+#undef acc1_02_re
+#undef acc1_02_im
+#undef acc1_10_re
+#undef acc1_10_im
+#undef acc1_11_re
+#undef acc1_11_im
+#undef acc1_12_re
+#undef acc1_12_im
+#undef acc1_20_re
+#undef acc1_20_im
+#undef acc1_21_re
+#undef acc1_21_im
+#undef acc1_22_re
+#undef acc1_22_im
+#undef acc1_30_re
+#undef acc1_30_im
+#undef acc1_31_re
+#undef acc1_31_im
+#undef acc1_32_re
+#undef acc1_32_im
+#undef acc2_00_re
+#undef acc2_00_im
+#undef acc2_01_re
+#undef acc2_01_im
+#undef acc2_02_re
+#undef acc2_02_im
+#undef acc2_10_re
+#undef acc2_10_im
+#undef acc2_11_re
+#undef acc2_11_im
+#undef acc2_12_re
+#undef acc2_12_im
+#undef acc2_20_re
+#undef acc2_20_im
+#undef acc2_21_re
+#undef acc2_21_im
+#undef acc2_22_re
+#undef acc2_22_im
+#undef acc2_30_re
+#undef acc2_30_im
+#undef acc2_31_re
+#undef acc2_31_im
+#undef acc2_32_re
+#undef acc2_32_im
+#undef g00_re
+#undef g00_im
+#undef g01_re
+#undef g01_im
+#undef g02_re
+#undef g02_im
+#undef g10_re
+#undef g10_im
+#undef g11_re
+#undef g11_im
+#undef g12_re
+#undef g12_im
+#undef g20_re
+#undef g20_im
+#undef g21_re
+#undef g21_im
+#undef g22_re
+#undef g22_im
+#undef gT00_re
+#undef gT00_im
+#undef gT01_re
+#undef gT01_im
+#undef gT02_re
+#undef gT02_im
+#undef gT10_re
+#undef gT10_im
+#undef gT11_re
+#undef gT11_im
+#undef gT12_re
+#undef gT12_im
+#undef gT20_re
+#undef gT20_im
+#undef gT21_re
+#undef gT21_im
+#undef gT22_re
+#undef gT22_im
+#undef o1_00_re
+#undef o1_00_im
+#undef o1_01_re
+#undef o1_01_im
+#undef o1_02_re
+#undef o1_02_im
+#undef o1_10_re
+#undef o1_10_im
+#undef o1_11_re
+#undef o1_11_im
+#undef o1_12_re
+#undef o1_12_im
+#undef o1_20_re
+#undef o1_20_im
+#undef o1_21_re
+#undef o1_21_im
+#undef o1_22_re
+#undef o1_22_im
+#undef o1_30_re
+#undef o1_30_im
+#undef o1_31_re
+#undef o1_31_im
+#undef o1_32_re
+#undef o1_32_im
+#undef o2_00_re
+#undef o2_00_im
+#undef o2_01_re
+#undef o2_01_im
+#undef o2_02_re
+#undef o2_02_im
+#undef o2_10_re
+#undef o2_10_im
+#undef o2_11_re
+#undef o2_11_im
+#undef o2_12_re
+#undef o2_12_im
+#undef o2_20_re
+#undef o2_20_im
+#undef o2_21_re
+#undef o2_21_im
+#undef o2_22_re
+#undef o2_22_im
+#undef o2_30_re
+#undef o2_30_im
+#undef o2_31_re
+#undef o2_31_im
+#undef o2_32_re
+#undef o2_32_im
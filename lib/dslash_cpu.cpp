@@ -0,0 +1,2195 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <clover_field.h>
+#include <face_quda.h>
+#include <dslash_quda.h>
+
+#ifdef HOST_DSLASH
+#include <host_simd.h>
+#endif
+
+/**
+   Host (CPU) implementations of the Dirac operators.  These act on
+   cpuColorSpinorField / cpuGaugeField objects in SPACE_SPIN_COLOR /
+   QDP order, are threaded with OpenMP over the checkerboarded
+   volume, and use the short vectors of host_simd.h for the inner
+   arithmetic.  The Wilson, clover, twisted-mass and domain-wall
+   operators come in two versions (see setHostDslashGenerated).  The
+   hand-written kernels vectorize over the spin pair (or the fifth
+   dimension) and follow the operation order of the reference
+   implementations in tests/, so they agree with them to the last
+   bit when both are built without FMA contraction (as make.inc
+   does).  The generated kernels are the *_cpu_core.h files emitted by
+   the scripts in lib/generate/ alongside the CUDA ones: fully
+   unrolled and spin projected, with each vector lane holding a
+   different site, which pays off with the wide vectors of AVX2 and
+   AVX-512, and agree with the reference to rounding.  Both work in
+   the DeGrand-Rossi basis of the host fields.
+
+   Boundary conditions follow the GPU kernels: a dimension which is
+   partitioned across processes takes its neighbours from the ghost
+   zone if commDim[mu] is set and drops them otherwise (Dirichlet
+   boundaries, as used by the domain-decomposition preconditioners);
+   an unpartitioned dimension is periodic.
+ */
+
+namespace quda {
+
+  // whether the host dslash overlaps the halo exchange with the interior
+  static bool hostOverlap = true;
+
+  void setHostDslashOverlap(bool overlap) { hostOverlap = overlap; }
+
+  bool getHostDslashOverlap() { return hostOverlap; }
+
+  // whether the host dslash uses the generated kernels, by default
+  // only where the vectors are wide enough for them to win
+#if defined(__AVX2__) || defined(__AVX512F__)
+  static bool hostGenerated = true;
+#else
+  static bool hostGenerated = false;
+#endif
+
+  void setHostDslashGenerated(bool generated) { hostGenerated = generated; }
+
+  bool getHostDslashGenerated() { return hostGenerated; }
+
+#ifdef HOST_DSLASH
+
+  /**
+     Lattice geometry and neighbour lookup shared by the host kernels.
+     Sites are labelled by their checkerboard index on the local 4-d
+     lattice, and the ghost zone indexing matches that produced by
+     cpuColorSpinorField::packGhost and cpuGaugeField::exchangeGhost.
+   */
+  struct HostGeometry {
+    int X[4];            // full local lattice dimensions
+    int volumeCB;        // checkerboarded 4-d volume
+    int faceVolumeCB[4]; // checkerboarded volume of a single face
+    bool partitioned[4]; // whether the dimension is split across processes
+    bool comms[4];       // whether to use the ghost zone when partitioned
+
+    HostGeometry(const int *x, const int *commDim) {
+      volumeCB = 1;
+      for (int d=0; d<4; d++) { X[d] = x[d]; volumeCB *= x[d]; }
+      volumeCB /= 2;
+      for (int d=0; d<4; d++) {
+	faceVolumeCB[d] = 2*volumeCB / X[d] / 2;
+	partitioned[d] = commDimPartitioned(d);
+	comms[d] = commDim[d];
+      }
+    }
+
+    /** Full lattice coordinates of checkerboard site cb */
+    inline void coords(int x[4], int cb, int parity) const {
+      int za = cb / (X[0]/2);
+      int x1h = cb - za*(X[0]/2);
+      int zb = za / X[1];
+      x[1] = za - zb*X[1];
+      x[3] = zb / X[2];
+      x[2] = zb - x[3]*X[2];
+      x[0] = 2*x1h + ((x[1] + x[2] + x[3] + parity) & 1);
+    }
+
+    inline int index(const int x[4]) const {
+      return (((x[3]*X[2] + x[2])*X[1] + x[1])*X[0] + x[0]) >> 1;
+    }
+
+    /** Checkerboard index of x in the ghost zone of dimension mu, at
+	the given depth into the face */
+    inline int faceIndex(const int x[4], int mu, int depth) const {
+      int idx = depth;
+      for (int d=3; d>=0; d--) if (d != mu) idx = idx*X[d] + x[d];
+      return idx >> 1;
+    }
+
+    /**
+       Locates the site hop steps from x in dimension mu.  Returns 0
+       if it is local (idx is its checkerboard index), 1 if it lies
+       in a ghost zone of the given depth (idx is the face index) and
+       -1 if the hop crosses a Dirichlet boundary.
+     */
+    inline int neighbor(int &idx, const int x[4], int mu, int hop, int nFace) const {
+      int y[4] = {x[0], x[1], x[2], x[3]};
+      y[mu] += hop;
+      if (y[mu] >= 0 && y[mu] < X[mu]) {
+	idx = index(y);
+	return 0;
+      } else if (!partitioned[mu]) {
+	y[mu] = (y[mu] + X[mu]) % X[mu];
+	idx = index(y);
+	return 0;
+      } else if (!comms[mu]) {
+	return -1;
+      }
+      idx = faceIndex(y, mu, hop > 0 ? y[mu] - X[mu] : y[mu] + nFace);
+      return 1;
+    }
+
+    /** The dimensions (bit mu) in which x reads a ghost zone of the given depth */
+    inline int ghostMask(const int x[4], int nFace) const {
+      int mask = 0;
+      for (int d=0; d<4; d++)
+	if (partitioned[d] && comms[d] && (x[d] < nFace || x[d] >= X[d] - nFace)) mask |= 1 << d;
+      return mask;
+    }
+  };
+
+  /**
+     The sites swept by a host kernel: the whole checkerboard volume,
+     or lists of sites of the output parity (s = 0) and, for the odd
+     slices of a domain wall field, of the other parity (s = 1).
+   */
+  struct HostSites {
+    const int *list[2];
+    int n[2];
+
+    HostSites(int volumeCB) {
+      for (int s=0; s<2; s++) { list[s] = 0; n[s] = volumeCB; }
+    }
+
+    HostSites(const int *list0, int n0, const int *list1, int n1) {
+      list[0] = list0; n[0] = n0;
+      list[1] = list1; n[1] = n1;
+    }
+
+    /** The checkerboard index of the k-th site */
+    inline int operator()(int s, int k) const { return list[s] ? list[s][k] : k; }
+  };
+
+  /**
+     The sites of each parity sorted by the set of dimensions whose
+     ghost zones they read (see HostGhost::apply), the interior
+     first: sites list[s][offset[s][m]] to list[s][offset[s][m+1]-1]
+     have ghost mask m.  They only depend on the geometry, so they are
+     built once and kept until freeHostDslashBuffer.
+   */
+  struct HostSiteLists {
+    int X[4];
+    int ghostDims; // dimensions (bit mu) whose ghost zones are read
+    int parity;
+    int nFace;
+    int nParity;
+    int *list[2];
+    int offset[2][17];
+  };
+
+  static std::vector<HostSiteLists*> siteLists;
+
+  static const HostSiteLists& hostSiteLists(const HostGeometry &geom, int parity, int nFace, int nParity) {
+    int ghostDims = 0;
+    for (int d=0; d<4; d++) if (geom.partitioned[d] && geom.comms[d]) ghostDims |= 1 << d;
+
+    for (size_t i=0; i<siteLists.size(); i++) {
+      const HostSiteLists &l = *siteLists[i];
+      if (l.X[0] == geom.X[0] && l.X[1] == geom.X[1] && l.X[2] == geom.X[2] && l.X[3] == geom.X[3] &&
+	  l.ghostDims == ghostDims && l.parity == parity && l.nFace == nFace && l.nParity == nParity)
+	return l;
+    }
+
+    HostSiteLists *l = new HostSiteLists;
+    for (int d=0; d<4; d++) l->X[d] = geom.X[d];
+    l->ghostDims = ghostDims;
+    l->parity = parity;
+    l->nFace = nFace;
+    l->nParity = nParity;
+
+    for (int s=0; s<2; s++) {
+      l->list[s] = 0;
+      for (int m=0; m<17; m++) l->offset[s][m] = 0;
+      if (s >= nParity) continue;
+      l->list[s] = (int*)safe_malloc(geom.volumeCB*sizeof(int));
+      int *mask = (int*)safe_malloc(geom.volumeCB*sizeof(int));
+#pragma omp parallel for schedule(static)
+      for (int i=0; i<geom.volumeCB; i++) {
+	int x[4];
+	geom.coords(x, i, parity ^ s);
+	mask[i] = geom.ghostMask(x, nFace);
+      }
+      for (int i=0; i<geom.volumeCB; i++) l->offset[s][mask[i]+1]++;
+      for (int m=0; m<16; m++) l->offset[s][m+1] += l->offset[s][m];
+      int next[16];
+      for (int m=0; m<16; m++) next[m] = l->offset[s][m];
+      for (int i=0; i<geom.volumeCB; i++) l->list[s][next[mask[i]]++] = i;
+      host_free(mask);
+    }
+
+    siteLists.push_back(l);
+    return *l;
+  }
+
+  /**
+     Storage of the links of a host gauge field.  Besides full 18-real
+     matrices, QDP-ordered fields may hold compressed links (see
+     QDPOrder in gauge_field_order.h): the first two rows (12) or two
+     phases and five elements (8) of an SU(3) link, with the
+     anisotropy and time boundary supplied at reconstruction as on the
+     GPU, or for the long links a U(3) matrix of norm scale stored as
+     13 or 9 reals whose last is its phase.  The kernels load the
+     packed reals and rebuild the links in registers, trading a few
+     dozen flops per link for a third to a half less link traffic.
+   */
+  template <typename Float>
+  struct HostLink {
+    QudaReconstructType reconstruct;
+    int length;       // reals per link
+    Float anisotropy; // u0 of the spatial links
+    Float tBoundary;  // u0 of the temporal links across the time boundary
+    Float invScale;   // 1/scale of the 13 and 9 reconstructions
+    bool firstT;      // whether this process holds the first time slice
+    bool lastT;       // and the last
+
+    HostLink(const cpuGaugeField &u)
+      : reconstruct(u.Reconstruct()), length(u.Reconstruct()), anisotropy(u.Anisotropy()),
+	tBoundary(u.TBoundary()), invScale(1.0/u.Scale()), firstT(comm_coord(3) == 0),
+	lastT(comm_coord(3) == comm_dim(3)-1) { }
+
+    /**
+       u0 of the 12 and 8 reconstructions, for the link in dimension
+       mu which leaves (back = 0) or enters (back = 1) a site on time
+       slice t, with ghost set if it is taken from the ghost zone
+     */
+    inline Float u0(int mu, int back, int t, int T, bool ghost) const {
+      if (mu < 3) return anisotropy;
+      const bool boundary = back ? t == 0 && (ghost ? firstT : lastT) : t == T-1 && lastT;
+      return boundary ? tBoundary : 1.0;
+    }
+
+    /**
+       Stands in for the links dropped at a Dirichlet boundary, where
+       the spinor is zero: a zero matrix, or for 8 and 9, which cannot
+       represent one, a cyclic permutation
+     */
+    inline const Float* dropped() const {
+      static const Float zero[18] = { };
+      static const Float cyclic[9] = { 0.0, 0.0, 1.0 };
+      return (length == 8 || length == 9) ? cyclic : zero;
+    }
+  };
+
+  // The few lane-wise steps of the reconstruction which are not
+  // arithmetic
+  template <typename Float, int N>
+  inline RealVec<Float,N> sqrtLanes(const RealVec<Float,N> &a) {
+    Float v[N];
+    a.store(v);
+    for (int k=0; k<N; k++) v[k] = v[k] > 0 ? sqrt(v[k]) : static_cast<Float>(0.0);
+    RealVec<Float,N> r;
+    r.load(v);
+    return r;
+  }
+
+  template <typename Float, int N>
+  inline RealVec<Float,N> recipLanes(const RealVec<Float,N> &a) {
+    Float v[N];
+    a.store(v);
+    for (int k=0; k<N; k++) v[k] = static_cast<Float>(1.0) / v[k];
+    RealVec<Float,N> r;
+    r.load(v);
+    return r;
+  }
+
+  template <typename Float, int N>
+  inline void sinCosLanes(RealVec<Float,N> &s, RealVec<Float,N> &c, const RealVec<Float,N> &a) {
+    Float v[N], sv[N], cv[N];
+    a.store(v);
+    for (int k=0; k<N; k++) { sv[k] = sin(v[k]); cv[k] = cos(v[k]); }
+    s.load(sv);
+    c.load(cv);
+  }
+
+  /** Multiplies the n complex numbers at u by cos + i sin */
+  template <typename Float, int N>
+  inline void rotateLanes(RealVec<Float,N> *u, int n, const RealVec<Float,N> &s, const RealVec<Float,N> &c) {
+    for (int j=0; j<n; j++) {
+      const RealVec<Float,N> re = u[2*j], im = u[2*j+1];
+      u[2*j] = c*re - s*im;
+      u[2*j+1] = c*im + s*re;
+    }
+  }
+
+  /** The third row of a 12-reconstructed link: f times the conjugate cross product of the first two */
+  template <typename Float, int N>
+  inline void thirdRow(RealVec<Float,N> *u, const RealVec<Float,N> &f) {
+    for (int c=0; c<3; c++) {
+      const int a = 2*((c+1)%3), b = 2*((c+2)%3);
+      const RealVec<Float,N> re = u[a]*u[6+b] - u[a+1]*u[7+b] - u[b]*u[6+a] + u[b+1]*u[7+a];
+      const RealVec<Float,N> im = u[b]*u[7+a] + u[b+1]*u[6+a] - u[a]*u[7+b] - u[a+1]*u[6+b];
+      u[12+2*c] = f*re;
+      u[13+2*c] = f*im;
+    }
+  }
+
+  /** The link from its 8-real form, as Reconstruct<8> in gauge_field_order.h, with rows of norm 1/u0 */
+  template <typename Float, int N>
+  inline void linkFrom8(RealVec<Float,N> *u, const RealVec<Float,N> &u0) {
+    typedef RealVec<Float,N> Vec;
+    const Vec u02_inv = recipLanes(u0*u0);
+    const Vec row_sum = u[2]*u[2] + u[3]*u[3] + u[4]*u[4] + u[5]*u[5];
+    const Vec theta20 = u[1];
+    Vec s, c;
+
+    // first row then first column
+    sinCosLanes(s, c, u[0]);
+    const Vec U00_mag = sqrtLanes(u02_inv - row_sum);
+    u[0] = U00_mag*c;
+    u[1] = U00_mag*s;
+    sinCosLanes(s, c, theta20);
+    const Vec U20_mag = sqrtLanes(u02_inv - u[0]*u[0] - u[1]*u[1] - u[6]*u[6] - u[7]*u[7]);
+    u[12] = U20_mag*c;
+    u[13] = U20_mag*s;
+
+    // the rest from the SU(2) rotation, with A = u0 conj(U00) U10
+    const Vec r_inv2 = recipLanes(u0*row_sum);
+    Vec Ar = u0*(u[0]*u[6] + u[1]*u[7]), Ai = u0*(u[0]*u[7] - u[1]*u[6]);
+    u[8] = -r_inv2*(u[12]*u[4] - u[13]*u[5] + Ar*u[2] - Ai*u[3]);
+    u[9] = r_inv2*(u[12]*u[5] + u[13]*u[4] - Ar*u[3] - Ai*u[2]);
+    u[10] = r_inv2*(u[12]*u[2] - u[13]*u[3] - Ar*u[4] + Ai*u[5]);
+    u[11] = -r_inv2*(u[12]*u[3] + u[13]*u[2] + Ar*u[5] + Ai*u[4]);
+
+    // A = u0 conj(U00) U20
+    Ar = u0*(u[0]*u[12] + u[1]*u[13]);
+    Ai = u0*(u[0]*u[13] - u[1]*u[12]);
+    u[14] = r_inv2*(u[6]*u[4] - u[7]*u[5] - Ar*u[2] + Ai*u[3]);
+    u[15] = -r_inv2*(u[6]*u[5] + u[7]*u[4] + Ar*u[3] + Ai*u[2]);
+    u[16] = -r_inv2*(u[6]*u[2] - u[7]*u[3] + Ar*u[4] - Ai*u[5]);
+    u[17] = r_inv2*(u[6]*u[3] + u[7]*u[2] - Ar*u[5] - Ai*u[4]);
+  }
+
+  /**
+     Rebuilds the links held packed in u[0..link.length) as full
+     matrices in u[0..18), with u0 for the 12 and 8 reconstructions
+   */
+  template <typename Float, int N>
+  inline void unpackLink(RealVec<Float,N> *u, const HostLink<Float> &link, const RealVec<Float,N> &u0) {
+    typedef RealVec<Float,N> Vec;
+    Vec s, c;
+    switch (link.reconstruct) {
+    case QUDA_RECONSTRUCT_12:
+      thirdRow(u, u0);
+      break;
+    case QUDA_RECONSTRUCT_8:
+      linkFrom8(u, u0);
+      break;
+    case QUDA_RECONSTRUCT_13: // the third row carries exp(3i phase)
+      sinCosLanes(s, c, Vec(3.0)*u[12]);
+      thirdRow(u, Vec(link.invScale));
+      rotateLanes(u+12, 3, s, c);
+      break;
+    case QUDA_RECONSTRUCT_9: // the whole link carries exp(i phase)
+      sinCosLanes(s, c, u[8]);
+      linkFrom8(u, Vec(link.invScale));
+      rotateLanes(u, 9, s, c);
+      break;
+    default:
+      break;
+    }
+  }
+
+  /** Gathers the link at p[k] into lane k, rebuilding it if compressed */
+  template <typename Float, int N>
+  inline void readLink(RealVec<Float,N> *u, const Float *const *p, const Float *u0, const HostLink<Float> &link) {
+    gatherLanes(u, p, link.length);
+    if (link.length != 18) {
+      RealVec<Float,N> u0v;
+      u0v.load(u0);
+      unpackLink(u, link, u0v);
+    }
+  }
+
+  /** The link at p, rebuilt in buf if it is compressed */
+  template <typename Float>
+  inline const Float* hostLink(Float buf[18], const Float *p, const HostLink<Float> &link, double u0) {
+    if (link.length == 18) return p;
+    RealVec<Float,1> u[18];
+    for (int j=0; j<link.length; j++) u[j] = RealVec<Float,1>(p[j]);
+    unpackLink(u, link, RealVec<Float,1>(static_cast<Float>(u0)));
+    for (int j=0; j<18; j++) u[j].store(buf + j);
+    return buf;
+  }
+
+  /**
+     Spin projection in the DeGrand-Rossi basis, indexed by projIdx =
+     2*mu + (backwards ^ dagger) as in the reference dslash.  The
+     upper components of the projected spinor are h_s = psi_s + c_s
+     psi_{p_s} (s = 0,1) with c_s = projSign[s] (times i if
+     projUseI), and the lower components are recovered from U h as
+     reconSign * (i) * (lane swap) U h.  All coefficients are 0, +/-1
+     or +/-i, so these are exact rewrites of the full 4x4 projector.
+   */
+  static const int projPartner[8][2] = { {3,2}, {3,2}, {3,2}, {3,2}, {2,3}, {2,3}, {2,3}, {2,3} };
+  static const bool projUseI[8] = { true, true, false, false, true, true, false, false };
+  static const int projSign[8][2] = { {-1,-1}, {1,1}, {1,-1}, {-1,1}, {-1,1}, {1,-1}, {-1,-1}, {1,1} };
+  static const int reconSign[8][2] = { {1,1}, {-1,-1}, {-1,1}, {1,-1}, {1,-1}, {-1,1}, {-1,-1}, {1,1} };
+
+  // the half spinor lanes are the two upper (or lower) spin components
+  template <typename Float>
+  struct HalfSpinor {
+    typedef ComplexVec<Float,2> Vec;
+    Vec s[3]; // color index
+
+    /** Projects the 4-spinor psi (24 reals, spin-color order) */
+    inline void project(const Float *psi, int proj, const Vec &sign) {
+      const int p0 = projPartner[proj][0];
+      const int stride = 6*(projPartner[proj][1] - p0);
+      for (int c=0; c<3; c++) {
+	Vec a, b;
+	a.load(psi + 2*c, 6);
+	b.load(psi + 6*p0 + 2*c, stride);
+	if (projUseI[proj]) b = times_i(b);
+	s[c] = a + sign*b;
+      }
+    }
+
+    /** this = U h */
+    inline void mul(const Float *U, const HalfSpinor &h) {
+      for (int n=0; n<3; n++)
+	s[n] = cmul(U[n*6+0], U[n*6+1], h.s[0]) + cmul(U[n*6+2], U[n*6+3], h.s[1]) +
+	  cmul(U[n*6+4], U[n*6+5], h.s[2]);
+    }
+
+    /** this = U^dagger h */
+    inline void mulDagger(const Float *U, const HalfSpinor &h) {
+      for (int n=0; n<3; n++)
+	s[n] = conj_cmul(U[0*6+2*n], U[0*6+2*n+1], h.s[0]) + conj_cmul(U[1*6+2*n], U[1*6+2*n+1], h.s[1]) +
+	  conj_cmul(U[2*6+2*n], U[2*6+2*n+1], h.s[2]);
+    }
+  };
+
+  /** A full spinor held as its upper and lower spin pairs */
+  template <typename Float>
+  struct HostSpinor {
+    typedef ComplexVec<Float,2> Vec;
+    Vec up[3], lo[3];
+
+    inline void zero() { for (int c=0; c<3; c++) up[c] = lo[c] = Vec::zero(); }
+
+    inline void load(const Float *psi) {
+      for (int c=0; c<3; c++) { up[c].load(psi + 2*c, 6); lo[c].load(psi + 12 + 2*c, 6); }
+    }
+
+    inline void store(Float *psi) const {
+      for (int c=0; c<3; c++) { up[c].store(psi + 2*c, 6); lo[c].store(psi + 12 + 2*c, 6); }
+    }
+
+    /** Projects this spinor into h, as HalfSpinor::project does from memory */
+    inline void project(HalfSpinor<Float> &h, int proj, const Vec &sign) const {
+      const bool swap = (projPartner[proj][0] == 3);
+      for (int c=0; c<3; c++) {
+	Vec b = swap ? reverse(lo[c]) : lo[c];
+	if (projUseI[proj]) b = times_i(b);
+	h.s[c] = up[c] + sign*b;
+      }
+    }
+
+    /** Accumulates the spin reconstruction of the gauged half spinor */
+    inline void reconstruct(const HalfSpinor<Float> &Uh, int proj, const Vec &sign) {
+      const bool swap = (projPartner[proj][0] == 3);
+      for (int c=0; c<3; c++) {
+	up[c] += Uh.s[c];
+	Vec t = swap ? reverse(Uh.s[c]) : Uh.s[c];
+	if (projUseI[proj]) t = times_i(t);
+	lo[c] += sign*t;
+      }
+    }
+  };
+
+  /** Spin-pair lane versions of the projection and reconstruction signs */
+  template <typename Float>
+  inline void projectionSigns(ComplexVec<Float,2> *pSign, ComplexVec<Float,2> *rSign) {
+    for (int p=0; p<8; p++) {
+      Float ps[2] = { (Float)projSign[p][0], (Float)projSign[p][1] };
+      Float rs[2] = { (Float)reconSign[p][0], (Float)reconSign[p][1] };
+      pSign[p] = ComplexVec<Float,2>::lanes(ps);
+      rSign[p] = ComplexVec<Float,2>::lanes(rs);
+    }
+  }
+
+  /**
+     The link of the hop from site x (checkerboard index i, parity
+     parity) in dimension mu, forwards or backwards, to the neighbor
+     nbr found at loc (see HostGeometry::neighbor), rebuilt in buf if
+     it is compressed
+   */
+  template <typename Float, typename Arg>
+  inline const Float* hopLink(Float buf[18], const Arg &arg, int i, const int x[4], int parity,
+			      int mu, int back, int nbr, int loc) {
+    const HostGeometry &geom = arg.geom;
+    const int L = arg.link.length;
+    const Float *U = !back ? arg.gauge[mu] + (parity*geom.volumeCB + i)*L :
+      loc ? arg.ghostGauge[mu] + ((1-parity)*geom.faceVolumeCB[mu] + nbr)*L :
+      arg.gauge[mu] + ((1-parity)*geom.volumeCB + nbr)*L;
+    return hostLink(buf, U, arg.link, arg.link.u0(mu, back, x[3], geom.X[3], loc > 0));
+  }
+
+  template <typename Float>
+  struct WilsonArg {
+    Float *out;
+    const Float *in;
+    const Float *x;
+    Float k;
+    const Float *gauge[4];
+    const Float *ghostGauge[4];
+    HostLink<Float> link;
+    const Float *fwdGhost[4];
+    const Float *backGhost[4];
+    const Float *clover; // clover term (or inverse) for the output parity, if any
+    bool asymmetric;     // out = A x + k D in rather than x + k A^-1 D in
+    int parity;
+    int dagger;
+    HostGeometry geom;
+
+    WilsonArg(cpuColorSpinorField *out_, const cpuGaugeField &gauge_, const cpuColorSpinorField *in_,
+	      int parity, int dagger, const cpuColorSpinorField *x_, double k, const HostGeometry &geom)
+      : out((Float*)out_->V()), in((const Float*)in_->V()), x(x_ ? (const Float*)x_->V() : 0),
+	k(k), link(gauge_), clover(0), asymmetric(false), parity(parity), dagger(dagger), geom(geom) {
+      for (int d=0; d<4; d++) {
+	gauge[d] = ((const Float**)gauge_.Gauge_p())[d];
+	ghostGauge[d] = (const Float*)gauge_.Ghost()[d];
+	fwdGhost[d] = (const Float*)cpuColorSpinorField::fwdGhostFaceBuffer[d];
+	backGhost[d] = (const Float*)cpuColorSpinorField::backGhostFaceBuffer[d];
+      }
+    }
+  };
+
+  /** Returns element (i,j) of the packed Hermitian 6x6 block a */
+  template <typename Float>
+  inline void cloverElem(Float &re, Float &im, const Float *a, int i, int j) {
+    if (i == j) { re = a[i]; im = 0.0; return; }
+    const int r = i > j ? i : j, c = i > j ? j : i;
+    const int off = 6 + 2*(c*(11-c)/2 + r-c-1);
+    re = a[off];
+    im = i > j ? a[off+1] : -a[off+1];
+  }
+
+  /**
+     Applies the packed clover term A (72 reals, see cpuCloverField)
+     to s in place.  gamma_5 is diag(1,1,-1,-1) in the DeGrand-Rossi
+     basis, so the upper spins see the first chiral block and the
+     lower spins the second.  Element k = 3*spin + color of a block
+     pairs with the spin lanes of HostSpinor: for output color r,
+     the lanes take (A_{0r,0c}, A_{1r,1c}) times s[c] plus (A_{0r,1c},
+     A_{1r,0c}) times the lane-swapped s[c].
+   */
+  template <typename Float>
+  inline void applyClover(HostSpinor<Float> &s, const Float *A) {
+    typedef ComplexVec<Float,2> Vec;
+    for (int chi=0; chi<2; chi++) {
+      const Float *a = A + 36*chi;
+      Vec *v = chi ? s.lo : s.up;
+      Vec in[3], swap[3];
+      for (int c=0; c<3; c++) { in[c] = v[c]; swap[c] = reverse(v[c]); }
+
+      for (int r=0; r<3; r++) {
+	Vec acc = Vec::zero();
+	for (int c=0; c<3; c++) {
+	  Float same[4], cross[4];
+	  cloverElem(same[0], same[1], a, r, c);
+	  cloverElem(same[2], same[3], a, 3+r, 3+c);
+	  cloverElem(cross[0], cross[1], a, r, 3+c);
+	  cloverElem(cross[2], cross[3], a, 3+r, c);
+	  Vec us, uc;
+	  us.load(same);
+	  uc.load(cross);
+	  acc += cmul(us, in[c]) + cmul(uc, swap[c]);
+	}
+	v[r] = acc;
+      }
+    }
+  }
+
+  template <typename Float>
+  struct CloverArg : public WilsonArg<Float> {
+    CloverArg(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuCloverField &clover,
+	      const cpuColorSpinorField *in, int parity, int dagger, const cpuColorSpinorField *x,
+	      double k, bool asymmetric, const HostGeometry &geom)
+      : WilsonArg<Float>(out, gauge, in, parity, dagger, x, k, geom) {
+      this->clover = (const Float*)((const char*)clover.V(!asymmetric) + parity*clover.Bytes()/2);
+      this->asymmetric = asymmetric;
+    }
+  };
+
+  /**
+     Computes the Wilson hopping term at site i of the output parity
+     and accumulates it into acc, in the operation order of the
+     reference wil_dslash
+   */
+  template <typename Float>
+  inline void wilsonHop(HostSpinor<Float> &acc, const WilsonArg<Float> &arg, int i, const int x[4],
+			const ComplexVec<Float,2> *pSign, const ComplexVec<Float,2> *rSign) {
+    const HostGeometry &geom = arg.geom;
+
+    for (int mu=0; mu<4; mu++) {
+      // forwards then backwards, as in the reference
+      for (int back=0; back<2; back++) {
+	int nbr;
+	int loc = geom.neighbor(nbr, x, mu, back ? -1 : +1, 1);
+	if (loc < 0) continue;
+
+	const int proj = 2*mu + (back + arg.dagger) % 2;
+	const Float *psi = loc ? (back ? arg.backGhost[mu] : arg.fwdGhost[mu]) + nbr*24 : arg.in + nbr*24;
+
+	HalfSpinor<Float> h, Uh;
+	h.project(psi, proj, pSign[proj]);
+
+	Float buf[18];
+	const Float *U = hopLink(buf, arg, i, x, arg.parity, mu, back, nbr, loc);
+	if (!back) Uh.mul(U, h);
+	else Uh.mulDagger(U, h);
+
+	acc.reconstruct(Uh, proj, rSign[proj]);
+      }
+    }
+  }
+
+  /**
+     Hand-written Wilson dslash, vectorized over the spin pair, which
+     follows the operation order of the reference implementations in
+     tests/ and so, built without FMA contraction (see host_simd.h),
+     agrees with them to the last bit.  With a clover
+     field in arg, its inverse is applied to the hopping term
+     (followed by the optional xpay), or, for the asymmetric operator,
+     the clover term itself is applied to the xpay field.
+   */
+  template <typename Float>
+  void wilsonDslashOrderedHost(const WilsonArg<Float> &arg, const HostSites &sites) {
+    typedef ComplexVec<Float,2> Vec;
+
+    Vec pSign[8], rSign[8];
+    projectionSigns(pSign, rSign);
+
+#pragma omp parallel for schedule(static)
+    for (int k=0; k<sites.n[0]; k++) {
+      const int i = sites(0, k);
+      int x[4];
+      arg.geom.coords(x, i, arg.parity);
+
+      HostSpinor<Float> acc;
+      acc.zero();
+      wilsonHop(acc, arg, i, x, pSign, rSign);
+      if (arg.clover && !arg.asymmetric) applyClover(acc, arg.clover + i*72);
+
+      if (arg.x) { // out = x + k * D in, x + k * A^-1 D in, or A x + k * D in
+	HostSpinor<Float> in;
+	in.load(arg.x + i*24);
+	if (arg.clover && arg.asymmetric) applyClover(in, arg.clover + i*72);
+	for (int c=0; c<3; c++) {
+	  acc.up[c] = in.up[c] + arg.k*acc.up[c];
+	  acc.lo[c] = in.lo[c] + arg.k*acc.lo[c];
+	}
+      }
+
+      acc.store(arg.out + i*24);
+    }
+  }
+
+  /**
+     Lane addressing for the generated kernels (in dslash_core/),
+     whose lanes are N consecutive sites of one parity from sites,
+     taken from slice "slice" of a 5-d field.  The neighbors are listed
+     in the order of the generated code (+x, -x, +y, ..., -t), and those
+     across a Dirichlet boundary point at zeros.  Nf flavors (further
+     slices) are read from each neighbor.
+   */
+  template <typename Float, int N, int Nf>
+  struct HostLanes {
+    int nLanes;                    // lanes holding sites (the last block may be partial)
+    int site[N];                   // index of each lane's site in the output field
+    int cb[N];                     // its 4-d checkerboard index
+    const Float *spinor[Nf][8][N]; // neighboring spinors
+    const Float *gauge[8][N];      // links to them, U(x) forwards and U(x-mu) backwards
+    Float u0[8][N];                // for their reconstruction (see HostLink)
+
+    template <typename Arg>
+    HostLanes(const Arg &arg, const HostSites &sites, int k0, int parity, int slice) {
+      static const Float zero[24] = { };
+      const HostGeometry &geom = arg.geom;
+      const int s = parity != arg.parity;
+      nLanes = sites.n[s] - k0 < N ? sites.n[s] - k0 : N;
+
+      for (int k=0; k<N; k++) {
+	const int i = sites(s, k < nLanes ? k0 + k : k0 + nLanes - 1);
+	site[k] = slice*geom.volumeCB + i;
+	cb[k] = i;
+	int x[4];
+	geom.coords(x, i, parity);
+
+	for (int mu=0; mu<4; mu++) {
+	  for (int back=0; back<2; back++) {
+	    const int dir = 2*mu + back;
+	    int nbr;
+	    int loc = geom.neighbor(nbr, x, mu, back ? -1 : +1, 1);
+	    u0[dir][k] = arg.link.u0(mu, back, x[3], geom.X[3], loc > 0);
+	    if (loc < 0) {
+	      for (int f=0; f<Nf; f++) spinor[f][dir][k] = zero;
+	      gauge[dir][k] = arg.link.dropped();
+	      continue;
+	    }
+
+	    const Float *psi = loc ? (back ? arg.backGhost[mu] : arg.fwdGhost[mu]) : arg.in;
+	    const int stride = loc ? geom.faceVolumeCB[mu] : geom.volumeCB;
+	    const int L = arg.link.length;
+	    for (int f=0; f<Nf; f++) spinor[f][dir][k] = psi + ((slice+f)*stride + nbr)*24;
+	    gauge[dir][k] = !back ? arg.gauge[mu] + (parity*geom.volumeCB + i)*L :
+	      loc ? arg.ghostGauge[mu] + ((1-parity)*geom.faceVolumeCB[mu] + nbr)*L :
+	      arg.gauge[mu] + ((1-parity)*geom.volumeCB + nbr)*L;
+	  }
+	}
+      }
+    }
+  };
+
+  /** Gathers n reals per lane from base + site*stride */
+  template <typename Float, int N>
+  inline void readLanes(RealVec<Float,N> *v, const Float *base, const int *site, int stride, int n) {
+    const Float *p[N];
+    for (int k=0; k<N; k++) p[k] = base + site[k]*stride;
+    gatherLanes(v, p, n);
+  }
+
+  /** Scatters a spinor per lane to base + site*24 */
+  template <typename Float, int N>
+  inline void writeLanes(Float *base, const RealVec<Float,N> *v, const int *site, int nLanes) {
+    Float *p[N];
+    for (int k=0; k<N; k++) p[k] = base + site[k]*24;
+    scatterLanes(p, v, 24, nLanes);
+  }
+
+  // Memory access of the generated kernels.  Flavor f of a doublet
+  // lies a whole (4-d) volume after flavor 0, and READ_SPINOR_5D reads
+  // slice xs of a 5-d field at each lane's 4-d site.
+#define READ_SPINOR(v, dir) gatherLanes(v, lanes.spinor[0][dir], 24)
+#define READ_SPINOR_FLAVOR(v, dir, f) gatherLanes(v, lanes.spinor[f][dir], 24)
+#define READ_GAUGE_MATRIX(v, dir) readLink(v, lanes.gauge[dir], lanes.u0[dir], arg.link)
+#define READ_CLOVER(v, chi) readLanes(v, arg.clover + 36*(chi), lanes.site, 72, 36)
+#define READ_ACCUM(v) readLanes(v, arg.x, lanes.site, 24, 24)
+#define READ_ACCUM_FLAVOR(v, f) readLanes(v, arg.x + (f)*24*arg.geom.volumeCB, lanes.site, 24, 24)
+#define WRITE_SPINOR(v) writeLanes(arg.out, v, lanes.site, lanes.nLanes)
+#define WRITE_SPINOR_FLAVOR(v, f) writeLanes(arg.out + (f)*24*arg.geom.volumeCB, v, lanes.site, lanes.nLanes)
+#define READ_SPINOR_5D(v, xs) readLanes(v, arg.in + (xs)*24*arg.geom.volumeCB, lanes.cb, 24, 24)
+
+  /**
+     Wilson dslash from the generated kernels.  With a clover field
+     in arg, its inverse is applied to the hopping term (followed by
+     the optional xpay), or, for the asymmetric operator, the clover
+     term itself is applied to the xpay field.
+   */
+  template <typename Float, int N>
+  void wilsonDslashHost(const WilsonArg<Float> &arg, const HostSites &sites) {
+    typedef RealVec<Float,N> spinorFloat;
+    const int nBlock = (sites.n[0] + N - 1) / N;
+
+#pragma omp parallel for schedule(static)
+    for (int b=0; b<nBlock; b++) {
+      HostLanes<Float,N,1> lanes(arg, sites, b*N, arg.parity, 0);
+      if (!arg.dagger) {
+#include "wilson_dslash_cpu_core.h"
+      } else {
+#include "wilson_dslash_dagger_cpu_core.h"
+      }
+    }
+  }
+
+  template <typename Float>
+  void cloverHost(Float *out, const Float *clover, const Float *in, int volumeCB) {
+#pragma omp parallel for schedule(static)
+    for (int i=0; i<volumeCB; i++) {
+      HostSpinor<Float> s;
+      s.load(in + i*24);
+      applyClover(s, clover + i*72);
+      s.store(out + i*24);
+    }
+  }
+
+  template <typename Float>
+  struct TwistedMassArg : public WilsonArg<Float> {
+    QudaTwistDslashType type;
+    Float a; // twist is c (1 + i a gamma_5 tau_3 + b tau_1), a negated for the dagger
+    Float b;
+    Float c;
+
+    TwistedMassArg(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+		   int parity, int dagger, const cpuColorSpinorField *x, QudaTwistDslashType type,
+		   double a, double b, double c, double k, const HostGeometry &geom)
+      : WilsonArg<Float>(out, gauge, in, parity, dagger, x, k, geom), type(type),
+	a(dagger ? -a : a), b(b), c(c) { }
+  };
+
+  /**
+     Twisted mass dslash from the generated kernels, with the twist
+     fused in where arg.type selects: on each neighbor as it is
+     loaded, on the result, or on the xpay field.
+   */
+  template <typename Float, int N>
+  void twistedMassDslashHost(const TwistedMassArg<Float> &arg, const HostSites &sites) {
+    typedef RealVec<Float,N> spinorFloat;
+    const int nBlock = (sites.n[0] + N - 1) / N;
+
+#pragma omp parallel for schedule(static)
+    for (int b=0; b<nBlock; b++) {
+      HostLanes<Float,N,1> lanes(arg, sites, b*N, arg.parity, 0);
+      if (!arg.dagger) {
+#include "tm_dslash_cpu_core.h"
+      } else {
+#include "tm_dslash_dagger_cpu_core.h"
+      }
+    }
+  }
+
+  /**
+     As twistedMassDslashHost for a flavor doublet, whose flavors are
+     stored one after the other like the slices of a 5-d field.  Both
+     are computed at each site, sharing the neighbor lookup and the
+     link.
+   */
+  template <typename Float, int N>
+  void ndegTwistedMassDslashHost(const TwistedMassArg<Float> &arg, const HostSites &sites) {
+    typedef RealVec<Float,N> spinorFloat;
+    const int nBlock = (sites.n[0] + N - 1) / N;
+
+#pragma omp parallel for schedule(static)
+    for (int b=0; b<nBlock; b++) {
+      HostLanes<Float,N,2> lanes(arg, sites, b*N, arg.parity, 0);
+      if (!arg.dagger) {
+#include "tm_ndeg_dslash_cpu_core.h"
+      } else {
+#include "tm_ndeg_dslash_dagger_cpu_core.h"
+      }
+    }
+  }
+
+  /**
+     Applies the twist in place to a single flavor (Nf = 1, where b
+     is ignored) or to a flavor doublet (Nf = 2).  gamma_5 is
+     diag(1,1,-1,-1) in the DeGrand-Rossi basis, so the twist only
+     needs the sign of a to change between the upper and lower spins.
+     The operation order is that of the reference twistGamma5 and
+     ndegTwistGamma5.
+   */
+  template <typename Float, int Nf>
+  inline void applyTwist(HostSpinor<Float> *s, const TwistedMassArg<Float> &arg) {
+    typedef ComplexVec<Float,2> Vec;
+    const Float a = arg.a, b = arg.b, c = arg.c;
+    for (int col=0; col<3; col++) {
+      if (Nf == 1) {
+	s[0].up[col] = c*(s[0].up[col] + a*times_i(s[0].up[col]));
+	s[0].lo[col] = c*(s[0].lo[col] + (-a)*times_i(s[0].lo[col]));
+      } else {
+	const Vec u0 = s[0].up[col], u1 = s[1].up[col];
+	const Vec l0 = s[0].lo[col], l1 = s[1].lo[col];
+	s[0].up[col] = c*((u0 + a*times_i(u0)) + b*u1);
+	s[1].up[col] = c*((u1 - a*times_i(u1)) + b*u0);
+	s[0].lo[col] = c*((l0 + (-a)*times_i(l0)) + b*l1);
+	s[1].lo[col] = c*((l1 - (-a)*times_i(l1)) + b*l0);
+      }
+    }
+  }
+
+  /**
+     Hand-written twisted mass dslash in the operation order of the
+     reference (see wilsonDslashOrderedHost), with the twist applied
+     where arg.type selects.  Both flavors of a doublet (Nf = 2) are
+     computed at each site, sharing the neighbor lookup and the link.
+   */
+  template <typename Float, int Nf>
+  void twistedMassDslashOrderedHost(const TwistedMassArg<Float> &arg, const HostSites &sites) {
+    typedef ComplexVec<Float,2> Vec;
+    const HostGeometry &geom = arg.geom;
+    const int parity = arg.parity;
+    const bool twistIn = (arg.type == QUDA_DEG_TWIST_INV_DSLASH);
+    const bool twistOut = (arg.type == QUDA_DEG_DSLASH_TWIST_INV);
+    const bool twistX = (arg.type == QUDA_DEG_DSLASH_TWIST_XPAY);
+
+    Vec pSign[8], rSign[8];
+    projectionSigns(pSign, rSign);
+
+#pragma omp parallel for schedule(static)
+    for (int k=0; k<sites.n[0]; k++) {
+      const int i = sites(0, k);
+      int x[4];
+      geom.coords(x, i, parity);
+
+      HostSpinor<Float> acc[Nf];
+      for (int f=0; f<Nf; f++) acc[f].zero();
+
+      for (int mu=0; mu<4; mu++) {
+	for (int back=0; back<2; back++) {
+	  int nbr;
+	  int loc = geom.neighbor(nbr, x, mu, back ? -1 : +1, 1);
+	  if (loc < 0) continue;
+
+	  const int proj = 2*mu + (back + arg.dagger) % 2;
+	  const Float *psi = loc ? (back ? arg.backGhost[mu] : arg.fwdGhost[mu]) : arg.in;
+	  const int flavorStride = 24*(loc ? geom.faceVolumeCB[mu] : geom.volumeCB);
+	  psi += nbr*24;
+
+	  HalfSpinor<Float> h[Nf];
+	  if (twistIn) {
+	    HostSpinor<Float> s[Nf];
+	    for (int f=0; f<Nf; f++) s[f].load(psi + f*flavorStride);
+	    applyTwist<Float,Nf>(s, arg);
+	    for (int f=0; f<Nf; f++) s[f].project(h[f], proj, pSign[proj]);
+	  } else {
+	    for (int f=0; f<Nf; f++) h[f].project(psi + f*flavorStride, proj, pSign[proj]);
+	  }
+
+	  Float buf[18];
+	  const Float *U = hopLink(buf, arg, i, x, parity, mu, back, nbr, loc);
+
+	  for (int f=0; f<Nf; f++) {
+	    HalfSpinor<Float> Uh;
+	    if (!back) Uh.mul(U, h[f]);
+	    else Uh.mulDagger(U, h[f]);
+	    acc[f].reconstruct(Uh, proj, rSign[proj]);
+	  }
+	}
+      }
+
+      if (twistOut) applyTwist<Float,Nf>(acc, arg);
+
+      if (arg.x) { // out = x + k * D in, or T x + k * D in
+	HostSpinor<Float> in[Nf];
+	for (int f=0; f<Nf; f++) in[f].load(arg.x + (f*geom.volumeCB + i)*24);
+	if (twistX) applyTwist<Float,Nf>(in, arg);
+	for (int f=0; f<Nf; f++) {
+	  for (int c=0; c<3; c++) {
+	    acc[f].up[c] = in[f].up[c] + arg.k*acc[f].up[c];
+	    acc[f].lo[c] = in[f].lo[c] + arg.k*acc[f].lo[c];
+	  }
+	}
+      }
+
+      for (int f=0; f<Nf; f++) acc[f].store(arg.out + (f*geom.volumeCB + i)*24);
+    }
+  }
+
+  template <typename Float>
+  struct StaggeredArg {
+    Float *out;
+    const Float *in;
+    const Float *x;
+    Float k;
+    const Float *fat[4];
+    const Float *lng[4];
+    const Float *ghostFat[4];
+    const Float *ghostLong[4];
+    HostLink<Float> longLink; // the fat links are never compressed
+    const Float *fwdGhost[4];
+    const Float *backGhost[4];
+    int parity;
+    int dagger;
+    HostGeometry geom;
+
+    StaggeredArg(cpuColorSpinorField *out_, const cpuGaugeField &fat_, const cpuGaugeField &long_,
+		 const cpuColorSpinorField *in_, int parity, int dagger, const cpuColorSpinorField *x_,
+		 double k, const HostGeometry &geom)
+      : out((Float*)out_->V()), in((const Float*)in_->V()), x(x_ ? (const Float*)x_->V() : 0),
+	k(k), longLink(long_), parity(parity), dagger(dagger), geom(geom) {
+      for (int d=0; d<4; d++) {
+	fat[d] = ((const Float**)fat_.Gauge_p())[d];
+	lng[d] = ((const Float**)long_.Gauge_p())[d];
+	ghostFat[d] = (const Float*)fat_.Ghost()[d];
+	ghostLong[d] = (const Float*)long_.Ghost()[d];
+	fwdGhost[d] = (const Float*)cpuColorSpinorField::fwdGhostFaceBuffer[d];
+	backGhost[d] = (const Float*)cpuColorSpinorField::backGhostFaceBuffer[d];
+      }
+    }
+  };
+
+  /**
+     Improved staggered dslash.  The one-hop (fat link) and three-hop
+     (Naik, long link) terms in a given direction have identical
+     structure, so they are computed together as the two lanes of a
+     ComplexVec and only summed at the end.  The spinor ghost zone is
+     three sites deep; the fat link ghost zone is one site deep.
+   */
+  template <typename Float>
+  void staggeredDslashHost(const StaggeredArg<Float> &arg, const HostSites &sites) {
+    typedef ComplexVec<Float,2> Vec;
+    const HostGeometry &geom = arg.geom;
+    const int parity = arg.parity;
+    static const Float zero[18] = { }; // stands in for terms dropped at Dirichlet boundaries
+    const int L = arg.longLink.length;
+
+#pragma omp parallel for schedule(static)
+    for (int k=0; k<sites.n[0]; k++) {
+      const int i = sites(0, k);
+      int x[4];
+      geom.coords(x, i, parity);
+      Float lng[18]; // a compressed long link, rebuilt
+
+      Vec acc[3];
+      for (int c=0; c<3; c++) acc[c] = Vec::zero();
+
+      for (int mu=0; mu<4; mu++) {
+	const int fv = geom.faceVolumeCB[mu];
+
+	// forwards: U(x) psi(x+mu) + L(x) psi(x+3mu)
+	{
+	  const Float *psi[2], *U[2];
+	  int nbr;
+	  for (int l=0; l<2; l++) {
+	    int loc = geom.neighbor(nbr, x, mu, l ? 3 : 1, 3);
+	    psi[l] = loc < 0 ? zero : (loc ? arg.fwdGhost[mu] : arg.in) + nbr*6;
+	    U[l] = loc < 0 ? zero : l ? hostLink(lng, arg.lng[mu] + (parity*geom.volumeCB + i)*L, arg.longLink, 1) :
+	      arg.fat[mu] + (parity*geom.volumeCB + i)*18;
+	  }
+
+	  Vec h[3];
+	  for (int m=0; m<3; m++) {
+	    const Float *p[2] = { psi[0] + 2*m, psi[1] + 2*m };
+	    h[m].gather(p);
+	  }
+	  for (int n=0; n<3; n++) {
+	    for (int m=0; m<3; m++) {
+	      const Float *p[2] = { U[0] + (n*3+m)*2, U[1] + (n*3+m)*2 };
+	      Vec u;
+	      u.gather(p);
+	      acc[n] += cmul(u, h[m]);
+	    }
+	  }
+	}
+
+	// backwards: U^dag(x-mu) psi(x-mu) + L^dag(x-3mu) psi(x-3mu)
+	{
+	  const Float *psi[2], *U[2];
+	  int nbr;
+	  for (int l=0; l<2; l++) {
+	    int loc = geom.neighbor(nbr, x, mu, l ? -3 : -1, 3);
+	    if (loc < 0) {
+	      psi[l] = U[l] = zero;
+	    } else if (loc) {
+	      psi[l] = arg.backGhost[mu] + nbr*6;
+	      // the spinor ghost is three deep, the fat link ghost only one
+	      U[l] = l ? hostLink(lng, arg.ghostLong[mu] + ((1-parity)*3*fv + nbr)*L, arg.longLink, 1) :
+		arg.ghostFat[mu] + ((1-parity)*fv + nbr - 2*fv)*18;
+	    } else {
+	      psi[l] = arg.in + nbr*6;
+	      U[l] = l ? hostLink(lng, arg.lng[mu] + ((1-parity)*geom.volumeCB + nbr)*L, arg.longLink, 1) :
+		arg.fat[mu] + ((1-parity)*geom.volumeCB + nbr)*18;
+	    }
+	  }
+
+	  Vec h[3];
+	  for (int m=0; m<3; m++) {
+	    const Float *p[2] = { psi[0] + 2*m, psi[1] + 2*m };
+	    h[m].gather(p);
+	  }
+	  for (int n=0; n<3; n++) {
+	    for (int m=0; m<3; m++) {
+	      const Float *p[2] = { U[0] + (m*3+n)*2, U[1] + (m*3+n)*2 };
+	      Vec u;
+	      u.gather(p);
+	      acc[n] -= conj_cmul(u, h[m]);
+	    }
+	  }
+	}
+      }
+
+      // sum the one-hop and three-hop lanes
+      Float D[6];
+      for (int c=0; c<3; c++) {
+	Float a[4];
+	acc[c].store(a);
+	D[2*c+0] = a[0] + a[2];
+	D[2*c+1] = a[1] + a[3];
+      }
+
+      Float *out = arg.out + i*6;
+      if (arg.dagger) for (int j=0; j<6; j++) D[j] = -D[j];
+      if (arg.x) { // out = k * x - D in, as in the GPU kernel
+	for (int j=0; j<6; j++) out[j] = arg.k*arg.x[i*6+j] - D[j];
+      } else {
+	for (int j=0; j<6; j++) out[j] = D[j];
+      }
+    }
+  }
+
+  template <typename Float>
+  struct DomainWallArg {
+    Float *out;
+    const Float *in;
+    const Float *x;
+    Float k;
+    Float mferm;
+    const Float *gauge[4];
+    const Float *ghostGauge[4];
+    HostLink<Float> link;
+    const Float *fwdGhost[4];
+    const Float *backGhost[4];
+    int parity;
+    int dagger;
+    int Ls;
+    HostGeometry geom;
+
+    DomainWallArg(cpuColorSpinorField *out_, const cpuGaugeField &gauge_, const cpuColorSpinorField *in_,
+		  int parity, int dagger, const cpuColorSpinorField *x_, double mferm, double k,
+		  const HostGeometry &geom)
+      : out((Float*)out_->V()), in((const Float*)in_->V()), x(x_ ? (const Float*)x_->V() : 0),
+	k(k), mferm(mferm), link(gauge_), parity(parity), dagger(dagger), Ls(in_->X(4)), geom(geom) {
+      for (int d=0; d<4; d++) {
+	gauge[d] = ((const Float**)gauge_.Gauge_p())[d];
+	ghostGauge[d] = (const Float*)gauge_.Ghost()[d];
+	fwdGhost[d] = (const Float*)cpuColorSpinorField::fwdGhostFaceBuffer[d];
+	backGhost[d] = (const Float*)cpuColorSpinorField::backGhostFaceBuffer[d];
+      }
+    }
+  };
+
+  /**
+     Domain wall dslash from the generated kernels: the 4-d Wilson
+     hopping term on each slice plus the chiral hops along the fifth
+     dimension, with -mferm at the walls.  The lanes are sites of a
+     single slice xs, whose 4-d parity follows from that of the 5-d
+     field, so the odd slices take their sites from the second list.
+   */
+  template <typename Float, int N>
+  void domainWallDslashHost(const DomainWallArg<Float> &arg, const HostSites &sites) {
+    typedef RealVec<Float,N> spinorFloat;
+    const int nBlock[2] = { (sites.n[0] + N - 1) / N, (sites.n[1] + N - 1) / N };
+    const int nMax = nBlock[0] > nBlock[1] ? nBlock[0] : nBlock[1];
+
+#pragma omp parallel for schedule(static)
+    for (int t=0; t<arg.Ls*nMax; t++) {
+      const int xs = t / nMax;
+      const int b = t - xs*nMax;
+      if (b >= nBlock[xs & 1]) continue;
+      HostLanes<Float,N,1> lanes(arg, sites, b*N, arg.parity ^ (xs & 1), xs);
+      if (!arg.dagger) {
+#include "dw_dslash_cpu_core.h"
+      } else {
+#include "dw_dslash_dagger_cpu_core.h"
+      }
+    }
+  }
+
+  /**
+     Hand-written domain wall dslash in the operation order of the
+     reference dw_dslash.  The threads run over the 4-d sites and the
+     N lanes of each vector are N slices s0, s0+2, ... of the fifth
+     dimension (those with the output 5-d parity), so every link is
+     loaded once and broadcast against all the slices that use it.
+     The sites of 4-d parity arg.parity ^ s take the slices s0 = s.
+     Lanes beyond the last slice read a zero spinor and are not
+     written back.
+   */
+  template <typename Float, int N>
+  void domainWallDslashOrderedHost(const DomainWallArg<Float> &arg, const HostSites &sites) {
+    typedef ComplexVec<Float,N> Vec;
+    const HostGeometry &geom = arg.geom;
+    const int Ls = arg.Ls;
+    const int Vh = geom.volumeCB;
+    static const Float zero[24] = { };
+
+#pragma omp parallel for schedule(static)
+    for (int t=0; t<sites.n[0]+sites.n[1]; t++) {
+      const int s0 = t < sites.n[0] ? 0 : 1;
+      const int i = sites(s0, t - s0*sites.n[0]);
+      const int p4 = arg.parity ^ s0; // 4-d parity
+      int x[4];
+      geom.coords(x, i, p4);
+
+      const int ns = (Ls - s0 + 1) / 2;
+
+      for (int first=0; first<ns; first+=N) {
+	const int nl = ns - first < N ? ns - first : N;
+	int s[N];
+	for (int k=0; k<N; k++) s[k] = s0 + 2*(first+k);
+
+	Vec acc[4][3];
+	for (int sp=0; sp<4; sp++) for (int c=0; c<3; c++) acc[sp][c] = Vec::zero();
+
+	// 4-d hopping term, forwards then backwards as in the reference
+	for (int mu=0; mu<4; mu++) {
+	  for (int back=0; back<2; back++) {
+	    int nbr;
+	    int loc = geom.neighbor(nbr, x, mu, back ? -1 : +1, 1);
+	    if (loc < 0) continue;
+
+	    const int proj = 2*mu + (back + arg.dagger) % 2;
+	    const Float *base = loc ? (back ? arg.backGhost[mu] : arg.fwdGhost[mu]) : arg.in;
+	    const int stride = loc ? geom.faceVolumeCB[mu] : Vh;
+	    const Float *psi[N];
+	    for (int k=0; k<N; k++) psi[k] = k < nl ? base + (s[k]*stride + nbr)*24 : zero;
+
+	    Vec h[2][3];
+	    for (int sp=0; sp<2; sp++) {
+	      const Float sign = projSign[proj][sp];
+	      for (int c=0; c<3; c++) {
+		const Float *pa[N], *pb[N];
+		for (int k=0; k<N; k++) {
+		  pa[k] = psi[k] + sp*6 + 2*c;
+		  pb[k] = psi[k] + projPartner[proj][sp]*6 + 2*c;
+		}
+		Vec a, b;
+		a.gather(pa);
+		b.gather(pb);
+		if (projUseI[proj]) b = times_i(b);
+		h[sp][c] = a + sign*b;
+	      }
+	    }
+
+	    Float buf[18];
+	    const Float *U = hopLink(buf, arg, i, x, p4, mu, back, nbr, loc);
+
+	    Vec Uh[2][3];
+	    for (int sp=0; sp<2; sp++) {
+	      for (int n=0; n<3; n++) {
+		if (!back) {
+		  Uh[sp][n] = cmul(U[n*6+0], U[n*6+1], h[sp][0]) + cmul(U[n*6+2], U[n*6+3], h[sp][1]) +
+		    cmul(U[n*6+4], U[n*6+5], h[sp][2]);
+		} else {
+		  Uh[sp][n] = conj_cmul(U[0*6+2*n], U[0*6+2*n+1], h[sp][0]) +
+		    conj_cmul(U[1*6+2*n], U[1*6+2*n+1], h[sp][1]) + conj_cmul(U[2*6+2*n], U[2*6+2*n+1], h[sp][2]);
+		}
+	      }
+	    }
+
+	    const bool swap = (projPartner[proj][0] == 3);
+	    for (int l=0; l<2; l++) {
+	      const Float sign = reconSign[proj][l];
+	      for (int c=0; c<3; c++) {
+		acc[l][c] += Uh[l][c];
+		Vec t = Uh[swap ? 1-l : l][c];
+		if (projUseI[proj]) t = times_i(t);
+		acc[2+l][c] += sign*t;
+	      }
+	    }
+	  }
+	}
+
+	// fifth dimension: P_R psi(s+1) and P_L psi(s-1) (swapped for
+	// the dagger), with the projector's factor of two and -mferm
+	// on the hops that wrap around the walls
+	for (int back=0; back<2; back++) {
+	  const int spin0 = (back ^ arg.dagger) ? 0 : 2;
+	  const Float *psi[N];
+	  Float scale[N];
+	  for (int k=0; k<N; k++) {
+	    int sn = s[k] + (back ? -1 : +1);
+	    scale[k] = 1.0;
+	    if (sn < 0 || sn >= Ls) { sn = (sn + Ls) % Ls; scale[k] = -arg.mferm; }
+	    psi[k] = k < nl ? arg.in + (sn*Vh + i)*24 : zero;
+	  }
+	  const Vec scaleVec = Vec::lanes(scale);
+
+	  for (int sp=spin0; sp<spin0+2; sp++) {
+	    for (int c=0; c<3; c++) {
+	      const Float *p[N];
+	      for (int k=0; k<N; k++) p[k] = psi[k] + sp*6 + 2*c;
+	      Vec a;
+	      a.gather(p);
+	      acc[sp][c] += scaleVec*((Float)2.0*a);
+	    }
+	  }
+	}
+
+	if (arg.x) { // out = x + k * D in
+	  const Float *px[N];
+	  for (int k=0; k<N; k++) px[k] = k < nl ? arg.x + (s[k]*Vh + i)*24 : zero;
+	  for (int sp=0; sp<4; sp++) {
+	    for (int c=0; c<3; c++) {
+	      const Float *p[N];
+	      for (int k=0; k<N; k++) p[k] = px[k] + sp*6 + 2*c;
+	      Vec a;
+	      a.gather(p);
+	      acc[sp][c] = a + arg.k*acc[sp][c];
+	    }
+	  }
+	}
+
+	for (int sp=0; sp<4; sp++) {
+	  for (int c=0; c<3; c++) {
+	    Float a[2*N];
+	    acc[sp][c].store(a);
+	    for (int k=0; k<nl; k++) {
+	      Float *out = arg.out + (s[k]*Vh + i)*24 + sp*6 + 2*c;
+	      out[0] = a[2*k+0];
+	      out[1] = a[2*k+1];
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+#undef READ_SPINOR
+#undef READ_SPINOR_FLAVOR
+#undef READ_GAUGE_MATRIX
+#undef READ_CLOVER
+#undef READ_ACCUM
+#undef READ_ACCUM_FLAVOR
+#undef WRITE_SPINOR
+#undef WRITE_SPINOR_FLAVOR
+#undef READ_SPINOR_5D
+
+  static void checkHostSpinor(const cpuColorSpinorField &out, const cpuColorSpinorField &in) {
+    if (in.SiteSubset() != QUDA_PARITY_SITE_SUBSET || out.SiteSubset() != QUDA_PARITY_SITE_SUBSET)
+      errorQuda("Host dslash requires single parity fields");
+    if (in.Precision() != out.Precision())
+      errorQuda("Input and output precisions differ (%d,%d)", in.Precision(), out.Precision());
+    if (in.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || out.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Field order %d not supported by the host dslash", in.FieldOrder());
+    if (in.Nspin() == 4 && (in.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS ||
+			    out.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS))
+      errorQuda("Gamma basis %d not supported by the host dslash", in.GammaBasis());
+  }
+
+  static void checkHostGauge(const cpuGaugeField &gauge, const cpuColorSpinorField &in) {
+    if (gauge.Order() != QUDA_QDP_GAUGE_ORDER)
+      errorQuda("Gauge order %d not supported by the host dslash", gauge.Order());
+    // 12 and 8 assume SU(3) links, up to the anisotropy and boundary (see HostLink)
+    const QudaReconstructType recon = gauge.Reconstruct();
+    if (recon != QUDA_RECONSTRUCT_NO && recon != QUDA_RECONSTRUCT_13 && recon != QUDA_RECONSTRUCT_9 &&
+	!((recon == QUDA_RECONSTRUCT_12 || recon == QUDA_RECONSTRUCT_8) && gauge.LinkType() == QUDA_WILSON_LINKS))
+      errorQuda("Reconstruct type %d not supported by the host dslash", gauge.Reconstruct());
+    if (gauge.Precision() != in.Precision())
+      errorQuda("Gauge and spinor precisions differ (%d,%d)", gauge.Precision(), in.Precision());
+  }
+
+  static void checkHostClover(const cpuCloverField &clover, const cpuColorSpinorField &in, bool inverse) {
+    if (clover.Order() != QUDA_PACKED_CLOVER_ORDER)
+      errorQuda("Clover order %d not supported by the host dslash", clover.Order());
+    if (clover.Precision() != in.Precision())
+      errorQuda("Clover and spinor precisions differ (%d,%d)", clover.Precision(), in.Precision());
+    if (!clover.V(inverse)) errorQuda("Clover %s has not been allocated", inverse ? "inverse" : "term");
+    if (clover.VolumeCB() != in.VolumeCB())
+      errorQuda("Clover and spinor volumes differ (%d,%d)", clover.VolumeCB(), in.VolumeCB());
+  }
+
+  /**
+     Fills the (static) host ghost buffers with the faces of in.
+     Only needed when a dimension is partitioned: unpartitioned
+     dimensions are wrapped around in the kernels directly.
+   */
+  static void exchangeHostGhost(const cpuColorSpinorField &in, int parity, int dagger, int nFace) {
+    bool partitioned = false;
+    for (int d=0; d<4; d++) if (commDimPartitioned(d)) partitioned = true;
+    if (!partitioned) return;
+
+    int X[4] = { 2*in.X(0), in.X(1), in.X(2), in.X(3) };
+    int Ls = in.Ndim() == 5 ? in.X(4) : 1;
+    FaceBuffer faceBuf(X, in.Ndim(), 2*in.Nspin()*in.Ncolor(), nFace, in.Precision(), Ls);
+    faceBuf.exchangeCpuSpinor(const_cast<cpuColorSpinorField&>(in), parity, dagger);
+  }
+
+  /**
+     Ghost zone of a single field, whose exchange may be overlapped
+     with the computation.  Unless overlap has been turned off (see
+     setHostDslashOverlap), the constructor only starts the exchange,
+     and apply() computes the interior, the sites whose neighbors are
+     all local (or dropped at Dirichlet boundaries), while the faces
+     are in flight.  The other sites are grouped by the set of
+     dimensions whose ghost zones they read, and each group is
+     computed as soon as the last of these has arrived.  The ghost
+     buffers may be reallocated when the exchange starts, so the
+     kernel arguments must be made after construction.
+   */
+  class HostGhost {
+    FaceBuffer *face; // the exchange in flight, if overlapping
+    const HostGeometry &geom;
+    const int nFace;
+
+    HostGhost(const HostGhost&);
+    HostGhost& operator=(const HostGhost&);
+
+  public:
+    HostGhost(const cpuColorSpinorField &in, const HostGeometry &geom, int parity, int dagger, int nFace)
+      : face(0), geom(geom), nFace(nFace) {
+      // nothing to exchange unless a partitioned dimension has comms on
+      bool partitioned = false;
+      for (int d=0; d<4; d++) if (geom.partitioned[d] && geom.comms[d]) partitioned = true;
+      if (!partitioned) return;
+
+      if (!hostOverlap) {
+	exchangeHostGhost(in, parity, dagger, nFace);
+	return;
+      }
+      const int X[4] = { 2*in.X(0), in.X(1), in.X(2), in.X(3) };
+      const int Ls = in.Ndim() == 5 ? in.X(4) : 1;
+      face = new FaceBuffer(X, in.Ndim(), 2*in.Nspin()*in.Ncolor(), nFace, in.Precision(), Ls);
+      face->exchangeCpuSpinorStart(const_cast<cpuColorSpinorField&>(in), parity, dagger);
+    }
+
+    ~HostGhost() { wait(); }
+
+    /** Completes the exchange, if it is in flight */
+    void wait() {
+      if (!face) return;
+      face->exchangeCpuSpinorWait();
+      delete face;
+      face = 0;
+    }
+
+    /**
+       Sweeps kernel over the sites of the output parity arg.parity.
+       nParity is 2 when the parity alternates between the slices of
+       the field (domain wall), so that sites of both are needed.
+     */
+    template <typename Arg, typename KernelArg>
+    void apply(void (*kernel)(const KernelArg&, const HostSites&), const Arg &arg, int nParity) {
+      if (!face) {
+	kernel(arg, HostSites(geom.volumeCB));
+	return;
+      }
+
+      // the sites of each parity sorted by their ghost mask, the interior first
+      const HostSiteLists &sites = hostSiteLists(geom, arg.parity, nFace, nParity);
+      int * const *list = sites.list;
+      const int (*offset)[17] = sites.offset;
+
+      int arrived = 0; // dimensions whose ghost zones have arrived
+      int done = 1;    // groups of sites computed, the interior (group 0) below
+      const int nChunk = 4;
+      for (int c=0; c<=nChunk; c++) {
+	// the messages may only progress in calls to the comms layer, so
+	// poll between chunks of the interior, then wait for the rest
+	if (c < nChunk) {
+	  int begin[2], end[2];
+	  for (int s=0; s<2; s++) {
+	    begin[s] = c*offset[s][1] / nChunk;
+	    end[s] = (c+1)*offset[s][1] / nChunk;
+	  }
+	  kernel(arg, HostSites(list[0] + begin[0], end[0] - begin[0], list[1] + begin[1], end[1] - begin[1]));
+	}
+
+	do {
+	  for (int d=0; d<4; d++)
+	    if (!(arrived & (1 << d)) && face->exchangeCpuSpinorQuery(d)) arrived |= 1 << d;
+	  for (int m=1; m<16; m++) {
+	    if ((done & (1 << m)) || (m & ~arrived)) continue;
+	    const int n0 = offset[0][m+1] - offset[0][m], n1 = offset[1][m+1] - offset[1][m];
+	    if (n0 || n1) kernel(arg, HostSites(list[0] + offset[0][m], n0, list[1] + offset[1][m], n1));
+	    done |= 1 << m;
+	  }
+	} while (c == nChunk && done != 0xffff);
+      }
+
+      wait();
+    }
+  };
+
+  /**
+     Multiple right-hand sides.  A block of nRhs single-parity 4-d
+     fields is applied in one sweep, with the lanes of the host
+     vectors running over the fields instead of over sites: each
+     lane gathers its own spinor, while the links (and clover term)
+     of a site are loaded once and broadcast to every lane, so the
+     gauge traffic is shared by the whole block.
+   */
+
+  /**
+     Ghost zones of a block of fields.  The host ghost buffers are
+     shared by all fields, so the faces of each field are exchanged
+     in turn and copied out, those of field r following those of
+     field r-1.
+   */
+  struct HostBlockGhost {
+    void *fwd[4];
+    void *back[4];
+    size_t faceBytes[4]; // size of the ghost zone of a single field
+
+    HostBlockGhost(cpuColorSpinorField **in, int nRhs, int parity, int dagger, int nFace,
+		   const int *commDim) {
+      bool partitioned = false;
+      for (int d=0; d<4; d++) {
+	fwd[d] = back[d] = 0;
+	faceBytes[d] = 0;
+	if (commDimPartitioned(d) && commDim[d]) partitioned = true;
+      }
+      if (!partitioned) return;
+
+      const cpuColorSpinorField &f = *in[0];
+      const int X[4] = { 2*f.X(0), f.X(1), f.X(2), f.X(3) };
+      const size_t siteBytes = 2*f.Nspin()*f.Ncolor()*f.Precision();
+      for (int d=0; d<4; d++) {
+	if (!commDimPartitioned(d) || !commDim[d]) continue;
+	faceBytes[d] = nFace*(f.VolumeCB()/X[d])*siteBytes;
+	fwd[d] = safe_malloc(nRhs*faceBytes[d]);
+	back[d] = safe_malloc(nRhs*faceBytes[d]);
+      }
+
+      for (int r=0; r<nRhs; r++) {
+	exchangeHostGhost(*in[r], parity, dagger, nFace);
+	for (int d=0; d<4; d++) {
+	  if (!commDimPartitioned(d) || !commDim[d]) continue;
+	  memcpy((char*)fwd[d] + r*faceBytes[d], cpuColorSpinorField::fwdGhostFaceBuffer[d], faceBytes[d]);
+	  memcpy((char*)back[d] + r*faceBytes[d], cpuColorSpinorField::backGhostFaceBuffer[d], faceBytes[d]);
+	}
+      }
+    }
+
+    ~HostBlockGhost() {
+      for (int d=0; d<4; d++) {
+	if (fwd[d]) host_free(fwd[d]);
+	if (back[d]) host_free(back[d]);
+      }
+    }
+  };
+
+  // Interleaved copy of the input block, kept between calls since a
+  // solver applies the dslash to blocks of the same size repeatedly
+  static void *blockBuffer = 0;
+  static size_t blockBufferBytes = 0;
+
+  static void* hostBlockBuffer(size_t bytes) {
+    if (bytes > blockBufferBytes) {
+      if (blockBuffer) host_free(blockBuffer);
+      blockBuffer = safe_malloc(bytes);
+      blockBufferBytes = bytes;
+    }
+    return blockBuffer;
+  }
+
+  /**
+     The fields of a block and their ghost zones.  The input fields
+     are copied into a single buffer with the fields interleaved per
+     site, so that the spinors of the block at a neighboring site are
+     contiguous: reading them from nRhs separate arrays costs a
+     memory stream (and cache set) per field, which throttles the
+     sweep once nRhs grows beyond a few fields.
+   */
+  template <typename Float>
+  struct HostBlock {
+    Float **out;
+    const Float **x;
+    int nRhs;
+    int siteReals;
+    Float *in; // in[(i*nRhs + r)*siteReals] is site i of field r
+    const Float *fwdGhost[4];
+    const Float *backGhost[4];
+    int ghostStride[4]; // reals between the ghost zones of consecutive fields
+
+    HostBlock(cpuColorSpinorField **out_, cpuColorSpinorField **in_, cpuColorSpinorField **x_,
+	      int nRhs, const HostBlockGhost &ghost)
+      : out(new Float*[nRhs]), x(x_ ? new const Float*[nRhs] : 0), nRhs(nRhs),
+	siteReals(2*in_[0]->Nspin()*in_[0]->Ncolor()), in(0) {
+      for (int r=0; r<nRhs; r++) {
+	out[r] = (Float*)out_[r]->V();
+	if (x) x[r] = (const Float*)x_[r]->V();
+      }
+
+      const int volumeCB = in_[0]->VolumeCB();
+      in = (Float*)hostBlockBuffer((size_t)volumeCB*nRhs*siteReals*sizeof(Float));
+      for (int r=0; r<nRhs; r++) {
+	const Float *v = (const Float*)in_[r]->V();
+#pragma omp parallel for schedule(static)
+	for (int i=0; i<volumeCB; i++)
+	  memcpy(in + ((size_t)i*nRhs + r)*siteReals, v + (size_t)i*siteReals, siteReals*sizeof(Float));
+      }
+
+      for (int d=0; d<4; d++) {
+	fwdGhost[d] = (const Float*)ghost.fwd[d];
+	backGhost[d] = (const Float*)ghost.back[d];
+	ghostStride[d] = ghost.faceBytes[d] / sizeof(Float);
+      }
+    }
+
+    ~HostBlock() {
+      delete []out;
+      if (x) delete []x;
+    }
+
+    /** Site i of field r of the input block */
+    inline const Float* site(int r, int i) const { return in + ((size_t)i*nRhs + r)*siteReals; }
+
+    /** The ghost zone of field r in the given direction of dimension mu */
+    inline const Float* ghost(int r, int mu, int back) const {
+      return (back ? backGhost[mu] : fwdGhost[mu]) + r*ghostStride[mu];
+    }
+
+  private:
+    HostBlock(const HostBlock&);
+    HostBlock& operator=(const HostBlock&);
+  };
+
+  /** Fields of the lanes starting at r0: the last block repeats its final field */
+  template <int N>
+  inline int blockLanes(int rhs[N], int r0, int nRhs) {
+    const int nLanes = nRhs - r0 < N ? nRhs - r0 : N;
+    for (int k=0; k<N; k++) rhs[k] = r0 + (k < nLanes ? k : nLanes - 1);
+    return nLanes;
+  }
+
+  template <typename Float>
+  struct WilsonBlockArg : public HostBlock<Float> {
+    Float k;
+    const Float *gauge[4];
+    const Float *ghostGauge[4];
+    HostLink<Float> link;
+    const Float *clover; // as for WilsonArg
+    bool asymmetric;
+    int parity;
+    int dagger;
+    HostGeometry geom;
+
+    WilsonBlockArg(cpuColorSpinorField **out, const cpuGaugeField &gauge_, cpuColorSpinorField **in,
+		   int nRhs, int parity, int dagger, cpuColorSpinorField **x, double k,
+		   const cpuCloverField *clover_, bool asymmetric, const HostBlockGhost &ghost,
+		   const HostGeometry &geom)
+      : HostBlock<Float>(out, in, x, nRhs, ghost), k(k), link(gauge_), clover(0), asymmetric(asymmetric),
+	parity(parity), dagger(dagger), geom(geom) {
+      for (int d=0; d<4; d++) {
+	gauge[d] = ((const Float**)gauge_.Gauge_p())[d];
+	ghostGauge[d] = (const Float*)gauge_.Ghost()[d];
+      }
+      if (clover_) clover = (const Float*)((const char*)clover_->V(!asymmetric) + parity*clover_->Bytes()/2);
+    }
+  };
+
+  /**
+     Lane addressing for the generated kernels over a block: the
+     lanes are up to N fields, starting at r0, at the single site i.
+     The neighbors and links of the site are found once, with select()
+     pointing the lanes at each group of fields in turn.
+   */
+  template <typename Float, int N>
+  struct RhsLanes {
+    int nLanes;
+    const Float *spinor[8][N]; // neighboring spinors of each field
+    const Float *gauge[8];     // links to them, shared by all lanes
+    Float link[8][18];         // the links, if they are compressed
+    const Float *clover;
+    const Float *accum[N];
+    Float *out[N];
+    int i;
+    int nbr[8];
+    int loc[8];
+
+    RhsLanes(const WilsonBlockArg<Float> &arg, int i) : i(i) {
+      const HostGeometry &geom = arg.geom;
+      const int parity = arg.parity;
+      int x[4];
+      geom.coords(x, i, parity);
+      for (int mu=0; mu<4; mu++) {
+	for (int back=0; back<2; back++) {
+	  const int dir = 2*mu + back;
+	  loc[dir] = geom.neighbor(nbr[dir], x, mu, back ? -1 : +1, 1);
+	  if (loc[dir] < 0) {
+	    gauge[dir] = zero();
+	    continue;
+	  }
+	  const int L = arg.link.length;
+	  const Float *U = !back ? arg.gauge[mu] + (parity*geom.volumeCB + i)*L :
+	    loc[dir] ? arg.ghostGauge[mu] + ((1-parity)*geom.faceVolumeCB[mu] + nbr[dir])*L :
+	    arg.gauge[mu] + ((1-parity)*geom.volumeCB + nbr[dir])*L;
+	  gauge[dir] = hostLink(link[dir], U, arg.link, arg.link.u0(mu, back, x[3], geom.X[3], loc[dir] > 0));
+	}
+      }
+      clover = arg.clover ? arg.clover + i*72 : 0;
+    }
+
+    void select(const WilsonBlockArg<Float> &arg, int r0) {
+      int rhs[N];
+      nLanes = blockLanes<N>(rhs, r0, arg.nRhs);
+      for (int dir=0; dir<8; dir++) {
+	for (int k=0; k<N; k++)
+	  spinor[dir][k] = loc[dir] < 0 ? zero() : loc[dir] ?
+	    arg.ghost(rhs[k], dir/2, dir%2) + nbr[dir]*24 : arg.site(rhs[k], nbr[dir]);
+      }
+      for (int k=0; k<N; k++) {
+	out[k] = arg.out[rhs[k]] + i*24;
+	accum[k] = arg.x ? arg.x[rhs[k]] + i*24 : 0;
+      }
+    }
+
+    static const Float* zero() {
+      static const Float z[24] = { };
+      return z;
+    }
+  };
+
+#define READ_SPINOR(v, dir) gatherLanes(v, lanes.spinor[dir], 24)
+#define READ_GAUGE_MATRIX(v, dir) broadcastLanes(v, lanes.gauge[dir], 18)
+#define READ_CLOVER(v, chi) broadcastLanes(v, lanes.clover + 36*(chi), 36)
+#define READ_ACCUM(v) gatherLanes(v, lanes.accum, 24)
+#define WRITE_SPINOR(v) scatterLanes(lanes.out, v, 24, lanes.nLanes)
+
+  /** Wilson (and clover) dslash of a block, as wilsonDslashHost */
+  template <typename Float, int N>
+  void wilsonDslashBlockHost(const WilsonBlockArg<Float> &arg) {
+    typedef RealVec<Float,N> spinorFloat;
+
+#pragma omp parallel for schedule(static)
+    for (int i=0; i<arg.geom.volumeCB; i++) {
+      RhsLanes<Float,N> lanes(arg, i);
+      for (int r0=0; r0<arg.nRhs; r0+=N) {
+	lanes.select(arg, r0);
+	if (!arg.dagger) {
+#include "wilson_dslash_cpu_core.h"
+	} else {
+#include "wilson_dslash_dagger_cpu_core.h"
+	}
+      }
+    }
+  }
+
+#undef READ_SPINOR
+#undef READ_GAUGE_MATRIX
+#undef READ_CLOVER
+#undef READ_ACCUM
+#undef WRITE_SPINOR
+
+  template <typename Float>
+  struct StaggeredBlockArg : public HostBlock<Float> {
+    Float k;
+    const Float *fat[4];
+    const Float *lng[4];
+    const Float *ghostFat[4];
+    const Float *ghostLong[4];
+    HostLink<Float> longLink;
+    int parity;
+    int dagger;
+    HostGeometry geom;
+
+    StaggeredBlockArg(cpuColorSpinorField **out, const cpuGaugeField &fat_, const cpuGaugeField &long_,
+		      cpuColorSpinorField **in, int nRhs, int parity, int dagger, cpuColorSpinorField **x,
+		      double k, const HostBlockGhost &ghost, const HostGeometry &geom)
+      : HostBlock<Float>(out, in, x, nRhs, ghost), k(k), longLink(long_), parity(parity), dagger(dagger),
+	geom(geom) {
+      for (int d=0; d<4; d++) {
+	fat[d] = ((const Float**)fat_.Gauge_p())[d];
+	lng[d] = ((const Float**)long_.Gauge_p())[d];
+	ghostFat[d] = (const Float*)fat_.Ghost()[d];
+	ghostLong[d] = (const Float*)long_.Ghost()[d];
+      }
+    }
+  };
+
+  /**
+     Improved staggered dslash of a block, as staggeredDslashHost.
+     The color vectors are held as separate real and imaginary parts,
+     with the link elements broadcast across the lanes.
+   */
+  template <typename Float, int N>
+  void staggeredDslashBlockHost(const StaggeredBlockArg<Float> &arg) {
+    typedef RealVec<Float,N> Vec;
+    const HostGeometry &geom = arg.geom;
+    const int parity = arg.parity;
+
+#pragma omp parallel for schedule(static)
+    for (int i=0; i<geom.volumeCB; i++) {
+      int x[4];
+      geom.coords(x, i, parity);
+
+      for (int r0=0; r0<arg.nRhs; r0+=N) {
+	int rhs[N];
+	const int nLanes = blockLanes<N>(rhs, r0, arg.nRhs);
+
+	Vec acc[6]; // re, im of each color
+	for (int j=0; j<6; j++) acc[j] = Vec(0.0);
+
+	for (int mu=0; mu<4; mu++) {
+	  const int fv = geom.faceVolumeCB[mu];
+	  for (int back=0; back<2; back++) {
+	    for (int naik=0; naik<2; naik++) {
+	      int nbr;
+	      int loc = geom.neighbor(nbr, x, mu, (back ? -1 : 1)*(naik ? 3 : 1), 3);
+	      if (loc < 0) continue; // dropped at a Dirichlet boundary
+
+	      // as in staggeredDslashHost: the fat link ghost is only one deep
+	      const int L = naik ? arg.longLink.length : 18;
+	      const Float *U = !back ? (naik ? arg.lng[mu] : arg.fat[mu]) + (parity*geom.volumeCB + i)*L :
+		!loc ? (naik ? arg.lng[mu] : arg.fat[mu]) + ((1-parity)*geom.volumeCB + nbr)*L :
+		naik ? arg.ghostLong[mu] + ((1-parity)*3*fv + nbr)*L :
+		arg.ghostFat[mu] + ((1-parity)*fv + nbr - 2*fv)*18;
+	      Float lng[18];
+	      if (naik) U = hostLink(lng, U, arg.longLink, 1);
+
+	      const Float *p[N];
+	      for (int k=0; k<N; k++) p[k] = loc ? arg.ghost(rhs[k], mu, back) + nbr*6 : arg.site(rhs[k], nbr);
+	      Vec h[6];
+	      gatherLanes(h, p, 6);
+
+	      for (int n=0; n<3; n++) {
+		for (int m=0; m<3; m++) {
+		  if (!back) { // U psi
+		    const Vec ur(U[(n*3+m)*2]), ui(U[(n*3+m)*2+1]);
+		    acc[2*n+0] += ur*h[2*m+0] - ui*h[2*m+1];
+		    acc[2*n+1] += ur*h[2*m+1] + ui*h[2*m+0];
+		  } else { // -U^dag psi
+		    const Vec ur(U[(m*3+n)*2]), ui(U[(m*3+n)*2+1]);
+		    acc[2*n+0] -= ur*h[2*m+0] + ui*h[2*m+1];
+		    acc[2*n+1] -= ur*h[2*m+1] - ui*h[2*m+0];
+		  }
+		}
+	      }
+	    }
+	  }
+	}
+
+	if (arg.dagger) for (int j=0; j<6; j++) acc[j] = -acc[j];
+	if (arg.x) { // out = k * x - D in, as in the GPU kernel
+	  const Float *p[N];
+	  for (int k=0; k<N; k++) p[k] = arg.x[rhs[k]] + i*6;
+	  Vec xv[6];
+	  gatherLanes(xv, p, 6);
+	  const Vec kv(arg.k);
+	  for (int j=0; j<6; j++) acc[j] = kv*xv[j] - acc[j];
+	}
+
+	Float *q[N];
+	for (int k=0; k<N; k++) q[k] = arg.out[rhs[k]] + i*6;
+	scatterLanes(q, acc, 6, nLanes);
+      }
+    }
+  }
+
+  static void checkHostBlock(cpuColorSpinorField **out, cpuColorSpinorField **in,
+			     cpuColorSpinorField **x, int nRhs) {
+    if (nRhs < 1) errorQuda("Invalid number of right-hand sides %d", nRhs);
+    for (int r=0; r<nRhs; r++) {
+      checkHostSpinor(*out[r], *in[r]);
+      if (x) checkHostSpinor(*out[r], *x[r]);
+      if (in[r]->Ndim() != 4) errorQuda("Block dslash requires 4-d fields, not %d-d", in[r]->Ndim());
+      if (in[r]->Precision() != in[0]->Precision() || in[r]->VolumeCB() != in[0]->VolumeCB())
+	errorQuda("Fields of the block differ in precision or volume");
+    }
+  }
+
+#endif // HOST_DSLASH
+
+  void wilsonDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+		       const int parity, const int dagger, const cpuColorSpinorField *x,
+		       const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostSpinor(*out, *in);
+    if (x) checkHostSpinor(*out, *x);
+    checkHostGauge(gauge, *in);
+
+    HostGeometry geom(gauge.X(), commDim);
+    HostGhost ghost(*in, geom, 1-parity, dagger, 1);
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      WilsonArg<double> arg(out, gauge, in, parity, dagger, x, k, geom);
+      if (hostGenerated) ghost.apply(wilsonDslashHost<double,SiteLanes<double>::value>, arg, 1);
+      else ghost.apply(wilsonDslashOrderedHost<double>, arg, 1);
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      WilsonArg<float> arg(out, gauge, in, parity, dagger, x, k, geom);
+      if (hostGenerated) ghost.apply(wilsonDslashHost<float,SiteLanes<float>::value>, arg, 1);
+      else ghost.apply(wilsonDslashOrderedHost<float>, arg, 1);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void cloverDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuCloverField &cloverInv,
+		       const cpuColorSpinorField *in, const int parity, const int dagger,
+		       const cpuColorSpinorField *x, const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostSpinor(*out, *in);
+    if (x) checkHostSpinor(*out, *x);
+    checkHostGauge(gauge, *in);
+    checkHostClover(cloverInv, *in, true);
+
+    HostGeometry geom(gauge.X(), commDim);
+    HostGhost ghost(*in, geom, 1-parity, dagger, 1);
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      CloverArg<double> arg(out, gauge, cloverInv, in, parity, dagger, x, k, false, geom);
+      if (hostGenerated) ghost.apply(wilsonDslashHost<double,SiteLanes<double>::value>, arg, 1);
+      else ghost.apply(wilsonDslashOrderedHost<double>, arg, 1);
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      CloverArg<float> arg(out, gauge, cloverInv, in, parity, dagger, x, k, false, geom);
+      if (hostGenerated) ghost.apply(wilsonDslashHost<float,SiteLanes<float>::value>, arg, 1);
+      else ghost.apply(wilsonDslashOrderedHost<float>, arg, 1);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void asymCloverDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuCloverField &clover,
+			   const cpuColorSpinorField *in, const int parity, const int dagger,
+			   const cpuColorSpinorField *x, const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    if (!x) errorQuda("Asymmetric clover dslash requires an xpay field");
+    checkHostSpinor(*out, *in);
+    checkHostSpinor(*out, *x);
+    checkHostGauge(gauge, *in);
+    checkHostClover(clover, *in, false);
+
+    HostGeometry geom(gauge.X(), commDim);
+    HostGhost ghost(*in, geom, 1-parity, dagger, 1);
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      CloverArg<double> arg(out, gauge, clover, in, parity, dagger, x, k, true, geom);
+      if (hostGenerated) ghost.apply(wilsonDslashHost<double,SiteLanes<double>::value>, arg, 1);
+      else ghost.apply(wilsonDslashOrderedHost<double>, arg, 1);
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      CloverArg<float> arg(out, gauge, clover, in, parity, dagger, x, k, true, geom);
+      if (hostGenerated) ghost.apply(wilsonDslashHost<float,SiteLanes<float>::value>, arg, 1);
+      else ghost.apply(wilsonDslashOrderedHost<float>, arg, 1);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void cloverCpu(cpuColorSpinorField *out, const cpuCloverField &clover, const cpuColorSpinorField *in,
+		 const int parity, const bool inverse) {
+#ifdef HOST_DSLASH
+    checkHostSpinor(*out, *in);
+    checkHostClover(clover, *in, inverse);
+
+    const void *A = (const char*)clover.V(inverse) + parity*clover.Bytes()/2;
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      cloverHost((double*)out->V(), (const double*)A, (const double*)in->V(), in->VolumeCB());
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      cloverHost((float*)out->V(), (const float*)A, (const float*)in->V(), in->VolumeCB());
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void twistedMassDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+			    const int parity, const int dagger, const cpuColorSpinorField *x,
+			    const QudaTwistDslashType type, const double &a, const double &b, const double &c,
+			    const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostSpinor(*out, *in);
+    if (x) checkHostSpinor(*out, *x);
+    checkHostGauge(gauge, *in);
+
+    int nFlavor = 0;
+    if (in->TwistFlavor() == QUDA_TWIST_PLUS || in->TwistFlavor() == QUDA_TWIST_MINUS) nFlavor = 1;
+    else if (in->TwistFlavor() == QUDA_TWIST_NONDEG_DOUBLET || in->TwistFlavor() == QUDA_TWIST_DEG_DOUBLET) nFlavor = 2;
+    else errorQuda("Twist flavor %d not supported by the host dslash", in->TwistFlavor());
+    if (nFlavor == 2 && (in->Ndim() != 5 || in->X(4) != 2))
+      errorQuda("Flavor doublet must be a 5-d field with two flavors");
+
+    if (type == QUDA_DEG_DSLASH_TWIST_XPAY && !x) errorQuda("Twisted xpay requires an xpay field");
+    if (type == QUDA_NONDEG_DSLASH) errorQuda("Twist type %d not supported by the host dslash", type);
+
+    HostGeometry geom(gauge.X(), commDim);
+    HostGhost ghost(*in, geom, 1-parity, dagger, 1);
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      TwistedMassArg<double> arg(out, gauge, in, parity, dagger, x, type, a, b, c, k, geom);
+      if (!hostGenerated) {
+	if (nFlavor == 1) ghost.apply(twistedMassDslashOrderedHost<double,1>, arg, 1);
+	else ghost.apply(twistedMassDslashOrderedHost<double,2>, arg, 1);
+      } else if (nFlavor == 1) {
+	ghost.apply(twistedMassDslashHost<double,SiteLanes<double>::value>, arg, 1);
+      } else {
+	ghost.apply(ndegTwistedMassDslashHost<double,SiteLanes<double>::value>, arg, 1);
+      }
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      TwistedMassArg<float> arg(out, gauge, in, parity, dagger, x, type, a, b, c, k, geom);
+      if (!hostGenerated) {
+	if (nFlavor == 1) ghost.apply(twistedMassDslashOrderedHost<float,1>, arg, 1);
+	else ghost.apply(twistedMassDslashOrderedHost<float,2>, arg, 1);
+      } else if (nFlavor == 1) {
+	ghost.apply(twistedMassDslashHost<float,SiteLanes<float>::value>, arg, 1);
+      } else {
+	ghost.apply(ndegTwistedMassDslashHost<float,SiteLanes<float>::value>, arg, 1);
+      }
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void staggeredDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &fatGauge, const cpuGaugeField &longGauge,
+			  const cpuColorSpinorField *in, const int parity, const int dagger,
+			  const cpuColorSpinorField *x, const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostSpinor(*out, *in);
+    if (x) checkHostSpinor(*out, *x);
+    checkHostGauge(fatGauge, *in);
+    checkHostGauge(longGauge, *in);
+    if (in->Nspin() != 1) errorQuda("Staggered dslash requires nSpin=1 fields, not %d", in->Nspin());
+    if (fatGauge.Nface() != 1 || longGauge.Nface() != 3)
+      errorQuda("Unexpected fat/long link ghost depths %d/%d", fatGauge.Nface(), longGauge.Nface());
+
+    HostGeometry geom(fatGauge.X(), commDim);
+    HostGhost ghost(*in, geom, 1-parity, dagger, 3);
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      StaggeredArg<double> arg(out, fatGauge, longGauge, in, parity, dagger, x, k, geom);
+      ghost.apply(staggeredDslashHost<double>, arg, 1);
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      StaggeredArg<float> arg(out, fatGauge, longGauge, in, parity, dagger, x, k, geom);
+      ghost.apply(staggeredDslashHost<float>, arg, 1);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void domainWallDslashCpu(cpuColorSpinorField *out, const cpuGaugeField &gauge, const cpuColorSpinorField *in,
+			   const int parity, const int dagger, const cpuColorSpinorField *x, const double &m_f,
+			   const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostSpinor(*out, *in);
+    if (x) checkHostSpinor(*out, *x);
+    checkHostGauge(gauge, *in);
+    if (in->Ndim() != 5) errorQuda("Domain wall dslash requires 5-d fields, not %d-d", in->Ndim());
+
+    HostGeometry geom(gauge.X(), commDim);
+    HostGhost ghost(*in, geom, 1-parity, dagger, 1);
+    if (in->Precision() == QUDA_DOUBLE_PRECISION) {
+      DomainWallArg<double> arg(out, gauge, in, parity, dagger, x, m_f, k, geom);
+      if (hostGenerated) ghost.apply(domainWallDslashHost<double,SiteLanes<double>::value>, arg, 2);
+      else ghost.apply(domainWallDslashOrderedHost<double,NativeLanes<double>::value>, arg, 2);
+    } else if (in->Precision() == QUDA_SINGLE_PRECISION) {
+      DomainWallArg<float> arg(out, gauge, in, parity, dagger, x, m_f, k, geom);
+      if (hostGenerated) ghost.apply(domainWallDslashHost<float,SiteLanes<float>::value>, arg, 2);
+      else ghost.apply(domainWallDslashOrderedHost<float,NativeLanes<float>::value>, arg, 2);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void wilsonDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &gauge, cpuColorSpinorField **in,
+		       const int nRhs, const int parity, const int dagger, cpuColorSpinorField **x,
+		       const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostBlock(out, in, x, nRhs);
+    if (nRhs == 1) { // nothing to share, so use the site-vectorized kernel
+      wilsonDslashCpu(out[0], gauge, in[0], parity, dagger, x ? x[0] : 0, k, commDim);
+      return;
+    }
+    checkHostGauge(gauge, *in[0]);
+
+    HostBlockGhost ghost(in, nRhs, 1-parity, dagger, 1, commDim);
+
+    HostGeometry geom(gauge.X(), commDim);
+    if (in[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      WilsonBlockArg<double> arg(out, gauge, in, nRhs, parity, dagger, x, k, 0, false, ghost, geom);
+      wilsonDslashBlockHost<double,SiteLanes<double>::value>(arg);
+    } else if (in[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      WilsonBlockArg<float> arg(out, gauge, in, nRhs, parity, dagger, x, k, 0, false, ghost, geom);
+      wilsonDslashBlockHost<float,SiteLanes<float>::value>(arg);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in[0]->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void cloverDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &gauge, const cpuCloverField &cloverInv,
+		       cpuColorSpinorField **in, const int nRhs, const int parity, const int dagger,
+		       cpuColorSpinorField **x, const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostBlock(out, in, x, nRhs);
+    if (nRhs == 1) {
+      cloverDslashCpu(out[0], gauge, cloverInv, in[0], parity, dagger, x ? x[0] : 0, k, commDim);
+      return;
+    }
+    checkHostGauge(gauge, *in[0]);
+    checkHostClover(cloverInv, *in[0], true);
+
+    HostBlockGhost ghost(in, nRhs, 1-parity, dagger, 1, commDim);
+
+    HostGeometry geom(gauge.X(), commDim);
+    if (in[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      WilsonBlockArg<double> arg(out, gauge, in, nRhs, parity, dagger, x, k, &cloverInv, false, ghost, geom);
+      wilsonDslashBlockHost<double,SiteLanes<double>::value>(arg);
+    } else if (in[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      WilsonBlockArg<float> arg(out, gauge, in, nRhs, parity, dagger, x, k, &cloverInv, false, ghost, geom);
+      wilsonDslashBlockHost<float,SiteLanes<float>::value>(arg);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in[0]->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void asymCloverDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &gauge, const cpuCloverField &clover,
+			   cpuColorSpinorField **in, const int nRhs, const int parity, const int dagger,
+			   cpuColorSpinorField **x, const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    if (!x) errorQuda("Asymmetric clover dslash requires xpay fields");
+    checkHostBlock(out, in, x, nRhs);
+    if (nRhs == 1) {
+      asymCloverDslashCpu(out[0], gauge, clover, in[0], parity, dagger, x[0], k, commDim);
+      return;
+    }
+    checkHostGauge(gauge, *in[0]);
+    checkHostClover(clover, *in[0], false);
+
+    HostBlockGhost ghost(in, nRhs, 1-parity, dagger, 1, commDim);
+
+    HostGeometry geom(gauge.X(), commDim);
+    if (in[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      WilsonBlockArg<double> arg(out, gauge, in, nRhs, parity, dagger, x, k, &clover, true, ghost, geom);
+      wilsonDslashBlockHost<double,SiteLanes<double>::value>(arg);
+    } else if (in[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      WilsonBlockArg<float> arg(out, gauge, in, nRhs, parity, dagger, x, k, &clover, true, ghost, geom);
+      wilsonDslashBlockHost<float,SiteLanes<float>::value>(arg);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in[0]->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void staggeredDslashCpu(cpuColorSpinorField **out, const cpuGaugeField &fatGauge, const cpuGaugeField &longGauge,
+			  cpuColorSpinorField **in, const int nRhs, const int parity, const int dagger,
+			  cpuColorSpinorField **x, const double &k, const int *commDim) {
+#ifdef HOST_DSLASH
+    checkHostBlock(out, in, x, nRhs);
+    if (nRhs == 1) {
+      staggeredDslashCpu(out[0], fatGauge, longGauge, in[0], parity, dagger, x ? x[0] : 0, k, commDim);
+      return;
+    }
+    checkHostGauge(fatGauge, *in[0]);
+    checkHostGauge(longGauge, *in[0]);
+    if (in[0]->Nspin() != 1) errorQuda("Staggered dslash requires nSpin=1 fields, not %d", in[0]->Nspin());
+    if (fatGauge.Nface() != 1 || longGauge.Nface() != 3)
+      errorQuda("Unexpected fat/long link ghost depths %d/%d", fatGauge.Nface(), longGauge.Nface());
+
+    HostBlockGhost ghost(in, nRhs, 1-parity, dagger, 3, commDim);
+
+    HostGeometry geom(fatGauge.X(), commDim);
+    if (in[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      StaggeredBlockArg<double> arg(out, fatGauge, longGauge, in, nRhs, parity, dagger, x, k, ghost, geom);
+      staggeredDslashBlockHost<double,SiteLanes<double>::value>(arg);
+    } else if (in[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      StaggeredBlockArg<float> arg(out, fatGauge, longGauge, in, nRhs, parity, dagger, x, k, ghost, geom);
+      staggeredDslashBlockHost<float,SiteLanes<float>::value>(arg);
+    } else {
+      errorQuda("Precision %d not supported by the host dslash", in[0]->Precision());
+    }
+#else
+    errorQuda("Host dslash has not been built");
+#endif
+  }
+
+  void freeHostDslashBuffer() {
+#ifdef HOST_DSLASH
+    if (blockBuffer) host_free(blockBuffer);
+    blockBuffer = 0;
+    blockBufferBytes = 0;
+
+    for (size_t i=0; i<siteLists.size(); i++) {
+      for (int s=0; s<2; s++) if (siteLists[i]->list[s]) host_free(siteLists[i]->list[s]);
+      delete siteLists[i];
+    }
+    siteLists.clear();
+#endif
+  }
+
+} // namespace quda
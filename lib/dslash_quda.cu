@@ -512,6 +512,27 @@ namespace quda {
     }
     virtual int Nface() { return 2; }
 
+    /**
+       Bytes moved by a nearest-neighbour dslash, ignoring cache reuse:
+       at each output site, the spinors at the neighbouring sites and
+       the links to them are read, and the output spinor (and any xpay
+       accumulator) is written (read).  The links are the same
+       precision as the spinors.
+       @param linkReals Reals stored per one-hop link
+       @param longLinkReals Reals stored per three-hop link (0 if none)
+       @param siteReals Any further reals read per site (e.g., the clover term)
+    */
+    long long dslashBytes(int linkReals, int longLinkReals=0, int siteReals=0) const
+    {
+      const int nDir = 2*4;
+      const int spinorBytes = 2*in->Ncolor()*in->Nspin()*in->Precision() +
+	(in->Precision() == QUDA_HALF_PRECISION ? sizeof(float) : 0);
+      const int nNeighbour = longLinkReals ? 2*nDir : nDir;
+      long long site = (long long)nNeighbour*spinorBytes + (x ? 2 : 1)*spinorBytes +
+	(nDir*(linkReals + longLinkReals) + siteReals)*in->Precision();
+      return site * dslashConstants.VolumeCB();
+    }
+
     virtual void preTune()
     {
       if (dslashParam.kernel_type < 5) { // exterior kernel
@@ -752,6 +773,7 @@ namespace quda {
     }
 
     long long flops() const { return (x ? 1368ll : 1320ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long bytes() const { return dslashBytes(reconstruct); }
   };
 
   template <typename sFloat, typename gFloat, typename cFloat>
@@ -815,6 +837,7 @@ namespace quda {
     }
 
     long long flops() const { return (x ? 1872ll : 1824ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long bytes() const { return dslashBytes(reconstruct, 0, 72); }
   };
 
   template <typename sFloat, typename gFloat, typename cFloat>
@@ -879,6 +902,7 @@ namespace quda {
     }
 
     long long flops() const { return 1872ll * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long bytes() const { return dslashBytes(reconstruct, 0, 72); }
   };
 
   void setTwistParam(double &a, double &b, const double &kappa, const double &mu, 
@@ -997,6 +1021,7 @@ namespace quda {
     }
 
     long long flops() const { return (x ? 1416ll : 1392ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long bytes() const { return dslashBytes(reconstruct); }
   };
 
   template <typename sFloat, typename gFloat>
@@ -1187,6 +1212,11 @@ namespace quda {
     int Nface() { return 6; }
 
     long long flops() const { return (x ? 1158ll : 1146ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long bytes() const { // the fat links are never compressed
+      const int longReals = reconstruct == QUDA_RECONSTRUCT_13 ? 12 :
+	reconstruct == QUDA_RECONSTRUCT_9 ? 8 : reconstruct;
+      return dslashBytes(18, longReals);
+    }
   };
 
   int gatherCompleted[Nstream];
@@ -1934,6 +1964,10 @@ namespace quda {
     }
 
     long long flops() const { return 504ll * dslashConstants.VolumeCB(); }
+    long long bytes() const {
+      return (long long)(in->Bytes() + in->NormBytes() + out->Bytes() + out->NormBytes()) +
+	72ll*in->Precision()*dslashConstants.VolumeCB();
+    }
   };
 
 
@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+#include <face_quda.h>
+
+/*!
+ * Thick-restart Lanczos (K. Wu and H. Simon, SIAM J. Matrix
+ * Anal. Appl. 22, 602 (2000)) with Chebyshev polynomial acceleration.
+ *
+ * The Lanczos iteration is run on B = T_d((c - A)/e), with
+ * c = (amax + amin)/2 and e = (amax - amin)/2, where T_d is the
+ * Chebyshev polynomial of degree d.  B maps the part of the spectrum
+ * of A in [amin, amax] to [-1, 1], while the modes below amin grow
+ * like exp(d acosh((c - lambda)/e)), so the lowest modes of A become
+ * the largest and best separated eigenvalues of B.  B shares its
+ * eigenvectors with A, and the eigenvalues of A are recovered from
+ * the Rayleigh quotients of the final Ritz vectors.
+ *
+ * After nkrylov steps the Lanczos matrix is diagonalised and the
+ * Krylov space is restarted with the leading Ritz vectors, together
+ * with the last Lanczos vector.  The kept Ritz vectors satisfy
+ *
+ *   B y_i = theta_i y_i + s_i v_m,  s_i = beta_m Y_mi,
+ *
+ * so after a restart the projected matrix has an arrowhead block
+ * followed by the usual tridiagonal.  The Lanczos vectors are fully
+ * reorthogonalised, and |s_i| is the residual of the Ritz pair.
+ */
+
+namespace quda {
+
+  ThickRestartLanczos::ThickRestartLanczos(DiracMatrix &mat, QudaInvertParam &param,
+					   TimeProfile &profile) :
+    mat(mat), param(param), profile(profile), tmp(0), tmp2(0), w0(0), w1(0)
+  {
+
+  }
+
+  ThickRestartLanczos::~ThickRestartLanczos() {
+
+  }
+
+  void ThickRestartLanczos::filter(ColorSpinorField &out, ColorSpinorField &in,
+				   const double amin, const double amax) {
+    const int deg = param.eig_poly_deg;
+
+    if (deg == 0) {
+      // the lowest modes of A are the largest of -A
+      mat(out, in, *tmp, *tmp2);
+      blas::ax(-1.0, out);
+      return;
+    }
+
+    const double c = 0.5*(amax + amin);
+    const double e = 0.5*(amax - amin);
+
+    // T_1 = (c - A)/e
+    ColorSpinorField *y_prev = &in, *y = &out, *next = w0, *spare = w1;
+    mat(*y, in, *tmp, *tmp2);
+    blas::axpby(c/e, in, -1.0/e, *y);
+
+    // T_k+1 = 2 (c - A)/e T_k - T_k-1
+    for (int k=1; k<deg; k++) {
+      mat(*next, *y, *tmp, *tmp2);
+      blas::axpby(2.0*c/e, *y, -2.0/e, *next);
+      blas::axpy(-1.0, *y_prev, *next);
+
+      ColorSpinorField *t = y_prev;
+      y_prev = y;
+      y = next;
+      next = (t == &in) ? spare : t;
+    }
+
+    if (y != &out) blas::copy(out, *y);
+  }
+
+  // W_j = sum_i V_i C_ij for the first nc columns of the n x nc matrix C, swapped into V
+  static void rotate(ColorSpinorField **V, ColorSpinorField **W, const std::vector<double> &C,
+		     const int n, const int nc) {
+    std::vector<Complex> coeff(n);
+    for (int j=0; j<nc; j++) {
+      for (int i=0; i<n; i++) coeff[i] = C[i*nc+j];
+      blas::zero(*W[j]);
+      blas::caxpy(&coeff[0], V, *W[j], n);
+    }
+    for (int j=0; j<nc; j++) std::swap(V[j], W[j]);
+  }
+
+  int ThickRestartLanczos::operator()(ColorSpinorField **evecs, double *evals, ColorSpinorField &v0)
+  {
+    profile.Start(QUDA_PROFILE_INIT);
+
+    const int nEv = param.nev;
+    const int nKr = param.eig_nkrylov;
+    const int deg = param.eig_poly_deg;
+    if (nEv < 1 || nKr < nEv+2)
+      errorQuda("Invalid Lanczos parameters nev = %d, eig_nkrylov = %d (must be at least nev+2)", nEv, nKr);
+    if (deg < 0) errorQuda("Invalid Chebyshev polynomial degree %d", deg);
+
+    const double v2 = norm2(v0);
+    if (v2 == 0.0) errorQuda("Lanczos starting vector is zero");
+
+    ColorSpinorParam csParam(v0);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    tmp = ColorSpinorField::Create(v0, csParam);
+    w0 = ColorSpinorField::Create(v0, csParam);
+    w1 = ColorSpinorField::Create(v0, csParam);
+
+    tmp2 = tmp;
+    // tmp only needed for multi-gpu Wilson-like kernels
+    if (mat.Type() != typeid(DiracStaggeredPC).name() &&
+	mat.Type() != typeid(DiracStaggered).name()) {
+      tmp2 = ColorSpinorField::Create(v0, csParam);
+    }
+
+    // the Krylov space, with one extra vector for the residual, and the workspace for restarts
+    ColorSpinorField **V = new ColorSpinorField*[nKr+1];
+    for (int i=0; i<=nKr; i++) V[i] = ColorSpinorField::Create(v0, csParam);
+    ColorSpinorField **W = new ColorSpinorField*[nKr];
+    for (int i=0; i<nKr; i++) W[i] = ColorSpinorField::Create(v0, csParam);
+
+    profile.Stop(QUDA_PROFILE_INIT);
+    profile.Start(QUDA_PROFILE_PREAMBLE);
+
+    double amin = param.eig_amin;
+    double amax = param.eig_amax;
+    if (deg > 0 && amax <= 0.0) {
+      // estimate the top of the spectrum by power iteration, with a safety margin
+      blas::copy(*w1, v0);
+      blas::ax(1.0/sqrt(v2), *w1);
+      double lambda = 0.0;
+      for (int i=0; i<30; i++) {
+	mat(*w0, *w1, *tmp, *tmp2);
+	lambda = sqrt(norm2(*w0));
+	blas::axpby(1.0/lambda, *w0, 0.0, *w1);
+      }
+      amax = 1.1*lambda;
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("TRLM: estimated eig_amax = %e\n", amax);
+    }
+    if (deg > 0 && (amin <= 0.0 || amin >= amax))
+      errorQuda("Invalid Chebyshev interval [%e, %e]", amin, amax);
+
+    blas::copy(*V[0], v0);
+    blas::ax(1.0/sqrt(v2), *V[0]);
+
+    // the projected matrix is diag(alpha) with the arrow s in row and column k and beta off the diagonal
+    std::vector<double> alpha(nKr), beta(nKr), s(nKr);
+    std::vector<double> T(nKr*nKr), Y(nKr*nKr), theta(nKr), C;
+    std::vector<Complex> c(nKr);
+
+    int k = 0; // number of Ritz vectors kept at the last restart
+    int nconv = 0;
+    int restart = 0;
+    int iter = 0;
+
+    profile.Stop(QUDA_PROFILE_PREAMBLE);
+    profile.Start(QUDA_PROFILE_COMPUTE);
+    blas_flops = 0;
+
+    while (true) {
+
+      for (int j=k; j<nKr; j++) {
+	filter(*V[j+1], *V[j], amin, amax);
+	iter++;
+
+	// full reorthogonalisation, with a second pass to restore orthogonality to working precision
+	for (int pass=0; pass<2; pass++) {
+	  blas::cDotProduct(&c[0], V, *V[j+1], j+1);
+	  if (pass == 0) alpha[j] = real(c[j]);
+	  for (int i=0; i<=j; i++) c[i] = -c[i];
+	  blas::caxpy(&c[0], V, *V[j+1], j+1);
+	}
+
+	beta[j] = sqrt(norm2(*V[j+1]));
+	if (beta[j] == 0.0) errorQuda("Lanczos breakdown at step %d", j);
+	blas::ax(1.0/beta[j], *V[j+1]);
+      }
+
+      std::fill(T.begin(), T.end(), 0.0);
+      for (int i=0; i<nKr; i++) T[i*nKr+i] = alpha[i];
+      for (int i=0; i<k; i++) T[i*nKr+k] = T[k*nKr+i] = s[i];
+      for (int i=k; i<nKr-1; i++) T[i*nKr+i+1] = T[(i+1)*nKr+i] = beta[i];
+      symmetricEigensolve(&theta[0], &Y[0], &T[0], nKr);
+
+      // the wanted Ritz pairs are the largest, in the last columns of Y
+      nconv = 0;
+      for (int i=0; i<nEv; i++) {
+	const int col = nKr-1-i;
+	if (fabs(beta[nKr-1]*Y[(nKr-1)*nKr+col]) >= param.eig_tol*fabs(theta[col])) break;
+	nconv++;
+      }
+
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("TRLM: restart %d, %d of %d eigenpairs converged\n", restart, nconv, nEv);
+
+      const bool done = (nconv == nEv || restart == param.eig_max_restarts);
+      const int keep = done ? nEv : nEv + (nKr-nEv)/2;
+
+      C.resize(nKr*keep);
+      for (int i=0; i<nKr; i++)
+	for (int j=0; j<keep; j++) C[i*keep+j] = Y[i*nKr+nKr-1-j];
+      rotate(V, W, C, nKr, keep);
+
+      if (done) break;
+
+      for (int i=0; i<keep; i++) {
+	alpha[i] = theta[nKr-1-i];
+	s[i] = beta[nKr-1]*Y[(nKr-1)*nKr+nKr-1-i];
+      }
+      std::swap(V[keep], V[nKr]);
+      k = keep;
+      restart++;
+    }
+
+    profile.Stop(QUDA_PROFILE_COMPUTE);
+    profile.Start(QUDA_PROFILE_EPILOGUE);
+
+    if (nconv < nEv)
+      warningQuda("TRLM: only %d of %d eigenpairs converged after %d restarts", nconv, nEv, restart);
+
+    // eigenvalues of A from the Rayleigh quotients, sorted in ascending order
+    std::vector<std::pair<double,int> > lambda(nEv);
+    std::vector<double> res(nEv);
+    for (int i=0; i<nEv; i++) {
+      mat(*w0, *V[i], *tmp, *tmp2);
+      lambda[i] = std::make_pair(blas::reDotProduct(*V[i], *w0), i);
+      blas::axpy(-lambda[i].first, *V[i], *w0);
+      res[i] = sqrt(norm2(*w0));
+    }
+    std::sort(lambda.begin(), lambda.end());
+
+    for (int i=0; i<nEv; i++) {
+      evals[i] = lambda[i].first;
+      blas::copy(*evecs[i], *V[lambda[i].second]);
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("TRLM: eval[%d] = %e, residual = %e\n", i, evals[i], res[lambda[i].second]);
+    }
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (quda::blas_flops + mat.flops())*1e-9;
+    reduceDouble(gflops);
+    param.gflops = gflops;
+    param.iter = iter*(deg > 0 ? deg : 1);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("TRLM: %d of %d eigenpairs converged after %d restarts, %d operator applications\n",
+		 nconv, nEv, restart, param.iter);
+
+    // reset the flops counters
+    quda::blas_flops = 0;
+    mat.flops();
+
+    profile.Stop(QUDA_PROFILE_EPILOGUE);
+    profile.Start(QUDA_PROFILE_FREE);
+
+    for (int i=0; i<nKr; i++) delete W[i];
+    delete []W;
+    for (int i=0; i<=nKr; i++) delete V[i];
+    delete []V;
+
+    if (tmp2 != tmp) delete tmp2;
+    delete w1;
+    delete w0;
+    delete tmp;
+    tmp = tmp2 = w0 = w1 = 0;
+
+    profile.Stop(QUDA_PROFILE_FREE);
+
+    return nconv;
+  }
+
+} // namespace quda
@@ -258,12 +258,47 @@ namespace quda {
     } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
       
 #ifdef BUILD_QDP_INTERFACE
-      extractGhost<Float,length>(QDPOrder<Float,length>(u, 0, Ghost),
-				 u.Nface(), u.SurfaceCB(), u.X(), location);
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	extractGhost<Float,length>(QDPOrder<Float,length>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	extractGhost<Float,length>(QDPOrder<Float,length,12>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	extractGhost<Float,length>(QDPOrder<Float,length,8>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_13) {
+	extractGhost<Float,length>(QDPOrder<Float,length,13>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_9) {
+	extractGhost<Float,length>(QDPOrder<Float,length,9>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
       
+    } else if (u.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length,12>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length,8>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_13) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length,13>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_9) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length,9>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+      }
     } else if (u.Order() == QUDA_QDPJIT_GAUGE_ORDER) {
 
 #ifdef BUILD_QDPJIT_INTERFACE
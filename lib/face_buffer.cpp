@@ -366,6 +366,13 @@ void FaceBuffer::scatter(cudaColorSpinorField &out, int dagger, int dir)
 
 // This is just an initial hack for CPU comms - should be creating the message handlers at instantiation
 void FaceBuffer::exchangeCpuSpinor(cpuColorSpinorField &spinor, int oddBit, int dagger)
+{
+  exchangeCpuSpinorStart(spinor, oddBit, dagger);
+  exchangeCpuSpinorWait();
+}
+
+
+void FaceBuffer::exchangeCpuSpinorStart(cpuColorSpinorField &spinor, int oddBit, int dagger)
 {
   // allocate the ghost buffer if not yet allocated
   spinor.allocateGhostBuffer();
@@ -377,45 +384,53 @@ void FaceBuffer::exchangeCpuSpinor(cpuColorSpinorField &spinor, int oddBit, int
 		     QUDA_FORWARDS, (QudaParity)oddBit, dagger);
   }
 
-  MsgHandle *mh_send_fwd[4];
-  MsgHandle *mh_from_back[4];
-  MsgHandle *mh_from_fwd[4];
-  MsgHandle *mh_send_back[4];
-
   for (int i=0; i<nDimComms; i++) {
     if (!commDimPartitioned(i)) continue;
-    mh_send_fwd[i] = comm_declare_send_relative(spinor.fwdGhostFaceSendBuffer[i], i, +1, nbytes[i]);
-    mh_send_back[i] = comm_declare_send_relative(spinor.backGhostFaceSendBuffer[i], i, -1, nbytes[i]);
-    mh_from_fwd[i] = comm_declare_receive_relative(spinor.fwdGhostFaceBuffer[i], i, +1, nbytes[i]);
-    mh_from_back[i] = comm_declare_receive_relative(spinor.backGhostFaceBuffer[i], i, -1, nbytes[i]);
+    mh_cpu_send_fwd[i] = comm_declare_send_relative(spinor.fwdGhostFaceSendBuffer[i], i, +1, nbytes[i]);
+    mh_cpu_send_back[i] = comm_declare_send_relative(spinor.backGhostFaceSendBuffer[i], i, -1, nbytes[i]);
+    mh_cpu_recv_fwd[i] = comm_declare_receive_relative(spinor.fwdGhostFaceBuffer[i], i, +1, nbytes[i]);
+    mh_cpu_recv_back[i] = comm_declare_receive_relative(spinor.backGhostFaceBuffer[i], i, -1, nbytes[i]);
   }
 
   for (int i=0; i<nDimComms; i++) {
     if (commDimPartitioned(i)) {
-      comm_start(mh_from_back[i]);
-      comm_start(mh_from_fwd[i]);
-      comm_start(mh_send_fwd[i]);
-      comm_start(mh_send_back[i]);
+      comm_start(mh_cpu_recv_back[i]);
+      comm_start(mh_cpu_recv_fwd[i]);
+      comm_start(mh_cpu_send_fwd[i]);
+      comm_start(mh_cpu_send_back[i]);
     } else {
       memcpy(spinor.backGhostFaceBuffer[i], spinor.fwdGhostFaceSendBuffer[i], nbytes[i]);
       memcpy(spinor.fwdGhostFaceBuffer[i], spinor.backGhostFaceSendBuffer[i], nbytes[i]);
     }
   }
+}
+
+
+int FaceBuffer::exchangeCpuSpinorQuery(int dim)
+{
+  if (dim >= nDimComms || !commDimPartitioned(dim)) return 1;
+
+  // only the ghost zone need have arrived: the sends are completed by exchangeCpuSpinorWait
+  return comm_query(mh_cpu_recv_back[dim]) && comm_query(mh_cpu_recv_fwd[dim]);
+}
 
+
+void FaceBuffer::exchangeCpuSpinorWait()
+{
   for (int i=0; i<nDimComms; i++) {
     if (!commDimPartitioned(i)) continue;
-    comm_wait(mh_send_fwd[i]);
-    comm_wait(mh_send_back[i]);
-    comm_wait(mh_from_back[i]);
-    comm_wait(mh_from_fwd[i]);
+    comm_wait(mh_cpu_send_fwd[i]);
+    comm_wait(mh_cpu_send_back[i]);
+    comm_wait(mh_cpu_recv_back[i]);
+    comm_wait(mh_cpu_recv_fwd[i]);
   }
 
   for (int i=0; i<nDimComms; i++) {
     if (!commDimPartitioned(i)) continue;
-    comm_free(mh_send_fwd[i]);
-    comm_free(mh_send_back[i]);
-    comm_free(mh_from_back[i]);
-    comm_free(mh_from_fwd[i]);
+    comm_free(mh_cpu_send_fwd[i]);
+    comm_free(mh_cpu_send_back[i]);
+    comm_free(mh_cpu_recv_back[i]);
+    comm_free(mh_cpu_recv_fwd[i]);
   }
 }
 
@@ -493,6 +508,31 @@ void reduceDouble(double &sum) { if (globalReduce) comm_allreduce(&sum); }
 void reduceDoubleArray(double *sum, const int len) 
 { if (globalReduce) comm_allreduce_array(sum, len); }
 
+// handle of the outstanding nonblocking reduction (at most one at a time)
+static MsgHandle *reduceHandle = NULL;
+static bool reducePending = false;
+
+/**
+   Start a nonblocking global sum of the partial sums in sum.  The
+   result is only valid after reduceDoubleArrayWait(), so that the
+   caller can overlap the reduction with other work.
+ */
+void reduceDoubleArrayStart(double *sum, const int len)
+{
+  if (reducePending) errorQuda("Nonblocking reduction already in flight");
+  if (!globalReduce) return;
+  reduceHandle = comm_iallreduce_array(sum, len);
+  reducePending = true;
+}
+
+void reduceDoubleArrayWait()
+{
+  if (!reducePending) return;
+  comm_allreduce_wait(reduceHandle);
+  reduceHandle = NULL;
+  reducePending = false;
+}
+
 int commDim(int dir) { return comm_dim(dir); }
 
 int commCoords(int dir) { return comm_coord(dir); }
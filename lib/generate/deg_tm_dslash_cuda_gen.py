@@ -71,6 +71,42 @@ igamma5 = complexify([
 ])
 
 
+# DeGrand-Rossi basis, used by the host (CPU) kernels
+gamma1_dr = complexify([
+    0, 0, 0, 1j,
+    0, 0, 1j, 0,
+    0, -1j, 0, 0,
+    -1j, 0, 0, 0
+])
+
+gamma2_dr = complexify([
+    0, 0, 0, -1,
+    0, 0, 1, 0,
+    0, 1, 0, 0,
+    -1, 0, 0, 0
+])
+
+gamma3_dr = complexify([
+    0, 0, 1j, 0,
+    0, 0, 0, -1j,
+    -1j, 0, 0, 0,
+    0, 1j, 0, 0
+])
+
+gamma4_dr = complexify([
+    0, 0, 1, 0,
+    0, 0, 0, 1,
+    1, 0, 0, 0,
+    0, 1, 0, 0
+])
+
+igamma5_dr = complexify([
+    1j, 0, 0, 0,
+    0, 1j, 0, 0,
+    0, 0, -1j, 0,
+    0, 0, 0, -1j
+])
+
 def gplus(g1, g2):
     return [x+y for (x,y) in zip(g1,g2)]
 
@@ -92,6 +128,13 @@ projectors = [
     gminus(id,gamma4), gplus(id,gamma4),
 ]
 
+projectors_dr = [
+    gminus(id,gamma1_dr), gplus(id,gamma1_dr),
+    gminus(id,gamma2_dr), gplus(id,gamma2_dr),
+    gminus(id,gamma3_dr), gplus(id,gamma3_dr),
+    gminus(id,gamma4_dr), gplus(id,gamma4_dr),
+]
+
 ### code generation  ########################################################################
 
 def indent(code):
@@ -420,6 +463,7 @@ def gen(dir, pack_only=False):
     for l in projStr.splitlines():
         str += "// "+l+"\n"
     str += "\n"
+    header = str
 
     str += "#ifdef MULTI_GPU\n"
     str += "const int sp_idx = (kernel_type == INTERIOR_KERNEL) ? ("+boundary[dir]+" ? "+sp_idx_wrap[dir]+" : "+sp_idx[dir]+") >> 1 :\n"
@@ -714,6 +758,15 @@ READ_SPINOR_SHARED(tx, threadIdx.y, tz);\n
         
         reconstruct += "\n"
 
+    if cpu:
+        # the host driver has already located the neighbors, so there is
+        # no boundary logic, and lanes across a Dirichlet boundary read zeros
+        load_cpu = "// read spinor and gauge matrix\n"
+        load_cpu += "READ_SPINOR(I, "+`dir`+");\n"
+        load_cpu += "READ_GAUGE_MATRIX(G, "+`dir`+");\n\n"
+        load_cpu += "if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) "+block(twist_cpu(in_re, in_im))+"\n\n"
+        return header + block(load_cpu + decl_half + project + "\n" + mult + reconstruct) + "\n\n"
+
     if dir >= 6:
         str += "if (gauge_fixed && ga_idx < X4X3X2X1hmX3X2X1h)\n"
         str += block(decl_half + prep_half + ident + reconstruct)
@@ -903,6 +956,136 @@ def generate_pack():
 # end def generate_pack
 
 
+### host (CPU) kernels ########################################################################
+
+def def_input_spinor_cpu():
+    str = "// input (neighbor) spinor and accumulator\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+in_re(s,c)+" I["+`2*i+0`+"]\n"
+            str += "#define "+in_im(s,c)+" I["+`2*i+1`+"]\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+acc_re(s,c)+" ACC["+`2*i+0`+"]\n"
+            str += "#define "+acc_im(s,c)+" ACC["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_input_spinor_cpu
+
+
+def def_gauge_cpu():
+    str = "// gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(0,m,n)+" G["+`2*i+0`+"]\n"
+            str += "#define "+g_im(0,m,n)+" G["+`2*i+1`+"]\n"
+    str += "\n"
+
+    str += "// conjugated gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(1,m,n)+" (+"+g_re(0,n,m)+")\n"
+            str += "#define "+g_im(1,m,n)+" (-"+g_im(0,n,m)+")\n"
+    str += "\n"
+
+    return str
+# end def def_gauge_cpu
+
+
+def def_output_spinor_cpu():
+    str = "// output spinor\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+out_re(s,c)+" O["+`2*i+0`+"]\n"
+            str += "#define "+out_im(s,c)+" O["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_output_spinor_cpu
+
+
+def cpu_defs():
+    return def_input_spinor_cpu() + def_gauge_cpu() + def_output_spinor_cpu()
+
+
+def undef_cpu(defs):
+    str = ""
+    for l in defs.splitlines():
+        if l.startswith("#define "): str += "#undef "+l.split()[1]+"\n"
+    return str
+# end def undef_cpu
+
+
+def twist_cpu(v_re, v_im):
+    # in place v = c (1 + i a gamma_5) v, with gamma_5 diagonal in the
+    # DeGrand-Rossi basis; the driver has negated a for the dagger
+    str = ""
+    for s in range(0,4):
+        for c in range(0,3):
+            str += "spinorFloat "+tmp_re(s,c)+" = "+v_re(s,c)+";  "
+            str += "spinorFloat "+tmp_im(s,c)+" = "+v_im(s,c)+";\n"
+    str += "\n"
+    for s in range(0,4):
+        g = igamma5_dr[4*s+s].imag
+        for c in range(0,3):
+            str += v_re(s,c)+" = arg.c*("+tmp_re(s,c)+" "+sign(-g)+" arg.a*"+tmp_im(s,c)+");\n"
+            str += v_im(s,c)+" = arg.c*("+tmp_im(s,c)+" "+sign(g)+" arg.a*"+tmp_re(s,c)+");\n"
+    return str
+# end def twist_cpu
+
+
+def prolog_cpu():
+    str = ("// *** CPU TWISTED MASS DSLASH ***\n\n" if not dagger else "// *** CPU TWISTED MASS DSLASH DAGGER ***\n\n")
+    str += (
+"""// Body of the host kernels in dslash_cpu.cpp, in the DeGrand-Rossi basis.
+// spinorFloat is a RealVec holding one site per lane, and the READ_*
+// and WRITE_SPINOR macros, which gather and scatter the lanes, are
+// defined there.  arg.type selects where the twist is applied.
+
+""")
+    str += cpu_defs()
+    str += "spinorFloat I[24], G[18], O[24];\n\n"
+
+    out = ""
+    for s in range(0,4):
+        for c in range(0,3):
+            out += out_re(s,c)+" = 0;  "+out_im(s,c)+" = 0;\n"
+    str += out + "\n"
+    return str
+# end def prolog_cpu
+
+
+def epilog_cpu():
+    str = ""
+    str += "if (arg.type == QUDA_DEG_DSLASH_TWIST_INV) "+block(twist_cpu(out_re, out_im))+"\n\n"
+
+    xpay = "spinorFloat ACC[24];\n"
+    xpay += "READ_ACCUM(ACC);\n\n"
+    xpay += "if (arg.type == QUDA_DEG_DSLASH_TWIST_XPAY) "+block(twist_cpu(acc_re, acc_im))+"\n\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            xpay += out_re(s,c)+" = "+acc_re(s,c)+" + arg.k*"+out_re(s,c)+";\n"
+            xpay += out_im(s,c)+" = "+acc_im(s,c)+" + arg.k*"+out_im(s,c)+";\n"
+    str += "// out = x + k * D in, or T x + k * D in\n"
+    str += "if (arg.x) "+block(xpay)+"\n\n"
+
+    str += "// write spinor field back to host memory\n"
+    str += "WRITE_SPINOR(O);\n\n"
+
+    str += "// undefine to prevent warnings when the core is included again\n"
+    str += undef_cpu(cpu_defs())
+    return str
+# end def epilog_cpu
+
+
+def generate_dslash_cpu():
+    return prolog_cpu() + gen(0) + gen(1) + gen(2) + gen(3) + gen(4) + gen(5) + gen(6) + gen(7) + epilog_cpu()
+
+
 def generate_dslash():
     return prolog() + gen(0) + gen(1) + gen(2) + gen(3) + gen(4) + gen(5) + gen(6) + gen(7) + epilog()
 
@@ -960,6 +1143,7 @@ twist = False
 sharedFloats = 0
 sharedDslash = False
 pack = False
+cpu = False
 
 # generate dslash kernels
 arch = 200
@@ -990,4 +1174,26 @@ f.close()
 dslash = False
 pack = False
 
+# generate the host (CPU) single-flavor kernels, which act on
+# DeGrand-Rossi basis fields
+cpu = True
+dslash = True
+projectors_gpu = projectors
+projectors = projectors_dr
 
+dagger = False
+print sys.argv[0] + ": generating tm_dslash_cpu_core.h";
+f = open('dslash_core/tm_dslash_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
+
+dagger = True
+print sys.argv[0] + ": generating tm_dslash_dagger_cpu_core.h";
+f = open('dslash_core/tm_dslash_dagger_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
+
+projectors = projectors_gpu
+cpu = False
+dslash = False
+dagger = False
@@ -71,6 +71,35 @@ igamma5 = complexify([
 ])
 
 
+# DeGrand-Rossi basis, used by the host (CPU) kernels
+gamma1_dr = complexify([
+    0, 0, 0, 1j,
+    0, 0, 1j, 0,
+    0, -1j, 0, 0,
+    -1j, 0, 0, 0
+])
+
+gamma2_dr = complexify([
+    0, 0, 0, -1,
+    0, 0, 1, 0,
+    0, 1, 0, 0,
+    -1, 0, 0, 0
+])
+
+gamma3_dr = complexify([
+    0, 0, 1j, 0,
+    0, 0, 0, -1j,
+    -1j, 0, 0, 0,
+    0, 1j, 0, 0
+])
+
+gamma4_dr = complexify([
+    0, 0, 1, 0,
+    0, 0, 0, 1,
+    1, 0, 0, 0,
+    0, 1, 0, 0
+])
+
 def gplus(g1, g2):
     return [x+y for (x,y) in zip(g1,g2)]
 
@@ -92,6 +121,13 @@ projectors = [
     gminus(id,gamma4), gplus(id,gamma4),
 ]
 
+projectors_dr = [
+    gminus(id,gamma1_dr), gplus(id,gamma1_dr),
+    gminus(id,gamma2_dr), gplus(id,gamma2_dr),
+    gminus(id,gamma3_dr), gplus(id,gamma3_dr),
+    gminus(id,gamma4_dr), gplus(id,gamma4_dr),
+]
+
 ### code generation  ########################################################################
 
 def indent(code):
@@ -509,6 +545,7 @@ def gen(dir, pack_only=False):
     for l in projStr.splitlines():
         str += "// "+l+"\n"
     str += "\n"
+    header = str
 
     str += "#ifdef MULTI_GPU\n"
     str += "const int sp_idx = (kernel_type == INTERIOR_KERNEL) ? ("+boundary[dir]+" ? "+sp_idx_wrap[dir]+" : "+sp_idx[dir]+") >> 1 :\n"
@@ -773,6 +810,14 @@ READ_SPINOR_SHARED(tx, threadIdx.y, tz);\n
         
         reconstruct += "\n"
 
+    if cpu:
+        # the host driver has already located the neighbors, so there is
+        # no boundary logic, and lanes across a Dirichlet boundary read zeros
+        load_cpu = "// read spinor and gauge matrix\n"
+        load_cpu += "READ_SPINOR(I, "+`dir`+");\n"
+        load_cpu += "READ_GAUGE_MATRIX(G, "+`dir`+");\n\n"
+        return header + block(load_cpu + decl_half + project + "\n" + mult + reconstruct) + "\n\n"
+
     if dir >= 6:
         str += "if (gauge_fixed && ga_idx < X4X3X2X1hmX3X2X1h)\n"
         str += block(decl_half + prep_half + ident + reconstruct)
@@ -838,7 +883,8 @@ def from_chiral_basis(v_out,v_in,c): # note: factor of 1/2 is included in clover
 
 
 def clover_mult(v_out, v_in, chi):
-    str = "READ_CLOVER(CLOVERTEX, "+`chi`+")\n\n"
+    if cpu: str = "READ_CLOVER(C, "+`chi`+");\n\n"
+    else: str = "READ_CLOVER(CLOVERTEX, "+`chi`+")\n\n"
 
     for s in range (0,2):
         for c in range (0,3):
@@ -1126,6 +1172,167 @@ def generate_pack():
 # end def generate_pack
 
 
+### host (CPU) kernels ########################################################################
+
+def def_input_spinor_cpu():
+    str = "// input (neighbor) spinor and accumulator\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+in_re(s,c)+" I["+`2*i+0`+"]\n"
+            str += "#define "+in_im(s,c)+" I["+`2*i+1`+"]\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+acc_re(s,c)+" ACC["+`2*i+0`+"]\n"
+            str += "#define "+acc_im(s,c)+" ACC["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_input_spinor_cpu
+
+
+def def_gauge_cpu():
+    str = "// gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(0,m,n)+" G["+`2*i+0`+"]\n"
+            str += "#define "+g_im(0,m,n)+" G["+`2*i+1`+"]\n"
+    str += "\n"
+
+    str += "// conjugated gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(1,m,n)+" (+"+g_re(0,n,m)+")\n"
+            str += "#define "+g_im(1,m,n)+" (-"+g_im(0,n,m)+")\n"
+    str += "\n"
+
+    return str
+# end def def_gauge_cpu
+
+
+def def_clover_cpu():
+    # the packed host layout matches that of a CUDA chiral block: the
+    # diagonal, then the lower triangle column by column
+    str = "// chiral block of the clover term (the same registers hold both blocks)\n"
+    i = 0
+    for m in range(0,6):
+        s = m/3
+        c = m%3
+        str += "#define "+c_re(0,s,c,s,c)+" C["+`i`+"]\n"
+        i += 1
+    for n in range(0,6):
+        sn = n/3
+        cn = n%3
+        for m in range(n+1,6):
+            sm = m/3
+            cm = m%3
+            str += "#define "+c_re(0,sm,cm,sn,cn)+" C["+`i`+"]\n"
+            str += "#define "+c_im(0,sm,cm,sn,cn)+" C["+`i+1`+"]\n"
+            i += 2
+
+    for n in range(0,6):
+        sn = n/3
+        cn = n%3
+        for m in range(0,n):
+            sm = m/3
+            cm = m%3
+            str += "#define "+c_re(0,sm,cm,sn,cn)+" (+"+c_re(0,sn,cn,sm,cm)+")\n"
+            str += "#define "+c_im(0,sm,cm,sn,cn)+" (-"+c_im(0,sn,cn,sm,cm)+")\n"
+
+    for n in range(0,6):
+        sn = n/3
+        cn = n%3
+        for m in range(0,6):
+            sm = m/3
+            cm = m%3
+            str += "#define "+c_re(1,sm,cm,sn,cn)+" "+c_re(0,sm,cm,sn,cn)+"\n"
+            if m != n: str += "#define "+c_im(1,sm,cm,sn,cn)+" "+c_im(0,sm,cm,sn,cn)+"\n"
+    str += "\n"
+
+    return str
+# end def def_clover_cpu
+
+
+def def_output_spinor_cpu():
+    str = "// output spinor\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+out_re(s,c)+" O["+`2*i+0`+"]\n"
+            str += "#define "+out_im(s,c)+" O["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_output_spinor_cpu
+
+
+def undef_cpu(defs):
+    str = ""
+    for l in defs.splitlines():
+        if l.startswith("#define "): str += "#undef "+l.split()[1]+"\n"
+    return str
+# end def undef_cpu
+
+
+def prolog_cpu():
+    str = ("// *** CPU DSLASH ***\n\n" if not dagger else "// *** CPU DSLASH DAGGER ***\n\n")
+    str += (
+"""// Body of the host kernels in dslash_cpu.cpp, in the DeGrand-Rossi basis.
+// spinorFloat is a RealVec holding one site per lane, and the READ_*
+// and WRITE_SPINOR macros, which gather and scatter the lanes, are
+// defined there.
+
+""")
+    str += cpu_defs()
+    str += "spinorFloat I[24], G[18], O[24];\n\n"
+
+    out = ""
+    for s in range(0,4):
+        for c in range(0,3):
+            out += out_re(s,c)+" = 0;  "+out_im(s,c)+" = 0;\n"
+    str += out + "\n"
+    return str
+# end def prolog_cpu
+
+
+def cpu_defs():
+    return def_input_spinor_cpu() + def_gauge_cpu() + def_clover_cpu() + def_output_spinor_cpu()
+
+
+def epilog_cpu():
+    str = ""
+    str += "// clover term: its inverse is applied to the hopping term, or for the\n"
+    str += "// asymmetric operator the clover term itself is applied to x\n"
+    str += "if (arg.clover && !arg.asymmetric) "
+    str += block("spinorFloat C[36];\n\n" + clover_mult("o","o",0) + clover_mult("o","o",1))
+    str += "\n\n"
+
+    xpay = "spinorFloat ACC[24];\n"
+    xpay += "READ_ACCUM(ACC);\n\n"
+    xpay += "if (arg.asymmetric) "
+    xpay += block("spinorFloat C[36];\n\n" + clover_mult("acc","acc",0) + clover_mult("acc","acc",1))
+    xpay += "\n\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            xpay += out_re(s,c)+" = "+acc_re(s,c)+" + arg.k*"+out_re(s,c)+";\n"
+            xpay += out_im(s,c)+" = "+acc_im(s,c)+" + arg.k*"+out_im(s,c)+";\n"
+    str += "// out = x + k * D in\n"
+    str += "if (arg.x) "+block(xpay)+"\n\n"
+
+    str += "// write spinor field back to host memory\n"
+    str += "WRITE_SPINOR(O);\n\n"
+
+    str += "// undefine to prevent warnings when the core is included again\n"
+    str += undef_cpu(cpu_defs())
+    return str
+# end def epilog_cpu
+
+
+def generate_dslash_cpu():
+    return prolog_cpu() + gen(0) + gen(1) + gen(2) + gen(3) + gen(4) + gen(5) + gen(6) + gen(7) + epilog_cpu()
+
+
 def generate_dslash():
     return prolog() + gen(0) + gen(1) + gen(2) + gen(3) + gen(4) + gen(5) + gen(6) + gen(7) + epilog()
 
@@ -1225,6 +1432,7 @@ asymClover = False
 sharedFloats = 0
 sharedDslash = False
 pack = False
+cpu = False
 
 # generate dslash kernels
 arch = 200
@@ -1266,3 +1474,31 @@ print sys.argv[0] + ": generating clover_core.h";
 f = open('dslash_core/clover_core.h', 'w')
 f.write(generate_clover())
 f.close()
+
+# generate the host (CPU) Wilson and clover kernels, which act on
+# DeGrand-Rossi basis fields
+cpu = True
+dslash = True
+clover = True
+sharedFloats = 0
+sharedDslash = False
+projectors_gpu = projectors
+projectors = projectors_dr
+
+dagger = False
+print sys.argv[0] + ": generating wilson_dslash_cpu_core.h";
+f = open('dslash_core/wilson_dslash_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
+
+dagger = True
+print sys.argv[0] + ": generating wilson_dslash_dagger_cpu_core.h";
+f = open('dslash_core/wilson_dslash_dagger_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
+
+projectors = projectors_gpu
+cpu = False
+dslash = False
+clover = False
+dagger = False
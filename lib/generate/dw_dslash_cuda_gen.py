@@ -74,6 +74,45 @@ igamma5 = complexify([
 two_P_L = [ id[x] - igamma5[x]/1j for x in range(0,4*4) ]
 two_P_R = [ id[x] + igamma5[x]/1j for x in range(0,4*4) ]
 
+# DeGrand-Rossi basis, used by the host (CPU) kernels
+gamma1_dr = complexify([
+    0, 0, 0, 1j,
+    0, 0, 1j, 0,
+    0, -1j, 0, 0,
+    -1j, 0, 0, 0
+])
+
+gamma2_dr = complexify([
+    0, 0, 0, -1,
+    0, 0, 1, 0,
+    0, 1, 0, 0,
+    -1, 0, 0, 0
+])
+
+gamma3_dr = complexify([
+    0, 0, 1j, 0,
+    0, 0, 0, -1j,
+    -1j, 0, 0, 0,
+    0, 1j, 0, 0
+])
+
+gamma4_dr = complexify([
+    0, 0, 1, 0,
+    0, 0, 0, 1,
+    1, 0, 0, 0,
+    0, 1, 0, 0
+])
+
+igamma5_dr = complexify([
+    1j, 0, 0, 0,
+    0, 1j, 0, 0,
+    0, 0, -1j, 0,
+    0, 0, 0, -1j
+])
+
+two_P_L_dr = [ id[x] - igamma5_dr[x]/1j for x in range(0,4*4) ]
+two_P_R_dr = [ id[x] + igamma5_dr[x]/1j for x in range(0,4*4) ]
+
 # for s1 in range(0,4) :
 # for s2 in range (0,4): print "%8s" % two_P_L[s1*4+s2],
 # print " ",
@@ -102,6 +141,13 @@ projectors = [
     gminus(id,gamma4), gplus(id,gamma4),
 ]
 
+projectors_dr = [
+    gminus(id,gamma1_dr), gplus(id,gamma1_dr),
+    gminus(id,gamma2_dr), gplus(id,gamma2_dr),
+    gminus(id,gamma3_dr), gplus(id,gamma3_dr),
+    gminus(id,gamma4_dr), gplus(id,gamma4_dr),
+]
+
 ### code generation ########################################################################
 
 def indent(code, n=1):
@@ -142,6 +188,9 @@ def a_im(b, s, c): return "a"+`(s+2*b)`+`c`+"_im"
 def tmp_re(s, c): return "tmp"+`s`+`c`+"_re"
 def tmp_im(s, c): return "tmp"+`s`+`c`+"_im"
 
+def acc_re(s, c): return "acc"+`s`+`c`+"_re"
+def acc_im(s, c): return "acc"+`s`+`c`+"_im"
+
 
 def def_input_spinor():
     str = ""
@@ -545,6 +594,7 @@ def gen(dir, pack_only=False):
     for l in projStr.splitlines():
         str += "//"+l+"\n"
     str += "\n"
+    header = str
 
     str += "#ifdef MULTI_GPU\n"
     str += "const int sp_idx = (kernel_type == INTERIOR_KERNEL) ? ("+boundary[dir]+" ? "+sp_idx_wrap[dir]+" : "+sp_idx[dir]+") >> 1 :\n"
@@ -720,6 +770,14 @@ def gen(dir, pack_only=False):
         
         if ( m < 2 ): reconstruct += "\n"
 
+    if cpu:
+        # the host driver has already located the neighbors, so there is
+        # no boundary logic, and lanes across a Dirichlet boundary read zeros
+        load_cpu = "// read spinor and gauge matrix\n"
+        load_cpu += "READ_SPINOR(I, "+`dir`+");\n"
+        load_cpu += "READ_GAUGE_MATRIX(G, "+`dir`+");\n\n"
+        return header + block(load_cpu + decl_half + project + "\n" + mult + reconstruct) + "\n\n"
+
     if dir >= 6:
         str += "if (gauge_fixed && ga_idx < X4X3X2X1hmX3X2X1h)\n"
         str += block(decl_half + prep_half + ident + reconstruct)
@@ -1132,6 +1190,155 @@ def generate_pack():
 # end def generate_pack
 
 
+### host (CPU) kernels ########################################################################
+
+def def_input_spinor_cpu():
+    str = "// input (neighbor) spinor and accumulator\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+in_re(s,c)+" I["+`2*i+0`+"]\n"
+            str += "#define "+in_im(s,c)+" I["+`2*i+1`+"]\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+acc_re(s,c)+" ACC["+`2*i+0`+"]\n"
+            str += "#define "+acc_im(s,c)+" ACC["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_input_spinor_cpu
+
+
+def def_gauge_cpu():
+    str = "// gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(0,m,n)+" G["+`2*i+0`+"]\n"
+            str += "#define "+g_im(0,m,n)+" G["+`2*i+1`+"]\n"
+    str += "\n"
+
+    str += "// conjugated gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(1,m,n)+" (+"+g_re(0,n,m)+")\n"
+            str += "#define "+g_im(1,m,n)+" (-"+g_im(0,n,m)+")\n"
+    str += "\n"
+
+    return str
+# end def def_gauge_cpu
+
+
+def def_output_spinor_cpu():
+    str = "// output spinor\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            i = 3*s+c
+            str += "#define "+out_re(s,c)+" O["+`2*i+0`+"]\n"
+            str += "#define "+out_im(s,c)+" O["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_output_spinor_cpu
+
+
+def cpu_defs():
+    return def_input_spinor_cpu() + def_gauge_cpu() + def_output_spinor_cpu()
+
+
+def undef_cpu(defs):
+    str = ""
+    for l in defs.splitlines():
+        if l.startswith("#define "): str += "#undef "+l.split()[1]+"\n"
+    return str
+# end def undef_cpu
+
+
+def gen_dw_cpu():
+    # the slice xs is the same for every lane, so the walls are a branch
+    if dagger: lsign='-'; ledge = '0'; rsign='+'; redge='arg.Ls-1'
+    else: lsign='+'; ledge = 'arg.Ls-1'; rsign='-'; redge='0'
+
+    def hop(P):
+        out = ""
+        for s1 in range(0,4):
+            for c in range(0,3):
+                re_rhs, im_rhs = "", ""
+                for s2 in range(0,4):
+                    re, im = P[4*s1+s2].real, P[4*s1+s2].imag
+                    if re != 0 :
+                        re_rhs += sign(re) + in_re(s2,c)
+                        im_rhs += sign(re) + in_im(s2,c)
+                    if im != 0 :
+                        re_rhs += sign(-im) + in_im(s2,c)
+                        im_rhs += sign(im) + in_re(s2,c)
+                if re_rhs == "": continue
+                out += out_re(s1,c) + " += " + re_rhs + ";  "
+                out += out_im(s1,c) + " += " + im_rhs + ";\n"
+        return out
+
+    def hop_wall(P):
+        return hop(P).replace(" += "," += -arg.mferm*(").replace(";  ",");  ").replace(";\n",");\n")
+
+    str = "// 5th dimension\n"
+    for (name, P, s, edge) in [("2 P_L", two_P_L_dr, lsign, ledge), ("2 P_R", two_P_R_dr, rsign, redge)]:
+        body = "const int sp_s = (xs == %s ? xs%s(arg.Ls-1) : xs%s1);\n" % (edge, "-" if s == "+" else "+", s)
+        body += "READ_SPINOR_5D(I, sp_s);\n\n"
+        body += "if (xs != %s) " % edge + block(hop(P)) + " else " + block(hop_wall(P)) + "\n"
+        str += "// "+name+"\n" + block(body) + "\n\n"
+    return str
+# end def gen_dw_cpu
+
+
+def prolog_cpu():
+    str = ("// *** CPU DOMAIN WALL DSLASH ***\n\n" if not dagger else "// *** CPU DOMAIN WALL DSLASH DAGGER ***\n\n")
+    str += (
+"""// Body of the host kernels in dslash_cpu.cpp, in the DeGrand-Rossi basis.
+// spinorFloat is a RealVec holding one 4-d site of slice xs per lane,
+// and the READ_* and WRITE_SPINOR macros, which gather and scatter the
+// lanes, are defined there.
+
+""")
+    str += cpu_defs()
+    str += "spinorFloat I[24], G[18], O[24];\n\n"
+
+    out = ""
+    for s in range(0,4):
+        for c in range(0,3):
+            out += out_re(s,c)+" = 0;  "+out_im(s,c)+" = 0;\n"
+    str += out + "\n"
+    return str
+# end def prolog_cpu
+
+
+def epilog_cpu():
+    xpay = "spinorFloat ACC[24];\n"
+    xpay += "READ_ACCUM(ACC);\n\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            xpay += out_re(s,c)+" = "+acc_re(s,c)+" + arg.k*"+out_re(s,c)+";\n"
+            xpay += out_im(s,c)+" = "+acc_im(s,c)+" + arg.k*"+out_im(s,c)+";\n"
+    str = "// out = x + k * D in\n"
+    str += "if (arg.x) "+block(xpay)+"\n\n"
+
+    str += "// write spinor field back to host memory\n"
+    str += "WRITE_SPINOR(O);\n\n"
+
+    str += "// undefine to prevent warnings when the core is included again\n"
+    str += undef_cpu(cpu_defs())
+    return str
+# end def epilog_cpu
+
+
+def generate_dslash_cpu():
+    r = prolog_cpu()
+    for i in range(0,8) :
+      r += gen( i )
+    r += gen_dw_cpu()
+    r += epilog_cpu()
+    return r
+
+
 def generate_dslash():
     r = prolog()
     for i in range(0,8) :
@@ -1149,6 +1356,7 @@ def generate_clover():
 
 sharedFloats = 0
 cloverSharedFloats = 0
+cpu = False
 if(len(sys.argv) > 1):
     if (sys.argv[1] == '--shared'):
         sharedFloats = int(sys.argv[2])
@@ -1173,8 +1381,24 @@ f = open('dslash_core/dw_dslash_dagger_core.h', 'w')
 f.write(generate_dslash())
 f.close()
 
+# generate the host (CPU) kernels, which act on DeGrand-Rossi basis fields
+cpu = True
+projectors_gpu = projectors
+projectors = projectors_dr
 
+print sys.argv[0] + ": generating dw_dslash_cpu_core.h";
+dslash = True
+dagger = False
+f = open('dslash_core/dw_dslash_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
 
+print sys.argv[0] + ": generating dw_dslash_dagger_cpu_core.h";
+dslash = True
+dagger = True
+f = open('dslash_core/dw_dslash_dagger_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
 
-
-
+projectors = projectors_gpu
+cpu = False
@@ -72,6 +72,42 @@ igamma5 = complexify([
 ])
 
 
+# DeGrand-Rossi basis, used by the host (CPU) kernels
+gamma1_dr = complexify([
+    0, 0, 0, 1j,
+    0, 0, 1j, 0,
+    0, -1j, 0, 0,
+    -1j, 0, 0, 0
+])
+
+gamma2_dr = complexify([
+    0, 0, 0, -1,
+    0, 0, 1, 0,
+    0, 1, 0, 0,
+    -1, 0, 0, 0
+])
+
+gamma3_dr = complexify([
+    0, 0, 1j, 0,
+    0, 0, 0, -1j,
+    -1j, 0, 0, 0,
+    0, 1j, 0, 0
+])
+
+gamma4_dr = complexify([
+    0, 0, 1, 0,
+    0, 0, 0, 1,
+    1, 0, 0, 0,
+    0, 1, 0, 0
+])
+
+igamma5_dr = complexify([
+    1j, 0, 0, 0,
+    0, 1j, 0, 0,
+    0, 0, -1j, 0,
+    0, 0, 0, -1j
+])
+
 def gplus(g1, g2):
     return [x+y for (x,y) in zip(g1,g2)]
 
@@ -93,6 +129,13 @@ projectors = [
     gminus(id,gamma4), gplus(id,gamma4),
 ]
 
+projectors_dr = [
+    gminus(id,gamma1_dr), gplus(id,gamma1_dr),
+    gminus(id,gamma2_dr), gplus(id,gamma2_dr),
+    gminus(id,gamma3_dr), gplus(id,gamma3_dr),
+    gminus(id,gamma4_dr), gplus(id,gamma4_dr),
+]
+
 ### code generation  ########################################################################
 
 def indent(code):
@@ -140,6 +183,11 @@ def acc1_im(s, c): return "acc1_"+`s`+`c`+"_im"
 def acc2_re(s, c): return "acc2_"+`s`+`c`+"_re"
 def acc2_im(s, c): return "acc2_"+`s`+`c`+"_im"
 
+def in2_re(s, c): return "i2_"+`s`+`c`+"_re"
+def in2_im(s, c): return "i2_"+`s`+`c`+"_im"
+def tmp2_re(s, c): return "tmp2_"+`s`+`c`+"_re"
+def tmp2_im(s, c): return "tmp2_"+`s`+`c`+"_im"
+
 
 def def_input_spinor():
     str = ""
@@ -473,6 +521,7 @@ def gen(dir, pack_only=False):
     for l in projStr.splitlines():
         str += "// "+l+"\n"
     str += "\n"
+    header = str
 
     str += "#ifdef MULTI_GPU\n"
     str += "const int sp_idx = (kernel_type == INTERIOR_KERNEL) ? ("+boundary[dir]+" ? "+sp_idx_wrap[dir]+" : "+sp_idx[dir]+") >> 1 :\n"
@@ -748,6 +797,26 @@ READ_SPINOR_SHARED(tx, threadIdx.y, tz);\n
         reconstruct_flv2 += "\n"
 
 
+    if cpu:
+        # the host driver has already located the neighbors, so there is
+        # no boundary logic, and lanes across a Dirichlet boundary read zeros;
+        # both flavors are read first since the twist mixes them
+        project_flv2 = project
+        for sp in range(0,4):
+            for c in range(0,3):
+                project_flv2 = project_flv2.replace(in_re(sp,c), in2_re(sp,c)).replace(in_im(sp,c), in2_im(sp,c))
+
+        load_cpu = "// read both flavors and the gauge matrix\n"
+        load_cpu += "READ_SPINOR_FLAVOR(I, "+`dir`+", 0);\n"
+        load_cpu += "READ_SPINOR_FLAVOR(I2, "+`dir`+", 1);\n"
+        load_cpu += "READ_GAUGE_MATRIX(G, "+`dir`+");\n\n"
+        load_cpu += "if (arg.type == QUDA_DEG_TWIST_INV_DSLASH) "
+        load_cpu += block(twist_cpu(in_re, in_im, in2_re, in2_im))+"\n\n"
+        str = header + load_cpu + decl_half
+        str += block(project + "\n" + mult + reconstruct_flv1) + "\n"
+        str += block(project_flv2 + "\n" + mult + reconstruct_flv2) + "\n"
+        return block(str) + "\n\n"
+
     if dir >= 6:
         str += decl_half
         str += "if (gauge_fixed && ga_idx < X4X3X2X1hmX3X2X1h)\n"
@@ -1083,6 +1152,145 @@ case EXTERIOR_KERNEL_Y:
 
 
 #####temporal
+### host (CPU) kernels ########################################################################
+
+def def_input_spinor_cpu():
+    str = "// input (neighbor) spinors and accumulators for both flavors\n"
+    for (vr, vi, name) in [(in_re, in_im, "I"), (in2_re, in2_im, "I2"), (acc1_re, acc1_im, "ACC1"), (acc2_re, acc2_im, "ACC2")]:
+        for s in range(0,4):
+            for c in range(0,3):
+                i = 3*s+c
+                str += "#define "+vr(s,c)+" "+name+"["+`2*i+0`+"]\n"
+                str += "#define "+vi(s,c)+" "+name+"["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_input_spinor_cpu
+
+
+def def_gauge_cpu():
+    str = "// gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(0,m,n)+" G["+`2*i+0`+"]\n"
+            str += "#define "+g_im(0,m,n)+" G["+`2*i+1`+"]\n"
+    str += "\n"
+
+    str += "// conjugated gauge link\n"
+    for m in range(0,3):
+        for n in range(0,3):
+            i = 3*m+n
+            str += "#define "+g_re(1,m,n)+" (+"+g_re(0,n,m)+")\n"
+            str += "#define "+g_im(1,m,n)+" (-"+g_im(0,n,m)+")\n"
+    str += "\n"
+
+    return str
+# end def def_gauge_cpu
+
+
+def def_output_spinor_cpu():
+    str = "// output spinors for both flavors\n"
+    for (vr, vi, name) in [(out1_re, out1_im, "O1"), (out2_re, out2_im, "O2")]:
+        for s in range(0,4):
+            for c in range(0,3):
+                i = 3*s+c
+                str += "#define "+vr(s,c)+" "+name+"["+`2*i+0`+"]\n"
+                str += "#define "+vi(s,c)+" "+name+"["+`2*i+1`+"]\n"
+    str += "\n"
+    return str
+# end def def_output_spinor_cpu
+
+
+def cpu_defs():
+    return def_input_spinor_cpu() + def_gauge_cpu() + def_output_spinor_cpu()
+
+
+def undef_cpu(defs):
+    str = ""
+    for l in defs.splitlines():
+        if l.startswith("#define "): str += "#undef "+l.split()[1]+"\n"
+    return str
+# end def undef_cpu
+
+
+def twist_cpu(v1_re, v1_im, v2_re, v2_im):
+    # in place v = c (1 + i a gamma_5 tau_3 + b tau_1) v, with gamma_5
+    # diagonal in the DeGrand-Rossi basis; the driver has negated a for
+    # the dagger
+    str = ""
+    for s in range(0,4):
+        for c in range(0,3):
+            str += "spinorFloat "+tmp_re(s,c)+" = "+v1_re(s,c)+";  "
+            str += "spinorFloat "+tmp_im(s,c)+" = "+v1_im(s,c)+";\n"
+            str += "spinorFloat "+tmp2_re(s,c)+" = "+v2_re(s,c)+";  "
+            str += "spinorFloat "+tmp2_im(s,c)+" = "+v2_im(s,c)+";\n"
+    str += "\n"
+    for (flv, vr, vi, tr, ti, wr, wi) in [(+1, v1_re, v1_im, tmp_re, tmp_im, tmp2_re, tmp2_im),
+                                          (-1, v2_re, v2_im, tmp2_re, tmp2_im, tmp_re, tmp_im)]:
+        for s in range(0,4):
+            g = flv*igamma5_dr[4*s+s].imag
+            for c in range(0,3):
+                str += vr(s,c)+" = arg.c*(("+tr(s,c)+" "+sign(-g)+" arg.a*"+ti(s,c)+") + arg.b*"+wr(s,c)+");\n"
+                str += vi(s,c)+" = arg.c*(("+ti(s,c)+" "+sign(g)+" arg.a*"+tr(s,c)+") + arg.b*"+wi(s,c)+");\n"
+    return str
+# end def twist_cpu
+
+
+def prolog_cpu():
+    str = ("// *** CPU NDEG TWISTED MASS DSLASH ***\n\n" if not dagger else "// *** CPU NDEG TWISTED MASS DSLASH DAGGER ***\n\n")
+    str += (
+"""// Body of the host kernels in dslash_cpu.cpp, in the DeGrand-Rossi basis.
+// spinorFloat is a RealVec holding one site per lane, and the READ_*
+// and WRITE_SPINOR_FLAVOR macros, which gather and scatter the lanes,
+// are defined there.  arg.type selects where the twist is applied.
+
+""")
+    str += cpu_defs()
+    str += "spinorFloat I[24], I2[24], G[18], O1[24], O2[24];\n\n"
+
+    out = ""
+    for s in range(0,4):
+        for c in range(0,3):
+            out += out1_re(s,c)+" = 0;  "+out1_im(s,c)+" = 0;\n"
+    out += "\n"
+    for s in range(0,4):
+        for c in range(0,3):
+            out += out2_re(s,c)+" = 0;  "+out2_im(s,c)+" = 0;\n"
+    str += out + "\n"
+    return str
+# end def prolog_cpu
+
+
+def epilog_cpu():
+    str = ""
+    str += "if (arg.type == QUDA_DEG_DSLASH_TWIST_INV) "+block(twist_cpu(out1_re, out1_im, out2_re, out2_im))+"\n\n"
+
+    xpay = "spinorFloat ACC1[24], ACC2[24];\n"
+    xpay += "READ_ACCUM_FLAVOR(ACC1, 0);\n"
+    xpay += "READ_ACCUM_FLAVOR(ACC2, 1);\n\n"
+    xpay += "if (arg.type == QUDA_DEG_DSLASH_TWIST_XPAY) "+block(twist_cpu(acc1_re, acc1_im, acc2_re, acc2_im))+"\n\n"
+    for (o_re, o_im, a_re, a_im) in [(out1_re, out1_im, acc1_re, acc1_im), (out2_re, out2_im, acc2_re, acc2_im)]:
+        for s in range(0,4):
+            for c in range(0,3):
+                xpay += o_re(s,c)+" = "+a_re(s,c)+" + arg.k*"+o_re(s,c)+";\n"
+                xpay += o_im(s,c)+" = "+a_im(s,c)+" + arg.k*"+o_im(s,c)+";\n"
+    str += "// out = x + k * D in, or T x + k * D in\n"
+    str += "if (arg.x) "+block(xpay)+"\n\n"
+
+    str += "// write both flavors back to host memory\n"
+    str += "WRITE_SPINOR_FLAVOR(O1, 0);\n"
+    str += "WRITE_SPINOR_FLAVOR(O2, 1);\n\n"
+
+    str += "// undefine to prevent warnings when the core is included again\n"
+    str += undef_cpu(cpu_defs())
+    return str
+# end def epilog_cpu
+
+
+def generate_dslash_cpu():
+    return prolog_cpu() + gen(0) + gen(1) + gen(2) + gen(3) + gen(4) + gen(5) + gen(6) + gen(7) + epilog_cpu()
+
+
 def generate_dslash():
     return prolog() + gen(0) + gen(1) + gen(2) + gen(3) + gen(4) + gen(5) + gen(6) + gen(7) + epilog()
 #    return prolog() + epilog()
@@ -1143,6 +1351,7 @@ dagger = False
 twist = False
 sharedFloatsPerFlavor = 0
 sharedDslash = False
+cpu = False
 
 # generate dslash kernels
 #arch = 200
@@ -1153,3 +1362,27 @@ generate_dslash_kernels(arch)
 
 #arch = 100
 #generate_dslash_kernels(arch)
+
+# generate the host (CPU) doublet kernels, which act on DeGrand-Rossi
+# basis fields
+cpu = True
+dslash = True
+projectors_gpu = projectors
+projectors = projectors_dr
+
+dagger = False
+print sys.argv[0] + ": generating tm_ndeg_dslash_cpu_core.h";
+f = open('dslash_core/tm_ndeg_dslash_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
+
+dagger = True
+print sys.argv[0] + ": generating tm_ndeg_dslash_dagger_cpu_core.h";
+f = open('dslash_core/tm_ndeg_dslash_dagger_cpu_core.h', 'w')
+f.write(generate_dslash_cpu())
+f.close()
+
+projectors = projectors_gpu
+cpu = False
+dslash = False
+dagger = False
@@ -0,0 +1,834 @@
+#ifndef _HOST_SIMD_H
+#define _HOST_SIMD_H
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+   Short-vector complex arithmetic for the host Dirac operators.
+
+   ComplexVec<Float,N> holds N complex numbers ("lanes") stored as
+   interleaved (re,im) pairs.  What a lane represents is up to the
+   caller: the two spin components of a half spinor (Wilson), the
+   one- and three-hop terms (improved staggered), the fifth
+   dimension (domain wall) or the right-hand-side index (multi-RHS).
+   The generic template is plain C++ which the compiler is free to
+   auto-vectorize; the specializations below map the
+   common (Float,N) combinations directly onto AVX2 and AVX-512
+   registers.  All operations are elementwise IEEE operations, each
+   rounded separately, so the vector and scalar code paths give
+   identical results as long as the compiler does not contract a
+   multiply and an add into an FMA: with -mfma that takes
+   -ffp-contract=off, which make.inc adds to host dslash builds.
+   Otherwise they agree only to rounding.
+ */
+
+namespace quda {
+
+  template <typename Float, int N>
+  struct ComplexVec {
+    Float v[2*N];
+
+    static inline ComplexVec zero() {
+      ComplexVec a;
+      for (int i=0; i<2*N; i++) a.v[i] = 0.0;
+      return a;
+    }
+
+    /** Sets every lane to the real number s[k] (both re and im) */
+    static inline ComplexVec lanes(const Float *s) {
+      ComplexVec a;
+      for (int k=0; k<N; k++) a.v[2*k] = a.v[2*k+1] = s[k];
+      return a;
+    }
+
+    inline void load(const Float *p) { for (int i=0; i<2*N; i++) v[i] = p[i]; }
+    inline void store(Float *p) const { for (int i=0; i<2*N; i++) p[i] = v[i]; }
+
+    /** Lane k is read from p + k*stride (stride may be negative) */
+    inline void load(const Float *p, int stride) {
+      for (int k=0; k<N; k++) { v[2*k] = p[k*stride]; v[2*k+1] = p[k*stride+1]; }
+    }
+    inline void store(Float *p, int stride) const {
+      for (int k=0; k<N; k++) { p[k*stride] = v[2*k]; p[k*stride+1] = v[2*k+1]; }
+    }
+
+    /** Lane k is read from p[k] */
+    inline void gather(const Float *const *p) {
+      for (int k=0; k<N; k++) { v[2*k] = p[k][0]; v[2*k+1] = p[k][1]; }
+    }
+
+    inline ComplexVec& operator+=(const ComplexVec &b) { for (int i=0; i<2*N; i++) v[i] += b.v[i]; return *this; }
+    inline ComplexVec& operator-=(const ComplexVec &b) { for (int i=0; i<2*N; i++) v[i] -= b.v[i]; return *this; }
+  };
+
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> operator+(const ComplexVec<Float,N> &a, const ComplexVec<Float,N> &b) {
+    ComplexVec<Float,N> c;
+    for (int i=0; i<2*N; i++) c.v[i] = a.v[i] + b.v[i];
+    return c;
+  }
+
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> operator-(const ComplexVec<Float,N> &a, const ComplexVec<Float,N> &b) {
+    ComplexVec<Float,N> c;
+    for (int i=0; i<2*N; i++) c.v[i] = a.v[i] - b.v[i];
+    return c;
+  }
+
+  /** Elementwise product, used with lanes() for per-lane signs and scalings */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> operator*(const ComplexVec<Float,N> &a, const ComplexVec<Float,N> &b) {
+    ComplexVec<Float,N> c;
+    for (int i=0; i<2*N; i++) c.v[i] = a.v[i] * b.v[i];
+    return c;
+  }
+
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> operator*(const Float &a, const ComplexVec<Float,N> &b) {
+    ComplexVec<Float,N> c;
+    for (int i=0; i<2*N; i++) c.v[i] = a * b.v[i];
+    return c;
+  }
+
+  /** Returns (ure + i uim) * h in every lane */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> cmul(const Float &ure, const Float &uim, const ComplexVec<Float,N> &h) {
+    ComplexVec<Float,N> c;
+    for (int k=0; k<N; k++) {
+      c.v[2*k+0] = ure*h.v[2*k+0] - uim*h.v[2*k+1];
+      c.v[2*k+1] = ure*h.v[2*k+1] + uim*h.v[2*k+0];
+    }
+    return c;
+  }
+
+  /** Returns (ure - i uim) * h in every lane */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> conj_cmul(const Float &ure, const Float &uim, const ComplexVec<Float,N> &h) {
+    ComplexVec<Float,N> c;
+    for (int k=0; k<N; k++) {
+      c.v[2*k+0] = ure*h.v[2*k+0] + uim*h.v[2*k+1];
+      c.v[2*k+1] = ure*h.v[2*k+1] - uim*h.v[2*k+0];
+    }
+    return c;
+  }
+
+  /** Returns u * h lane by lane */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> cmul(const ComplexVec<Float,N> &u, const ComplexVec<Float,N> &h) {
+    ComplexVec<Float,N> c;
+    for (int k=0; k<N; k++) {
+      c.v[2*k+0] = u.v[2*k]*h.v[2*k+0] - u.v[2*k+1]*h.v[2*k+1];
+      c.v[2*k+1] = u.v[2*k]*h.v[2*k+1] + u.v[2*k+1]*h.v[2*k+0];
+    }
+    return c;
+  }
+
+  /** Returns conj(u) * h lane by lane */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> conj_cmul(const ComplexVec<Float,N> &u, const ComplexVec<Float,N> &h) {
+    ComplexVec<Float,N> c;
+    for (int k=0; k<N; k++) {
+      c.v[2*k+0] = u.v[2*k]*h.v[2*k+0] + u.v[2*k+1]*h.v[2*k+1];
+      c.v[2*k+1] = u.v[2*k]*h.v[2*k+1] - u.v[2*k+1]*h.v[2*k+0];
+    }
+    return c;
+  }
+
+  /** Returns i * h */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> times_i(const ComplexVec<Float,N> &h) {
+    ComplexVec<Float,N> c;
+    for (int k=0; k<N; k++) {
+      c.v[2*k+0] = -h.v[2*k+1];
+      c.v[2*k+1] = h.v[2*k+0];
+    }
+    return c;
+  }
+
+  /** Reverses the lane order */
+  template <typename Float, int N>
+  inline ComplexVec<Float,N> reverse(const ComplexVec<Float,N> &a) {
+    ComplexVec<Float,N> c;
+    for (int k=0; k<N; k++) { c.v[2*k] = a.v[2*(N-1-k)]; c.v[2*k+1] = a.v[2*(N-1-k)+1]; }
+    return c;
+  }
+
+  /**
+     RealVec<Float,N> holds N real numbers, one per lane, and is the
+     spinorFloat of the generated host kernels in dslash_core/.  There
+     the lanes are N sites, so the unrolled per-site code the
+     generator writes for a CUDA thread runs on N sites at once.
+     Operators are friends so that scalars (e.g., the 2 of a
+     projector) broadcast implicitly.
+   */
+  template <typename Float, int N>
+  struct RealVec {
+    Float v[N];
+
+    RealVec() { }
+    RealVec(const Float &s) { for (int k=0; k<N; k++) v[k] = s; }
+
+    inline void load(const Float *p) { for (int k=0; k<N; k++) v[k] = p[k]; }
+    inline void store(Float *p) const { for (int k=0; k<N; k++) p[k] = v[k]; }
+
+    inline RealVec& operator+=(const RealVec &b) { for (int k=0; k<N; k++) v[k] += b.v[k]; return *this; }
+    inline RealVec& operator-=(const RealVec &b) { for (int k=0; k<N; k++) v[k] -= b.v[k]; return *this; }
+
+    friend inline RealVec operator+(const RealVec &a, const RealVec &b) {
+      RealVec c; for (int k=0; k<N; k++) c.v[k] = a.v[k] + b.v[k]; return c;
+    }
+    friend inline RealVec operator-(const RealVec &a, const RealVec &b) {
+      RealVec c; for (int k=0; k<N; k++) c.v[k] = a.v[k] - b.v[k]; return c;
+    }
+    friend inline RealVec operator*(const RealVec &a, const RealVec &b) {
+      RealVec c; for (int k=0; k<N; k++) c.v[k] = a.v[k] * b.v[k]; return c;
+    }
+    friend inline RealVec operator-(const RealVec &a) {
+      RealVec c; for (int k=0; k<N; k++) c.v[k] = -a.v[k]; return c;
+    }
+    friend inline RealVec operator+(const RealVec &a) { return a; }
+  };
+
+  /** v[j] takes p[k][j] in lane k, for j < n */
+  template <typename Float, int N>
+  inline void gatherLanes(RealVec<Float,N> *v, const Float *const *p, int n) {
+    for (int j=0; j<n; j++) {
+      Float t[N];
+      for (int k=0; k<N; k++) t[k] = p[k][j];
+      v[j].load(t);
+    }
+  }
+
+  /** The inverse of gatherLanes, writing only the first nLanes lanes */
+  template <typename Float, int N>
+  inline void scatterLanes(Float *const *p, const RealVec<Float,N> *v, int n, int nLanes) {
+    for (int j=0; j<n; j++) {
+      Float t[N];
+      v[j].store(t);
+      for (int k=0; k<nLanes; k++) p[k][j] = t[k];
+    }
+  }
+
+  /** v[j] takes p[j] in every lane, for j < n */
+  template <typename Float, int N>
+  inline void broadcastLanes(RealVec<Float,N> *v, const Float *p, int n) {
+    for (int j=0; j<n; j++) v[j] = RealVec<Float,N>(p[j]);
+  }
+
+  /**
+     Number of complex lanes that fill one native register.  Kernels
+     that are free to choose their vector length (e.g., domain wall,
+     where the lanes run along the fifth dimension) use this.
+   */
+  template <typename Float> struct NativeLanes { };
+#ifdef __AVX512F__
+  template <> struct NativeLanes<double> { static const int value = 4; };
+  template <> struct NativeLanes<float> { static const int value = 8; };
+#else
+  template <> struct NativeLanes<double> { static const int value = 2; };
+  template <> struct NativeLanes<float> { static const int value = 4; };
+#endif
+
+  /**
+     Number of sites the generated kernels process at once, one per
+     RealVec lane: a native register of reals, or a single site for
+     the portable scalar fallback.
+   */
+  template <typename Float> struct SiteLanes { };
+#if defined(__AVX512F__)
+  template <> struct SiteLanes<double> { static const int value = 8; };
+  template <> struct SiteLanes<float> { static const int value = 16; };
+#elif defined(__AVX2__)
+  template <> struct SiteLanes<double> { static const int value = 4; };
+  template <> struct SiteLanes<float> { static const int value = 8; };
+#elif defined(__SSE2__)
+  template <> struct SiteLanes<double> { static const int value = 2; };
+  template <> struct SiteLanes<float> { static const int value = 4; };
+#else
+  template <> struct SiteLanes<double> { static const int value = 1; };
+  template <> struct SiteLanes<float> { static const int value = 1; };
+#endif
+
+  // Generates the RealVec specialization for one native register type
+#define HOST_REAL_VEC(Float, N, T, loadu, storeu, add, sub, mul, set1, neg) \
+  template <>								\
+  struct RealVec<Float,N> {						\
+    T r;								\
+    RealVec() { }							\
+    RealVec(const Float &s) : r(set1(s)) { }				\
+    inline void load(const Float *p) { r = loadu(p); }			\
+    inline void store(Float *p) const { storeu(p, r); }		\
+    inline RealVec& operator+=(const RealVec &b) { r = add(r, b.r); return *this; } \
+    inline RealVec& operator-=(const RealVec &b) { r = sub(r, b.r); return *this; } \
+    friend inline RealVec operator+(const RealVec &a, const RealVec &b) \
+    { RealVec c; c.r = add(a.r, b.r); return c; }			\
+    friend inline RealVec operator-(const RealVec &a, const RealVec &b) \
+    { RealVec c; c.r = sub(a.r, b.r); return c; }			\
+    friend inline RealVec operator*(const RealVec &a, const RealVec &b) \
+    { RealVec c; c.r = mul(a.r, b.r); return c; }			\
+    friend inline RealVec operator-(const RealVec &a)			\
+    { RealVec c; c.r = neg(a.r); return c; }				\
+    friend inline RealVec operator+(const RealVec &a) { return a; }	\
+  };
+
+#if defined(__SSE2__) && !defined(__AVX2__) && !defined(__AVX512F__)
+
+  // Without AVX the generated kernels still use the SSE2 registers
+  // every x86-64 processor has; only RealVec is provided for these.
+  inline __m128d neg128(const __m128d &a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+  inline __m128 neg128(const __m128 &a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+  HOST_REAL_VEC(double, 2, __m128d, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, _mm_sub_pd,
+		_mm_mul_pd, _mm_set1_pd, neg128)
+  HOST_REAL_VEC(float, 4, __m128, _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps, _mm_sub_ps,
+		_mm_mul_ps, _mm_set1_ps, neg128)
+
+  inline void gatherLanes(RealVec<double,2> *v, const double *const *p, int n) {
+    int j = 0;
+    for (; j+2<=n; j+=2) {
+      __m128d r0 = _mm_loadu_pd(p[0]+j), r1 = _mm_loadu_pd(p[1]+j);
+      v[j].r = _mm_unpacklo_pd(r0, r1);
+      v[j+1].r = _mm_unpackhi_pd(r0, r1);
+    }
+    for (; j<n; j++) v[j].r = _mm_set_pd(p[1][j], p[0][j]);
+  }
+
+  inline void scatterLanes(double *const *p, const RealVec<double,2> *v, int n, int nLanes) {
+    int j = 0;
+    for (; j+2<=n; j+=2) {
+      _mm_storeu_pd(p[0]+j, _mm_unpacklo_pd(v[j].r, v[j+1].r));
+      if (nLanes == 2) _mm_storeu_pd(p[1]+j, _mm_unpackhi_pd(v[j].r, v[j+1].r));
+    }
+    for (; j<n; j++) {
+      double t[2];
+      v[j].store(t);
+      for (int k=0; k<nLanes; k++) p[k][j] = t[k];
+    }
+  }
+
+  inline void gatherLanes(RealVec<float,4> *v, const float *const *p, int n) {
+    int j = 0;
+    for (; j+4<=n; j+=4) {
+      __m128 r0 = _mm_loadu_ps(p[0]+j), r1 = _mm_loadu_ps(p[1]+j);
+      __m128 r2 = _mm_loadu_ps(p[2]+j), r3 = _mm_loadu_ps(p[3]+j);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      v[j].r = r0; v[j+1].r = r1; v[j+2].r = r2; v[j+3].r = r3;
+    }
+    for (; j<n; j++) v[j].r = _mm_set_ps(p[3][j], p[2][j], p[1][j], p[0][j]);
+  }
+
+  inline void scatterLanes(float *const *p, const RealVec<float,4> *v, int n, int nLanes) {
+    int j = 0;
+    if (nLanes == 4) {
+      for (; j+4<=n; j+=4) {
+	__m128 r0 = v[j].r, r1 = v[j+1].r, r2 = v[j+2].r, r3 = v[j+3].r;
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps(p[0]+j, r0); _mm_storeu_ps(p[1]+j, r1);
+	_mm_storeu_ps(p[2]+j, r2); _mm_storeu_ps(p[3]+j, r3);
+      }
+    }
+    for (; j<n; j++) {
+      float t[4];
+      v[j].store(t);
+      for (int k=0; k<nLanes; k++) p[k][j] = t[k];
+    }
+  }
+
+#endif // __SSE2__ only
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+
+  // negation flips the sign bit, as the scalar code does
+  inline __m256d neg256(const __m256d &a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+  inline __m256 neg256(const __m256 &a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+
+  HOST_REAL_VEC(double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_sub_pd,
+		_mm256_mul_pd, _mm256_set1_pd, neg256)
+  HOST_REAL_VEC(float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, _mm256_sub_ps,
+		_mm256_mul_ps, _mm256_set1_ps, neg256)
+
+  /**
+     Four lanes of doubles: each group of four reals is loaded from
+     every lane and transposed in registers, rather than assembled
+     one element at a time.
+   */
+  inline void transpose4(__m256d &r0, __m256d &r1, __m256d &r2, __m256d &r3) {
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+    r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+  }
+
+  inline void gatherLanes(RealVec<double,4> *v, const double *const *p, int n) {
+    int j = 0;
+    for (; j+4<=n; j+=4) {
+      __m256d r0 = _mm256_loadu_pd(p[0]+j), r1 = _mm256_loadu_pd(p[1]+j);
+      __m256d r2 = _mm256_loadu_pd(p[2]+j), r3 = _mm256_loadu_pd(p[3]+j);
+      transpose4(r0, r1, r2, r3);
+      v[j].r = r0; v[j+1].r = r1; v[j+2].r = r2; v[j+3].r = r3;
+    }
+    for (; j<n; j++) v[j].r = _mm256_set_pd(p[3][j], p[2][j], p[1][j], p[0][j]);
+  }
+
+  inline void scatterLanes(double *const *p, const RealVec<double,4> *v, int n, int nLanes) {
+    int j = 0;
+    if (nLanes == 4) {
+      for (; j+4<=n; j+=4) {
+	__m256d r0 = v[j].r, r1 = v[j+1].r, r2 = v[j+2].r, r3 = v[j+3].r;
+	transpose4(r0, r1, r2, r3);
+	_mm256_storeu_pd(p[0]+j, r0); _mm256_storeu_pd(p[1]+j, r1);
+	_mm256_storeu_pd(p[2]+j, r2); _mm256_storeu_pd(p[3]+j, r3);
+      }
+    }
+    for (; j<n; j++) {
+      double t[4];
+      v[j].store(t);
+      for (int k=0; k<nLanes; k++) p[k][j] = t[k];
+    }
+  }
+
+  /** Eight lanes of floats, as for doubles with an 8x8 transpose */
+  inline void transpose8(__m256 *r) {
+    __m256 t[8], u[8];
+    for (int i=0; i<8; i+=4) {
+      t[i+0] = _mm256_unpacklo_ps(r[i+0], r[i+1]); t[i+1] = _mm256_unpackhi_ps(r[i+0], r[i+1]);
+      t[i+2] = _mm256_unpacklo_ps(r[i+2], r[i+3]); t[i+3] = _mm256_unpackhi_ps(r[i+2], r[i+3]);
+      u[i+0] = _mm256_shuffle_ps(t[i+0], t[i+2], 0x44); u[i+1] = _mm256_shuffle_ps(t[i+0], t[i+2], 0xEE);
+      u[i+2] = _mm256_shuffle_ps(t[i+1], t[i+3], 0x44); u[i+3] = _mm256_shuffle_ps(t[i+1], t[i+3], 0xEE);
+    }
+    for (int i=0; i<4; i++) {
+      r[i] = _mm256_permute2f128_ps(u[i], u[i+4], 0x20);
+      r[i+4] = _mm256_permute2f128_ps(u[i], u[i+4], 0x31);
+    }
+  }
+
+  inline void gatherLanes(RealVec<float,8> *v, const float *const *p, int n) {
+    int j = 0;
+    for (; j+8<=n; j+=8) {
+      __m256 r[8];
+      for (int k=0; k<8; k++) r[k] = _mm256_loadu_ps(p[k]+j);
+      transpose8(r);
+      for (int k=0; k<8; k++) v[j+k].r = r[k];
+    }
+    for (; j<n; j++)
+      v[j].r = _mm256_set_ps(p[7][j], p[6][j], p[5][j], p[4][j], p[3][j], p[2][j], p[1][j], p[0][j]);
+  }
+
+  inline void scatterLanes(float *const *p, const RealVec<float,8> *v, int n, int nLanes) {
+    int j = 0;
+    if (nLanes == 8) {
+      for (; j+8<=n; j+=8) {
+	__m256 r[8];
+	for (int k=0; k<8; k++) r[k] = v[j+k].r;
+	transpose8(r);
+	for (int k=0; k<8; k++) _mm256_storeu_ps(p[k]+j, r[k]);
+      }
+    }
+    for (; j<n; j++) {
+      float t[8];
+      v[j].store(t);
+      for (int k=0; k<nLanes; k++) p[k][j] = t[k];
+    }
+  }
+
+  // Generates the arithmetic operators common to every intrinsic specialization
+#define HOST_SIMD_OPS(Float, N, T, add, sub, mul, set1)			\
+  inline ComplexVec<Float,N> operator+(const ComplexVec<Float,N> &a, const ComplexVec<Float,N> &b) \
+  { ComplexVec<Float,N> c; c.r = add(a.r, b.r); return c; }		\
+  inline ComplexVec<Float,N> operator-(const ComplexVec<Float,N> &a, const ComplexVec<Float,N> &b) \
+  { ComplexVec<Float,N> c; c.r = sub(a.r, b.r); return c; }		\
+  inline ComplexVec<Float,N> operator*(const ComplexVec<Float,N> &a, const ComplexVec<Float,N> &b) \
+  { ComplexVec<Float,N> c; c.r = mul(a.r, b.r); return c; }		\
+  inline ComplexVec<Float,N> operator*(const Float &a, const ComplexVec<Float,N> &b) \
+  { ComplexVec<Float,N> c; c.r = mul(set1(a), b.r); return c; }
+
+  // double, 2 lanes (AVX)
+  template <>
+  struct ComplexVec<double,2> {
+    __m256d r;
+    static inline ComplexVec zero() { ComplexVec a; a.r = _mm256_setzero_pd(); return a; }
+    static inline ComplexVec lanes(const double *s) {
+      ComplexVec a; a.r = _mm256_set_pd(s[1], s[1], s[0], s[0]); return a;
+    }
+    inline void load(const double *p) { r = _mm256_loadu_pd(p); }
+    inline void store(double *p) const { _mm256_storeu_pd(p, r); }
+    inline void load(const double *p, int stride) {
+      r = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p)), _mm_loadu_pd(p+stride), 1);
+    }
+    inline void store(double *p, int stride) const {
+      _mm_storeu_pd(p, _mm256_castpd256_pd128(r));
+      _mm_storeu_pd(p+stride, _mm256_extractf128_pd(r, 1));
+    }
+    inline void gather(const double *const *p) {
+      r = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p[0])), _mm_loadu_pd(p[1]), 1);
+    }
+    inline ComplexVec& operator+=(const ComplexVec &b) { r = _mm256_add_pd(r, b.r); return *this; }
+    inline ComplexVec& operator-=(const ComplexVec &b) { r = _mm256_sub_pd(r, b.r); return *this; }
+  };
+
+  HOST_SIMD_OPS(double, 2, __m256d, _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_set1_pd)
+
+  template <>
+  inline ComplexVec<double,2> cmul(const double &ure, const double &uim, const ComplexVec<double,2> &h) {
+    ComplexVec<double,2> c;
+    c.r = _mm256_addsub_pd(_mm256_mul_pd(_mm256_set1_pd(ure), h.r),
+			   _mm256_mul_pd(_mm256_set1_pd(uim), _mm256_permute_pd(h.r, 0x5)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,2> conj_cmul(const double &ure, const double &uim, const ComplexVec<double,2> &h) {
+    ComplexVec<double,2> c;
+    c.r = _mm256_addsub_pd(_mm256_mul_pd(_mm256_set1_pd(ure), h.r),
+			   _mm256_mul_pd(_mm256_set1_pd(-uim), _mm256_permute_pd(h.r, 0x5)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,2> cmul(const ComplexVec<double,2> &u, const ComplexVec<double,2> &h) {
+    ComplexVec<double,2> c;
+    c.r = _mm256_addsub_pd(_mm256_mul_pd(_mm256_movedup_pd(u.r), h.r),
+			   _mm256_mul_pd(_mm256_permute_pd(u.r, 0xF), _mm256_permute_pd(h.r, 0x5)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,2> conj_cmul(const ComplexVec<double,2> &u, const ComplexVec<double,2> &h) {
+    ComplexVec<double,2> c;
+    c.r = _mm256_addsub_pd(_mm256_mul_pd(_mm256_movedup_pd(u.r), h.r),
+			   _mm256_mul_pd(_mm256_sub_pd(_mm256_setzero_pd(), _mm256_permute_pd(u.r, 0xF)),
+					 _mm256_permute_pd(h.r, 0x5)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,2> times_i(const ComplexVec<double,2> &h) {
+    ComplexVec<double,2> c;
+    c.r = _mm256_addsub_pd(_mm256_setzero_pd(), _mm256_permute_pd(h.r, 0x5));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,2> reverse(const ComplexVec<double,2> &a) {
+    ComplexVec<double,2> c; c.r = _mm256_permute2f128_pd(a.r, a.r, 1); return c;
+  }
+
+  // float, 2 lanes (SSE3)
+  template <>
+  struct ComplexVec<float,2> {
+    __m128 r;
+    static inline ComplexVec zero() { ComplexVec a; a.r = _mm_setzero_ps(); return a; }
+    static inline ComplexVec lanes(const float *s) {
+      ComplexVec a; a.r = _mm_set_ps(s[1], s[1], s[0], s[0]); return a;
+    }
+    inline void load(const float *p) { r = _mm_loadu_ps(p); }
+    inline void store(float *p) const { _mm_storeu_ps(p, r); }
+    inline void load(const float *p, int stride) {
+      r = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p), (const __m64*)(p+stride));
+    }
+    inline void store(float *p, int stride) const {
+      _mm_storel_pi((__m64*)p, r);
+      _mm_storeh_pi((__m64*)(p+stride), r);
+    }
+    inline void gather(const float *const *p) {
+      r = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p[0]), (const __m64*)p[1]);
+    }
+    inline ComplexVec& operator+=(const ComplexVec &b) { r = _mm_add_ps(r, b.r); return *this; }
+    inline ComplexVec& operator-=(const ComplexVec &b) { r = _mm_sub_ps(r, b.r); return *this; }
+  };
+
+  HOST_SIMD_OPS(float, 2, __m128, _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_set1_ps)
+
+  template <>
+  inline ComplexVec<float,2> cmul(const float &ure, const float &uim, const ComplexVec<float,2> &h) {
+    ComplexVec<float,2> c;
+    c.r = _mm_addsub_ps(_mm_mul_ps(_mm_set1_ps(ure), h.r),
+			_mm_mul_ps(_mm_set1_ps(uim), _mm_shuffle_ps(h.r, h.r, _MM_SHUFFLE(2,3,0,1))));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,2> conj_cmul(const float &ure, const float &uim, const ComplexVec<float,2> &h) {
+    ComplexVec<float,2> c;
+    c.r = _mm_addsub_ps(_mm_mul_ps(_mm_set1_ps(ure), h.r),
+			_mm_mul_ps(_mm_set1_ps(-uim), _mm_shuffle_ps(h.r, h.r, _MM_SHUFFLE(2,3,0,1))));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,2> cmul(const ComplexVec<float,2> &u, const ComplexVec<float,2> &h) {
+    ComplexVec<float,2> c;
+    c.r = _mm_addsub_ps(_mm_mul_ps(_mm_moveldup_ps(u.r), h.r),
+			_mm_mul_ps(_mm_movehdup_ps(u.r), _mm_shuffle_ps(h.r, h.r, _MM_SHUFFLE(2,3,0,1))));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,2> conj_cmul(const ComplexVec<float,2> &u, const ComplexVec<float,2> &h) {
+    ComplexVec<float,2> c;
+    c.r = _mm_addsub_ps(_mm_mul_ps(_mm_moveldup_ps(u.r), h.r),
+			_mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_movehdup_ps(u.r)),
+				   _mm_shuffle_ps(h.r, h.r, _MM_SHUFFLE(2,3,0,1))));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,2> times_i(const ComplexVec<float,2> &h) {
+    ComplexVec<float,2> c;
+    c.r = _mm_addsub_ps(_mm_setzero_ps(), _mm_shuffle_ps(h.r, h.r, _MM_SHUFFLE(2,3,0,1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,2> reverse(const ComplexVec<float,2> &a) {
+    ComplexVec<float,2> c; c.r = _mm_shuffle_ps(a.r, a.r, _MM_SHUFFLE(1,0,3,2)); return c;
+  }
+
+  // float, 4 lanes (AVX)
+  template <>
+  struct ComplexVec<float,4> {
+    __m256 r;
+    static inline ComplexVec zero() { ComplexVec a; a.r = _mm256_setzero_ps(); return a; }
+    static inline ComplexVec lanes(const float *s) {
+      ComplexVec a; a.r = _mm256_set_ps(s[3], s[3], s[2], s[2], s[1], s[1], s[0], s[0]); return a;
+    }
+    inline void load(const float *p) { r = _mm256_loadu_ps(p); }
+    inline void store(float *p) const { _mm256_storeu_ps(p, r); }
+    inline void load(const float *p, int stride) {
+      r = _mm256_set_ps(p[3*stride+1], p[3*stride], p[2*stride+1], p[2*stride],
+			p[stride+1], p[stride], p[1], p[0]);
+    }
+    inline void store(float *p, int stride) const {
+      float a[8]; _mm256_storeu_ps(a, r);
+      for (int k=0; k<4; k++) { p[k*stride] = a[2*k]; p[k*stride+1] = a[2*k+1]; }
+    }
+    inline void gather(const float *const *p) {
+      r = _mm256_set_ps(p[3][1], p[3][0], p[2][1], p[2][0], p[1][1], p[1][0], p[0][1], p[0][0]);
+    }
+    inline ComplexVec& operator+=(const ComplexVec &b) { r = _mm256_add_ps(r, b.r); return *this; }
+    inline ComplexVec& operator-=(const ComplexVec &b) { r = _mm256_sub_ps(r, b.r); return *this; }
+  };
+
+  HOST_SIMD_OPS(float, 4, __m256, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_set1_ps)
+
+  template <>
+  inline ComplexVec<float,4> cmul(const float &ure, const float &uim, const ComplexVec<float,4> &h) {
+    ComplexVec<float,4> c;
+    c.r = _mm256_addsub_ps(_mm256_mul_ps(_mm256_set1_ps(ure), h.r),
+			   _mm256_mul_ps(_mm256_set1_ps(uim), _mm256_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,4> conj_cmul(const float &ure, const float &uim, const ComplexVec<float,4> &h) {
+    ComplexVec<float,4> c;
+    c.r = _mm256_addsub_ps(_mm256_mul_ps(_mm256_set1_ps(ure), h.r),
+			   _mm256_mul_ps(_mm256_set1_ps(-uim), _mm256_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,4> cmul(const ComplexVec<float,4> &u, const ComplexVec<float,4> &h) {
+    ComplexVec<float,4> c;
+    c.r = _mm256_addsub_ps(_mm256_mul_ps(_mm256_moveldup_ps(u.r), h.r),
+			   _mm256_mul_ps(_mm256_movehdup_ps(u.r), _mm256_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,4> conj_cmul(const ComplexVec<float,4> &u, const ComplexVec<float,4> &h) {
+    ComplexVec<float,4> c;
+    c.r = _mm256_addsub_ps(_mm256_mul_ps(_mm256_moveldup_ps(u.r), h.r),
+			   _mm256_mul_ps(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_movehdup_ps(u.r)),
+					 _mm256_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,4> times_i(const ComplexVec<float,4> &h) {
+    ComplexVec<float,4> c;
+    c.r = _mm256_addsub_ps(_mm256_setzero_ps(), _mm256_permute_ps(h.r, 0xB1));
+    return c;
+  }
+
+#endif // __AVX2__ || __AVX512F__
+
+#ifdef __AVX512F__
+
+  // AVX-512F has no floating point xor, so negate through the integer unit
+  inline __m512d neg512(const __m512d &a) {
+    return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(0x8000000000000000LL)));
+  }
+  inline __m512 neg512(const __m512 &a) {
+    return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x80000000)));
+  }
+
+  HOST_REAL_VEC(double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_sub_pd,
+		_mm512_mul_pd, _mm512_set1_pd, neg512)
+  HOST_REAL_VEC(float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, _mm512_sub_ps,
+		_mm512_mul_ps, _mm512_set1_ps, neg512)
+
+  // AVX-512 has no addsub: even (real) slots take a-b, odd (imaginary) slots a+b
+
+  // double, 4 lanes
+  template <>
+  struct ComplexVec<double,4> {
+    __m512d r;
+    static inline ComplexVec zero() { ComplexVec a; a.r = _mm512_setzero_pd(); return a; }
+    static inline ComplexVec lanes(const double *s) {
+      ComplexVec a; a.r = _mm512_set_pd(s[3], s[3], s[2], s[2], s[1], s[1], s[0], s[0]); return a;
+    }
+    inline void load(const double *p) { r = _mm512_loadu_pd(p); }
+    inline void store(double *p) const { _mm512_storeu_pd(p, r); }
+    inline void load(const double *p, int stride) {
+      r = _mm512_set_pd(p[3*stride+1], p[3*stride], p[2*stride+1], p[2*stride],
+			p[stride+1], p[stride], p[1], p[0]);
+    }
+    inline void store(double *p, int stride) const {
+      double a[8]; _mm512_storeu_pd(a, r);
+      for (int k=0; k<4; k++) { p[k*stride] = a[2*k]; p[k*stride+1] = a[2*k+1]; }
+    }
+    inline void gather(const double *const *p) {
+      r = _mm512_set_pd(p[3][1], p[3][0], p[2][1], p[2][0], p[1][1], p[1][0], p[0][1], p[0][0]);
+    }
+    inline ComplexVec& operator+=(const ComplexVec &b) { r = _mm512_add_pd(r, b.r); return *this; }
+    inline ComplexVec& operator-=(const ComplexVec &b) { r = _mm512_sub_pd(r, b.r); return *this; }
+  };
+
+  HOST_SIMD_OPS(double, 4, __m512d, _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_set1_pd)
+
+  inline __m512d addsub512(const __m512d &a, const __m512d &b) {
+    return _mm512_mask_sub_pd(_mm512_add_pd(a, b), 0x55, a, b);
+  }
+
+  template <>
+  inline ComplexVec<double,4> cmul(const double &ure, const double &uim, const ComplexVec<double,4> &h) {
+    ComplexVec<double,4> c;
+    c.r = addsub512(_mm512_mul_pd(_mm512_set1_pd(ure), h.r),
+		    _mm512_mul_pd(_mm512_set1_pd(uim), _mm512_permute_pd(h.r, 0x55)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,4> conj_cmul(const double &ure, const double &uim, const ComplexVec<double,4> &h) {
+    ComplexVec<double,4> c;
+    c.r = addsub512(_mm512_mul_pd(_mm512_set1_pd(ure), h.r),
+		    _mm512_mul_pd(_mm512_set1_pd(-uim), _mm512_permute_pd(h.r, 0x55)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,4> cmul(const ComplexVec<double,4> &u, const ComplexVec<double,4> &h) {
+    ComplexVec<double,4> c;
+    c.r = addsub512(_mm512_mul_pd(_mm512_movedup_pd(u.r), h.r),
+		    _mm512_mul_pd(_mm512_permute_pd(u.r, 0xFF), _mm512_permute_pd(h.r, 0x55)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,4> conj_cmul(const ComplexVec<double,4> &u, const ComplexVec<double,4> &h) {
+    ComplexVec<double,4> c;
+    c.r = addsub512(_mm512_mul_pd(_mm512_movedup_pd(u.r), h.r),
+		    _mm512_mul_pd(_mm512_sub_pd(_mm512_setzero_pd(), _mm512_permute_pd(u.r, 0xFF)),
+				  _mm512_permute_pd(h.r, 0x55)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<double,4> times_i(const ComplexVec<double,4> &h) {
+    ComplexVec<double,4> c;
+    c.r = addsub512(_mm512_setzero_pd(), _mm512_permute_pd(h.r, 0x55));
+    return c;
+  }
+
+  // float, 8 lanes
+  template <>
+  struct ComplexVec<float,8> {
+    __m512 r;
+    static inline ComplexVec zero() { ComplexVec a; a.r = _mm512_setzero_ps(); return a; }
+    static inline ComplexVec lanes(const float *s) {
+      ComplexVec a;
+      a.r = _mm512_set_ps(s[7], s[7], s[6], s[6], s[5], s[5], s[4], s[4],
+			  s[3], s[3], s[2], s[2], s[1], s[1], s[0], s[0]);
+      return a;
+    }
+    inline void load(const float *p) { r = _mm512_loadu_ps(p); }
+    inline void store(float *p) const { _mm512_storeu_ps(p, r); }
+    inline void load(const float *p, int stride) {
+      float a[16];
+      for (int k=0; k<8; k++) { a[2*k] = p[k*stride]; a[2*k+1] = p[k*stride+1]; }
+      r = _mm512_loadu_ps(a);
+    }
+    inline void store(float *p, int stride) const {
+      float a[16]; _mm512_storeu_ps(a, r);
+      for (int k=0; k<8; k++) { p[k*stride] = a[2*k]; p[k*stride+1] = a[2*k+1]; }
+    }
+    inline void gather(const float *const *p) {
+      float a[16];
+      for (int k=0; k<8; k++) { a[2*k] = p[k][0]; a[2*k+1] = p[k][1]; }
+      r = _mm512_loadu_ps(a);
+    }
+    inline ComplexVec& operator+=(const ComplexVec &b) { r = _mm512_add_ps(r, b.r); return *this; }
+    inline ComplexVec& operator-=(const ComplexVec &b) { r = _mm512_sub_ps(r, b.r); return *this; }
+  };
+
+  HOST_SIMD_OPS(float, 8, __m512, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_set1_ps)
+
+  inline __m512 addsub512(const __m512 &a, const __m512 &b) {
+    return _mm512_mask_sub_ps(_mm512_add_ps(a, b), 0x5555, a, b);
+  }
+
+  template <>
+  inline ComplexVec<float,8> cmul(const float &ure, const float &uim, const ComplexVec<float,8> &h) {
+    ComplexVec<float,8> c;
+    c.r = addsub512(_mm512_mul_ps(_mm512_set1_ps(ure), h.r),
+		    _mm512_mul_ps(_mm512_set1_ps(uim), _mm512_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,8> conj_cmul(const float &ure, const float &uim, const ComplexVec<float,8> &h) {
+    ComplexVec<float,8> c;
+    c.r = addsub512(_mm512_mul_ps(_mm512_set1_ps(ure), h.r),
+		    _mm512_mul_ps(_mm512_set1_ps(-uim), _mm512_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,8> cmul(const ComplexVec<float,8> &u, const ComplexVec<float,8> &h) {
+    ComplexVec<float,8> c;
+    c.r = addsub512(_mm512_mul_ps(_mm512_moveldup_ps(u.r), h.r),
+		    _mm512_mul_ps(_mm512_movehdup_ps(u.r), _mm512_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,8> conj_cmul(const ComplexVec<float,8> &u, const ComplexVec<float,8> &h) {
+    ComplexVec<float,8> c;
+    c.r = addsub512(_mm512_mul_ps(_mm512_moveldup_ps(u.r), h.r),
+		    _mm512_mul_ps(_mm512_sub_ps(_mm512_setzero_ps(), _mm512_movehdup_ps(u.r)),
+				  _mm512_permute_ps(h.r, 0xB1)));
+    return c;
+  }
+
+  template <>
+  inline ComplexVec<float,8> times_i(const ComplexVec<float,8> &h) {
+    ComplexVec<float,8> c;
+    c.r = addsub512(_mm512_setzero_ps(), _mm512_permute_ps(h.r, 0xB1));
+    return c;
+  }
+
+#endif // __AVX512F__
+
+#undef HOST_SIMD_OPS
+#undef HOST_REAL_VEC
+
+} // namespace quda
+
+#endif // _HOST_SIMD_H
@@ -4,6 +4,7 @@
 #include <math.h>
 #include <string.h>
 #include <sys/time.h>
+#include <vector>
 
 #include <quda.h>
 #include <quda_internal.h>
@@ -81,6 +82,132 @@ cudaCloverField *cloverPrecise = NULL;
 cudaCloverField *cloverSloppy = NULL;
 cudaCloverField *cloverPrecondition = NULL;
 
+// host mirrors of gaugePrecise (and the fat/long links) used when the
+// Dirac operator is applied on the CPU
+cpuGaugeField *gaugeHost = NULL;
+cpuGaugeField *gaugeFatHost = NULL;
+cpuGaugeField *gaugeLongHost = NULL;
+
+// host copy of the clover term and its inverse (packed order) used by
+// the host clover dslash
+cpuCloverField *cloverHost = NULL;
+
+// whether two sets of parameters describe the same solve operator, at
+// the same precision and location
+static bool sameOperator(const QudaInvertParam *a, const QudaInvertParam *b)
+{
+  return (a->dslash_type == b->dslash_type &&
+	  a->kappa == b->kappa &&
+	  a->mass == b->mass &&
+	  a->mu == b->mu &&
+	  a->epsilon == b->epsilon &&
+	  a->twist_flavor == b->twist_flavor &&
+	  a->m5 == b->m5 &&
+	  a->Ls == b->Ls &&
+	  a->solve_type == b->solve_type &&
+	  a->matpc_type == b->matpc_type &&
+	  a->dagger == b->dagger &&
+	  a->cuda_prec == b->cuda_prec &&
+	  a->compute_location == b->compute_location);
+}
+
+// eigCG deflation space, kept across solves with the same operator and
+// discarded whenever the gauge field or clover term changes
+static DeflationSpace *deflation = NULL;
+static QudaInvertParam deflationParam;
+
+static void freeDeflationSpace(void)
+{
+  delete deflation;
+  deflation = NULL;
+}
+
+// returns the eigCG deflation space for this operator, starting a new
+// one if the operator differs from the one the space was built for
+static DeflationSpace* getDeflationSpace(const QudaInvertParam *param)
+{
+  if (deflation && !sameOperator(param, &deflationParam)) {
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Operator changed, discarding the eigCG deflation space\n");
+    freeDeflationSpace();
+  }
+
+  if (!deflation) {
+    if (param->nev <= 0 || param->deflation_grid <= 0)
+      errorQuda("Invalid eigCG parameters nev = %d, deflation_grid = %d", param->nev, param->deflation_grid);
+    deflation = new DeflationSpace(param->nev*param->deflation_grid);
+    deflationParam = *param;
+  }
+
+  return deflation;
+}
+
+// Chronological solution histories, one per operator (mass), from
+// which invertQuda builds the initial guess of each solve.  Unlike the
+// deflation space they are kept when the gauge field changes, since
+// the solutions of the previous molecular dynamics steps are what the
+// guess is extrapolated from.
+static std::vector<ChronoHistory*> chronoHistory;
+static std::vector<QudaInvertParam> chronoParam;
+
+void flushChronoQuda(void)
+{
+  for (unsigned int i=0; i<chronoHistory.size(); i++) delete chronoHistory[i];
+  chronoHistory.clear();
+  chronoParam.clear();
+}
+
+// returns the solution history for this operator, or NULL if the
+// chronological guess is disabled or not applicable
+static ChronoHistory* getChronoHistory(const QudaInvertParam *param)
+{
+  if (param->chrono_max_dim <= 0) return NULL;
+
+  for (unsigned int i=0; i<chronoHistory.size(); i++) {
+    if (!sameOperator(param, &chronoParam[i])) continue;
+    if (chronoParam[i].chrono_max_dim == param->chrono_max_dim) return chronoHistory[i];
+    // the depth changed, so start again
+    delete chronoHistory[i];
+    chronoHistory.erase(chronoHistory.begin()+i);
+    chronoParam.erase(chronoParam.begin()+i);
+    break;
+  }
+
+  chronoHistory.push_back(new ChronoHistory(param->chrono_max_dim));
+  chronoParam.push_back(*param);
+  return chronoHistory.back();
+}
+
+// starts the solve from the chronological guess, unless an initial
+// guess was supplied by the caller
+static void chronoGuess(ChronoHistory *history, ColorSpinorField &x, ColorSpinorField &b,
+			DiracMatrix &m, SolverParam &solverParam, TimeProfile &profile)
+{
+  if (!history || history->Size() == 0 || solverParam.use_init_guess == QUDA_USE_INIT_GUESS_YES) return;
+  history->guess(x, b, m, profile);
+  solverParam.use_init_guess = QUDA_USE_INIT_GUESS_YES;
+}
+
+// records the solution, then discards the oldest solutions of the
+// deepest histories until the memory cap is met
+static void chronoUpdate(ChronoHistory *history, ColorSpinorField &x, const QudaInvertParam *param)
+{
+  if (!history) return;
+  history->add(x);
+
+  if (param->chrono_max_gib <= 0.0) return;
+  const size_t max_bytes = (size_t)(param->chrono_max_gib*(1<<30));
+  while (true) {
+    size_t bytes = 0;
+    ChronoHistory *deepest = NULL;
+    for (unsigned int i=0; i<chronoHistory.size(); i++) {
+      bytes += chronoHistory[i]->Bytes();
+      if (!deepest || chronoHistory[i]->Size() > deepest->Size()) deepest = chronoHistory[i];
+    }
+    if (bytes <= max_bytes || deepest->Size() == 0) break;
+    deepest->pop();
+  }
+}
+
 
 cudaDeviceProp deviceProp;
 cudaStream_t *streams;
@@ -105,6 +232,12 @@ static TimeProfile profileMulti("invertMultiShiftQuda");
 //!< Profiler for invertMultiShiftMixedQuda
 static TimeProfile profileMultiMixed("invertMultiShiftMixedQuda");
 
+//!< Profiler for invertMultiSrcQuda
+static TimeProfile profileMultiSrc("invertMultiSrcQuda");
+
+//!< Profiler for eigensolveQuda
+static TimeProfile profileEigensolve("eigensolveQuda");
+
 //!< Profiler for computeFatLinkQuda
 static TimeProfile profileFatLink("computeKSLinkQuda");
 
@@ -358,6 +491,9 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 
   checkGaugeParam(param);
 
+  // a new gauge field invalidates the eigCG deflation space
+  freeDeflationSpace();
+
   profileGauge.Start(QUDA_PROFILE_INIT);  
   // Set the specific input parameters and create the cpu gauge field
   GaugeFieldParam gauge_param(h_gauge, *param);
@@ -427,6 +563,42 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 
   profileGauge.Stop(QUDA_PROFILE_COMPUTE); 
 
+#ifdef HOST_DSLASH
+  // keep a QDP-ordered host copy of the links for the host dslash
+  if (param->location == QUDA_CPU_FIELD_LOCATION) {
+    GaugeFieldParam host_param(h_gauge, *param);
+    host_param.create = QUDA_NULL_FIELD_CREATE;
+    host_param.precision = (param->cuda_prec == QUDA_HALF_PRECISION) ? 
+      QUDA_SINGLE_PRECISION : param->cuda_prec;
+    // follow the compression of the device field where the host
+    // dslash can reconstruct it: 12 and 8 need SU(3) links, and the
+    // long links use 13 and 9
+    if (((param->reconstruct == QUDA_RECONSTRUCT_12 || param->reconstruct == QUDA_RECONSTRUCT_8) && 
+	 param->type == QUDA_WILSON_LINKS) ||
+	param->reconstruct == QUDA_RECONSTRUCT_13 || param->reconstruct == QUDA_RECONSTRUCT_9) {
+      host_param.reconstruct = param->reconstruct;
+    } else {
+      host_param.reconstruct = QUDA_RECONSTRUCT_NO;
+    }
+    host_param.order = QUDA_QDP_GAUGE_ORDER;
+    host_param.pad = 0;
+
+    cpuGaugeField **host = NULL;
+    switch (param->type) {
+    case QUDA_WILSON_LINKS: host = &gaugeHost; break;
+    case QUDA_ASQTAD_FAT_LINKS: host = &gaugeFatHost; break;
+    case QUDA_ASQTAD_LONG_LINKS: host = &gaugeLongHost; break;
+    default: errorQuda("Invalid gauge type");
+    }
+
+    if (*host) delete *host;
+    *host = new cpuGaugeField(host_param);
+    (*host)->copy(*in);
+  } else {
+    warningQuda("Host gauge field requires a gauge field on the CPU, host dslash will be unavailable");
+  }
+#endif
+
   switch (param->type) {
     case QUDA_WILSON_LINKS:
       //if (gaugePrecise) errorQuda("Precise gauge field already allocated");
@@ -499,6 +671,60 @@ void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 }
 
 
+// create the device clover fields (precise, sloppy and preconditioner) from in
+static void createCloverFields(const CloverField &in, QudaInvertParam *inv_param)
+{
+  profileClover.Start(QUDA_PROFILE_INIT);
+
+  CloverFieldParam clover_param;
+  clover_param.nDim = 4;
+  for (int i=0; i<4; i++) clover_param.x[i] = gaugePrecise->X()[i];
+  clover_param.setPrecision(inv_param->clover_cuda_prec);
+  clover_param.pad = inv_param->cl_pad;
+  clover_param.direct = in.V(false) ? true : false;
+  clover_param.inverse = in.V(true) ? true : false;
+  clover_param.create = QUDA_NULL_FIELD_CREATE;
+  cloverPrecise = new cudaCloverField(clover_param);
+  profileClover.Stop(QUDA_PROFILE_INIT);
+
+  profileClover.Start(QUDA_PROFILE_H2D);
+  cloverPrecise->copy(in);
+  profileClover.Stop(QUDA_PROFILE_H2D);
+
+  inv_param->cloverGiB = cloverPrecise->GBytes();
+
+  // create the mirror sloppy clover field
+  if (inv_param->clover_cuda_prec != inv_param->clover_cuda_prec_sloppy) {
+    profileClover.Start(QUDA_PROFILE_INIT);
+    clover_param.setPrecision(inv_param->clover_cuda_prec_sloppy);
+    cloverSloppy = new cudaCloverField(clover_param); 
+    cloverSloppy->copy(*cloverPrecise);
+    profileClover.Stop(QUDA_PROFILE_INIT);
+    /*profileClover.Start(QUDA_PROFILE_H2D);
+      cloverSloppy->loadCPUField(cpu);
+      profileClover.Stop(QUDA_PROFILE_H2D);*/
+    inv_param->cloverGiB += cloverSloppy->GBytes();
+  } else {
+    cloverSloppy = cloverPrecise;
+  }
+
+  // create the mirror preconditioner clover field
+  if (inv_param->clover_cuda_prec_sloppy != inv_param->clover_cuda_prec_precondition &&
+      inv_param->clover_cuda_prec_precondition != QUDA_INVALID_PRECISION) {
+    profileClover.Start(QUDA_PROFILE_INIT);
+    clover_param.setPrecision(inv_param->clover_cuda_prec_precondition);
+    cloverPrecondition = new cudaCloverField(clover_param);
+    cloverPrecondition->copy(*cloverSloppy);
+    profileClover.Stop(QUDA_PROFILE_INIT);
+    /*profileClover.Start(QUDA_PROFILE_H2D);
+      cloverPrecondition->loadCPUField(cpu);
+      profileClover.Stop(QUDA_PROFILE_H2D);*/
+    inv_param->cloverGiB += cloverPrecondition->GBytes();
+  } else {
+    cloverPrecondition = cloverSloppy;
+  }
+}
+
 void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 {
   profileClover.Start(QUDA_PROFILE_TOTAL);
@@ -508,6 +734,9 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 
   if (!initialized) errorQuda("QUDA not initialized");
 
+  // a new clover term invalidates the eigCG deflation space
+  freeDeflationSpace();
+
   if (!h_clover && !h_clovinv) {
     errorQuda("loadCloverQuda() called with neither clover term nor inverse");
   }
@@ -535,7 +764,12 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
   // We issue a warning only when it seems likely that the user is screwing up:
 
   // inverted clover term is required when applying preconditioned operator
-  if (!h_clovinv && pc_solve && pc_solution) {
+  // (a host-dslash build computes it below from a host clover term)
+  bool host_inverse = false;
+#ifdef HOST_DSLASH
+  host_inverse = (h_clover && inv_param->clover_location == QUDA_CPU_FIELD_LOCATION);
+#endif
+  if (!h_clovinv && !host_inverse && pc_solve && pc_solution) {
     warningQuda("Inverted clover term not loaded");
   }
 
@@ -569,55 +803,99 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
     static_cast<CloverField*>(new cpuCloverField(cpuParam)) : 
     static_cast<CloverField*>(new cudaCloverField(cpuParam));
 
-  CloverFieldParam clover_param;
-  clover_param.nDim = 4;
-  for (int i=0; i<4; i++) clover_param.x[i] = gaugePrecise->X()[i];
-  clover_param.setPrecision(inv_param->clover_cuda_prec);
-  clover_param.pad = inv_param->cl_pad;
-  clover_param.direct = h_clover ? true : false;
-  clover_param.inverse = h_clovinv ? true : false;
-  clover_param.create = QUDA_NULL_FIELD_CREATE;
-  cloverPrecise = new cudaCloverField(clover_param);
+#ifdef HOST_DSLASH
+  // if only the clover term was given, compute its inverse on the host
+  if (h_clover && !h_clovinv && inv_param->clover_location == QUDA_CPU_FIELD_LOCATION) {
+    CloverFieldParam inv_cpu_param(cpuParam);
+    inv_cpu_param.order = QUDA_PACKED_CLOVER_ORDER;
+    inv_cpu_param.direct = true;
+    inv_cpu_param.inverse = true;
+    inv_cpu_param.clover = NULL;
+    inv_cpu_param.cloverInv = NULL;
+    inv_cpu_param.create = QUDA_NULL_FIELD_CREATE;
+    cpuCloverField *inv = new cpuCloverField(inv_cpu_param);
+    copyGenericClover(*inv, *in, false, QUDA_CPU_FIELD_LOCATION);
+    cloverInvertCpu(*inv);
+    delete in;
+    in = inv;
+  }
+#endif
+
   profileClover.Stop(QUDA_PROFILE_INIT);
 
-  profileClover.Start(QUDA_PROFILE_H2D);
-  cloverPrecise->copy(*in);
-  profileClover.Stop(QUDA_PROFILE_H2D);
+  createCloverFields(*in, inv_param);
+
+#ifdef HOST_DSLASH
+  // keep a packed copy of the clover term and inverse for the host dslash
+  if (inv_param->clover_location == QUDA_CPU_FIELD_LOCATION && gaugeHost) {
+    CloverFieldParam host_param(cpuParam);
+    host_param.precision = gaugeHost->Precision();
+    host_param.order = QUDA_PACKED_CLOVER_ORDER;
+    host_param.direct = in->V(false) ? true : false;
+    host_param.inverse = in->V(true) ? true : false;
+    host_param.clover = NULL;
+    host_param.cloverInv = NULL;
+    host_param.create = QUDA_NULL_FIELD_CREATE;
+
+    if (cloverHost) delete cloverHost;
+    cloverHost = new cpuCloverField(host_param);
+    if (host_param.direct) copyGenericClover(*cloverHost, *in, false, QUDA_CPU_FIELD_LOCATION);
+    if (host_param.inverse) copyGenericClover(*cloverHost, *in, true, QUDA_CPU_FIELD_LOCATION);
+  }
+#endif
 
-  inv_param->cloverGiB = cloverPrecise->GBytes();
+  delete in; // delete object referencing input field
 
-  // create the mirror sloppy clover field
-  if (inv_param->clover_cuda_prec != inv_param->clover_cuda_prec_sloppy) {
-    profileClover.Start(QUDA_PROFILE_INIT);
-    clover_param.setPrecision(inv_param->clover_cuda_prec_sloppy);
-    cloverSloppy = new cudaCloverField(clover_param); 
-    cloverSloppy->copy(*cloverPrecise);
-    profileClover.Stop(QUDA_PROFILE_INIT);
-    /*profileClover.Start(QUDA_PROFILE_H2D);
-      cloverSloppy->loadCPUField(cpu);
-      profileClover.Stop(QUDA_PROFILE_H2D);*/
-    inv_param->cloverGiB += cloverSloppy->GBytes();
-  } else {
-    cloverSloppy = cloverPrecise;
-  }
+  popVerbosity();
 
-  // create the mirror preconditioner clover field
-  if (inv_param->clover_cuda_prec_sloppy != inv_param->clover_cuda_prec_precondition &&
-      inv_param->clover_cuda_prec_precondition != QUDA_INVALID_PRECISION) {
-    profileClover.Start(QUDA_PROFILE_INIT);
-    clover_param.setPrecision(inv_param->clover_cuda_prec_precondition);
-    cloverPrecondition = new cudaCloverField(clover_param);
-    cloverPrecondition->copy(*cloverSloppy);
-    profileClover.Stop(QUDA_PROFILE_INIT);
-    /*profileClover.Start(QUDA_PROFILE_H2D);
-      cloverPrecondition->loadCPUField(cpu);
-      profileClover.Stop(QUDA_PROFILE_H2D);*/
-    inv_param->cloverGiB += cloverPrecondition->GBytes();
-  } else {
-    cloverPrecondition = cloverSloppy;
-  }
+  profileClover.Stop(QUDA_PROFILE_TOTAL);
+}
 
-  delete in; // delete object referencing input field
+void computeCloverQuda(QudaInvertParam *inv_param)
+{
+  profileClover.Start(QUDA_PROFILE_TOTAL);
+
+  pushVerbosity(inv_param->verbosity);
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(inv_param);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (gaugePrecise == NULL) errorQuda("Gauge field must be loaded before clover");
+  if (inv_param->dslash_type != QUDA_CLOVER_WILSON_DSLASH) errorQuda("Wrong dslash_type in computeCloverQuda()");
+  if (inv_param->clover_coeff == DBL_MIN)
+    errorQuda("Parameter clover_coeff undefined");
+
+#ifdef HOST_DSLASH
+  if (gaugeHost == NULL) errorQuda("Host gauge field not allocated (requires a gauge field loaded from the CPU)");
+  if (cloverPrecise) freeCloverQuda();
+
+  profileClover.Start(QUDA_PROFILE_INIT);
+  CloverFieldParam host_param;
+  host_param.nDim = 4;
+  for (int i=0; i<4; i++) host_param.x[i] = gaugeHost->X()[i];
+  host_param.precision = gaugeHost->Precision();
+  host_param.pad = 0;
+  host_param.order = QUDA_PACKED_CLOVER_ORDER;
+  host_param.direct = true;
+  host_param.inverse = true;
+  host_param.clover = NULL;
+  host_param.norm = 0;
+  host_param.cloverInv = NULL;
+  host_param.invNorm = 0;
+  host_param.create = QUDA_NULL_FIELD_CREATE;
+  cloverHost = new cpuCloverField(host_param);
+  profileClover.Stop(QUDA_PROFILE_INIT);
+
+  profileClover.Start(QUDA_PROFILE_COMPUTE);
+  computeCloverCpu(*cloverHost, *gaugeHost, inv_param->clover_coeff);
+  cloverInvertCpu(*cloverHost);
+  profileClover.Stop(QUDA_PROFILE_COMPUTE);
+
+  // the device fields are filled from the host field, which is kept
+  // for the host dslash
+  createCloverFields(*cloverHost, inv_param);
+#else
+  errorQuda("computeCloverQuda() requires a host-dslash build");
+#endif
 
   popVerbosity();
 
@@ -627,6 +905,7 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 void freeGaugeQuda(void) 
 {  
   if (!initialized) errorQuda("QUDA not initialized");
+  freeDeflationSpace();
   if (gaugeSloppy != gaugePrecondition && gaugePrecondition) delete gaugePrecondition;
   if (gaugePrecise != gaugeSloppy && gaugeSloppy) delete gaugeSloppy;
   if (gaugePrecise) delete gaugePrecise;
@@ -650,12 +929,20 @@ void freeGaugeQuda(void)
   gaugeFatPrecondition = NULL;
   gaugeFatSloppy = NULL;
   gaugeFatPrecise = NULL;
+
+  if (gaugeHost) delete gaugeHost;
+  if (gaugeFatHost) delete gaugeFatHost;
+  if (gaugeLongHost) delete gaugeLongHost;
+  gaugeHost = NULL;
+  gaugeFatHost = NULL;
+  gaugeLongHost = NULL;
 }
 
 
 void freeCloverQuda(void)
 {
   if (!initialized) errorQuda("QUDA not initialized");
+  freeDeflationSpace();
   if (cloverPrecondition != cloverSloppy && cloverPrecondition) delete cloverPrecondition;
   if (cloverSloppy != cloverPrecise && cloverSloppy) delete cloverSloppy;
   if (cloverPrecise) delete cloverPrecise;
@@ -663,6 +950,9 @@ void freeCloverQuda(void)
   cloverPrecondition = NULL;
   cloverSloppy = NULL;
   cloverPrecise = NULL;
+
+  if (cloverHost) delete cloverHost;
+  cloverHost = NULL;
 }
 
 
@@ -676,9 +966,11 @@ void endQuda(void)
   cudaColorSpinorField::freeBuffer();
   cudaColorSpinorField::freeGhostBuffer();
   cpuColorSpinorField::freeGhostBuffer();
+  freeHostDslashBuffer();
   FaceBuffer::flushPinnedCache();
   freeGaugeQuda();
   freeCloverQuda();
+  flushChronoQuda();
 
   endBlas();
 
@@ -711,6 +1003,8 @@ void endQuda(void)
     profileInvert.Print();
     profileMulti.Print();
     profileMultiMixed.Print();
+    profileMultiSrc.Print();
+    profileEigensolve.Print();
     profileFatLink.Print();
     profileGaugeForce.Print();
     profileGaugeUpdate.Print();
@@ -771,6 +1065,10 @@ namespace quda {
     diracParam.fatGauge = gaugeFatPrecise;
     diracParam.longGauge = gaugeLongPrecise;    
     diracParam.clover = cloverPrecise;
+    diracParam.hostGauge = gaugeHost;
+    diracParam.hostFatGauge = gaugeFatHost;
+    diracParam.hostLongGauge = gaugeLongHost;
+    diracParam.hostClover = cloverHost;
     diracParam.kappa = kappa;
     diracParam.mass = inv_param->mass;
     diracParam.m5 = inv_param->m5;
@@ -797,7 +1095,9 @@ namespace quda {
 
   }
 
-  // The preconditioner currently mimicks the sloppy operator with no comms
+  // The preconditioner mimicks the sloppy operator with no comms: the
+  // hops across process boundaries are dropped, giving the local
+  // Dirichlet blocks of the Schwarz preconditioner
   void setDiracPreParam(DiracParam &diracParam, QudaInvertParam *inv_param, const bool pc)
   {
     setDiracParam(diracParam, inv_param, pc);
@@ -829,7 +1129,7 @@ namespace quda {
   }
 
   void massRescale(QudaDslashType dslash_type, double &kappa, QudaSolutionType solution_type, 
-      QudaMassNormalization mass_normalization, cudaColorSpinorField &b)
+      QudaMassNormalization mass_normalization, ColorSpinorField &b)
   {   
     if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
       printfQuda("Mass rescale: Kappa is: %g\n", kappa);
@@ -850,27 +1150,27 @@ namespace quda {
       case QUDA_MAT_SOLUTION:
         if (mass_normalization == QUDA_MASS_NORMALIZATION ||
             mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) {
-          axCuda(2.0*kappa, b);
+          blas::ax(2.0*kappa, b);
         }
         break;
       case QUDA_MATDAG_MAT_SOLUTION:
         if (mass_normalization == QUDA_MASS_NORMALIZATION ||
             mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) {
-          axCuda(4.0*kappa*kappa, b);
+          blas::ax(4.0*kappa*kappa, b);
         }
         break;
       case QUDA_MATPC_SOLUTION:
         if (mass_normalization == QUDA_MASS_NORMALIZATION) {
-          axCuda(4.0*kappa*kappa, b);
+          blas::ax(4.0*kappa*kappa, b);
         } else if (mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) {
-          axCuda(2.0*kappa, b);
+          blas::ax(2.0*kappa, b);
         }
         break;
       case QUDA_MATPCDAG_MATPC_SOLUTION:
         if (mass_normalization == QUDA_MASS_NORMALIZATION) {
-          axCuda(16.0*pow(kappa,4), b);
+          blas::ax(16.0*pow(kappa,4), b);
         } else if (mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) {
-          axCuda(4.0*kappa*kappa, b);
+          blas::ax(4.0*kappa*kappa, b);
         }
         break;
       default:
@@ -937,6 +1237,73 @@ namespace quda {
 
   }*/
 
+enum HostDiracOperator { HOST_DSLASH_OPERATOR, HOST_M_OPERATOR, HOST_MDAGM_OPERATOR,
+			 HOST_CLOVER_OPERATOR, HOST_CLOVER_INV_OPERATOR };
+
+// Apply the Dirac operator on the host (compute_location == CPU).  The
+// user fields are copied into work fields matching the host gauge field
+// (precision, DeGrand-Rossi basis, space-spin-color order), the operator
+// is applied and scaled, and the result is copied back.
+static void hostDiracQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, const bool pc,
+			  const HostDiracOperator op, const QudaParity parity, const double scale)
+{
+  const cpuGaugeField *hostGauge = (inv_param->dslash_type == QUDA_ASQTAD_DSLASH) ? 
+    gaugeFatHost : gaugeHost;
+  if (hostGauge == NULL) errorQuda("Host gauge field not allocated (requires a host-dslash build)");
+  if (inv_param->dslash_type == QUDA_ASQTAD_DSLASH && gaugeLongHost == NULL)
+    errorQuda("Host long links not allocated");
+  if (inv_param->dslash_type == QUDA_CLOVER_WILSON_DSLASH && cloverHost == NULL)
+    errorQuda("Host clover field not allocated");
+  if (inv_param->input_location != QUDA_CPU_FIELD_LOCATION || 
+      inv_param->output_location != QUDA_CPU_FIELD_LOCATION) 
+    errorQuda("Host dslash requires input and output fields on the CPU");
+
+  ColorSpinorParam cpuParam(h_in, *inv_param, hostGauge->X(), pc);
+  if (cpuParam.siteOrder != QUDA_EVEN_ODD_SITE_ORDER) 
+    errorQuda("Host dslash requires even-odd site ordering");
+
+  cpuColorSpinorField in_h(cpuParam);
+  cpuParam.v = h_out;
+  cpuColorSpinorField out_h(cpuParam);
+
+  ColorSpinorParam hostParam(cpuParam);
+  hostParam.v = NULL;
+  hostParam.create = QUDA_NULL_FIELD_CREATE;
+  hostParam.precision = hostGauge->Precision();
+  hostParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  if (hostParam.nSpin == 4) hostParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  cpuColorSpinorField in(hostParam);
+  cpuColorSpinorField out(hostParam);
+
+  in.copy(in_h);
+
+  DiracParam diracParam;
+  setDiracParam(diracParam, inv_param, pc);
+
+  if (op == HOST_CLOVER_OPERATOR || op == HOST_CLOVER_INV_OPERATOR) {
+    DiracCloverPC dirac(diracParam);
+    if (op == HOST_CLOVER_OPERATOR) dirac.Clover(out, in, parity);
+    else dirac.CloverInv(out, in, parity);
+  } else {
+    Dirac *dirac = Dirac::create(diracParam); // create the Dirac operator
+    switch (op) {
+    case HOST_DSLASH_OPERATOR: dirac->Dslash(out, in, parity); break;
+    case HOST_M_OPERATOR: dirac->M(out, in); break;
+    case HOST_MDAGM_OPERATOR: dirac->MdagM(out, in); break;
+    default: errorQuda("Invalid host operator %d", op);
+    }
+    delete dirac; // clean up
+  }
+
+  if (scale != 1.0) axCpu(scale, out);
+
+  out_h.copy(out);
+
+  if (getVerbosity() >= QUDA_VERBOSE) {
+    printfQuda("In CPU %e Out CPU %e\n", normCpu(in_h), normCpu(out_h));
+  }
+}
+
 void dslashQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity parity)
 {
   if (inv_param->dslash_type == QUDA_DOMAIN_WALL_DSLASH) setKernelPackT(true);
@@ -948,6 +1315,12 @@ void dslashQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity
   pushVerbosity(inv_param->verbosity);
   if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(inv_param);
 
+  if (inv_param->compute_location == QUDA_CPU_FIELD_LOCATION) {
+    hostDiracQuda(h_out, h_in, inv_param, true, HOST_DSLASH_OPERATOR, parity, 1.0);
+    popVerbosity();
+    return;
+  }
+
   ColorSpinorParam cpuParam(h_in, *inv_param, gaugePrecise->X(), 1);
 
   ColorSpinorField *in_h = (inv_param->input_location == QUDA_CPU_FIELD_LOCATION) ?
@@ -1016,6 +1389,21 @@ void MatQuda(void *h_out, void *h_in, QudaInvertParam *inv_param)
   bool pc = (inv_param->solution_type == QUDA_MATPC_SOLUTION ||
       inv_param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
 
+  if (inv_param->compute_location == QUDA_CPU_FIELD_LOCATION) {
+    double kappa = inv_param->kappa;
+    double scale = 1.0;
+    if (pc) {
+      if (inv_param->mass_normalization == QUDA_MASS_NORMALIZATION) scale = 0.25/(kappa*kappa);
+      else if (inv_param->mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) scale = 0.5/kappa;
+    } else if (inv_param->mass_normalization == QUDA_MASS_NORMALIZATION ||
+	       inv_param->mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) {
+      scale = 0.5/kappa;
+    }
+    hostDiracQuda(h_out, h_in, inv_param, pc, HOST_M_OPERATOR, QUDA_INVALID_PARITY, scale);
+    popVerbosity();
+    return;
+  }
+
   ColorSpinorParam cpuParam(h_in, *inv_param, gaugePrecise->X(), pc);
   ColorSpinorField *in_h = (inv_param->input_location == QUDA_CPU_FIELD_LOCATION) ?
     static_cast<ColorSpinorField*>(new cpuColorSpinorField(cpuParam)) : 
@@ -1089,6 +1477,21 @@ void MatDagMatQuda(void *h_out, void *h_in, QudaInvertParam *inv_param)
   bool pc = (inv_param->solution_type == QUDA_MATPC_SOLUTION ||
       inv_param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
 
+  if (inv_param->compute_location == QUDA_CPU_FIELD_LOCATION) {
+    double kappa = inv_param->kappa;
+    double scale = 1.0;
+    if (pc) {
+      if (inv_param->mass_normalization == QUDA_MASS_NORMALIZATION) scale = 1.0/pow(2.0*kappa,4);
+      else if (inv_param->mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) scale = 0.25/(kappa*kappa);
+    } else if (inv_param->mass_normalization == QUDA_MASS_NORMALIZATION ||
+	       inv_param->mass_normalization == QUDA_ASYMMETRIC_MASS_NORMALIZATION) {
+      scale = 0.25/(kappa*kappa);
+    }
+    hostDiracQuda(h_out, h_in, inv_param, pc, HOST_MDAGM_OPERATOR, QUDA_INVALID_PARITY, scale);
+    popVerbosity();
+    return;
+  }
+
   ColorSpinorParam cpuParam(h_in, *inv_param, gaugePrecise->X(), pc);
   ColorSpinorField *in_h = (inv_param->input_location == QUDA_CPU_FIELD_LOCATION) ?
     static_cast<ColorSpinorField*>(new cpuColorSpinorField(cpuParam)) : 
@@ -1183,6 +1586,13 @@ void cloverQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity
   if (inv_param->dslash_type != QUDA_CLOVER_WILSON_DSLASH)
     errorQuda("Cannot apply the clover term for a non Wilson-clover dslash");
 
+  if (inv_param->compute_location == QUDA_CPU_FIELD_LOCATION) {
+    hostDiracQuda(h_out, h_in, inv_param, true, inverse ? HOST_CLOVER_INV_OPERATOR : HOST_CLOVER_OPERATOR,
+		  parity, 1.0);
+    popVerbosity();
+    return;
+  }
+
   ColorSpinorParam cpuParam(h_in, *inv_param, gaugePrecise->X(), 1);
 
   ColorSpinorField *in_h = (inv_param->input_location == QUDA_CPU_FIELD_LOCATION) ?
@@ -1242,6 +1652,119 @@ void cloverQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity
 }
 
 
+// Solve on the host (compute_location == CPU).  Mirrors invertQuda
+// below, but the work fields live in host memory at the precision of
+// the host gauge field, so there is no sloppy or preconditioner
+// precision and no prepare/reconstruct step: the solution and solve
+// preconditioning must match.
+static void hostInvertQuda(void *hp_x, void *hp_b, QudaInvertParam *param, const bool pc_solution,
+			   const bool pc_solve, const bool mat_solution, const bool direct_solve)
+{
+  const cpuGaugeField *hostGauge = (param->dslash_type == QUDA_ASQTAD_DSLASH) ? 
+    gaugeFatHost : gaugeHost;
+  if (hostGauge == NULL) errorQuda("Host gauge field not allocated (requires a host-dslash build)");
+  if (param->dslash_type == QUDA_ASQTAD_DSLASH && gaugeLongHost == NULL)
+    errorQuda("Host long links not allocated");
+  if (param->dslash_type == QUDA_CLOVER_WILSON_DSLASH && cloverHost == NULL)
+    errorQuda("Host clover field not allocated");
+  if (param->input_location != QUDA_CPU_FIELD_LOCATION || 
+      param->output_location != QUDA_CPU_FIELD_LOCATION) 
+    errorQuda("Host solver requires input and output fields on the CPU");
+  if (pc_solution != pc_solve)
+    errorQuda("Host solver requires the solution_type and solve_type preconditioning to match");
+
+  // wrap CPU host side pointers
+  ColorSpinorParam cpuParam(hp_b, *param, hostGauge->X(), pc_solution);
+  if (cpuParam.siteOrder != QUDA_EVEN_ODD_SITE_ORDER) 
+    errorQuda("Host solver requires even-odd site ordering");
+  cpuColorSpinorField h_b(cpuParam);
+  cpuParam.v = hp_x;
+  cpuColorSpinorField h_x(cpuParam);
+
+  ColorSpinorParam hostParam(cpuParam);
+  hostParam.v = NULL;
+  hostParam.create = QUDA_NULL_FIELD_CREATE;
+  hostParam.precision = hostGauge->Precision();
+  hostParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  if (hostParam.nSpin == 4) hostParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  cpuColorSpinorField b(hostParam);
+  cpuColorSpinorField x(hostParam);
+
+  b.copy(h_b);
+  if (param->use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+    if (!mat_solution && direct_solve) errorQuda("Initial guess not supported for two-pass solver");
+    x.copy(h_x);
+  } else {
+    x.zero();
+  }
+
+  double nb = norm2(b);
+  if (nb==0.0) errorQuda("Solution has zero norm");
+
+  if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) {
+    blas::ax(1.0/sqrt(nb), b);
+    blas::ax(1.0/sqrt(nb), x);
+  }
+
+  massRescale(param->dslash_type, param->kappa, param->solution_type, param->mass_normalization, b);
+
+  DiracParam diracParam;
+  setDiracParam(diracParam, param, pc_solve);
+  Dirac *dirac = Dirac::create(diracParam);
+
+  // the host operators only act on fields of the host gauge precision
+  SolverParam solverParam(*param);
+  solverParam.precision = hostGauge->Precision();
+  solverParam.precision_sloppy = hostGauge->Precision();
+  solverParam.precision_precondition = hostGauge->Precision();
+
+  if (mat_solution && !direct_solve) { // prepare source: b' = A^dag b
+    cpuColorSpinorField tmp(b);
+    dirac->Mdag(b, tmp);
+  } else if (!mat_solution && direct_solve) { // perform the first of two solves: A^dag y = b
+    DiracMdag m(*dirac);
+    Solver *solve = Solver::create(solverParam, m, m, m, profileInvert);
+    (*solve)(x, b);
+    blas::copy(b, x);
+    delete solve;
+  }
+
+  // the chronological guess only applies to single-pass solves
+  ChronoHistory *history = (mat_solution || !direct_solve) ? getChronoHistory(param) : NULL;
+
+  if (direct_solve) {
+    DiracM m(*dirac);
+    chronoGuess(history, x, b, m, solverParam, profileInvert);
+    Solver *solve = Solver::create(solverParam, m, m, m, profileInvert);
+    (*solve)(x, b);
+    delete solve;
+  } else {
+    DiracMdagM m(*dirac);
+    if (param->inv_type == QUDA_EIGCG_INVERTER) solverParam.deflation = getDeflationSpace(param);
+    chronoGuess(history, x, b, m, solverParam, profileInvert);
+    Solver *solve = Solver::create(solverParam, m, m, m, profileInvert);
+    (*solve)(x, b);
+    delete solve;
+  }
+  solverParam.updateInvertParam(*param);
+
+  chronoUpdate(history, x, param);
+
+  if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) {
+    // rescale the solution
+    blas::ax(sqrt(nb), x);
+  }
+
+  h_x.copy(x);
+
+  if (getVerbosity() >= QUDA_VERBOSE) {
+    printfQuda("Solution: CPU = %g, host copy = %g\n", norm2(h_x), norm2(x));
+  }
+
+  delete dirac;
+}
+
+
 void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 {
 
@@ -1285,6 +1808,13 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   param->gflops = 0;
   param->iter = 0;
 
+  if (param->compute_location == QUDA_CPU_FIELD_LOCATION) {
+    hostInvertQuda(hp_x, hp_b, param, pc_solution, pc_solve, mat_solution, direct_solve);
+    popVerbosity();
+    profileInvert.Stop(QUDA_PROFILE_TOTAL);
+    return;
+  }
+
   Dirac *d = NULL;
   Dirac *dSloppy = NULL;
   Dirac *dPre = NULL;
@@ -1411,9 +1941,13 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     delete solve;
   }
 
+  // the chronological guess only applies to single-pass solves
+  ChronoHistory *history = (mat_solution || !direct_solve) ? getChronoHistory(param) : NULL;
+
   if (direct_solve) {
     DiracM m(dirac), mSloppy(diracSloppy), mPre(diracPre);
     SolverParam solverParam(*param);
+    chronoGuess(history, *out, *in, m, solverParam, profileInvert);
     Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, profileInvert);
     (*solve)(*out, *in);
     solverParam.updateInvertParam(*param);
@@ -1421,12 +1955,16 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   } else {
     DiracMdagM m(dirac), mSloppy(diracSloppy), mPre(diracPre);
     SolverParam solverParam(*param);
+    if (param->inv_type == QUDA_EIGCG_INVERTER) solverParam.deflation = getDeflationSpace(param);
+    chronoGuess(history, *out, *in, m, solverParam, profileInvert);
     Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, profileInvert);
     (*solve)(*out, *in);
     solverParam.updateInvertParam(*param);
     delete solve;
   }
 
+  chronoUpdate(history, *out, param);
+
   if (getVerbosity() >= QUDA_VERBOSE){
     double nx = norm2(*x);
     printfQuda("Solution = %g\n",nx);
@@ -1466,6 +2004,345 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 }
 
 
+/*!
+ * Solve for param->num_src sources with the same operator.  With the
+ * block CG inverter all sources share one Krylov space and the
+ * operator is applied to the whole block at once; any other inverter
+ * solves the sources one at a time through invertQuda.
+ *
+ * Block CG works on the normal operator, so solve_type must be NORMOP
+ * or NORMOP_PC, and the solution and solve preconditioning have to
+ * match.  The solve is carried out in the cuda_prec precision (or the
+ * host gauge precision when compute_location is the CPU) with no
+ * sloppy precision.
+ */
+void invertMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param)
+{
+  const int nSrc = param->num_src;
+  if (nSrc < 1) errorQuda("Invalid number of sources %d", nSrc);
+
+  if (param->inv_type != QUDA_BLOCK_CG_INVERTER) {
+    int iter = 0;
+    double secs = 0.0, gflops = 0.0;
+    for (int i=0; i<nSrc; i++) {
+      invertQuda(_hp_x[i], _hp_b[i], param);
+      iter += param->iter;
+      secs += param->secs;
+      gflops += param->gflops;
+    }
+    param->iter = iter;
+    param->secs = secs;
+    param->gflops = gflops;
+    return;
+  }
+
+  if (param->dslash_type == QUDA_DOMAIN_WALL_DSLASH) setKernelPackT(true);
+
+  profileMultiSrc.Start(QUDA_PROFILE_TOTAL);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+
+  pushVerbosity(param->verbosity);
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(param);
+
+  // check the gauge fields have been created
+  cudaGaugeField *cudaGauge = checkGauge(param);
+
+  checkInvertParam(param);
+
+  bool pc_solution = (param->solution_type == QUDA_MATPC_SOLUTION) || 
+    (param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+  bool pc_solve = (param->solve_type == QUDA_DIRECT_PC_SOLVE) || 
+    (param->solve_type == QUDA_NORMOP_PC_SOLVE);
+  bool mat_solution = (param->solution_type == QUDA_MAT_SOLUTION) || 
+    (param->solution_type ==  QUDA_MATPC_SOLUTION);
+  bool direct_solve = (param->solve_type == QUDA_DIRECT_SOLVE) || 
+    (param->solve_type == QUDA_DIRECT_PC_SOLVE);
+
+  if (direct_solve) errorQuda("Block CG requires a normal-operator solve_type");
+  if (pc_solution != pc_solve)
+    errorQuda("Multi-source solver requires the solution_type and solve_type preconditioning to match");
+
+  const bool host = (param->compute_location == QUDA_CPU_FIELD_LOCATION);
+  const cpuGaugeField *hostGauge = (param->dslash_type == QUDA_ASQTAD_DSLASH) ? 
+    gaugeFatHost : gaugeHost;
+  if (host && hostGauge == NULL) errorQuda("Host gauge field not allocated (requires a host-dslash build)");
+
+  param->secs = 0;
+  param->gflops = 0;
+  param->iter = 0;
+
+  Dirac *d = NULL;
+  Dirac *dSloppy = NULL;
+  Dirac *dPre = NULL;
+  if (host) {
+    DiracParam diracParam;
+    setDiracParam(diracParam, param, pc_solve);
+    d = Dirac::create(diracParam);
+  } else {
+    createDirac(d, dSloppy, dPre, *param, pc_solve);
+  }
+  Dirac &dirac = *d;
+
+  profileMultiSrc.Start(QUDA_PROFILE_H2D);
+
+  const int *X = cudaGauge->X();
+
+  // wrap CPU host side pointers
+  ColorSpinorField **h_b = new ColorSpinorField*[nSrc];
+  ColorSpinorField **h_x = new ColorSpinorField*[nSrc];
+  ColorSpinorParam cpuParam(_hp_b[0], *param, X, pc_solution);
+  for (int i=0; i<nSrc; i++) {
+    cpuParam.v = _hp_b[i];
+    h_b[i] = (param->input_location == QUDA_CPU_FIELD_LOCATION) ?
+      static_cast<ColorSpinorField*>(new cpuColorSpinorField(cpuParam)) : 
+      static_cast<ColorSpinorField*>(new cudaColorSpinorField(cpuParam));
+    cpuParam.v = _hp_x[i];
+    h_x[i] = (param->output_location == QUDA_CPU_FIELD_LOCATION) ?
+      static_cast<ColorSpinorField*>(new cpuColorSpinorField(cpuParam)) : 
+      static_cast<ColorSpinorField*>(new cudaColorSpinorField(cpuParam));
+  }
+
+  // the work fields live where the solve is computed
+  ColorSpinorParam workParam(cpuParam, *param);
+  if (host) {
+    workParam = cpuParam;
+    workParam.v = NULL;
+    workParam.location = QUDA_CPU_FIELD_LOCATION;
+    workParam.precision = hostGauge->Precision();
+    workParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    if (workParam.nSpin == 4) workParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  }
+
+  ColorSpinorField **b = new ColorSpinorField*[nSrc];
+  ColorSpinorField **x = new ColorSpinorField*[nSrc];
+  for (int i=0; i<nSrc; i++) {
+    workParam.create = QUDA_COPY_FIELD_CREATE;
+    b[i] = ColorSpinorField::Create(*h_b[i], workParam);
+    if (param->use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      x[i] = ColorSpinorField::Create(*h_x[i], workParam);
+    } else {
+      workParam.create = QUDA_ZERO_FIELD_CREATE;
+      x[i] = ColorSpinorField::Create(workParam);
+    }
+  }
+
+  profileMultiSrc.Stop(QUDA_PROFILE_H2D);
+
+  setTuning(param->tune);
+
+  // rescale each source and solution to help prevent the onset of underflow
+  double *nb = new double[nSrc];
+  for (int i=0; i<nSrc; i++) {
+    nb[i] = norm2(*b[i]);
+    if (nb[i] == 0.0) continue;
+    if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) {
+      blas::ax(1.0/sqrt(nb[i]), *b[i]);
+      blas::ax(1.0/sqrt(nb[i]), *x[i]);
+    }
+  }
+
+  DiracMdag mdag(dirac);
+  for (int i=0; i<nSrc; i++) {
+    massRescale(param->dslash_type, param->kappa, param->solution_type, param->mass_normalization, *b[i]);
+
+    if (mat_solution) { // prepare source: b' = A^dag b
+      workParam.create = QUDA_COPY_FIELD_CREATE;
+      ColorSpinorField *tmp = ColorSpinorField::Create(*b[i], workParam);
+      mdag(*b[i], *tmp);
+      delete tmp;
+    }
+  }
+
+  SolverParam solverParam(*param);
+  if (host) {
+    // the host operators only act on fields of the host gauge precision
+    solverParam.precision = hostGauge->Precision();
+    solverParam.precision_sloppy = hostGauge->Precision();
+    solverParam.precision_precondition = hostGauge->Precision();
+  }
+
+  DiracMdagM m(dirac);
+  BlockCG cg(m, solverParam, profileMultiSrc);
+  cg(x, b, nSrc);
+  solverParam.updateInvertParam(*param);
+
+  for (int i=0; i<nSrc; i++) {
+    if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION && nb[i] != 0.0) {
+      // rescale the solution
+      blas::ax(sqrt(nb[i]), *x[i]);
+    }
+  }
+
+  profileMultiSrc.Start(QUDA_PROFILE_D2H);
+  for (int i=0; i<nSrc; i++) *h_x[i] = *x[i];
+  profileMultiSrc.Stop(QUDA_PROFILE_D2H);
+
+  for (int i=0; i<nSrc; i++) {
+    delete x[i];
+    delete b[i];
+    delete h_x[i];
+    delete h_b[i];
+  }
+  delete []nb;
+  delete []x;
+  delete []b;
+  delete []h_x;
+  delete []h_b;
+
+  delete d;
+  delete dSloppy;
+  delete dPre;
+
+  popVerbosity();
+
+  profileMultiSrc.Stop(QUDA_PROFILE_TOTAL);
+}
+
+
+/*!
+ * Computes the param->nev lowest eigenpairs of the normal operator
+ * M^dag M (or its even-odd preconditioned form for NORMOP_PC) with
+ * the thick-restart Lanczos eigensolver, starting from a random
+ * vector.  The eigenvalues are those of the operator in the internal
+ * normalization of the Dirac operator (mass_normalization is not
+ * applied).
+ *
+ * The eigenvectors replace the eigCG deflation space, so a later
+ * eigCG solve with the same operator deflates them from the start,
+ * and are copied to host_evecs (param->nev fields of the solve
+ * subset) when it is not NULL.  The computation is carried out in the
+ * cuda_prec precision, or the host gauge precision when
+ * compute_location is the CPU.
+ */
+void eigensolveQuda(void **host_evecs, double *evals, QudaInvertParam *param)
+{
+  if (param->dslash_type == QUDA_DOMAIN_WALL_DSLASH) setKernelPackT(true);
+
+  profileEigensolve.Start(QUDA_PROFILE_TOTAL);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+
+  pushVerbosity(param->verbosity);
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(param);
+
+  // check the gauge fields have been created
+  cudaGaugeField *cudaGauge = checkGauge(param);
+
+  checkInvertParam(param);
+
+  // the eigensolver parameters are not covered by checkInvertParam
+  if (param->nev <= 0) errorQuda("Invalid number of eigenpairs nev = %d", param->nev);
+  if (param->eig_poly_deg < 0) errorQuda("Invalid eig_poly_deg = %d", param->eig_poly_deg);
+  if (param->eig_poly_deg > 0 && (param->eig_amin == DBL_MIN || param->eig_amax == DBL_MIN))
+    errorQuda("Chebyshev interval eig_amin, eig_amax undefined");
+  if (param->eig_tol <= DBL_MIN) errorQuda("Invalid eig_tol = %e", param->eig_tol);
+  if (param->eig_max_restarts < 0) errorQuda("Invalid eig_max_restarts = %d", param->eig_max_restarts);
+
+  bool pc_solve = (param->solve_type == QUDA_DIRECT_PC_SOLVE) || 
+    (param->solve_type == QUDA_NORMOP_PC_SOLVE);
+  bool direct_solve = (param->solve_type == QUDA_DIRECT_SOLVE) || 
+    (param->solve_type == QUDA_DIRECT_PC_SOLVE);
+
+  if (direct_solve) errorQuda("Lanczos eigensolver requires a normal-operator solve_type");
+
+  const bool host = (param->compute_location == QUDA_CPU_FIELD_LOCATION);
+  const cpuGaugeField *hostGauge = (param->dslash_type == QUDA_ASQTAD_DSLASH) ? 
+    gaugeFatHost : gaugeHost;
+  if (host && hostGauge == NULL) errorQuda("Host gauge field not allocated (requires a host-dslash build)");
+
+  param->secs = 0;
+  param->gflops = 0;
+  param->iter = 0;
+
+  Dirac *d = NULL;
+  Dirac *dSloppy = NULL;
+  Dirac *dPre = NULL;
+  if (host) {
+    DiracParam diracParam;
+    setDiracParam(diracParam, param, pc_solve);
+    d = Dirac::create(diracParam);
+  } else {
+    createDirac(d, dSloppy, dPre, *param, pc_solve);
+  }
+  Dirac &dirac = *d;
+
+  profileEigensolve.Start(QUDA_PROFILE_H2D);
+
+  const int *X = cudaGauge->X();
+  const int nEv = param->nev;
+
+  ColorSpinorParam cpuParam(host_evecs ? host_evecs[0] : NULL, *param, X, pc_solve);
+
+  // random starting vector, generated on the host
+  ColorSpinorParam randParam(cpuParam);
+  randParam.v = NULL;
+  randParam.create = QUDA_ZERO_FIELD_CREATE;
+  randParam.precision = QUDA_DOUBLE_PRECISION;
+  randParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  cpuColorSpinorField *rand = new cpuColorSpinorField(randParam);
+  rand->Source(QUDA_RANDOM_SOURCE);
+
+  // the work fields live where the eigensolver is computed
+  ColorSpinorParam workParam(cpuParam, *param);
+  if (host) {
+    workParam = cpuParam;
+    workParam.v = NULL;
+    workParam.location = QUDA_CPU_FIELD_LOCATION;
+    workParam.precision = hostGauge->Precision();
+    workParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    if (workParam.nSpin == 4) workParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  }
+
+  workParam.create = QUDA_COPY_FIELD_CREATE;
+  ColorSpinorField *v0 = ColorSpinorField::Create(*rand, workParam);
+  delete rand;
+
+  workParam.create = QUDA_ZERO_FIELD_CREATE;
+  ColorSpinorField **evecs = new ColorSpinorField*[nEv];
+  for (int i=0; i<nEv; i++) evecs[i] = ColorSpinorField::Create(workParam);
+
+  profileEigensolve.Stop(QUDA_PROFILE_H2D);
+
+  setTuning(param->tune);
+
+  DiracMdagM m(dirac);
+  ThickRestartLanczos lanczos(m, *param, profileEigensolve);
+  lanczos(evecs, evals, *v0);
+
+  // the eigenvectors become the deflation space of this operator
+  freeDeflationSpace();
+  deflation = new DeflationSpace(nEv);
+  deflationParam = *param;
+  deflation->add(evecs, nEv, m);
+
+  if (host_evecs) {
+    profileEigensolve.Start(QUDA_PROFILE_D2H);
+    for (int i=0; i<nEv; i++) {
+      cpuParam.v = host_evecs[i];
+      ColorSpinorField *h_evec = (param->output_location == QUDA_CPU_FIELD_LOCATION) ?
+	static_cast<ColorSpinorField*>(new cpuColorSpinorField(cpuParam)) : 
+	static_cast<ColorSpinorField*>(new cudaColorSpinorField(cpuParam));
+      *h_evec = *evecs[i];
+      delete h_evec;
+    }
+    profileEigensolve.Stop(QUDA_PROFILE_D2H);
+  }
+
+  for (int i=0; i<nEv; i++) delete evecs[i];
+  delete []evecs;
+  delete v0;
+
+  delete d;
+  delete dSloppy;
+  delete dPre;
+
+  popVerbosity();
+
+  profileEigensolve.Stop(QUDA_PROFILE_TOTAL);
+}
+
+
 /*! 
  * Generic version of the multi-shift solver. Should work for
  * most fermions. Note that offset[0] is not folded into the mass parameter.
@@ -1566,7 +2443,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   Dirac &diracSloppy = *dSloppy;
 
   cudaColorSpinorField *b = NULL;   // Cuda RHS
-  cudaColorSpinorField **x = NULL;  // Cuda Solutions
+  ColorSpinorField **x = NULL;  // Cuda Solutions
 
   // Grab the dimension array of the input gauge field.
   const int *X = ( param->dslash_type == QUDA_ASQTAD_DSLASH ) ? 
@@ -1599,7 +2476,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   profileMulti.Stop(QUDA_PROFILE_H2D);
 
   // Create the solution fields filled with zero
-  x = new cudaColorSpinorField* [ param->num_offset ];
+  x = new ColorSpinorField* [ param->num_offset ];
   cudaParam.create = QUDA_ZERO_FIELD_CREATE;
   for(int i=0; i < param->num_offset; i++) { 
     x[i] = new cudaColorSpinorField(cudaParam);
@@ -1726,7 +2603,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   profileMulti.Start(QUDA_PROFILE_D2H);
   for(int i=0; i < param->num_offset; i++) { 
     if (param->solver_normalization == QUDA_SOURCE_NORMALIZATION) { // rescale the solution 
-      axCuda(sqrt(nb), *x[i]);
+      blas::ax(sqrt(nb), *x[i]);
     }
 
     if (getVerbosity() >= QUDA_VERBOSE){
@@ -2254,6 +3131,7 @@ void load_gauge_quda_(void *h_gauge, QudaGaugeParam *param) { loadGaugeQuda(h_ga
 void free_gauge_quda_() { freeGaugeQuda(); }
 void load_clover_quda_(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param) 
 { loadCloverQuda(h_clover, h_clovinv, inv_param); }
+void compute_clover_quda_(QudaInvertParam *inv_param) { computeCloverQuda(inv_param); }
 void free_clover_quda_(void) { freeCloverQuda(); }
 void dslash_quda_(void *h_out, void *h_in, QudaInvertParam *inv_param,
     QudaParity *parity) { dslashQuda(h_out, h_in, inv_param, *parity); }
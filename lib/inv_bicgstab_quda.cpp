@@ -17,10 +17,14 @@ namespace quda {
   // set the required parameters for the inner solver
   void fillInnerSolveParam(SolverParam &inner, const SolverParam &outer);
 
-  double resNorm(const DiracMatrix &mat, cudaColorSpinorField &b, cudaColorSpinorField &x) {  
-    cudaColorSpinorField r(b);
-    mat(r, x);
-    return xmyNormCuda(b, r);
+  double resNorm(const DiracMatrix &mat, ColorSpinorField &b, ColorSpinorField &x) {  
+    ColorSpinorParam csParam(b);
+    csParam.create = QUDA_COPY_FIELD_CREATE;
+    ColorSpinorField *r = ColorSpinorField::Create(b, csParam);
+    mat(*r, x);
+    double r2 = blas::xmyNorm(b, *r);
+    delete r;
+    return r2;
   }
 
 
@@ -58,43 +62,43 @@ namespace quda {
     return updateR;
   }
 
-  void BiCGstab::operator()(cudaColorSpinorField &x, cudaColorSpinorField &b) 
+  void BiCGstab::operator()(ColorSpinorField &x, ColorSpinorField &b) 
   {
     profile.Start(QUDA_PROFILE_PREAMBLE);
 
     if (!init) {
       ColorSpinorParam csParam(x);
       csParam.create = QUDA_ZERO_FIELD_CREATE;
-      yp = new cudaColorSpinorField(x, csParam);
-      rp = new cudaColorSpinorField(x, csParam); 
+      yp = ColorSpinorField::Create(x, csParam);
+      rp = ColorSpinorField::Create(x, csParam); 
       csParam.setPrecision(param.precision_sloppy);
-      pp = new cudaColorSpinorField(x, csParam);
-      vp = new cudaColorSpinorField(x, csParam);
-      tmpp = new cudaColorSpinorField(x, csParam);
-      tp = new cudaColorSpinorField(x, csParam);
+      pp = ColorSpinorField::Create(x, csParam);
+      vp = ColorSpinorField::Create(x, csParam);
+      tmpp = ColorSpinorField::Create(x, csParam);
+      tp = ColorSpinorField::Create(x, csParam);
 
       init = true;
     }
 
-    cudaColorSpinorField &y = *yp;
-    cudaColorSpinorField &r = *rp; 
-    cudaColorSpinorField &p = *pp;
-    cudaColorSpinorField &v = *vp;
-    cudaColorSpinorField &tmp = *tmpp;
-    cudaColorSpinorField &t = *tp;
+    ColorSpinorField &y = *yp;
+    ColorSpinorField &r = *rp; 
+    ColorSpinorField &p = *pp;
+    ColorSpinorField &v = *vp;
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &t = *tp;
 
-    cudaColorSpinorField *x_sloppy, *r_sloppy, *r_0;
+    ColorSpinorField *x_sloppy, *r_sloppy, *r_0;
 
-    double b2 = normCuda(b); // norm sq of source
+    double b2 = norm2(b); // norm sq of source
     double r2;               // norm sq of residual
 
     // compute initial residual depending on whether we have an initial guess or not
     if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
       mat(r, x, y);
-      r2 = xmyNormCuda(b, r);
-      copyCuda(y, x);
+      r2 = blas::xmyNorm(b, r);
+      blas::copy(y, x);
     } else {
-      copyCuda(r, b);
+      blas::copy(r, b);
       r2 = b2;
     }
 
@@ -113,21 +117,21 @@ namespace quda {
       x_sloppy = &x;
       r_sloppy = &r;
       r_0 = &b;
-      zeroCuda(*x_sloppy);
+      blas::zero(*x_sloppy);
     } else {
       ColorSpinorParam csParam(x);
       csParam.create = QUDA_ZERO_FIELD_CREATE;
       csParam.setPrecision(param.precision_sloppy);
-      x_sloppy = new cudaColorSpinorField(x, csParam);
+      x_sloppy = ColorSpinorField::Create(x, csParam);
       csParam.create = QUDA_COPY_FIELD_CREATE;
-      r_sloppy = new cudaColorSpinorField(r, csParam);
-      r_0 = new cudaColorSpinorField(b, csParam);
+      r_sloppy = ColorSpinorField::Create(r, csParam);
+      r_0 = ColorSpinorField::Create(b, csParam);
     }
 
     // Syntatic sugar
-    cudaColorSpinorField &rSloppy = *r_sloppy;
-    cudaColorSpinorField &xSloppy = *x_sloppy;
-    cudaColorSpinorField &r0 = *r_0;
+    ColorSpinorField &rSloppy = *r_sloppy;
+    ColorSpinorField &xSloppy = *x_sloppy;
+    ColorSpinorField &r0 = *r_0;
 
     SolverParam solve_param_inner(param);
     fillInnerSolveParam(solve_param_inner, param);
@@ -136,7 +140,7 @@ namespace quda {
 
     const bool use_heavy_quark_res = 
       (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) ? true : false;
-    double heavy_quark_res = use_heavy_quark_res ? sqrt(HeavyQuarkResidualNormCuda(x,r).z) : 0.0;
+    double heavy_quark_res = use_heavy_quark_res ? sqrt(blas::HeavyQuarkResidualNorm(x,r).z) : 0.0;
     int heavy_quark_check = 10; // how often to check the heavy quark residual
 
     double delta = param.delta;
@@ -167,8 +171,8 @@ namespace quda {
     profile.Stop(QUDA_PROFILE_PREAMBLE);
     profile.Start(QUDA_PROFILE_COMPUTE);
     
-    rho = r2; // cDotProductCuda(r0, r_sloppy); // BiCRstab
-    copyCuda(p, rSloppy);
+    rho = r2; // blas::cDotProduct(r0, r_sloppy); // BiCRstab
+    blas::copy(p, rSloppy);
 
     if (getVerbosity() >= QUDA_DEBUG_VERBOSE) 
       printfQuda("BiCGstab debug: x2=%e, r2=%e, v2=%e, p2=%e, tmp2=%e r0=%e t2=%e\n", 
@@ -181,28 +185,28 @@ namespace quda {
 
       Complex r0v;
       if (param.pipeline) {
-	r0v = cDotProductCuda(r0, v);
-	if (k>0) rho = cDotProductCuda(r0, r);
+	r0v = blas::cDotProduct(r0, v);
+	if (k>0) rho = blas::cDotProduct(r0, r);
       } else {
-	r0v = cDotProductCuda(r0, v);
+	r0v = blas::cDotProduct(r0, v);
       }
       if (abs(rho) == 0.0) alpha = 0.0;
       else alpha = rho / r0v;
 
       // r -= alpha*v
-      caxpyCuda(-alpha, v, rSloppy);
+      blas::caxpy(-alpha, v, rSloppy);
 
       matSloppy(t, rSloppy, tmp);
     
       int updateR = 0;
       if (param.pipeline) {
 	// omega = (t, r) / (t, t)
-	omega_t2 = cDotProductNormACuda(t, rSloppy);
+	omega_t2 = blas::cDotProductNormA(t, rSloppy);
 	Complex tr = Complex(omega_t2.x, omega_t2.y);
 	double t2 = omega_t2.z;
 	omega = tr / t2;
 	double s2 = norm2(rSloppy);
-	Complex r0t = cDotProductCuda(r0, t);
+	Complex r0t = blas::cDotProduct(r0, t);
 	beta = -r0t / r0v;
 	r2 = s2 - real(omega * conj(tr)) ;
 
@@ -210,18 +214,18 @@ namespace quda {
         updateR = reliable(rNorm, maxrx, maxrr, r2, delta);
       } else {
 	// omega = (t, r) / (t, t)
-	omega_t2 = cDotProductNormACuda(t, rSloppy);
+	omega_t2 = blas::cDotProductNormA(t, rSloppy);
 	omega = Complex(omega_t2.x / omega_t2.z, omega_t2.y / omega_t2.z);
       }
 
       if (param.pipeline && !updateR) {
 	//x += alpha*p + omega*r, r -= omega*t, p = r - beta*omega*v + beta*p
-	caxpbypzYmbwCuda(alpha, p, omega, rSloppy, xSloppy, t);
-	cxpaypbzCuda(rSloppy, -beta*omega, v, beta, p);
+	blas::caxpbypzYmbw(alpha, p, omega, rSloppy, xSloppy, t);
+	blas::cxpaypbz(rSloppy, -beta*omega, v, beta, p);
 	//tripleBiCGstabUpdate(alpha, p, omega, rSloppy, xSloppy, t, -beta*omega, v, beta, p
       } else {
 	//x += alpha*p + omega*r, r -= omega*t, r2 = (r,r), rho = (r0, r)
-	rho_r2 = caxpbypzYmbwcDotProductUYNormYCuda(alpha, p, omega, rSloppy, xSloppy, t, r0);
+	rho_r2 = blas::caxpbypzYmbwcDotProductUYNormY(alpha, p, omega, rSloppy, xSloppy, t, r0);
 
 	rho0 = rho;
 	rho = Complex(rho_r2.x, rho_r2.y);
@@ -229,22 +233,22 @@ namespace quda {
       }
 
       if (use_heavy_quark_res && k%heavy_quark_check==0) { 
-	copyCuda(tmp,y);
-	heavy_quark_res = sqrt(xpyHeavyQuarkResidualNormCuda(xSloppy, tmp, rSloppy).z);
+	blas::copy(tmp,y);
+	heavy_quark_res = sqrt(blas::xpyHeavyQuarkResidualNorm(xSloppy, tmp, rSloppy).z);
       }
 
       if (!param.pipeline) updateR = reliable(rNorm, maxrx, maxrr, r2, delta);
 
       if (updateR) {
-	if (x.Precision() != xSloppy.Precision()) copyCuda(x, xSloppy);
+	if (x.Precision() != xSloppy.Precision()) blas::copy(x, xSloppy);
       
-	xpyCuda(x, y); // swap these around?
+	blas::xpy(x, y); // swap these around?
 
 	mat(r, y, x);
-	r2 = xmyNormCuda(b, r);
+	r2 = blas::xmyNorm(b, r);
 
-	if (x.Precision() != rSloppy.Precision()) copyCuda(rSloppy, r);            
-	zeroCuda(xSloppy);
+	if (x.Precision() != rSloppy.Precision()) blas::copy(rSloppy, r);            
+	blas::zero(xSloppy);
 
 	rNorm = sqrt(r2);
 	maxrr = rNorm;
@@ -264,13 +268,13 @@ namespace quda {
       if (!param.pipeline || updateR) {// need to update if not pipeline or did a reliable update
 	if (abs(rho*alpha) == 0.0) beta = 0.0;
 	else beta = (rho/rho0) * (alpha/omega);      
-	cxpaypbzCuda(rSloppy, -beta*omega, v, beta, p);
+	blas::cxpaypbz(rSloppy, -beta*omega, v, beta, p);
       }
 
     }
 
-    if (x.Precision() != xSloppy.Precision()) copyCuda(x, xSloppy);
-    xpyCuda(y, x);
+    if (x.Precision() != xSloppy.Precision()) blas::copy(x, xSloppy);
+    blas::xpy(y, x);
 
     profile.Stop(QUDA_PROFILE_COMPUTE);
     profile.Start(QUDA_PROFILE_EPILOGUE);
@@ -289,9 +293,9 @@ namespace quda {
     if (param.inv_type_precondition != QUDA_GCR_INVERTER) { // do not do the below if we this is an inner solver
       // Calculate the true residual
       mat(r, x);
-      param.true_res = sqrt(xmyNormCuda(b, r) / b2);
+      param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
 #if (__COMPUTE_CAPABILITY__ >= 200)
-      param.true_res_hq = sqrt(HeavyQuarkResidualNormCuda(x,r).z);
+      param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x,r).z);
 #else
       param.true_res_hq = 0.0;
 #endif
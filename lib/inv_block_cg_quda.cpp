@@ -0,0 +1,405 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+#include <face_quda.h>
+
+/*!
+ * Block CG for N right-hand sides (D. P. O'Leary, Linear Algebra
+ * Appl. 29, 293 (1980)), in the breakdown-free form of H. Ji and
+ * Y. Li (arXiv:1409.7867).  All systems share one Krylov space: each
+ * iteration applies the operator to a block of up to N search
+ * directions P, and every column of the solution is updated with the
+ * components of the whole block, so the iteration count falls as N
+ * grows.
+ *
+ * The search directions are kept orthonormal, P^dag P = 1, with a
+ * pivoted Cholesky factorisation of the Gram matrix of the new block.
+ * Directions that are numerically dependent on the others are dropped
+ * at that point, which removes the rank deficiency that makes plain
+ * block CG break down.  Converged columns stop contributing new
+ * directions, so the block shrinks as the sources converge.
+ *
+ * The block scalars only need small dense linear algebra on the host,
+ * and each of the three phases of an iteration performs its local
+ * reductions with a single global sum.
+ */
+
+namespace quda {
+
+  BlockCG::BlockCG(DiracMatrix &mat, SolverParam &param, TimeProfile &profile) :
+    Solver(param, profile), mat(mat)
+  {
+
+  }
+
+  BlockCG::~BlockCG() {
+
+  }
+
+  /**
+     Rank-revealing orthonormalisation of the n fields W from their
+     Gram matrix G = W^dag W.  A pivoted Cholesky factorisation selects
+     the most independent columns first and stops once the remaining
+     columns have a relative norm below sqrt(tol) after projection.
+     On return perm holds the selected columns and C the upper
+     triangular coefficients with which P_j = sum_i C_ij W_perm[i] is
+     orthonormal.  Returns the rank.
+   */
+  static int orthonormalize(std::vector<Complex> &C, std::vector<int> &perm,
+			    std::vector<Complex> G, const int n, const double tol) {
+    std::vector<Complex> L(n*n, 0.0);
+    std::vector<double> diag(n);
+    for (int i=0; i<n; i++) {
+      perm[i] = i;
+      diag[i] = real(G[i*n+i]);
+    }
+
+    int rank = 0;
+    for (int k=0; k<n; k++) {
+      // pivot on the largest relative Schur-complement diagonal
+      int p = k;
+      double best = -1.0;
+      for (int i=k; i<n; i++) {
+	double d = diag[perm[i]] > 0.0 ? real(G[perm[i]*n+perm[i]]) / diag[perm[i]] : 0.0;
+	if (d > best) { best = d; p = i; }
+      }
+      if (best <= tol) break;
+
+      std::swap(perm[k], perm[p]);
+      for (int l=0; l<k; l++) std::swap(L[k*n+l], L[p*n+l]);
+
+      const int pk = perm[k];
+      double lkk = sqrt(real(G[pk*n+pk]));
+      L[k*n+k] = lkk;
+      for (int i=k+1; i<n; i++) L[i*n+k] = G[perm[i]*n+pk] / lkk;
+
+      // update the Schur complement
+      for (int i=k+1; i<n; i++)
+	for (int j=k+1; j<n; j++)
+	  G[perm[i]*n+perm[j]] -= L[i*n+k] * conj(L[j*n+k]);
+
+      rank++;
+    }
+
+    // C = L^-dag restricted to the leading rank x rank block
+    for (int j=0; j<rank; j++) {
+      for (int i=0; i<n; i++) C[i*n+j] = 0.0;
+      for (int i=j; i>=0; i--) {
+	Complex s = (i == j) ? 1.0 : 0.0;
+	for (int l=i+1; l<=j; l++) s -= conj(L[l*n+i]) * C[l*n+j];
+	C[i*n+j] = s / real(L[i*n+i]);
+      }
+    }
+
+    return rank;
+  }
+
+  // the column with the largest relative residual, ignoring zero sources
+  static int worstColumn(const std::vector<double> &r2, const std::vector<double> &b2) {
+    int worst = 0;
+    double max = -1.0;
+    for (size_t i=0; i<r2.size(); i++) {
+      if (b2[i] == 0.0) continue;
+      if (r2[i]/b2[i] > max) { max = r2[i]/b2[i]; worst = i; }
+    }
+    return worst;
+  }
+
+  void BlockCG::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    ColorSpinorField *x_p = &x;
+    ColorSpinorField *b_p = &b;
+    (*this)(&x_p, &b_p, 1);
+  }
+
+  void BlockCG::operator()(ColorSpinorField **x, ColorSpinorField **b, const int nRhs)
+  {
+    profile.Start(QUDA_PROFILE_INIT);
+
+    const int N = nRhs;
+    if (N < 1) errorQuda("Invalid number of right-hand sides %d", N);
+
+    std::vector<double> b2(N), r2(N), stop(N);
+    for (int i=0; i<N; i++) {
+      b2[i] = norm2(*b[i]);
+      stop[i] = b2[i]*param.tol*param.tol; // stopping condition of solver
+    }
+
+    ColorSpinorParam csParam(*x[0]);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField **R = new ColorSpinorField*[N];
+    ColorSpinorField **P = new ColorSpinorField*[N];
+    ColorSpinorField **Q = new ColorSpinorField*[N];
+    ColorSpinorField **W = new ColorSpinorField*[N];
+    for (int i=0; i<N; i++) {
+      R[i] = ColorSpinorField::Create(*b[0], csParam);
+      P[i] = ColorSpinorField::Create(*b[0], csParam);
+      Q[i] = ColorSpinorField::Create(*b[0], csParam);
+      W[i] = ColorSpinorField::Create(*b[0], csParam);
+    }
+
+    profile.Stop(QUDA_PROFILE_INIT);
+    profile.Start(QUDA_PROFILE_PREAMBLE);
+
+    // a zero source has the zero solution and takes no part in the iteration
+    std::vector<int> active;
+    for (int i=0; i<N; i++) {
+      if (b2[i] == 0.0) {
+	printfQuda("Warning: inverting on zero-field source %d\n", i);
+	blas::zero(*x[i]);
+      } else {
+	active.push_back(i);
+      }
+    }
+
+    mat(R, x, N);
+    for (int i=0; i<N; i++) r2[i] = b2[i] == 0.0 ? 0.0 : blas::xmyNorm(*b[i], *R[i]);
+
+    // relative squared norm below which a new direction counts as dependent
+    const double tol = x[0]->Precision() == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-5;
+
+    std::vector<Complex> PQ(N*N), PR(N*N), C(N*N), G(N*N);
+    std::vector<int> perm(N);
+    std::vector<double> buf(4*N*N+N);
+    Complex *cdot = new Complex[N];
+    Complex *coeff = new Complex[N];
+    ColorSpinorField **Wperm = new ColorSpinorField*[N];
+
+    // initial directions span the residuals of the unconverged columns
+    int m = 0; // block size
+    {
+      std::vector<int> still;
+      for (size_t a=0; a<active.size(); a++)
+	if (r2[active[a]] > stop[active[a]]) still.push_back(active[a]);
+      active = still;
+    }
+    int na = active.size();
+    if (na > 0) {
+      bool reduceState = globalReduce;
+      globalReduce = false;
+      for (int a=0; a<na; a++) {
+	blas::copy(*W[a], *R[active[a]]);
+	blas::cDotProduct(cdot, W, *W[a], a+1);
+	for (int c=0; c<=a; c++) {
+	  buf[2*(a*N+c)+0] = real(cdot[c]);
+	  buf[2*(a*N+c)+1] = imag(cdot[c]);
+	}
+      }
+      globalReduce = reduceState;
+      reduceDoubleArray(&buf[0], 2*N*N);
+      for (int a=0; a<na; a++)
+	for (int c=0; c<=a; c++) {
+	  G[c*na+a] = Complex(buf[2*(a*N+c)+0], buf[2*(a*N+c)+1]);
+	  G[a*na+c] = conj(G[c*na+a]);
+	}
+
+      m = orthonormalize(C, perm, G, na, tol);
+      for (int i=0; i<na; i++) Wperm[i] = W[perm[i]];
+      for (int j=0; j<m; j++) {
+	for (int i=0; i<=j; i++) coeff[i] = C[i*na+j];
+	blas::zero(*P[j]);
+	blas::caxpy(coeff, Wperm, *P[j], j+1);
+      }
+    }
+
+    profile.Stop(QUDA_PROFILE_PREAMBLE);
+    profile.Start(QUDA_PROFILE_COMPUTE);
+    blas_flops = 0;
+
+    int k=0;
+    int worst = worstColumn(r2, b2);
+    PrintStats("BlockCG", k, r2[worst], b2[worst], 0.0);
+
+    while (na > 0 && m > 0 && k < param.maxiter) {
+
+      mat(Q, P, m);
+
+      // P^dag Q and P^dag R with one global sum
+      bool reduceState = globalReduce;
+      globalReduce = false;
+      for (int j=0; j<m; j++) {
+	blas::cDotProduct(cdot, P, *Q[j], m);
+	for (int i=0; i<m; i++) {
+	  buf[2*(i*m+j)+0] = real(cdot[i]);
+	  buf[2*(i*m+j)+1] = imag(cdot[i]);
+	}
+      }
+      for (int a=0; a<na; a++) {
+	blas::cDotProduct(cdot, P, *R[active[a]], m);
+	for (int i=0; i<m; i++) {
+	  buf[2*(m*m+i*na+a)+0] = real(cdot[i]);
+	  buf[2*(m*m+i*na+a)+1] = imag(cdot[i]);
+	}
+      }
+      globalReduce = reduceState;
+      reduceDoubleArray(&buf[0], 2*(m*m+m*na));
+
+      for (int i=0; i<m; i++)
+	for (int j=0; j<m; j++) PQ[i*m+j] = Complex(buf[2*(i*m+j)+0], buf[2*(i*m+j)+1]);
+      for (int i=0; i<m*na; i++) PR[i] = Complex(buf[2*(m*m+i)+0], buf[2*(m*m+i)+1]);
+
+      // the directions are orthonormal, so P^dag A P is positive definite
+      // unless the operator is not
+      if (!cholesky(&PQ[0], m)) {
+	warningQuda("BlockCG: P^dag A P is not positive definite, terminating");
+	break;
+      }
+
+      // alpha = (P^dag Q)^-1 P^dag R, x += P alpha, r -= Q alpha
+      choleskySolve(&PQ[0], m, &PR[0], na);
+      for (int a=0; a<na; a++) {
+	for (int i=0; i<m; i++) coeff[i] = PR[i*na+a];
+	blas::caxpy(coeff, P, *x[active[a]], m);
+	for (int i=0; i<m; i++) coeff[i] = -PR[i*na+a];
+	blas::caxpy(coeff, Q, *R[active[a]], m);
+      }
+
+      k++;
+
+      // residual norms and Q^dag R with one global sum
+      globalReduce = false;
+      for (int a=0; a<na; a++) {
+	buf[2*m*na+a] = norm2(*R[active[a]]);
+	blas::cDotProduct(cdot, Q, *R[active[a]], m);
+	for (int i=0; i<m; i++) {
+	  buf[2*(i*na+a)+0] = real(cdot[i]);
+	  buf[2*(i*na+a)+1] = imag(cdot[i]);
+	}
+      }
+      globalReduce = reduceState;
+      reduceDoubleArray(&buf[0], 2*m*na+na);
+
+      // deflate the converged columns
+      std::vector<int> still;
+      for (int a=0; a<na; a++) {
+	const int i = active[a];
+	r2[i] = buf[2*m*na+a];
+	if (r2[i] > stop[i]) still.push_back(i);
+      }
+      const int nb = still.size();
+
+      worst = worstColumn(r2, b2);
+      PrintStats("BlockCG", k, r2[worst], b2[worst], 0.0);
+
+      if (nb < na && getVerbosity() >= QUDA_DEBUG_VERBOSE)
+	printfQuda("BlockCG: %d of %d columns remain active\n", nb, N);
+
+      // beta = -(P^dag Q)^-1 Q^dag R for the remaining columns
+      for (int a=0, c=0; a<na; a++) {
+	if (r2[active[a]] <= stop[active[a]]) continue;
+	for (int l=0; l<m; l++) C[l*nb+c] = -Complex(buf[2*(l*na+a)+0], buf[2*(l*na+a)+1]);
+	c++;
+      }
+
+      active = still;
+      na = nb;
+      if (na == 0) break;
+
+      // w = r + P beta
+      choleskySolve(&PQ[0], m, &C[0], na);
+      for (int a=0; a<na; a++) {
+	blas::copy(*W[a], *R[active[a]]);
+	for (int l=0; l<m; l++) coeff[l] = C[l*na+a];
+	blas::caxpy(coeff, P, *W[a], m);
+      }
+
+      // Gram matrix of the new block and its rank-revealing orthonormalisation
+      globalReduce = false;
+      for (int a=0; a<na; a++) {
+	blas::cDotProduct(cdot, W, *W[a], a+1);
+	for (int c=0; c<=a; c++) {
+	  buf[2*(a*N+c)+0] = real(cdot[c]);
+	  buf[2*(a*N+c)+1] = imag(cdot[c]);
+	}
+      }
+      globalReduce = reduceState;
+      reduceDoubleArray(&buf[0], 2*N*N);
+      for (int a=0; a<na; a++)
+	for (int c=0; c<=a; c++) {
+	  G[c*na+a] = Complex(buf[2*(a*N+c)+0], buf[2*(a*N+c)+1]);
+	  G[a*na+c] = conj(G[c*na+a]);
+	}
+
+      m = orthonormalize(C, perm, G, na, tol);
+      if (m < na && getVerbosity() >= QUDA_DEBUG_VERBOSE)
+	printfQuda("BlockCG: dropped %d dependent directions\n", na - m);
+
+      for (int i=0; i<na; i++) Wperm[i] = W[perm[i]];
+      for (int j=0; j<m; j++) {
+	for (int i=0; i<=j; i++) coeff[i] = C[i*na+j];
+	blas::zero(*P[j]);
+	blas::caxpy(coeff, Wperm, *P[j], j+1);
+      }
+    }
+
+    if (na > 0 && m == 0)
+      warningQuda("BlockCG: search space exhausted with %d columns unconverged", na);
+
+    profile.Stop(QUDA_PROFILE_COMPUTE);
+    profile.Start(QUDA_PROFILE_EPILOGUE);
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (quda::blas_flops + mat.flops())*1e-9;
+    reduceDouble(gflops);
+    param.gflops = gflops;
+    param.iter += k;
+
+    if (k==param.maxiter)
+      warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    // compute the true residuals, reporting the worst column
+    mat(R, x, N);
+    param.true_res = 0.0;
+    param.true_res_hq = 0.0;
+    for (int i=0; i<N; i++) {
+      if (b2[i] == 0.0) continue;
+      double true_res = sqrt(blas::xmyNorm(*b[i], *R[i]) / b2[i]);
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("BlockCG: source %d, iterated residual = %e, true residual = %e\n",
+		   i, sqrt(r2[i]/b2[i]), true_res);
+      param.true_res = std::max(param.true_res, true_res);
+#if (__COMPUTE_CAPABILITY__ >= 200)
+      param.true_res_hq = std::max(param.true_res_hq, sqrt(blas::HeavyQuarkResidualNorm(*x[i],*R[i]).z));
+#endif
+    }
+
+    PrintSummary("BlockCG", k, r2[worst], b2[worst]);
+
+    // reset the flops counters
+    quda::blas_flops = 0;
+    mat.flops();
+
+    profile.Stop(QUDA_PROFILE_EPILOGUE);
+    profile.Start(QUDA_PROFILE_FREE);
+
+    delete []Wperm;
+    delete []coeff;
+    delete []cdot;
+
+    for (int i=0; i<N; i++) {
+      delete W[i];
+      delete Q[i];
+      delete P[i];
+      delete R[i];
+    }
+    delete []W;
+    delete []Q;
+    delete []P;
+    delete []R;
+
+    profile.Stop(QUDA_PROFILE_FREE);
+
+    return;
+  }
+
+} // namespace quda
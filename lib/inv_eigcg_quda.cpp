@@ -0,0 +1,406 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+#include <face_quda.h>
+
+/*!
+ * Incremental eigCG (A. Stathopoulos and K. Orginos, SIAM
+ * J. Sci. Comput. 32, 439 (2010)).
+ *
+ * The CG coefficients define the Lanczos tridiagonal matrix T of the
+ * operator in the basis of normalised residuals, v_j = r_j / |r_j|,
+ *
+ *   T_jj = 1/alpha_j + beta_{j-1}/alpha_{j-1},
+ *   T_j,j+1 = -sqrt(beta_j)/alpha_j,
+ *
+ * so the Ritz pairs of the operator can be followed at no extra
+ * operator cost.  The residuals are kept in a search space V of
+ * max_search_dim vectors.  When V is full it is restarted with the
+ * nev lowest Ritz vectors of T and the nev lowest Ritz vectors of T
+ * with its last row and column removed (the locally optimal
+ * restart), while CG itself carries on unchanged.  After a restart
+ * the coupling of the next residual to the restarted basis is given
+ * by A r_j = A p_j - beta_{j-1} A p_{j-1}, which reuses the operator
+ * applications of CG.
+ *
+ * At the end of each solve the nev lowest Ritz vectors are added to
+ * the persistent DeflationSpace, and each solve starts from the
+ * Galerkin projection of the source onto that space (init-CG).
+ */
+
+namespace quda {
+
+  DeflationSpace::DeflationSpace(const int max_size) :
+    U(0), H(0), size(0), max_size(max_size)
+  {
+    U = new ColorSpinorField*[max_size];
+    H = new Complex[max_size*max_size];
+  }
+
+  DeflationSpace::~DeflationSpace() {
+    for (int i=0; i<size; i++) delete U[i];
+    delete []U;
+    delete []H;
+  }
+
+  void DeflationSpace::deflate(ColorSpinorField &x, ColorSpinorField &r) const {
+    if (size == 0) return;
+
+    std::vector<Complex> L(size*size);
+    for (int i=0; i<size; i++)
+      for (int j=0; j<size; j++) L[i*size+j] = H[i*max_size+j];
+
+    if (!cholesky(&L[0], size)) {
+      warningQuda("Deflation space projection is not positive definite, skipping deflation");
+      return;
+    }
+
+    std::vector<Complex> c(size);
+    blas::cDotProduct(&c[0], U, r, size);
+    choleskySolve(&L[0], size, &c[0], 1);
+    blas::caxpy(&c[0], U, x, size);
+  }
+
+  void DeflationSpace::add(ColorSpinorField **v, const int n, const DiracMatrix &mat) {
+    std::vector<Complex> c(max_size);
+    ColorSpinorParam csParam(*v[0]);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField *Au = ColorSpinorField::Create(*v[0], csParam);
+
+    int added = 0;
+    for (int i=0; i<n && size<max_size; i++) {
+      csParam.create = QUDA_COPY_FIELD_CREATE;
+      ColorSpinorField *u = ColorSpinorField::Create(*v[i], csParam);
+      const double u2 = norm2(*u);
+
+      // classical Gram-Schmidt, twice for stability
+      for (int pass=0; pass<2 && size>0; pass++) {
+	blas::cDotProduct(&c[0], U, *u, size);
+	for (int j=0; j<size; j++) c[j] = -c[j];
+	blas::caxpy(&c[0], U, *u, size);
+      }
+
+      const double norm = norm2(*u);
+      if (norm <= 1e-12*u2) { // already contained in the space
+	delete u;
+	continue;
+      }
+      blas::ax(1.0/sqrt(norm), *u);
+
+      // extend H = U^dag A U by one row and column
+      U[size] = u;
+      mat(*Au, *u);
+      blas::cDotProduct(&c[0], U, *Au, size+1);
+      for (int j=0; j<=size; j++) {
+	H[j*max_size+size] = c[j];
+	H[size*max_size+j] = conj(c[j]);
+      }
+      H[size*max_size+size] = real(c[size]);
+      size++;
+      added++;
+    }
+
+    delete Au;
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("EigCG: added %d vectors to the deflation space, size = %d of %d\n",
+		 added, size, max_size);
+  }
+
+  EigCG::EigCG(DiracMatrix &mat, SolverParam &param, TimeProfile &profile) :
+    Solver(param, profile), mat(mat)
+  {
+
+  }
+
+  EigCG::~EigCG() {
+
+  }
+
+  // replaces the n fields V by the linear combinations V C, with C an
+  // n x nc row-major matrix, using W as workspace
+  static void rotate(ColorSpinorField **V, ColorSpinorField **W, const std::vector<double> &C,
+		     const int n, const int nc) {
+    std::vector<Complex> coeff(n);
+    for (int j=0; j<nc; j++) {
+      for (int i=0; i<n; i++) coeff[i] = C[i*nc+j];
+      blas::zero(*W[j]);
+      blas::caxpy(&coeff[0], V, *W[j], n);
+    }
+    for (int j=0; j<nc; j++) std::swap(V[j], W[j]);
+  }
+
+  void EigCG::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    profile.Start(QUDA_PROFILE_INIT);
+
+    DeflationSpace &space = *param.deflation;
+    const int nev = param.nev;
+    const bool harvest = !space.Full() && nev > 0;
+    const int m = harvest ? param.max_search_dim : 0;
+    if (harvest && m <= 2*nev)
+      errorQuda("eigCG search space %d must be larger than twice the number of eigenvectors %d", m, nev);
+
+    // Check to see that we're not trying to invert on a zero-field source
+    const double b2 = norm2(b);
+    if(b2 == 0){
+      profile.Stop(QUDA_PROFILE_INIT);
+      printfQuda("Warning: inverting on zero-field source\n");
+      x=b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      return;
+    }
+
+    ColorSpinorParam csParam(x);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField *r_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField *pp = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField *Ap_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField *tmp_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField &r = *r_p;
+    ColorSpinorField &p = *pp;
+    ColorSpinorField &Ap = *Ap_p;
+    ColorSpinorField &tmp = *tmp_p;
+
+    ColorSpinorField *tmp2_p = tmp_p;
+    // tmp only needed for multi-gpu Wilson-like kernels
+    if (mat.Type() != typeid(DiracStaggeredPC).name() &&
+	mat.Type() != typeid(DiracStaggered).name()) {
+      tmp2_p = ColorSpinorField::Create(b, csParam);
+    }
+    ColorSpinorField &tmp2 = *tmp2_p;
+
+    // the search space, its restart workspace and A p_{j-1}
+    ColorSpinorField **V = NULL, **W = NULL, *Ap_prev = NULL;
+    if (harvest) {
+      V = new ColorSpinorField*[m];
+      W = new ColorSpinorField*[2*nev];
+      for (int i=0; i<m; i++) V[i] = ColorSpinorField::Create(b, csParam);
+      for (int i=0; i<2*nev; i++) W[i] = ColorSpinorField::Create(b, csParam);
+      Ap_prev = ColorSpinorField::Create(b, csParam);
+    }
+
+    profile.Stop(QUDA_PROFILE_INIT);
+    profile.Start(QUDA_PROFILE_PREAMBLE);
+
+    mat(r, x, tmp, tmp2);
+    double r2 = blas::xmyNorm(b, r);
+
+    // start from the deflated initial guess
+    if (space.Size() > 0) {
+      space.deflate(x, r);
+      mat(r, x, tmp, tmp2);
+      r2 = blas::xmyNorm(b, r);
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("EigCG: deflated with %d vectors, |r|/|b| = %e\n", space.Size(), sqrt(r2/b2));
+    }
+    blas::copy(p, r);
+
+    const bool use_heavy_quark_res =
+      (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) ? true : false;
+    double heavy_quark_res = 0.0;
+    if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x,r).z);
+
+    double stop = b2*param.tol*param.tol; // stopping condition of solver
+
+    double alpha = 0.0, alpha_old = 0.0, beta = 0.0;
+    int kv = 0; // vectors in the search space
+    bool restarted = false;
+    int nRestart = 0;
+
+    std::vector<double> T(m*m), Tm1((m-1)*(m-1)), eval(m), evec(m*m), evec1((m-1)*(m-1));
+    std::vector<double> Q(m*2*nev), H(4*nev*nev), Z(4*nev*nev), C(m*2*nev);
+    std::vector<Complex> cdot(m);
+
+    profile.Stop(QUDA_PROFILE_PREAMBLE);
+    profile.Start(QUDA_PROFILE_COMPUTE);
+    blas_flops = 0;
+
+    int k=0;
+
+    PrintStats("EigCG", k, r2, b2, heavy_quark_res);
+
+    while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && k < param.maxiter) {
+
+      if (harvest) {
+	if (kv == m) {
+	  // locally optimal restart with the lowest Ritz vectors of T_m and T_(m-1)
+	  symmetricEigensolve(&eval[0], &evec[0], &T[0], m);
+	  for (int i=0; i<m-1; i++)
+	    for (int j=0; j<m-1; j++) Tm1[i*(m-1)+j] = T[i*m+j];
+	  symmetricEigensolve(&eval[0], &evec1[0], &Tm1[0], m-1);
+
+	  for (int i=0; i<m; i++) {
+	    for (int j=0; j<nev; j++) {
+	      Q[i*2*nev+j] = evec[i*m+j];
+	      Q[i*2*nev+nev+j] = (i < m-1) ? evec1[i*(m-1)+j] : 0.0;
+	    }
+	  }
+
+	  // orthonormalise the 2 nev columns of Q, dropping dependent ones
+	  int nk = 0;
+	  for (int j=0; j<2*nev; j++) {
+	    for (int pass=0; pass<2; pass++) {
+	      for (int l=0; l<nk; l++) {
+		double dot = 0.0;
+		for (int i=0; i<m; i++) dot += Q[i*2*nev+l] * Q[i*2*nev+j];
+		for (int i=0; i<m; i++) Q[i*2*nev+j] -= dot * Q[i*2*nev+l];
+	      }
+	    }
+	    double norm = 0.0;
+	    for (int i=0; i<m; i++) norm += Q[i*2*nev+j] * Q[i*2*nev+j];
+	    if (norm < 1e-12) continue;
+	    for (int i=0; i<m; i++) Q[i*2*nev+nk] = Q[i*2*nev+j] / sqrt(norm);
+	    nk++;
+	  }
+
+	  // H = Q^T T Q and its eigenvectors Z give the restarted basis V Q Z
+	  for (int a=0; a<nk; a++) {
+	    for (int c=0; c<nk; c++) {
+	      double sum = 0.0;
+	      for (int i=0; i<m; i++) {
+		if (Q[i*2*nev+a] == 0.0) continue;
+		double TQ = 0.0;
+		for (int j=0; j<m; j++) TQ += T[i*m+j] * Q[j*2*nev+c];
+		sum += Q[i*2*nev+a] * TQ;
+	      }
+	      H[a*nk+c] = sum;
+	    }
+	  }
+	  symmetricEigensolve(&eval[0], &Z[0], &H[0], nk);
+
+	  for (int i=0; i<m; i++) {
+	    for (int c=0; c<nk; c++) {
+	      double sum = 0.0;
+	      for (int a=0; a<nk; a++) sum += Q[i*2*nev+a] * Z[a*nk+c];
+	      C[i*nk+c] = sum;
+	    }
+	  }
+	  rotate(V, W, C, m, nk);
+
+	  std::fill(T.begin(), T.end(), 0.0);
+	  for (int i=0; i<nk; i++) T[i*m+i] = eval[i];
+	  kv = nk;
+
+	  blas::copy(*Ap_prev, Ap);
+	  restarted = true;
+	  nRestart++;
+	} else if (kv > 0) {
+	  T[(kv-1)*m+kv] = T[kv*m+kv-1] = -sqrt(beta)/alpha_old;
+	}
+
+	blas::copy(*V[kv], r);
+	blas::ax(1.0/sqrt(r2), *V[kv]);
+	kv++;
+      }
+
+      mat(Ap, p, tmp, tmp2);
+      alpha = r2 / blas::reDotProduct(p, Ap);
+
+      if (harvest) {
+	T[(kv-1)*m+kv-1] = 1.0/alpha + (k > 0 ? beta/alpha_old : 0.0);
+
+	if (restarted) {
+	  // couple the new vector to the restarted basis: A r = A p - beta A p_old
+	  blas::xpay(Ap, -beta, *Ap_prev);
+	  blas::cDotProduct(&cdot[0], V, *Ap_prev, kv-1);
+	  for (int i=0; i<kv-1; i++)
+	    T[i*m+kv-1] = T[(kv-1)*m+i] = real(cdot[i]) / sqrt(r2);
+	  restarted = false;
+	}
+      }
+
+      blas::axpy(alpha, p, x);
+      double r2_old = r2;
+      r2 = blas::axpyNorm(-alpha, Ap, r);
+      beta = r2 / r2_old;
+      blas::xpay(r, beta, p);
+      alpha_old = alpha;
+
+      if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x,r).z);
+
+      k++;
+      PrintStats("EigCG", k, r2, b2, heavy_quark_res);
+    }
+
+    profile.Stop(QUDA_PROFILE_COMPUTE);
+    profile.Start(QUDA_PROFILE_EPILOGUE);
+
+    // add the lowest Ritz vectors of the final search space to the deflation space
+    if (harvest && kv > 0) {
+      const int nconv = std::min(nev, kv);
+      std::vector<double> Tk(kv*kv), Y(kv*kv);
+      for (int i=0; i<kv; i++)
+	for (int j=0; j<kv; j++) Tk[i*kv+j] = T[i*m+j];
+      symmetricEigensolve(&eval[0], &Y[0], &Tk[0], kv);
+
+      if (getVerbosity() >= QUDA_VERBOSE) {
+	printfQuda("EigCG: %d restarts, lowest Ritz values:", nRestart);
+	for (int i=0; i<nconv; i++) printfQuda(" %e", eval[i]);
+	printfQuda("\n");
+      }
+
+      for (int i=0; i<kv; i++)
+	for (int j=0; j<nconv; j++) C[i*nconv+j] = Y[i*kv+j];
+      rotate(V, W, C, kv, nconv);
+      space.add(V, nconv, mat);
+    }
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (quda::blas_flops + mat.flops())*1e-9;
+    reduceDouble(gflops);
+    param.gflops = gflops;
+    param.iter += k;
+
+    if (k==param.maxiter)
+      warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    // compute the true residuals
+    mat(r, x, tmp, tmp2);
+    param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
+#if (__COMPUTE_CAPABILITY__ >= 200)
+    param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x,r).z);
+#else
+    param.true_res_hq = 0.0;
+#endif
+
+    PrintSummary("EigCG", k, r2, b2);
+
+    // reset the flops counters
+    quda::blas_flops = 0;
+    mat.flops();
+
+    profile.Stop(QUDA_PROFILE_EPILOGUE);
+    profile.Start(QUDA_PROFILE_FREE);
+
+    if (harvest) {
+      delete Ap_prev;
+      for (int i=0; i<2*nev; i++) delete W[i];
+      for (int i=0; i<m; i++) delete V[i];
+      delete []W;
+      delete []V;
+    }
+
+    if (&tmp2 != &tmp) delete tmp2_p;
+    delete tmp_p;
+    delete Ap_p;
+    delete pp;
+    delete r_p;
+
+    profile.Stop(QUDA_PROFILE_FREE);
+
+    return;
+  }
+
+} // namespace quda
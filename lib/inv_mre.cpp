@@ -12,8 +12,8 @@ namespace quda {
 
   }
 
-  void MinResExt::operator()(cudaColorSpinorField &x, cudaColorSpinorField &b, 
-			     cudaColorSpinorField **p, cudaColorSpinorField **q, int N) {
+  void MinResExt::operator()(ColorSpinorField &x, ColorSpinorField &b, 
+			     ColorSpinorField **p, ColorSpinorField **q, int N, bool orthonormal) {
 
     /*
       We want to find the best initial guess of the solution of
@@ -29,7 +29,7 @@ namespace quda {
     
     // if no guess is required, then set initial guess = 0
     if (N == 0) {
-      zeroCuda(x);
+      blas::zero(x);
       return;
     }
 
@@ -43,27 +43,33 @@ namespace quda {
     Complex *alpha = new Complex[N];
     Complex *beta = new Complex[N];
 
-    // Orthonormalise the vector basis
-    for (int i=0; i<N; i++) {
-      double p2 = norm2(*p[i]);
-      axCuda(1 / sqrt(p2), *p[i]);
-      for (int j=i+1; j<N; j++) {
-	Complex xp = cDotProductCuda(*p[i], *p[j]);
-	caxpyCuda(-xp, *p[i], *p[j]);
+    // Orthonormalise the vector basis (classical Gram-Schmidt with
+    // block dots and updates, applied twice since the previous
+    // solutions are close to collinear)
+    if (!orthonormal) {
+      for (int i=0; i<N; i++) {
+	for (int pass=0; pass<2 && i>0; pass++) {
+	  blas::cDotProduct(alpha, p, *p[i], i);
+	  for (int j=0; j<i; j++) alpha[j] = -alpha[j];
+	  blas::caxpy(alpha, p, *p[i], i);
+	}
+	double p2 = norm2(*p[i]);
+	blas::ax(1 / sqrt(p2), *p[i]);
       }
     }
 
     // Perform sparse matrix multiplication and construct rhs
+    blas::cDotProduct(beta, p, b, N);
     for (int i=0; i<N; i++) {
-      beta[i] = cDotProductCuda(*p[i], b);
       mat(*q[i], *p[i]);
-      G[i][i] = reDotProductCuda(*q[i], *p[i]);
+      G[i][i] = blas::reDotProduct(*q[i], *p[i]);
     }
 
     // Construct the matrix
-    for (int j=0; j<N; j++) {
-      for (int k=j+1; k<N; k++) {
-	G[j][k] = cDotProductCuda(*p[j], *q[k]);
+    for (int k=1; k<N; k++) {
+      blas::cDotProduct(alpha, p, *q[k], k);
+      for (int j=0; j<k; j++) {
+	G[j][k] = alpha[j];
 	G[k][j] = conj(G[j][k]);
       }
     }
@@ -88,16 +94,18 @@ namespace quda {
     }
 
     // Use Gaussian Elimination to solve equations and calculate initial guess
-    zeroCuda(x);
     for (int i=N-1; i>=0; i--) {
       alpha[i] = 0.0;
       for (int j=i+1; j<N; j++) alpha[i] += G[i][j] * alpha[j];
       alpha[i] = (beta[i]-alpha[i])/G[i][i];
-      caxpyCuda(alpha[i], *p[i], x);
-      caxpyCuda(-alpha[i], *q[i], b);
       //printfQuda("%d %e %e\n", i, real(alpha[i]), imag(alpha[i]));
     }
 
+    blas::zero(x);
+    blas::caxpy(alpha, p, x, N);
+    for (int i=0; i<N; i++) beta[i] = -alpha[i];
+    blas::caxpy(beta, q, b, N);
+
     double rsd = sqrt(norm2(b) / b2 );
     printfQuda("MinResExt: N = %d, |res| / |src| = %e\n", N, rsd);
     
@@ -108,4 +116,147 @@ namespace quda {
     delete [] beta;
   }
 
+  ChronoHistory::ChronoHistory(const int max_dim) :
+    p(0), R(0), size(0), max_dim(max_dim)
+  {
+    p = new ColorSpinorField*[max_dim];
+    R = new Complex[max_dim*max_dim];
+  }
+
+  ChronoHistory::~ChronoHistory() {
+    for (int i=0; i<size; i++) delete p[i];
+    delete []p;
+    delete []R;
+  }
+
+  size_t ChronoHistory::Bytes() const {
+    size_t bytes = 0;
+    for (int i=0; i<size; i++) bytes += p[i]->Bytes() + p[i]->NormBytes();
+    return bytes;
+  }
+
+  void ChronoHistory::guess(ColorSpinorField &x, ColorSpinorField &b, DiracMatrix &mat,
+			    TimeProfile &profile) {
+    if (size == 0) return;
+
+    ColorSpinorParam csParam(b);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField **q = new ColorSpinorField*[size];
+    for (int i=0; i<size; i++) q[i] = ColorSpinorField::Create(b, csParam);
+
+    // MinResExt overwrites the source with the residual of the guess
+    csParam.create = QUDA_COPY_FIELD_CREATE;
+    ColorSpinorField *r = ColorSpinorField::Create(b, csParam);
+
+    // the basis is kept orthonormal, and must not be modified since R refers to it
+    MinResExt mre(mat, profile);
+    mre(x, *r, p, q, size, true);
+
+    delete r;
+    for (int i=0; i<size; i++) delete q[i];
+    delete []q;
+  }
+
+  double ChronoHistory::project(Complex *coeff, ColorSpinorField &v) {
+    // project out the basis, twice to keep it orthonormal to working
+    // precision, accumulating the coefficients
+    for (int i=0; i<size; i++) coeff[i] = 0.0;
+    if (size > 0) {
+      Complex *c = new Complex[size];
+      for (int pass=0; pass<2; pass++) {
+	blas::cDotProduct(c, p, v, size);
+	for (int i=0; i<size; i++) {
+	  coeff[i] += c[i];
+	  c[i] = -c[i];
+	}
+	blas::caxpy(c, p, v, size);
+      }
+      delete []c;
+    }
+    return norm2(v);
+  }
+
+  void ChronoHistory::add(ColorSpinorField &x) {
+    if (max_dim == 0) return;
+
+    ColorSpinorParam csParam(x);
+    csParam.create = QUDA_COPY_FIELD_CREATE;
+    ColorSpinorField *v = ColorSpinorField::Create(x, csParam);
+    const double x2 = norm2(*v);
+
+    Complex *coeff = new Complex[max_dim];
+    double v2 = project(coeff, *v);
+    if (v2 <= 1e-12*x2) { // nothing new
+      delete []coeff;
+      delete v;
+      return;
+    }
+
+    if (size == max_dim) {
+      // make room, then project again since pop() rotates the basis
+      pop();
+      blas::copy(*v, x);
+      v2 = project(coeff, *v);
+    }
+
+    // the new column of R
+    for (int i=0; i<size; i++) R[i*max_dim+size] = coeff[i];
+    R[size*max_dim+size] = sqrt(v2);
+    delete []coeff;
+
+    blas::ax(1.0/sqrt(v2), *v);
+    p[size++] = v;
+  }
+
+  void ChronoHistory::pop() {
+    if (size == 0) return;
+
+    if (size > 1) {
+      // Without its first column X = P R[:,1:], where R[:,1:] is upper
+      // Hessenberg.  Givens rotations G restore the triangular form,
+      // X = (P G^dag) (G R[:,1:]), after which the last basis vector
+      // no longer contributes and is dropped.
+      ColorSpinorParam csParam(*p[0]);
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      ColorSpinorField *t = ColorSpinorField::Create(*p[0], csParam);
+
+      for (int j=0; j<size-1; j++) {
+	const Complex a = R[j*max_dim+j+1];
+	const Complex b = R[(j+1)*max_dim+j+1];
+	const double n = sqrt(norm(a) + norm(b));
+	if (n == 0.0) continue;
+	double c;
+	Complex s;
+	if (abs(a) == 0.0) {
+	  c = 0.0;
+	  s = 1.0;
+	} else {
+	  c = abs(a) / n;
+	  s = (a / abs(a)) * conj(b) / n;
+	}
+
+	for (int k=j+1; k<size; k++) {
+	  const Complex rj = R[j*max_dim+k];
+	  const Complex rj1 = R[(j+1)*max_dim+k];
+	  R[j*max_dim+k] = c*rj + s*rj1;
+	  R[(j+1)*max_dim+k] = -conj(s)*rj + c*rj1;
+	}
+
+	blas::copy(*t, *p[j]);
+	blas::ax(c, *p[j]);
+	blas::caxpy(conj(s), *p[j+1], *p[j]);
+	blas::ax(c, *p[j+1]);
+	blas::caxpy(-s, *t, *p[j+1]);
+      }
+
+      delete t;
+
+      for (int i=0; i<size-1; i++)
+	for (int k=0; k<size-1; k++) R[i*max_dim+k] = R[i*max_dim+k+1];
+    }
+
+    delete p[size-1];
+    size--;
+  }
+
 } // namespace quda
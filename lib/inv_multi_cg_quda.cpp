@@ -18,6 +18,14 @@
  *
  * The lowest offset is in offsets[0]
  *
+ * Each shift is retired from the update loop as soon as its iterated
+ * residual meets its own tol_offset, and its search direction is
+ * freed.  The unshifted system (offset[0]) drives the recurrences and
+ * is updated until every shift has converged.  The shifted updates
+ * are carried out in the sloppy precision; when this is half
+ * precision reliable updates are always enabled, so that the
+ * solutions are accumulated in the full precision.
+ *
  */
 
 namespace quda {
@@ -33,17 +41,19 @@ namespace quda {
   }
 
   /**
-     Compute the new values of alpha and zeta
+     Compute the new values of alpha and zeta for the active shifts
    */
   void updateAlphaZeta(double *alpha, double *zeta, double *zeta_old, 
 		       const double *r2, const double *beta, const double pAp, 
-		       const double *offset, const int nShift, const int j_low) {
+		       const double *offset, const int nShift, const int j_low,
+		       const bool *active) {
     double alpha_old[QUDA_MAX_MULTI_SHIFT];
     for (int j=0; j<nShift; j++) alpha_old[j] = alpha[j];
 
     alpha[0] = r2[0] / pAp;        
     zeta[0] = 1.0;
     for (int j=1; j<nShift; j++) {
+      if (!active[j]) continue;
       double c0 = zeta[j] * zeta_old[j] * alpha_old[j_low];
       double c1 = alpha[j_low] * beta[j_low] * (zeta_old[j]-zeta[j]);
       double c2 = zeta_old[j] * alpha_old[j_low] * (1.0+(offset[j]-offset[0])*alpha[j_low]);
@@ -54,7 +64,7 @@ namespace quda {
     }	
   }
 
-  void MultiShiftCG::operator()(cudaColorSpinorField **x, cudaColorSpinorField &b)
+  void MultiShiftCG::operator()(ColorSpinorField **x, ColorSpinorField &b)
   {
     profile.Start(QUDA_PROFILE_INIT);
 
@@ -63,7 +73,7 @@ namespace quda {
  
     if (num_offset == 0) return;
 
-    const double b2 = normCuda(b);
+    const double b2 = norm2(b);
     // Check to see that we're not trying to invert on a zero-field source
     if(b2 == 0){
       profile.Stop(QUDA_PROFILE_INIT);
@@ -83,58 +93,65 @@ namespace quda {
     double *beta = new double[num_offset];
   
     int j_low = 0;   
-    int num_offset_now = num_offset;
+    bool active[QUDA_MAX_MULTI_SHIFT]; // whether each shift is still being updated
+    int num_active = num_offset;
     for (int i=0; i<num_offset; i++) {
       zeta[i] = zeta_old[i] = 1.0;
       beta[i] = 0.0;
       alpha[i] = 1.0;
+      active[i] = true;
     }
   
-    // flag whether we will be using reliable updates or not
-    bool reliable = false;
+    // flag whether we will be using reliable updates or not (half
+    // precision cannot accumulate the solutions by itself)
+    bool reliable = (param.precision_sloppy == QUDA_HALF_PRECISION);
     for (int j=0; j<num_offset; j++) 
       if (param.tol_offset[j] < param.delta) reliable = true;
 
-    cudaColorSpinorField *r = new cudaColorSpinorField(b);
-    cudaColorSpinorField *r_sloppy;
-    cudaColorSpinorField **x_sloppy = new cudaColorSpinorField*[num_offset];
-    cudaColorSpinorField **y = reliable ? new cudaColorSpinorField*[num_offset] : NULL;
-  
     ColorSpinorParam csParam(b);
+    csParam.create = QUDA_COPY_FIELD_CREATE;
+
+    ColorSpinorField *r = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField *r_sloppy;
+    ColorSpinorField **x_sloppy = new ColorSpinorField*[num_offset];
+    ColorSpinorField **y = reliable ? new ColorSpinorField*[num_offset] : NULL;
+  
     csParam.create = QUDA_ZERO_FIELD_CREATE;
 
     if (reliable)
-      for (int i=0; i<num_offset; i++) y[i] = new cudaColorSpinorField(*r, csParam);
+      for (int i=0; i<num_offset; i++) y[i] = ColorSpinorField::Create(*r, csParam);
 
     csParam.setPrecision(param.precision_sloppy);
   
     if (param.precision_sloppy == x[0]->Precision()) {
       for (int i=0; i<num_offset; i++){
 	x_sloppy[i] = x[i];
-	zeroCuda(*x_sloppy[i]);
+	blas::zero(*x_sloppy[i]);
       }
       r_sloppy = r;
     } else {
       for (int i=0; i<num_offset; i++)
-	x_sloppy[i] = new cudaColorSpinorField(*x[i], csParam);
+	x_sloppy[i] = ColorSpinorField::Create(*x[i], csParam);
       csParam.create = QUDA_COPY_FIELD_CREATE;
-      r_sloppy = new cudaColorSpinorField(*r, csParam);
+      r_sloppy = ColorSpinorField::Create(*r, csParam);
     }
   
-    cudaColorSpinorField **p = new cudaColorSpinorField*[num_offset];  
-    for (int i=0; i<num_offset; i++) p[i]= new cudaColorSpinorField(*r_sloppy);    
+    csParam.create = QUDA_COPY_FIELD_CREATE;
+    ColorSpinorField **p = new ColorSpinorField*[num_offset];  
+    for (int i=0; i<num_offset; i++) p[i]= ColorSpinorField::Create(*r_sloppy, csParam);    
   
     csParam.create = QUDA_ZERO_FIELD_CREATE;
-    cudaColorSpinorField* Ap = new cudaColorSpinorField(*r_sloppy, csParam);
+    ColorSpinorField* Ap = ColorSpinorField::Create(*r_sloppy, csParam);
   
-    cudaColorSpinorField tmp1(*Ap, csParam);
-    cudaColorSpinorField *tmp2_p = &tmp1;
+    ColorSpinorField *tmp1_p = ColorSpinorField::Create(*Ap, csParam);
+    ColorSpinorField &tmp1 = *tmp1_p;
+    ColorSpinorField *tmp2_p = tmp1_p;
     // tmp only needed for multi-gpu Wilson-like kernels
     if (mat.Type() != typeid(DiracStaggeredPC).name() && 
 	mat.Type() != typeid(DiracStaggered).name()) {
-      tmp2_p = new cudaColorSpinorField(*Ap, csParam);
+      tmp2_p = ColorSpinorField::Create(*Ap, csParam);
     }
-    cudaColorSpinorField &tmp2 = *tmp2_p;
+    ColorSpinorField &tmp2 = *tmp2_p;
 
     profile.Stop(QUDA_PROFILE_INIT);
     profile.Start(QUDA_PROFILE_PREAMBLE);
@@ -172,28 +189,29 @@ namespace quda {
     if (getVerbosity() >= QUDA_VERBOSE) 
       printfQuda("MultiShift CG: %d iterations, <r,r> = %e, |r|/|b| = %e\n", k, r2[0], sqrt(r2[0]/b2));
     
-    while (r2[0] > stop[0] &&  k < param.maxiter) {
+    while (num_active > 0 &&  k < param.maxiter) {
       matSloppy(*Ap, *p[0], tmp1, tmp2);
       // FIXME - this should be curried into the Dirac operator
-      if (r->Nspin()==4) axpyCuda(offset[0], *p[0], *Ap); 
+      if (r->Nspin()==4) blas::axpy(offset[0], *p[0], *Ap); 
 
-      pAp = reDotProductCuda(*p[0], *Ap);
+      pAp = blas::reDotProduct(*p[0], *Ap);
 
       // compute zeta and alpha
-      updateAlphaZeta(alpha, zeta, zeta_old, r2, beta, pAp, offset, num_offset_now, j_low);
+      updateAlphaZeta(alpha, zeta, zeta_old, r2, beta, pAp, offset, num_offset, j_low, active);
 	
       r2_old = r2[0];
-      Complex cg_norm = axpyCGNormCuda(-alpha[j_low], *Ap, *r_sloppy);
+      Complex cg_norm = blas::axpyCGNorm(-alpha[j_low], *Ap, *r_sloppy);
       r2[0] = real(cg_norm);
       double zn = imag(cg_norm);
 
       // reliable update conditions
       rNorm[0] = sqrt(r2[0]);
-      for (int j=1; j<num_offset_now; j++) rNorm[j] = rNorm[0] * zeta[j];
+      for (int j=1; j<num_offset; j++) if (active[j]) rNorm[j] = rNorm[0] * zeta[j];
 
       int updateX=0, updateR=0;
       int reliable_shift = -1; // this is the shift that sets the reliable_shift
-      for (int j=num_offset_now-1; j>=0; j--) {
+      for (int j=num_offset-1; j>=0; j--) {
+	if (j > 0 && !active[j]) continue;
 	if (rNorm[j] > maxrx[j]) maxrx[j] = rNorm[j];
 	if (rNorm[j] > maxrr[j]) maxrr[j] = rNorm[j];
 	updateX = (rNorm[j] < delta*r0Norm[j] && r0Norm[j] <= maxrx[j]) ? 1 : updateX;
@@ -205,28 +223,30 @@ namespace quda {
 	//beta[0] = r2[0] / r2_old;	
 	beta[0] = zn / r2_old;
 	// update p[0] and x[0]
-	axpyZpbxCuda(alpha[0], *p[0], *x_sloppy[0], *r_sloppy, beta[0]);	
+	blas::axpyZpbx(alpha[0], *p[0], *x_sloppy[0], *r_sloppy, beta[0]);	
 
-	for (int j=1; j<num_offset_now; j++) {
+	for (int j=1; j<num_offset; j++) {
+	  if (!active[j]) continue;
 	  beta[j] = beta[j_low] * zeta[j] * alpha[j] / (zeta_old[j] * alpha[j_low]);
 	  // update p[i] and x[i]
-	  axpyBzpcxCuda(alpha[j], *p[j], *x_sloppy[j], zeta[j], *r_sloppy, beta[j]);
+	  blas::axpyBzpcx(alpha[j], *p[j], *x_sloppy[j], zeta[j], *r_sloppy, beta[j]);
 	}
       } else {
-	for (int j=0; j<num_offset_now; j++) {
-	  axpyCuda(alpha[j], *p[j], *x_sloppy[j]);
-	  copyCuda(*x[j], *x_sloppy[j]);
-	  xpyCuda(*x[j], *y[j]);
+	for (int j=0; j<num_offset; j++) {
+	  if (j > 0 && !active[j]) continue;
+	  blas::axpy(alpha[j], *p[j], *x_sloppy[j]);
+	  blas::copy(*x[j], *x_sloppy[j]);
+	  blas::xpy(*x[j], *y[j]);
 	}
 
 	mat(*r, *y[0], *x[0]); // here we can use x as tmp
-	if (r->Nspin()==4) axpyCuda(offset[0], *y[0], *r);
+	if (r->Nspin()==4) blas::axpy(offset[0], *y[0], *r);
 
-	r2[0] = xmyNormCuda(b, *r);
-	for (int j=1; j<num_offset_now; j++) r2[j] = zeta[j] * zeta[j] * r2[0];
-	for (int j=0; j<num_offset_now; j++) zeroCuda(*x_sloppy[j]);
+	r2[0] = blas::xmyNorm(b, *r);
+	for (int j=1; j<num_offset; j++) if (active[j]) r2[j] = zeta[j] * zeta[j] * r2[0];
+	for (int j=0; j<num_offset; j++) if (j == 0 || active[j]) blas::zero(*x_sloppy[j]);
 
-	copyCuda(*r_sloppy, *r);            
+	blas::copy(*r_sloppy, *r);            
 
 	// break-out check if we have reached the limit of the precision
 	if (sqrt(r2[reliable_shift]) > r0Norm[reliable_shift]) { // reuse r0Norm for this
@@ -239,10 +259,11 @@ namespace quda {
 
 	// update beta and p
 	beta[0] = r2[0] / r2_old; 
-	xpayCuda(*r_sloppy, beta[0], *p[0]);
-	for (int j=1; j<num_offset_now; j++) {
+	blas::xpay(*r_sloppy, beta[0], *p[0]);
+	for (int j=1; j<num_offset; j++) {
+	  if (!active[j]) continue;
 	  beta[j] = beta[j_low] * zeta[j] * alpha[j] / (zeta_old[j] * alpha[j_low]);
-	  axpbyCuda(zeta[j], *r_sloppy, beta[j], *p[j]);
+	  blas::axpby(zeta[j], *r_sloppy, beta[j], *p[j]);
 	}    
 
 	// update reliable update parameters for the system that triggered the update
@@ -254,13 +275,20 @@ namespace quda {
 	rUpdate++;
       }    
 
-      // now we can check if any of the shifts have converged and remove them
-      for (int j=1; j<num_offset_now; j++) {
-	r2[j] = zeta[j] * zeta[j] * r2[0];
+      // now we can check if any of the shifts have converged and retire
+      // them; the unshifted system keeps driving the recurrences
+      for (int j=0; j<num_offset; j++) {
+	if (!active[j]) continue;
+	if (j > 0) r2[j] = zeta[j] * zeta[j] * r2[0];
 	if (r2[j] < stop[j]) {
 	  if (getVerbosity() >= QUDA_VERBOSE)
 	    printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
-	  num_offset_now--;
+	  active[j] = false;
+	  num_active--;
+	  if (j > 0) {
+	    delete p[j];
+	    p[j] = NULL;
+	  }
 	}
       }
 
@@ -272,8 +300,8 @@ namespace quda {
     
     
     for (int i=0; i<num_offset; i++) {
-      copyCuda(*x[i], *x_sloppy[i]);
-      if (reliable) xpyCuda(*y[i], *x[i]);
+      blas::copy(*x[i], *x_sloppy[i]);
+      if (reliable) blas::xpy(*y[i], *x[i]);
     }
 
     profile.Stop(QUDA_PROFILE_COMPUTE);
@@ -290,14 +318,14 @@ namespace quda {
     for(int i=0; i < num_offset; i++) { 
       mat(*r, *x[i]); 
       if (r->Nspin()==4) {
-	axpyCuda(offset[i], *x[i], *r); // Offset it.
+	blas::axpy(offset[i], *x[i], *r); // Offset it.
       } else if (i!=0) {
-	axpyCuda(offset[i]-offset[0], *x[i], *r); // Offset it.
+	blas::axpy(offset[i]-offset[0], *x[i], *r); // Offset it.
       }
-      double true_res = xmyNormCuda(b, *r);
+      double true_res = blas::xmyNorm(b, *r);
       param.true_res_offset[i] = sqrt(true_res/b2);
 #if (__COMPUTE_CAPABILITY__ >= 200)
-      param.true_res_hq_offset[i] = sqrt(HeavyQuarkResidualNormCuda(*x[i], *r).z);
+      param.true_res_hq_offset[i] = sqrt(blas::HeavyQuarkResidualNorm(*x[i], *r).z);
 #else
       param.true_res_hq_offset[i] = 0.0;
 #endif   
@@ -320,9 +348,10 @@ namespace quda {
     profile.Start(QUDA_PROFILE_FREE);
 
     if (&tmp2 != &tmp1) delete tmp2_p;
+    delete tmp1_p;
 
     delete r;
-    for (int i=0; i<num_offset; i++) delete p[i];
+    for (int i=0; i<num_offset; i++) delete p[i]; // retired directions are already freed
     delete []p;
 
     if (reliable) {
@@ -0,0 +1,257 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+#include <face_quda.h>
+
+/*!
+ * Pipelined CG (P. Ghysels and W. Vanroose, Parallel Computing 40,
+ * 224 (2014)).  Standard CG has two global reductions per iteration
+ * that each stall the whole machine.  Here the recurrences are
+ * rearranged so that (r,r) and (w,r) (with w = A r) are computed by a
+ * single fused local reduction, whose global sum is started
+ * nonblocking and completed only after q = A w has been applied.
+ *
+ * The extra recurrences for w, s = A p and z = A s accumulate
+ * rounding errors, so (as with the reliable updates in CG) the
+ * iterated residual is periodically replaced by the true residual,
+ * b - A x, computed in the outer precision.
+ */
+
+namespace quda {
+
+  PipelinedCG::PipelinedCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param,
+			   TimeProfile &profile) :
+    Solver(param, profile), mat(mat), matSloppy(matSloppy)
+  {
+
+  }
+
+  PipelinedCG::~PipelinedCG() {
+
+  }
+
+  void PipelinedCG::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    profile.Start(QUDA_PROFILE_INIT);
+
+    // Check to see that we're not trying to invert on a zero-field source
+    const double b2 = norm2(b);
+    if(b2 == 0){
+      profile.Stop(QUDA_PROFILE_INIT);
+      printfQuda("Warning: inverting on zero-field source\n");
+      x=b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      return;
+    }
+
+    ColorSpinorParam csParam(x);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField *r_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField *y_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField &r = *r_p;
+    ColorSpinorField &y = *y_p;
+
+    // y accumulates the solution at each residual replacement
+    blas::copy(y, x);
+    mat(r, y, x);
+    double r2 = blas::xmyNorm(b, r);
+
+    csParam.setPrecision(param.precision_sloppy);
+    ColorSpinorField *x_sloppy = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *w_p = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *q_p = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *z_p = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *s_p = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *pp = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *tmp_p = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField &xSloppy = *x_sloppy;
+    ColorSpinorField &w = *w_p;
+    ColorSpinorField &q = *q_p;
+    ColorSpinorField &z = *z_p;
+    ColorSpinorField &s = *s_p;
+    ColorSpinorField &p = *pp;
+    ColorSpinorField &tmp = *tmp_p;
+
+    ColorSpinorField *tmp2_p = tmp_p;
+    // tmp only needed for multi-gpu Wilson-like kernels
+    if (mat.Type() != typeid(DiracStaggeredPC).name() &&
+	mat.Type() != typeid(DiracStaggered).name()) {
+      tmp2_p = ColorSpinorField::Create(x, csParam);
+    }
+    ColorSpinorField &tmp2 = *tmp2_p;
+
+    ColorSpinorField *r_sloppy;
+    if (param.precision_sloppy == x.Precision()) {
+      r_sloppy = &r;
+    } else {
+      csParam.create = QUDA_COPY_FIELD_CREATE;
+      r_sloppy = ColorSpinorField::Create(r, csParam);
+    }
+    ColorSpinorField &rSloppy = *r_sloppy;
+
+    profile.Stop(QUDA_PROFILE_INIT);
+    profile.Start(QUDA_PROFILE_PREAMBLE);
+
+    const bool use_heavy_quark_res =
+      (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) ? true : false;
+    double heavy_quark_res = 0.0;
+    if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(y,r).z);
+
+    double stop = b2*param.tol*param.tol; // stopping condition of solver
+    double delta = param.delta;
+
+    double alpha = 0.0, beta = 0.0;
+    double gamma = r2, gamma_old = r2;
+    bool restart = true; // the first iteration after a (re)start has beta = 0
+    int rUpdate = 0;
+
+    double r0Norm = sqrt(r2);
+    int resIncrease = 0;
+    int maxResIncrease = 0; // 0 means we have no tolerance
+
+    profile.Stop(QUDA_PROFILE_PREAMBLE);
+    profile.Start(QUDA_PROFILE_COMPUTE);
+    blas_flops = 0;
+
+    int k=0;
+
+    PrintStats("PipelinedCG", k, r2, b2, heavy_quark_res);
+
+    matSloppy(w, rSloppy, tmp, tmp2);
+
+    while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && k < param.maxiter) {
+
+      // fused local reduction of (r,r) and (w,r), summed while q = A w is applied
+      bool reduceState = globalReduce;
+      globalReduce = false;
+      double3 rw = blas::cDotProductNormA(rSloppy, w);
+      globalReduce = reduceState;
+      double sum[2] = { rw.z, rw.x };
+      reduceDoubleArrayStart(sum, 2);
+
+      matSloppy(q, w, tmp, tmp2);
+
+      reduceDoubleArrayWait();
+      gamma = sum[0];
+      double wr = sum[1];
+      r2 = gamma;
+
+      if (restart) {
+	beta = 0.0;
+	alpha = gamma / wr;
+	restart = false;
+      } else {
+	beta = gamma / gamma_old;
+	alpha = gamma / (wr - beta * gamma / alpha);
+      }
+      gamma_old = gamma;
+
+      blas::xpay(q, beta, z);         // z = q + beta z = A s
+      blas::xpay(w, beta, s);         // s = w + beta s = A p
+      blas::xpay(rSloppy, beta, p);   // p = r + beta p
+      blas::axpy(alpha, p, xSloppy);  // x = x + alpha p
+      blas::axpy(-alpha, s, rSloppy); // r = r - alpha s
+      blas::axpy(-alpha, z, w);       // w = w - alpha z = A r
+
+      k++;
+
+      // the iterated residual norm lags one iteration behind
+      double rNorm = sqrt(r2);
+      bool converged = convergence(r2, heavy_quark_res, stop, param.tol_hq);
+
+      if (rNorm < delta*r0Norm || converged) {
+	// replace the iterated residual with the true residual and restart the recurrences
+	blas::copy(x, xSloppy);
+	blas::xpy(x, y);
+	mat(r, y, x); // here we can use x as tmp
+	r2 = blas::xmyNorm(b, r);
+	if (x.Precision() != rSloppy.Precision()) blas::copy(rSloppy, r);
+	blas::zero(xSloppy);
+
+	if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(y,r).z);
+
+	// break-out check if we have reached the limit of the precision
+	if (sqrt(r2) > r0Norm && converged) {
+	  warningQuda("PipelinedCG: new true residual norm %e is greater than previous true residual norm %e",
+		      sqrt(r2), r0Norm);
+	  rUpdate++;
+	  if (++resIncrease > maxResIncrease) break;
+	} else {
+	  resIncrease = 0;
+	}
+
+	r0Norm = sqrt(r2);
+	rUpdate++;
+
+	matSloppy(w, rSloppy, tmp, tmp2);
+	restart = true;
+      }
+
+      PrintStats("PipelinedCG", k, r2, b2, heavy_quark_res);
+    }
+
+    blas::copy(x, xSloppy);
+    blas::xpy(y, x);
+
+    profile.Stop(QUDA_PROFILE_COMPUTE);
+    profile.Start(QUDA_PROFILE_EPILOGUE);
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (quda::blas_flops + mat.flops() + matSloppy.flops())*1e-9;
+    reduceDouble(gflops);
+    param.gflops = gflops;
+    param.iter += k;
+
+    if (k==param.maxiter)
+      warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("PipelinedCG: Residual replacements = %d\n", rUpdate);
+
+    // compute the true residuals
+    mat(r, x, y);
+    param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
+#if (__COMPUTE_CAPABILITY__ >= 200)
+    param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x,r).z);
+#else
+    param.true_res_hq = 0.0;
+#endif
+
+    PrintSummary("PipelinedCG", k, r2, b2);
+
+    // reset the flops counters
+    quda::blas_flops = 0;
+    mat.flops();
+    matSloppy.flops();
+
+    profile.Stop(QUDA_PROFILE_EPILOGUE);
+    profile.Start(QUDA_PROFILE_FREE);
+
+    if (&tmp2 != &tmp) delete tmp2_p;
+    if (&rSloppy != &r) delete r_sloppy;
+
+    delete tmp_p;
+    delete pp;
+    delete s_p;
+    delete z_p;
+    delete q_p;
+    delete w_p;
+    delete x_sloppy;
+    delete y_p;
+    delete r_p;
+
+    profile.Stop(QUDA_PROFILE_FREE);
+
+    return;
+  }
+
+} // namespace quda
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+#include <face_quda.h>
+
+/*!
+ * Communication-avoiding s-step CG (A. T. Chronopoulos and
+ * C. W. Gear, J. Comput. Appl. Math. 25, 153 (1989); E. Carson and
+ * J. Demmel, SIAM J. Matrix Anal. Appl. 35, 22 (2014)).
+ *
+ * At the start of each outer iteration the 2s+1 basis vectors
+ *
+ *   V = [p, Ap, ..., A^s p, r, Ar, ..., A^(s-1) r]
+ *
+ * are built with 2s-1 operator applications and their Gram matrix
+ * G = Re V^dag V is formed with one global reduction.  The next s CG
+ * steps are then carried out on coordinate vectors in this basis,
+ * where the operator acts as the shift matrix T and every inner
+ * product is a small dense product with G, so no further global sums
+ * are required until the basis is rebuilt.
+ *
+ * Since A is Hermitian and the CG scalars are real, the coordinates
+ * are real and only the real part of V^dag V is needed.
+ */
+
+namespace quda {
+
+  SStepCG::SStepCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param,
+		   TimeProfile &profile) :
+    Solver(param, profile), mat(mat), matSloppy(matSloppy)
+  {
+
+  }
+
+  SStepCG::~SStepCG() {
+
+  }
+
+  // returns u^T G v for the n x n Gram matrix G
+  static double gramDot(const std::vector<double> &G, const std::vector<double> &u,
+			const std::vector<double> &v, const int n) {
+    double sum = 0.0;
+    for (int i=0; i<n; i++) {
+      if (u[i] == 0.0) continue;
+      double Gv = 0.0;
+      for (int j=0; j<n; j++) Gv += G[i*n+j] * v[j];
+      sum += u[i] * Gv;
+    }
+    return sum;
+  }
+
+  // applies the operator in basis coordinates: shifts the p and r blocks up by one
+  static void shift(std::vector<double> &Tv, const std::vector<double> &v, const int s) {
+    std::fill(Tv.begin(), Tv.end(), 0.0);
+    for (int i=0; i<s; i++) Tv[i+1] = v[i];
+    for (int i=0; i<s-1; i++) Tv[s+2+i] = v[s+1+i];
+  }
+
+  void SStepCG::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    profile.Start(QUDA_PROFILE_INIT);
+
+    const int s = param.s_step;
+    if (s < 1) errorQuda("Invalid s-step size %d", s);
+    const int n = 2*s+1; // size of the basis
+
+    // Check to see that we're not trying to invert on a zero-field source
+    const double b2 = norm2(b);
+    if(b2 == 0){
+      profile.Stop(QUDA_PROFILE_INIT);
+      printfQuda("Warning: inverting on zero-field source\n");
+      x=b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      return;
+    }
+
+    ColorSpinorParam csParam(x);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField *r_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField *y_p = ColorSpinorField::Create(b, csParam);
+    ColorSpinorField &r = *r_p;
+    ColorSpinorField &y = *y_p;
+
+    // y accumulates the solution at each residual replacement
+    blas::copy(y, x);
+    mat(r, y, x);
+    double r2 = blas::xmyNorm(b, r);
+
+    csParam.setPrecision(param.precision_sloppy);
+    ColorSpinorField **V = new ColorSpinorField*[n];
+    for (int i=0; i<n; i++) V[i] = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *x_sloppy = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *p_new = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *r_new = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField *tmp_p = ColorSpinorField::Create(x, csParam);
+    ColorSpinorField &xSloppy = *x_sloppy;
+    ColorSpinorField &tmp = *tmp_p;
+
+    ColorSpinorField *tmp2_p = tmp_p;
+    // tmp only needed for multi-gpu Wilson-like kernels
+    if (mat.Type() != typeid(DiracStaggeredPC).name() &&
+	mat.Type() != typeid(DiracStaggered).name()) {
+      tmp2_p = ColorSpinorField::Create(x, csParam);
+    }
+    ColorSpinorField &tmp2 = *tmp2_p;
+
+    // V[0] holds p and V[s+1] holds r
+    blas::copy(*V[s+1], r);
+    blas::copy(*V[0], *V[s+1]);
+
+    profile.Stop(QUDA_PROFILE_INIT);
+    profile.Start(QUDA_PROFILE_PREAMBLE);
+
+    const bool use_heavy_quark_res =
+      (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) ? true : false;
+    double heavy_quark_res = 0.0;
+    if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(y,r).z);
+
+    double stop = b2*param.tol*param.tol; // stopping condition of solver
+    double delta = param.delta;
+
+    std::vector<double> G(n*n), g(n*(n+1)/2);
+    std::vector<double> xc(n), rc(n), pc(n), Tp(n);
+    Complex *cdot = new Complex[n];
+    Complex *coeff = new Complex[n];
+
+    double r0Norm = sqrt(r2);
+    int rUpdate = 0;
+    int resIncrease = 0;
+    int maxResIncrease = 0; // 0 means we have no tolerance
+
+    profile.Stop(QUDA_PROFILE_PREAMBLE);
+    profile.Start(QUDA_PROFILE_COMPUTE);
+    blas_flops = 0;
+
+    int k=0;
+
+    PrintStats("SStepCG", k, r2, b2, heavy_quark_res);
+
+    while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && k < param.maxiter) {
+
+      // matrix powers
+      for (int i=0; i<s; i++) matSloppy(*V[i+1], *V[i], tmp, tmp2);
+      for (int i=0; i<s-1; i++) matSloppy(*V[s+2+i], *V[s+1+i], tmp, tmp2);
+
+      // local Gram matrix (lower triangle), followed by a single global sum
+      bool reduceState = globalReduce;
+      globalReduce = false;
+      for (int j=0; j<n; j++) {
+	blas::cDotProduct(cdot, V, *V[j], j+1);
+	for (int i=0; i<=j; i++) g[j*(j+1)/2+i] = real(cdot[i]);
+      }
+      globalReduce = reduceState;
+      reduceDoubleArray(&g[0], n*(n+1)/2);
+
+      for (int j=0; j<n; j++)
+	for (int i=0; i<=j; i++) G[i*n+j] = G[j*n+i] = g[j*(j+1)/2+i];
+
+      // s CG steps in basis coordinates
+      std::fill(xc.begin(), xc.end(), 0.0);
+      std::fill(pc.begin(), pc.end(), 0.0);
+      std::fill(rc.begin(), rc.end(), 0.0);
+      pc[0] = 1.0;
+      rc[s+1] = 1.0;
+
+      double rr = gramDot(G, rc, rc, n);
+      for (int j=0; j<s && k<param.maxiter; j++) {
+	shift(Tp, pc, s);
+	double alpha = rr / gramDot(G, pc, Tp, n);
+	for (int i=0; i<n; i++) {
+	  xc[i] += alpha * pc[i];
+	  rc[i] -= alpha * Tp[i];
+	}
+
+	double rr_new = gramDot(G, rc, rc, n);
+	double beta = rr_new / rr;
+	rr = rr_new;
+	for (int i=0; i<n; i++) pc[i] = rc[i] + beta * pc[i];
+
+	k++;
+	r2 = rr;
+	PrintStats("SStepCG", k, r2, b2, heavy_quark_res);
+	if (convergence(r2, heavy_quark_res, stop, param.tol_hq)) break;
+      }
+
+      // recover x, r and p from their coordinates
+      for (int i=0; i<n; i++) coeff[i] = Complex(xc[i], 0.0);
+      blas::caxpy(coeff, V, xSloppy, n);
+
+      for (int i=0; i<n; i++) coeff[i] = Complex(rc[i], 0.0);
+      blas::zero(*r_new);
+      blas::caxpy(coeff, V, *r_new, n);
+
+      for (int i=0; i<n; i++) coeff[i] = Complex(pc[i], 0.0);
+      blas::zero(*p_new);
+      blas::caxpy(coeff, V, *p_new, n);
+
+      std::swap(V[s+1], r_new);
+      std::swap(V[0], p_new);
+
+      // a non-positive norm means the basis has lost rank
+      if (r2 <= 0.0) r2 = norm2(*V[s+1]);
+
+      double rNorm = sqrt(r2);
+      bool converged = convergence(r2, heavy_quark_res, stop, param.tol_hq);
+
+      if (rNorm < delta*r0Norm || converged) {
+	// replace the iterated residual with the true residual, keeping p
+	blas::copy(x, xSloppy);
+	blas::xpy(x, y);
+	mat(r, y, x); // here we can use x as tmp
+	r2 = blas::xmyNorm(b, r);
+	blas::copy(*V[s+1], r);
+	blas::zero(xSloppy);
+
+	if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(y,r).z);
+
+	// break-out check if we have reached the limit of the precision
+	if (sqrt(r2) > r0Norm && converged) {
+	  warningQuda("SStepCG: new true residual norm %e is greater than previous true residual norm %e",
+		      sqrt(r2), r0Norm);
+	  rUpdate++;
+	  if (++resIncrease > maxResIncrease) break;
+	} else {
+	  resIncrease = 0;
+	}
+
+	r0Norm = sqrt(r2);
+	rUpdate++;
+      }
+    }
+
+    blas::copy(x, xSloppy);
+    blas::xpy(y, x);
+
+    profile.Stop(QUDA_PROFILE_COMPUTE);
+    profile.Start(QUDA_PROFILE_EPILOGUE);
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (quda::blas_flops + mat.flops() + matSloppy.flops())*1e-9;
+    reduceDouble(gflops);
+    param.gflops = gflops;
+    param.iter += k;
+
+    if (k==param.maxiter)
+      warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("SStepCG: s = %d, residual replacements = %d\n", s, rUpdate);
+
+    // compute the true residuals
+    mat(r, x, y);
+    param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
+#if (__COMPUTE_CAPABILITY__ >= 200)
+    param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x,r).z);
+#else
+    param.true_res_hq = 0.0;
+#endif
+
+    PrintSummary("SStepCG", k, r2, b2);
+
+    // reset the flops counters
+    quda::blas_flops = 0;
+    mat.flops();
+    matSloppy.flops();
+
+    profile.Stop(QUDA_PROFILE_EPILOGUE);
+    profile.Start(QUDA_PROFILE_FREE);
+
+    delete []coeff;
+    delete []cdot;
+
+    if (&tmp2 != &tmp) delete tmp2_p;
+    delete tmp_p;
+    delete r_new;
+    delete p_new;
+    delete x_sloppy;
+    for (int i=0; i<n; i++) delete V[i];
+    delete []V;
+    delete y_p;
+    delete r_p;
+
+    profile.Stop(QUDA_PROFILE_FREE);
+
+    return;
+  }
+
+} // namespace quda
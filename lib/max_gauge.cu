@@ -37,6 +37,8 @@ namespace quda {
     // max only supported on external fields currently
     if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
       max = maxGauge<Float,Nc>(QDPOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+    } else if (u.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+      max = maxGauge<Float,Nc>(AoSoAOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
     } else if (u.Order() == QUDA_CPS_WILSON_GAUGE_ORDER) {
       max = maxGauge<Float,Nc>(CPSOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
@@ -0,0 +1,214 @@
+/**
+  Parameter struct for the multi-blas kernel, which updates the
+  single field Y using each of the nxz fields X[i] with the
+  coefficient a[i]
+*/
+template <int NXZ, typename Float2, typename SpinorX, typename SpinorY, typename Functor>
+struct MultiBlasArg {
+  SpinorX X[NXZ];
+  SpinorY Y;
+  Float2 a[NXZ];
+  Functor f;
+  const int nxz;
+  const int length;
+  MultiBlasArg(SpinorX X[], SpinorY Y, const Float2 a[], Functor f, int nxz, int length)
+  : Y(Y), f(f), nxz(nxz), length(length)
+  { for (int i=0; i<nxz; i++) { this->X[i] = X[i]; this->a[i] = a[i]; } }
+};
+
+/**
+   Generic multi-blas kernel: Y is loaded and stored once per site,
+   with all nxz updates applied in between.
+ */
+template <typename FloatN, int M, int NXZ, typename Float2, typename SpinorX, typename SpinorY, typename Functor>
+__global__ void multiBlasKernel(MultiBlasArg<NXZ,Float2,SpinorX,SpinorY,Functor> arg) {
+  unsigned int i = blockIdx.x*(blockDim.x) + threadIdx.x;
+  unsigned int gridSize = gridDim.x*blockDim.x;
+  while (i < arg.length) {
+    FloatN y[M];
+    arg.Y.load(y, i);
+
+#pragma unroll
+    for (int k=0; k<NXZ; k++) {
+      if (k < arg.nxz) {
+	FloatN x[M];
+	arg.X[k].load(x, i);
+#pragma unroll
+	for (int j=0; j<M; j++) arg.f(arg.a[k], x[j], y[j]);
+      }
+    }
+
+    arg.Y.save(y, i);
+    i += gridSize;
+  }
+}
+
+template <int NXZ, typename FloatN, int M, typename Float2, typename SpinorX, typename SpinorY, typename Functor>
+class MultiBlasCuda : public Tunable {
+
+private:
+  mutable MultiBlasArg<NXZ,Float2,SpinorX,SpinorY,Functor> arg;
+
+  // host pointers used for backing up the output field when tuning
+  char *Y_h, *Ynorm_h;
+
+  unsigned int sharedBytesPerThread() const { return 0; }
+  unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+
+  virtual bool advanceSharedBytes(TuneParam &param) const
+  {
+    TuneParam next(param);
+    advanceBlockDim(next); // to get next blockDim
+    int nthreads = next.block.x * next.block.y * next.block.z;
+    param.shared_bytes = sharedBytesPerThread()*nthreads > sharedBytesPerBlock(param) ?
+      sharedBytesPerThread()*nthreads : sharedBytesPerBlock(param);
+    return false;
+  }
+
+public:
+  MultiBlasCuda(SpinorX X[], SpinorY &Y, const Float2 a[], Functor &f, int nxz, int length) :
+  arg(X, Y, a, f, nxz, length), Y_h(0), Ynorm_h(0) { ; }
+  virtual ~MultiBlasCuda() { }
+
+  TuneKey tuneKey() const {
+    std::stringstream vol, aux;
+    vol << blasConstants.x[0] << "x";
+    vol << blasConstants.x[1] << "x";
+    vol << blasConstants.x[2] << "x";
+    vol << blasConstants.x[3];
+    aux << "stride=" << blasConstants.stride << ",prec=" << arg.Y.Precision() << ",nxz=" << arg.nxz;
+    return TuneKey(vol.str(), typeid(arg.f).name(), aux.str());
+  }
+
+  void apply(const cudaStream_t &stream) {
+    TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+    multiBlasKernel<FloatN,M> <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+  }
+
+  void preTune() {
+    size_t bytes = arg.Y.Precision()*(sizeof(FloatN)/sizeof(((FloatN*)0)->x))*M*arg.Y.Stride();
+    size_t norm_bytes = (arg.Y.Precision() == QUDA_HALF_PRECISION) ? sizeof(float)*arg.length : 0;
+    arg.Y.save(&Y_h, &Ynorm_h, bytes, norm_bytes);
+  }
+
+  void postTune() {
+    size_t bytes = arg.Y.Precision()*(sizeof(FloatN)/sizeof(((FloatN*)0)->x))*M*arg.Y.Stride();
+    size_t norm_bytes = (arg.Y.Precision() == QUDA_HALF_PRECISION) ? sizeof(float)*arg.length : 0;
+    arg.Y.load(&Y_h, &Ynorm_h, bytes, norm_bytes);
+  }
+
+  long long flops() const { return arg.f.flops()*(sizeof(FloatN)/sizeof(((FloatN*)0)->x))*arg.length*M*arg.nxz; }
+  long long bytes() const {
+    size_t bytes = arg.Y.Precision()*(sizeof(FloatN)/sizeof(((FloatN*)0)->x))*M;
+    if (arg.Y.Precision() == QUDA_HALF_PRECISION) bytes += sizeof(float);
+    return (arg.nxz+2)*bytes*arg.length; }
+};
+
+/**
+   Driver for the generic multi-blas routine, which applies the
+   functor with coefficient a[i] to x[i] and y, for i < nxz <=
+   MAX_MULTI_BLAS_N, updating y.
+ */
+template <template <typename Float2, typename FloatN> class Functor>
+void multiBlasCuda(const Complex *a, cudaColorSpinorField **x, cudaColorSpinorField &y, const int nxz) {
+  if (nxz > MAX_MULTI_BLAS_N) errorQuda("Set size %d greater than maximum %d", nxz, MAX_MULTI_BLAS_N);
+
+  if (y.SiteSubset() == QUDA_FULL_SITE_SUBSET) {
+    cudaColorSpinorField *xe[MAX_MULTI_BLAS_N], *xo[MAX_MULTI_BLAS_N];
+    for (int i=0; i<nxz; i++) { xe[i] = &x[i]->Even(); xo[i] = &x[i]->Odd(); }
+    multiBlasCuda<Functor>(a, xe, y.Even(), nxz);
+    multiBlasCuda<Functor>(a, xo, y.Odd(), nxz);
+    return;
+  }
+
+  for (int i=0; i<nxz; i++) checkSpinor((*x[i]), y);
+
+  if (!y.isNative()) {
+    warningQuda("Blas on non-native fields is not supported\n");
+    return;
+  }
+
+  for (int d=0; d<QUDA_MAX_DIM; d++) blasConstants.x[d] = y.X()[d];
+  blasConstants.stride = y.Stride();
+
+  double2 a2[MAX_MULTI_BLAS_N];
+  float2 a2f[MAX_MULTI_BLAS_N];
+  for (int i=0; i<nxz; i++) {
+    a2[i] = make_double2(REAL(a[i]), IMAG(a[i]));
+    a2f[i] = make_float2(REAL(a[i]), IMAG(a[i]));
+  }
+
+  if (y.Precision() == QUDA_DOUBLE_PRECISION) {
+    const int M = 1;
+    Spinor<double2,double2,double2,M,0> X[MAX_MULTI_BLAS_N];
+    for (int i=0; i<nxz; i++) X[i] = Spinor<double2,double2,double2,M,0>(*x[i]);
+    Spinor<double2,double2,double2,M,1,0> Y(y);
+    Functor<double2, double2> f;
+    MultiBlasCuda<MAX_MULTI_BLAS_N,double2,M,double2,
+      Spinor<double2,double2,double2,M,0>, Spinor<double2,double2,double2,M,1,0>, Functor<double2, double2> >
+      blas(X, Y, a2, f, nxz, y.Length()/(2*M));
+    blas.apply(*blasStream);
+  } else if (y.Precision() == QUDA_SINGLE_PRECISION) {
+    const int M = 1;
+    if (y.Nspin() == 4) {
+#if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC)
+      Spinor<float4,float4,float4,M,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float4,float4,float4,M,0>(*x[i]);
+      Spinor<float4,float4,float4,M,1,0> Y(y);
+      Functor<float2, float4> f;
+      MultiBlasCuda<MAX_MULTI_BLAS_N,float4,M,float2,
+	Spinor<float4,float4,float4,M,0>, Spinor<float4,float4,float4,M,1,0>, Functor<float2, float4> >
+	blas(X, Y, a2f, f, nxz, y.Length()/(4*M));
+      blas.apply(*blasStream);
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else {
+#ifdef GPU_STAGGERED_DIRAC
+      Spinor<float2,float2,float2,M,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float2,float2,float2,M,0>(*x[i]);
+      Spinor<float2,float2,float2,M,1,0> Y(y);
+      Functor<float2, float2> f;
+      MultiBlasCuda<MAX_MULTI_BLAS_N,float2,M,float2,
+	Spinor<float2,float2,float2,M,0>, Spinor<float2,float2,float2,M,1,0>, Functor<float2, float2> >
+	blas(X, Y, a2f, f, nxz, y.Length()/(2*M));
+      blas.apply(*blasStream);
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    }
+  } else {
+    if (y.Nspin() == 4){ //wilson
+#if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC)
+      Spinor<float4,float4,short4,6,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float4,float4,short4,6,0>(*x[i]);
+      Spinor<float4,float4,short4,6,1,0> Y(y);
+      Functor<float2, float4> f;
+      MultiBlasCuda<MAX_MULTI_BLAS_N,float4,6,float2,
+	Spinor<float4,float4,short4,6,0>, Spinor<float4,float4,short4,6,1,0>, Functor<float2, float4> >
+	blas(X, Y, a2f, f, nxz, y.Volume());
+      blas.apply(*blasStream);
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else if (y.Nspin() == 1) {//staggered
+#ifdef GPU_STAGGERED_DIRAC
+      Spinor<float2,float2,short2,3,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float2,float2,short2,3,0>(*x[i]);
+      Spinor<float2,float2,short2,3,1,0> Y(y);
+      Functor<float2, float2> f;
+      MultiBlasCuda<MAX_MULTI_BLAS_N,float2,3,float2,
+	Spinor<float2,float2,short2,3,0>, Spinor<float2,float2,short2,3,1,0>, Functor<float2, float2> >
+	blas(X, Y, a2f, f, nxz, y.Volume());
+      blas.apply(*blasStream);
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else { errorQuda("ERROR: nSpin=%d is not supported\n", y.Nspin()); }
+    blas_bytes += (nxz+2)*(unsigned long long)y.Volume()*sizeof(float);
+  }
+  blas_bytes += (nxz+2)*(unsigned long long)y.RealLength()*y.Precision();
+  blas_flops += Functor<double2,double2>::flops()*nxz*(unsigned long long)y.RealLength();
+
+  checkCudaError();
+}
@@ -0,0 +1,250 @@
+/**
+   Parameter struct for the multi-reduction kernel, which reduces
+   each of the nxz fields X[i] against the single field Y.  Each
+   reduction is complex (double2) valued, with the block partial
+   sums written to partial[i*gridDim.x + blockIdx.x].
+*/
+template <int NXZ, typename SpinorX, typename SpinorY, typename Reducer>
+struct MultiReduceArg {
+  SpinorX X[NXZ];
+  SpinorY Y;
+  Reducer r;
+  double2 *partial;
+  const int nxz;
+  const int length;
+  MultiReduceArg(SpinorX X[], SpinorY Y, Reducer r, double2 *partial, int nxz, int length)
+  : Y(Y), r(r), partial(partial), nxz(nxz), length(length)
+  { for (int i=0; i<nxz; i++) this->X[i] = X[i]; }
+};
+
+/**
+   Generic multi-reduction kernel: Y is loaded once per site and
+   reduced against each of the X fields, so the nxz reductions cost
+   a single pass over Y.
+ */
+template <typename FloatN, int M, int NXZ, typename SpinorX, typename SpinorY, typename Reducer>
+__global__ void multiReduceKernel(MultiReduceArg<NXZ,SpinorX,SpinorY,Reducer> arg) {
+  unsigned int tid = threadIdx.x;
+  unsigned int i = blockIdx.x*(blockDim.x) + threadIdx.x;
+  unsigned int gridSize = gridDim.x*blockDim.x;
+
+  double2 sum[NXZ];
+#pragma unroll
+  for (int k=0; k<NXZ; k++) zero(sum[k]);
+
+  while (i < arg.length) {
+    FloatN y[M];
+    arg.Y.load(y, i);
+
+#pragma unroll
+    for (int k=0; k<NXZ; k++) {
+      if (k < arg.nxz) {
+	FloatN x[M];
+	arg.X[k].load(x, i);
+#pragma unroll
+	for (int j=0; j<M; j++) arg.r(sum[k], x[j], y[j]);
+      }
+    }
+
+    i += gridSize;
+  }
+
+  // reduce each sum over the thread block in turn
+  extern __shared__ double sdata[];
+#pragma unroll
+  for (int k=0; k<NXZ; k++) {
+    if (k < arg.nxz) {
+      sdata[tid] = sum[k].x;
+      sdata[tid + blockDim.x] = sum[k].y;
+      __syncthreads();
+
+      // the block size need not be a power of two
+      for (unsigned int s = blockDim.x; s > 1; ) {
+	unsigned int half = (s + 1) / 2;
+	if (tid + half < s) {
+	  sdata[tid] += sdata[tid + half];
+	  sdata[tid + blockDim.x] += sdata[tid + half + blockDim.x];
+	}
+	__syncthreads();
+	s = half;
+      }
+
+      if (tid == 0) arg.partial[k*gridDim.x + blockIdx.x] = make_double2(sdata[0], sdata[blockDim.x]);
+      __syncthreads();
+    }
+  }
+
+}
+
+template <int NXZ, typename FloatN, int M, typename SpinorX, typename SpinorY, typename Reducer>
+class MultiReduceCuda : public Tunable {
+
+private:
+  mutable MultiReduceArg<NXZ,SpinorX,SpinorY,Reducer> arg;
+  Complex *result;
+
+  unsigned int sharedBytesPerThread() const { return 2*sizeof(double); }
+  unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+
+  virtual bool advanceSharedBytes(TuneParam &param) const
+  {
+    TuneParam next(param);
+    advanceBlockDim(next); // to get next blockDim
+    int nthreads = next.block.x * next.block.y * next.block.z;
+    param.shared_bytes = sharedBytesPerThread()*nthreads > sharedBytesPerBlock(param) ?
+      sharedBytesPerThread()*nthreads : sharedBytesPerBlock(param);
+    return false;
+  }
+
+public:
+  MultiReduceCuda(Complex *result, SpinorX X[], SpinorY &Y, Reducer &r, int nxz, int length) :
+  arg(X, Y, r, (double2*)hd_reduce, nxz, length), result(result) { ; }
+  virtual ~MultiReduceCuda() { }
+
+  TuneKey tuneKey() const {
+    std::stringstream vol, aux;
+    vol << blasConstants.x[0] << "x";
+    vol << blasConstants.x[1] << "x";
+    vol << blasConstants.x[2] << "x";
+    vol << blasConstants.x[3];
+    aux << "stride=" << blasConstants.stride << ",prec=" << arg.Y.Precision() << ",nxz=" << arg.nxz;
+    return TuneKey(vol.str(), typeid(arg.r).name(), aux.str());
+  }
+
+  void apply(const cudaStream_t &stream) {
+    TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+    if (tp.grid.x*arg.nxz > REDUCE_MAX_BLOCKS)
+      errorQuda("Grid size %d too large for %d reductions", tp.grid.x, arg.nxz);
+
+    multiReduceKernel<FloatN,M> <<< tp.grid, tp.block, tp.shared_bytes, stream >>>(arg);
+
+#if (defined(_MSC_VER) && defined(_WIN64)) || defined(__LP64__)
+    if(deviceProp.canMapHostMemory) {
+      cudaEventRecord(reduceEnd, stream);
+      while (cudaSuccess != cudaEventQuery(reduceEnd)) { ; }
+    } else
+#endif
+      { cudaMemcpy(h_reduce, hd_reduce, arg.nxz*tp.grid.x*sizeof(double2), cudaMemcpyDeviceToHost); }
+
+    // finish the reduction over the thread blocks on the host
+    const double2 *partial = (double2*)h_reduce;
+    for (int k=0; k<arg.nxz; k++) {
+      double2 sum = make_double2(0.0, 0.0);
+      for (unsigned int b=0; b<tp.grid.x; b++) sum += partial[k*tp.grid.x + b];
+      result[k] = Complex(sum.x, sum.y);
+    }
+  }
+
+  long long flops() const { return arg.r.flops()*(sizeof(FloatN)/sizeof(((FloatN*)0)->x))*arg.length*M*arg.nxz; }
+  long long bytes() const {
+    size_t bytes = arg.Y.Precision()*(sizeof(FloatN)/sizeof(((FloatN*)0)->x))*M;
+    if (arg.Y.Precision() == QUDA_HALF_PRECISION) bytes += sizeof(float);
+    return (arg.nxz+1)*bytes*arg.length; }
+};
+
+/**
+   Driver for the generic multi-reduction routine: result[i] is the
+   reduction of x[i] against y, for i < nxz <= MAX_MULTI_BLAS_N.
+   The reductions are complex valued, and are summed over all ranks.
+ */
+template <template <typename Float2, typename FloatN> class Reducer>
+void multiReduceCuda(Complex *result, cudaColorSpinorField **x, cudaColorSpinorField &y, const int nxz) {
+  if (nxz > MAX_MULTI_BLAS_N) errorQuda("Set size %d greater than maximum %d", nxz, MAX_MULTI_BLAS_N);
+
+  if (y.SiteSubset() == QUDA_FULL_SITE_SUBSET) {
+    cudaColorSpinorField *xe[MAX_MULTI_BLAS_N], *xo[MAX_MULTI_BLAS_N];
+    for (int i=0; i<nxz; i++) { xe[i] = &x[i]->Even(); xo[i] = &x[i]->Odd(); }
+    Complex even[MAX_MULTI_BLAS_N], odd[MAX_MULTI_BLAS_N];
+    multiReduceCuda<Reducer>(even, xe, y.Even(), nxz);
+    multiReduceCuda<Reducer>(odd, xo, y.Odd(), nxz);
+    for (int i=0; i<nxz; i++) result[i] = even[i] + odd[i];
+    return;
+  }
+
+  for (int i=0; i<nxz; i++) checkSpinor((*x[i]), y);
+
+  if (!y.isNative()) {
+    warningQuda("Reductions on non-native fields is not supported\n");
+    for (int i=0; i<nxz; i++) result[i] = 0.0;
+    return;
+  }
+
+  for (int d=0; d<QUDA_MAX_DIM; d++) blasConstants.x[d] = y.X()[d];
+  blasConstants.stride = y.Stride();
+
+  if (y.Precision() == QUDA_DOUBLE_PRECISION) {
+    const int M = 1;
+    Spinor<double2,double2,double2,M,0> X[MAX_MULTI_BLAS_N];
+    for (int i=0; i<nxz; i++) X[i] = Spinor<double2,double2,double2,M,0>(*x[i]);
+    Spinor<double2,double2,double2,M,0,0> Y(y);
+    Reducer<double2, double2> r;
+    MultiReduceCuda<MAX_MULTI_BLAS_N,double2,M,
+      Spinor<double2,double2,double2,M,0>, Spinor<double2,double2,double2,M,0,0>, Reducer<double2, double2> >
+      reduce(result, X, Y, r, nxz, y.Length()/(2*M));
+    reduce.apply(*getBlasStream());
+  } else if (y.Precision() == QUDA_SINGLE_PRECISION) {
+    const int M = 1;
+    if (y.Nspin() == 4) {
+#if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC)
+      Spinor<float4,float4,float4,M,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float4,float4,float4,M,0>(*x[i]);
+      Spinor<float4,float4,float4,M,0,0> Y(y);
+      Reducer<float2, float4> r;
+      MultiReduceCuda<MAX_MULTI_BLAS_N,float4,M,
+	Spinor<float4,float4,float4,M,0>, Spinor<float4,float4,float4,M,0,0>, Reducer<float2, float4> >
+	reduce(result, X, Y, r, nxz, y.Length()/(4*M));
+      reduce.apply(*getBlasStream());
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else if (y.Nspin() == 1) {
+#ifdef GPU_STAGGERED_DIRAC
+      Spinor<float2,float2,float2,M,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float2,float2,float2,M,0>(*x[i]);
+      Spinor<float2,float2,float2,M,0,0> Y(y);
+      Reducer<float2, float2> r;
+      MultiReduceCuda<MAX_MULTI_BLAS_N,float2,M,
+	Spinor<float2,float2,float2,M,0>, Spinor<float2,float2,float2,M,0,0>, Reducer<float2, float2> >
+	reduce(result, X, Y, r, nxz, y.Length()/(2*M));
+      reduce.apply(*getBlasStream());
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else { errorQuda("ERROR: nSpin=%d is not supported\n", y.Nspin()); }
+  } else {
+    if (y.Nspin() == 4){ //wilson
+#if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC)
+      Spinor<float4,float4,short4,6,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float4,float4,short4,6,0>(*x[i]);
+      Spinor<float4,float4,short4,6,0,0> Y(y);
+      Reducer<float2, float4> r;
+      MultiReduceCuda<MAX_MULTI_BLAS_N,float4,6,
+	Spinor<float4,float4,short4,6,0>, Spinor<float4,float4,short4,6,0,0>, Reducer<float2, float4> >
+	reduce(result, X, Y, r, nxz, y.Volume());
+      reduce.apply(*getBlasStream());
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else if (y.Nspin() == 1) {//staggered
+#ifdef GPU_STAGGERED_DIRAC
+      Spinor<float2,float2,short2,3,0> X[MAX_MULTI_BLAS_N];
+      for (int i=0; i<nxz; i++) X[i] = Spinor<float2,float2,short2,3,0>(*x[i]);
+      Spinor<float2,float2,short2,3,0,0> Y(y);
+      Reducer<float2, float2> r;
+      MultiReduceCuda<MAX_MULTI_BLAS_N,float2,3,
+	Spinor<float2,float2,short2,3,0>, Spinor<float2,float2,short2,3,0,0>, Reducer<float2, float2> >
+	reduce(result, X, Y, r, nxz, y.Volume());
+      reduce.apply(*getBlasStream());
+#else
+      errorQuda("blas has not been built for Nspin=%d fields", y.Nspin());
+#endif
+    } else { errorQuda("ERROR: nSpin=%d is not supported\n", y.Nspin()); }
+    blas_bytes += (nxz+1)*(unsigned long long)y.Volume()*sizeof(float);
+  }
+  blas_bytes += (nxz+1)*(unsigned long long)y.RealLength()*y.Precision();
+  blas_flops += Reducer<double2,double2>::flops()*nxz*(unsigned long long)y.RealLength();
+
+  reduceDoubleArray((double*)result, 2*nxz);
+
+  checkCudaError();
+}
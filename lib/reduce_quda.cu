@@ -330,6 +330,38 @@ namespace quda {
     return Complex(cdot.x, cdot.y);
   }
 
+#if (__COMPUTE_CAPABILITY__ >= 200)
+
+  namespace reduce {
+#include <multi_reduce_core.h>
+  } // namespace reduce
+
+  /**
+     Returns the complex-valued dot product of x and y, with x
+     running over a set of fields (see multiReduceCuda)
+  */
+  template <typename Float2, typename FloatN>
+  struct multiCdot {
+    __device__ void operator()(double2 &sum, const FloatN &x, const FloatN &y) { sum += cdot_(x,y); }
+    static int flops() { return 4; } //! flops per element
+  };
+
+  void cDotProductCuda(Complex *result, cudaColorSpinorField **x, cudaColorSpinorField &y, const int N) {
+    for (int i=0; i<N; i+=MAX_MULTI_BLAS_N) {
+      const int n = (N-i < MAX_MULTI_BLAS_N) ? N-i : MAX_MULTI_BLAS_N;
+      reduce::multiReduceCuda<multiCdot>(result+i, x+i, y, n);
+    }
+  }
+
+#else
+
+  // the kernel arguments of the block reduction exceed the Tesla limit
+  void cDotProductCuda(Complex *result, cudaColorSpinorField **x, cudaColorSpinorField &y, const int N) {
+    for (int i=0; i<N; i++) result[i] = cDotProductCuda(*x[i], y);
+  }
+
+#endif
+
   /**
      double2 xpaycDotzyCuda(float2 *x, float a, float2 *y, float2 *z, int n) {}
    
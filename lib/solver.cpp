@@ -1,6 +1,8 @@
 #include <quda_internal.h>
 #include <invert_quda.h>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 namespace quda {
 
@@ -31,6 +33,23 @@ namespace quda {
       report("MR");
       solver = new MR(mat, param, profile);
       break;
+    case QUDA_PIPELINED_CG_INVERTER:
+      report("PipelinedCG");
+      solver = new PipelinedCG(mat, matSloppy, param, profile);
+      break;
+    case QUDA_SSTEP_CG_INVERTER:
+      report("SStepCG");
+      solver = new SStepCG(mat, matSloppy, param, profile);
+      break;
+    case QUDA_BLOCK_CG_INVERTER:
+      report("BlockCG");
+      solver = new BlockCG(mat, param, profile);
+      break;
+    case QUDA_EIGCG_INVERTER:
+      report("EigCG");
+      if (!param.deflation) errorQuda("EigCG requires a deflation space (and a normal-operator solve_type)");
+      solver = new EigCG(mat, param, profile);
+      break;
     default:
       errorQuda("Invalid solver type");
     }
@@ -80,4 +99,86 @@ namespace quda {
     }
   }
 
+  bool cholesky(Complex *A, const int n) {
+    for (int j=0; j<n; j++) {
+      double d = real(A[j*n+j]);
+      for (int l=0; l<j; l++) d -= norm(A[j*n+l]);
+      if (d <= 0.0) return false;
+      d = sqrt(d);
+      A[j*n+j] = d;
+      for (int i=j+1; i<n; i++) {
+	Complex s = A[i*n+j];
+	for (int l=0; l<j; l++) s -= A[i*n+l] * conj(A[j*n+l]);
+	A[i*n+j] = s / d;
+      }
+    }
+    return true;
+  }
+
+  void choleskySolve(const Complex *L, const int n, Complex *B, const int m) {
+    for (int c=0; c<m; c++) {
+      for (int i=0; i<n; i++) {
+	Complex s = B[i*m+c];
+	for (int l=0; l<i; l++) s -= L[i*n+l] * B[l*m+c];
+	B[i*m+c] = s / real(L[i*n+i]);
+      }
+      for (int i=n-1; i>=0; i--) {
+	Complex s = B[i*m+c];
+	for (int l=i+1; l<n; l++) s -= conj(L[l*n+i]) * B[l*m+c];
+	B[i*m+c] = s / real(L[i*n+i]);
+      }
+    }
+  }
+
+  void symmetricEigensolve(double *eval, double *evec, const double *A, const int n) {
+    std::vector<double> a(A, A+n*n);
+    for (int i=0; i<n; i++)
+      for (int j=0; j<n; j++) evec[i*n+j] = (i == j) ? 1.0 : 0.0;
+
+    // cyclic Jacobi sweeps until the off-diagonal part is negligible
+    for (int sweep=0; sweep<100; sweep++) {
+      double off = 0.0, diag = 0.0;
+      for (int i=0; i<n; i++) {
+	diag += a[i*n+i]*a[i*n+i];
+	for (int j=i+1; j<n; j++) off += a[i*n+j]*a[i*n+j];
+      }
+      if (off <= 1e-30*diag) break;
+
+      for (int p=0; p<n; p++) {
+	for (int q=p+1; q<n; q++) {
+	  if (a[p*n+q] == 0.0) continue;
+	  double theta = (a[q*n+q] - a[p*n+p]) / (2.0*a[p*n+q]);
+	  double t = (theta >= 0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta*theta + 1.0));
+	  double c = 1.0 / sqrt(t*t + 1.0);
+	  double s = t*c;
+	  for (int k=0; k<n; k++) {
+	    double akp = a[k*n+p], akq = a[k*n+q];
+	    a[k*n+p] = c*akp - s*akq;
+	    a[k*n+q] = s*akp + c*akq;
+	  }
+	  for (int k=0; k<n; k++) {
+	    double apk = a[p*n+k], aqk = a[q*n+k];
+	    a[p*n+k] = c*apk - s*aqk;
+	    a[q*n+k] = s*apk + c*aqk;
+	  }
+	  for (int k=0; k<n; k++) {
+	    double vkp = evec[k*n+p], vkq = evec[k*n+q];
+	    evec[k*n+p] = c*vkp - s*vkq;
+	    evec[k*n+q] = s*vkp + c*vkq;
+	  }
+	}
+      }
+    }
+
+    // sort into ascending order
+    for (int i=0; i<n; i++) eval[i] = a[i*n+i];
+    for (int i=0; i<n; i++) {
+      int min = i;
+      for (int j=i+1; j<n; j++) if (eval[j] < eval[min]) min = j;
+      if (min == i) continue;
+      std::swap(eval[i], eval[min]);
+      for (int k=0; k<n; k++) std::swap(evec[k*n+i], evec[k*n+min]);
+    }
+  }
+
 } // namespace quda
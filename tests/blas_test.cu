@@ -1,12 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <quda_internal.h>
 #include <color_spinor_field.h>
 #include <blas_quda.h>
+#include <blas_expr.h>
 
 #include <test_util.h>
 #include <face_quda.h>
+#include <comm_quda.h>
 
 // include because of nasty globals used in the tests
 #include <dslash_util.h>
@@ -27,13 +30,18 @@ extern bool tune;
 extern void usage(char** );
 
 #if (__COMPUTE_CAPABILITY__ >= 200)
-const int Nkernels = 32;
-#else // exclude Heavy Quark Norm if on Tesla architecture
+const int Nkernels = 35;
+#else // exclude Heavy Quark Norm and the block kernels if on Tesla architecture
 const int Nkernels = 31;
 #endif
 
 using namespace quda;
 
+// roofline mode: benchmark each kernel over a sweep of volumes and
+// precisions on the device and the host, relative to STREAM triad
+bool roofline = false;
+const char *json_file = "blas_roofline.json";
+
 cpuColorSpinorField *xH, *yH, *zH, *wH, *vH, *hH, *lH;
 cudaColorSpinorField *xD, *yD, *zD, *wD, *vD, *hD, *lD;
 int Nspin;
@@ -329,6 +337,24 @@ double benchmark(int kernel, const int niter) {
       HeavyQuarkResidualNormCuda(*xD, *yD);
       break;
 
+    // block kernels
+    case 32:
+      { cudaColorSpinorField *set[] = {xD, yD, zD, wD};
+	quda::Complex d[4];
+	cDotProductCuda(d, set, *vD, 4); }
+      break;
+
+    case 33:
+      { cudaColorSpinorField *set[] = {xD, zD, wD, vD};
+	quda::Complex coeff[] = {a2, b2, c2, a2};
+	caxpyCuda(coeff, set, *yD, 4); }
+      break;
+
+    case 34:
+      axpyZpbxCuda(a, *xD, *yD, *zD, b);
+      norm2(*xD);
+      break;
+
     default:
       errorQuda("Undefined blas kernel %d\n", kernel);
     }
@@ -622,6 +648,51 @@ double test(int kernel) {
 	fabs(d.y - h.y) / fabs(h.y) + fabs(d.z - h.z) / fabs(h.z); }
     break;
 
+  case 32:
+    *xD = *xH;
+    *yD = *yH;
+    *zD = *zH;
+    *wD = *wH;
+    *vD = *vH;
+    { cudaColorSpinorField *setD[] = {xD, yD, zD, wD};
+      cpuColorSpinorField *setH[] = {xH, yH, zH, wH};
+      quda::Complex d[4];
+      cDotProductCuda(d, setD, *vD, 4);
+      for (int i=0; i<4; i++) {
+	quda::Complex h = cDotProductCpu(*setH[i], *vH);
+	error += abs(d[i] - h) / abs(h);
+      } }
+    break;
+
+  case 33:
+    *xD = *xH;
+    *yD = *yH;
+    *zD = *zH;
+    *wD = *wH;
+    *vD = *vH;
+    { cudaColorSpinorField *setD[] = {xD, zD, wD, vD};
+      cpuColorSpinorField *setH[] = {xH, zH, wH, vH};
+      quda::Complex coeff[] = {a2, b2, c2, a2};
+      caxpyCuda(coeff, setD, *yD, 4);
+      for (int i=0; i<4; i++) caxpyCpu(coeff[i], *setH[i], *yH);
+      error = ERROR(y); }
+    break;
+
+  case 34: // check the fused host blas against the hand-fused device kernel
+    *xD = *xH;
+    *yD = *yH;
+    *zD = *zH;
+    { axpyZpbxCuda(a, *xD, *yD, *zD, b);
+      double d = norm2(*xD), h;
+      FusedBlas fused;
+      expr::Field X(*xH), Y(*yH), Z(*zH);
+      fused.assign(*yH, Y + a*X);
+      fused.assign(*xH, Z + b*X);
+      fused.norm2(h, X);
+      fused.flush();
+      error = ERROR(x) + ERROR(y) + fabs(d - h) / h; }
+    break;
+
   default:
     errorQuda("Undefined blas kernel %d\n", kernel);
   }
@@ -629,12 +700,408 @@ double test(int kernel) {
   return error;
 }
 
+/**
+   Host counterpart of benchmark(), applying the host BLAS to the host
+   fields, which must first be converted to the benchmark precision
+   (see setHostPrecision).  Returns the time in seconds.
+*/
+double benchmarkCpu(int kernel, const int niter) {
+
+  // moderate coefficients, so that repeated updates neither overflow
+  // nor run into denormals
+  double a = 0.5, b = 0.25, c = 0.125;
+  quda::Complex a2(0.5, 0.25), b2(-0.25, 0.5), c2(0.125, -0.5);
+
+  quda::Timer timer;
+  timer.Start();
+
+  for (int i=0; i < niter; ++i) {
+
+    switch (kernel) {
+
+    case 0:
+      yH->copy(*hH);
+      break;
+
+    case 1:
+      yH->copy(*lH);
+      break;
+      
+    case 2:
+      axpbyCpu(a, *xH, b, *yH);
+      break;
+
+    case 3:
+      xpyCpu(*xH, *yH);
+      break;
+
+    case 4:
+      axpyCpu(a, *xH, *yH);
+      break;
+
+    case 5:
+      xpayCpu(*xH, a, *yH);
+      break;
+
+    case 6:
+      mxpyCpu(*xH, *yH);
+      break;
+
+    case 7:
+      axCpu(a, *xH);
+      break;
+
+    case 8:
+      caxpyCpu(a2, *xH, *yH);
+      break;
+
+    case 9:
+      caxpbyCpu(a2, *xH, b2, *yH);
+      break;
+
+    case 10:
+      cxpaypbzCpu(*xH, a2, *yH, b2, *zH);
+      break;
+
+    case 11:
+      axpyBzpcxCpu(a, *xH, *yH, b, *zH, c);
+      break;
+
+    case 12:
+      axpyZpbxCpu(a, *xH, *yH, *zH, b);
+      break;
+
+    case 13:
+      caxpbypzYmbwCpu(a2, *xH, b2, *yH, *zH, *wH);
+      break;
+      
+    case 14:
+      cabxpyAxCpu(a, b2, *xH, *yH);
+      break;
+
+    case 15:
+      caxpbypzCpu(a2, *xH, b2, *yH, *zH);
+      break;
+
+    case 16:
+      caxpbypczpwCpu(a2, *xH, b2, *yH, c2, *zH, *wH);
+      break;
+
+    case 17:
+      caxpyXmazCpu(a2, *xH, *yH, *zH);
+      break;
+
+      // double
+    case 18:
+      normCpu(*xH);
+      break;
+
+    case 19:
+      reDotProductCpu(*xH, *yH);
+      break;
+
+    case 20:
+      axpyNormCpu(a, *xH, *yH);
+      break;
+
+    case 21:
+      xmyNormCpu(*xH, *yH);
+      break;
+      
+    case 22:
+      caxpyNormCpu(a2, *xH, *yH);
+      break;
+
+    case 23:
+      caxpyXmazNormXCpu(a2, *xH, *yH, *zH);
+      break;
+
+    case 24:
+      cabxpyAxNormCpu(a, b2, *xH, *yH);
+      break;
+
+    // double2
+    case 25:
+      cDotProductCpu(*xH, *yH);
+      break;
+
+    case 26:
+      xpaycDotzyCpu(*xH, a, *yH, *zH);
+      break;
+      
+    case 27:
+      caxpyDotzyCpu(a2, *xH, *yH, *zH);
+      break;
+
+    // double3
+    case 28:
+      cDotProductNormACpu(*xH, *yH);
+      break;
+
+    case 29:
+      cDotProductNormBCpu(*xH, *yH);
+      break;
+
+    case 30:
+      caxpbypzYmbwcDotProductUYNormYCpu(a2, *xH, b2, *yH, *zH, *wH, *vH);
+      break;
+
+    case 31:
+      HeavyQuarkResidualNormCpu(*xH, *yH);
+      break;
+
+    // block kernels, which the host applies one field at a time
+    case 32:
+      { cpuColorSpinorField *set[] = {xH, yH, zH, wH};
+	for (int j=0; j<4; j++) cDotProductCpu(*set[j], *vH); }
+      break;
+
+    case 33:
+      { cpuColorSpinorField *set[] = {xH, zH, wH, vH};
+	quda::Complex coeff[] = {a2, b2, c2, a2};
+	for (int j=0; j<4; j++) caxpyCpu(coeff[j], *set[j], *yH); }
+      break;
+
+    case 34:
+      { double h;
+	FusedBlas fused;
+	expr::Field X(*xH), Y(*yH), Z(*zH);
+	fused.assign(*yH, Y + a*X);
+	fused.assign(*xH, Z + b*X);
+	fused.norm2(h, X);
+	fused.flush(); }
+      break;
+
+    default:
+      errorQuda("Undefined blas kernel %d\n", kernel);
+    }
+  }
+
+  timer.Stop();
+  return timer.Last();
+}
+
+/**
+   Convert the host fields to the precision of the device fields for
+   the given benchmark precision, as done by initFields for the
+   device, so that the host moves the same data as the device.
+*/
+void setHostPrecision(int prec)
+{
+  const QudaPrecision precision[] = { QUDA_HALF_PRECISION, QUDA_SINGLE_PRECISION, QUDA_DOUBLE_PRECISION };
+  const QudaPrecision high_aux_prec = prec == 2 ? QUDA_SINGLE_PRECISION : QUDA_DOUBLE_PRECISION;
+  const QudaPrecision low_aux_prec = prec == 0 ? QUDA_SINGLE_PRECISION : QUDA_HALF_PRECISION;
+
+  cpuColorSpinorField **field[] = { &vH, &wH, &xH, &yH, &zH, &hH, &lH };
+  for (int i=0; i<7; i++) {
+    ColorSpinorParam param(**field[i]);
+    param.precision = (i == 5) ? high_aux_prec : (i == 6) ? low_aux_prec : precision[prec];
+    param.create = QUDA_NULL_FIELD_CREATE;
+    cpuColorSpinorField *f = new cpuColorSpinorField(param);
+    *f = **field[i];
+    delete *field[i];
+    *field[i] = f;
+  }
+}
+
+__global__ void triadKernel(double *a, const double *b, const double *c, const double s, const int n) {
+  int i = blockIdx.x*blockDim.x + threadIdx.x;
+  const int gridSize = gridDim.x*blockDim.x;
+  for (; i<n; i += gridSize) a[i] = b[i] + s*c[i];
+}
+
+/**
+   Measure the device STREAM triad bandwidth a = b + s*c, counting
+   three streams per element as STREAM does, and taking the best of
+   the repetitions.  Returns GB/s.
+*/
+double deviceTriad() {
+  const int n = 1 << 24;
+  const int nRep = 20;
+  double *a = (double*)device_malloc(n*sizeof(double));
+  double *b = (double*)device_malloc(n*sizeof(double));
+  double *c = (double*)device_malloc(n*sizeof(double));
+  cudaMemset(b, 0, n*sizeof(double));
+  cudaMemset(c, 0, n*sizeof(double));
+
+  cudaEvent_t start, end;
+  cudaEventCreate(&start);
+  cudaEventCreate(&end);
+
+  const int block = 256;
+  const int grid = deviceProp.multiProcessorCount * 8;
+  float best = 0.0;
+  for (int rep=0; rep<=nRep; rep++) {
+    cudaEventRecord(start, 0);
+    triadKernel<<<grid, block>>>(a, b, c, 3.0, n);
+    cudaEventRecord(end, 0);
+    cudaEventSynchronize(end);
+    float ms;
+    cudaEventElapsedTime(&ms, start, end);
+    if (rep > 0 && (best == 0.0 || ms < best)) best = ms; // skip the warm up
+  }
+
+  cudaEventDestroy(start);
+  cudaEventDestroy(end);
+  device_free(a);
+  device_free(b);
+  device_free(c);
+  checkCudaError();
+
+  return 3.0*n*sizeof(double) / (best*1e-3) / 1e9;
+}
+
+/**
+   Measure the host STREAM triad bandwidth using the (threaded) fused
+   host blas, z = x + s*y, on fields of the given parameters in double
+   precision.  Returns GB/s.
+*/
+double hostTriad(ColorSpinorParam param) {
+  const int nRep = 10;
+  param.precision = QUDA_DOUBLE_PRECISION;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  cpuColorSpinorField x(param), y(param), z(param);
+  expr::Field X(x), Y(y);
+
+  double best = 0.0;
+  for (int rep=0; rep<=nRep; rep++) {
+    quda::Timer timer;
+    timer.Start();
+    FusedBlas triad;
+    triad.assign(z, X + 3.0*Y);
+    triad.flush();
+    timer.Stop();
+    if (rep > 0 && (best == 0.0 || timer.Last() < best)) best = timer.Last(); // skip the warm up
+  }
+
+  return 3.0*x.Length()*sizeof(double) / best / 1e9;
+}
+
+/**
+   Roofline mode: for each local volume L^4 of the sweep and each
+   precision, time every kernel on the device and its counterpart on
+   the host.  Bytes and flops per call are those the device drivers
+   account in blas_bytes and blas_flops, which the host kernels are
+   charged too, so both report the bandwidth achieved in moving the
+   data each kernel needs.  These are printed as a fraction of the
+   STREAM triad bandwidth of each backend, and written as JSON to
+   json_file.
+*/
+void runRoofline(char **names, const int Nprec)
+{
+  const char *prec_str[] = {"half", "single", "double"};
+  const int sweep[] = {8, 12, 16, 24, 32};
+  const int nVol = sizeof(sweep)/sizeof(sweep[0]);
+
+  setTuning(tune ? QUDA_TUNE_YES : QUDA_TUNE_NO);
+  setVerbosity(QUDA_SILENT);
+
+  double gpuPeak = deviceTriad();
+  double cpuPeak;
+  {
+    ColorSpinorParam param;
+    param.nColor = 3;
+    param.nSpin = (dslash_type == QUDA_ASQTAD_DSLASH) ? 1 : 4;
+    param.nDim = 4;
+    param.pad = 0;
+    param.siteSubset = QUDA_PARITY_SITE_SUBSET;
+    param.x[0] = sweep[nVol-1]/2;
+    for (int d=1; d<4; d++) param.x[d] = sweep[nVol-1];
+    param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+    param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+    cpuPeak = hostTriad(param);
+  }
+  printfQuda("\nSTREAM triad: device %.1f GB/s, host %.1f GB/s\n", gpuPeak, cpuPeak);
+
+  FILE *json = (comm_rank() == 0) ? fopen(json_file, "w") : 0;
+  if (comm_rank() == 0 && !json) errorQuda("Unable to open %s", json_file);
+  if (json) {
+    fprintf(json, "{\n  \"ranks\": %d,\n  \"niter\": %d,\n", comm_size(), niter);
+    fprintf(json, "  \"stream_triad_gbytes\": { \"gpu\": %.3f, \"cpu\": %.3f },\n", gpuPeak, cpuPeak);
+    fprintf(json, "  \"results\": [");
+  }
+  bool first = true;
+
+  for (int v = 0; v < nVol; v++) {
+    xdim = ydim = zdim = tdim = sweep[v];
+
+    for (int prec = 0; prec < Nprec; prec++) {
+      initFields(prec);
+
+      double bytes[Nkernels], flops[Nkernels], secs[2][Nkernels];
+      for (int kernel = 0; kernel < Nkernels; kernel++) {
+	// only benchmark "high precision" copyCuda() if double is supported
+	if ((Nprec < 3) && (kernel == 0)) continue;
+	benchmark(kernel, 1); // tune and warm up
+	quda::blas_flops = 0;
+	quda::blas_bytes = 0;
+	secs[0][kernel] = benchmark(kernel, niter);
+	bytes[kernel] = (double)quda::blas_bytes / niter;
+	flops[kernel] = (double)quda::blas_flops / niter;
+      }
+
+      setHostPrecision(prec);
+      for (int kernel = 0; kernel < Nkernels; kernel++) {
+	if ((Nprec < 3) && (kernel == 0)) continue;
+	benchmarkCpu(kernel, 1); // warm up
+	secs[1][kernel] = benchmarkCpu(kernel, niter);
+      }
+
+      const char *backend[] = {"gpu", "cpu"};
+      const double peak[] = {gpuPeak, cpuPeak};
+      printfQuda("\n%d^4 volume, %s precision (GB/s, fraction of STREAM triad)\n", sweep[v], prec_str[prec]);
+      for (int kernel = 0; kernel < Nkernels; kernel++) {
+	if ((Nprec < 3) && (kernel == 0)) continue;
+	printfQuda("%-31s:", names[kernel]);
+	for (int b = 0; b < 2; b++) {
+	  double gbytes = bytes[kernel]*niter / (secs[b][kernel]*1e9);
+	  double gflops = flops[kernel]*niter / (secs[b][kernel]*1e9);
+	  printfQuda(" %s %7.1f (%5.2f)", backend[b], gbytes, gbytes/peak[b]);
+	  if (json) {
+	    fprintf(json, "%s\n    { \"backend\": \"%s\", \"precision\": \"%s\", \"volume\": [%d, %d, %d, %d], "
+		    "\"kernel\": \"%s\", \"bytes\": %.0f, \"flops\": %.0f, \"seconds\": %e, "
+		    "\"gbytes\": %.3f, \"gflops\": %.3f, \"peak_fraction\": %.4f }",
+		    first ? "" : ",", backend[b], prec_str[prec], xdim, ydim, zdim, tdim, names[kernel],
+		    bytes[kernel], flops[kernel], secs[b][kernel] / niter, gbytes, gflops, gbytes/peak[b]);
+	    first = false;
+	  }
+	}
+	printfQuda("\n");
+      }
+
+      freeFields();
+    }
+  }
+
+  if (json) {
+    fprintf(json, "\n  ]\n}\n");
+    fclose(json);
+    printfQuda("\nWrote %s\n", json_file);
+  }
+}
+
 int main(int argc, char** argv)
 {
   for (int i = 1; i < argc; i++){
     if(process_command_line_option(argc, argv, &i) == 0){
       continue;
     } 
+
+    if( strcmp(argv[i], "--roofline") == 0){
+      roofline = true;
+      continue;
+    }
+
+    if( strcmp(argv[i], "--json") == 0){
+      if(i+1 >= argc){
+	usage(argv);
+      }
+      json_file = argv[i+1];
+      i++;
+      continue;
+    }
+
     printfQuda("ERROR: Invalid option:%s\n", argv[i]);
     usage(argv);
   }
@@ -676,7 +1143,10 @@ int main(int argc, char** argv)
     "cDotProductNormA",
     "cDotProductNormB",
     "caxpbypzYmbwcDotProductWYNormY",
-    "HeavyQuarkResidualNorm"
+    "HeavyQuarkResidualNorm",
+    "multi-cDotProduct",
+    "multi-caxpy",
+    "fused-axpyZpbxNorm"
   };
 
   char *prec_str[] = {"half", "single", "double"};
@@ -688,6 +1158,13 @@ int main(int argc, char** argv)
   int Nprec = 2;
 #endif
 
+  if (roofline) {
+    runRoofline(names, Nprec);
+    endQuda();
+    finalizeComms();
+    return 0;
+  }
+
   // enable the tuning
   setTuning(tune ? QUDA_TUNE_YES : QUDA_TUNE_NO);
   setVerbosity(QUDA_SILENT);
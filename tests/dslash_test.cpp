@@ -2,6 +2,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <float.h>
 
 #include <quda.h>
 #include <quda_internal.h>
@@ -35,6 +37,8 @@ QudaGaugeParam gauge_param;
 QudaInvertParam inv_param;
 
 cpuColorSpinorField *spinor, *spinorOut, *spinorRef, *spinorTmp;
+cpuColorSpinorField *hostSpinor=0, *hostSpinorOut=0; // used by the host dslash
+cpuColorSpinorField **hostBlock=0, **hostBlockOut=0; // nrhs copies of them for the block host dslash
 cudaColorSpinorField *cudaSpinor, *cudaSpinorOut, *tmp1=0, *tmp2=0;
 
 void *hostGauge[4], *hostClover, *hostCloverInv;
@@ -61,7 +65,9 @@ extern QudaPrecision prec;
 extern QudaDagType dagger;
 
 extern int niter;
+extern int nrhs;
 extern char latfile[];
+extern QudaFieldLocation compute_location;
 
 void init(int argc, char **argv) {
 
@@ -127,6 +133,13 @@ void init(int argc, char **argv) {
 
   inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
   inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.compute_location = compute_location;
+
+  if (compute_location == QUDA_CPU_FIELD_LOCATION && 
+      dslash_type != QUDA_WILSON_DSLASH && dslash_type != QUDA_DOMAIN_WALL_DSLASH &&
+      dslash_type != QUDA_TWISTED_MASS_DSLASH && dslash_type != QUDA_CLOVER_WILSON_DSLASH) {
+    errorQuda("Host dslash only supports the Wilson, clover, domain wall and twisted mass dslash");
+  }
 
 #ifndef MULTI_GPU // free parameter for single GPU
   gauge_param.ga_pad = 0;
@@ -208,7 +221,7 @@ void init(int argc, char **argv) {
   if (dslash_type == QUDA_TWISTED_MASS_DSLASH) {
     csParam.twistFlavor = inv_param.twist_flavor;
     csParam.nDim = (inv_param.twist_flavor == QUDA_TWIST_PLUS || inv_param.twist_flavor == QUDA_TWIST_MINUS) ? 4 : 5;
-    csParam.x[4] = Ls;    
+    csParam.x[4] = (csParam.nDim == 5) ? 2 : Ls; // the doublet stores its two flavors as a fifth dimension
   }
 
 
@@ -309,6 +322,28 @@ void init(int argc, char **argv) {
     diracParam.tmp2 = tmp2;
     
     dirac = Dirac::create(diracParam);
+
+    if (compute_location == QUDA_CPU_FIELD_LOCATION) {
+      // the host dslash runs in the precision of the host gauge field
+      ColorSpinorParam hostParam(*spinor);
+      hostParam.create = QUDA_NULL_FIELD_CREATE;
+      hostParam.precision = (cuda_prec == QUDA_HALF_PRECISION) ? QUDA_SINGLE_PRECISION : cuda_prec;
+      hostSpinor = new cpuColorSpinorField(hostParam);
+      hostSpinorOut = new cpuColorSpinorField(hostParam);
+      hostSpinor->copy(*spinor);
+
+      if (nrhs > 1) {
+	if (test_type != 0) errorQuda("--nrhs requires --test 0");
+	hostBlock = new cpuColorSpinorField*[nrhs];
+	hostBlockOut = new cpuColorSpinorField*[nrhs];
+	hostBlock[0] = hostSpinor;
+	hostBlockOut[0] = hostSpinorOut;
+	for (int r=1; r<nrhs; r++) {
+	  hostBlock[r] = new cpuColorSpinorField(*hostSpinor);
+	  hostBlockOut[r] = new cpuColorSpinorField(hostParam);
+	}
+      }
+    }
   } else {
     double cpu_norm = norm2(*spinor);
     printfQuda("Source: CPU = %e\n", cpu_norm);
@@ -323,6 +358,16 @@ void end() {
     delete cudaSpinorOut;
     delete tmp1;
     delete tmp2;
+    if (hostSpinor) delete hostSpinor;
+    if (hostSpinorOut) delete hostSpinorOut;
+    if (hostBlock) {
+      for (int r=1; r<nrhs; r++) {
+	delete hostBlock[r];
+	delete hostBlockOut[r];
+      }
+      delete []hostBlock;
+      delete []hostBlockOut;
+    }
   }
 
   // release memory
@@ -393,6 +438,31 @@ double dslashCUDA(int niter) {
   return secs;
 }
 
+// execute host kernel
+double dslashCPU(int niter) {
+
+  stopwatchStart();
+
+  for (int i = 0; i < niter; i++) {
+    switch (test_type) {
+    case 0:
+      if (hostBlock) dirac->Dslash(hostBlockOut, hostBlock, nrhs, parity);
+      else dirac->Dslash(*hostSpinorOut, *hostSpinor, parity);
+      break;
+    case 1:
+    case 2:
+      dirac->M(*hostSpinorOut, *hostSpinor);
+      break;
+    case 3:
+    case 4:
+      dirac->MdagM(*hostSpinorOut, *hostSpinor);
+      break;
+    }
+  }
+    
+  return stopwatchReadSeconds();
+}
+
 void dslashRef() {
 
   // compare to dslash reference implementation
@@ -558,6 +628,13 @@ void display_test_info()
 
 extern void usage(char**);
 
+template <typename Float>
+static double maxAbs(const Float *a, int len) {
+  double m = 0.0;
+  for (int i=0; i<len; i++) m = MAX(m, fabs(a[i]));
+  return m;
+}
+
 
 int main(int argc, char **argv)
 {
@@ -582,20 +659,24 @@ int main(int argc, char **argv)
   printfQuda("Gauge mem: %.3f GiB\n", gauge_param.gaugeGiB);
   
   int attempts = 1;
+  int fail = 0;
   dslashRef();
   for (int i=0; i<attempts; i++) {
 
-    if (tune) { // warm-up run
+    bool host = (!transfer && compute_location == QUDA_CPU_FIELD_LOCATION);
+
+    if (tune && !host) { // warm-up run
       printfQuda("Tuning...\n");
       setTuning(QUDA_TUNE_YES);
       dslashCUDA(1);
     }
-    printfQuda("Executing %d kernel loops...\n", niter);
+    printfQuda("Executing %d %s kernel loops...\n", niter, host ? "host" : "device");
     if (!transfer) dirac->Flops();
-    double secs = dslashCUDA(niter);
+    double secs = host ? dslashCPU(niter) : dslashCUDA(niter);
     printfQuda("done.\n\n");
 
-    if (!transfer) *spinorOut = *cudaSpinorOut;
+    if (host) spinorOut->copy(*hostSpinorOut);
+    else if (!transfer) *spinorOut = *cudaSpinorOut;
 
     // print timing information
     printfQuda("%fus per kernel call\n", 1e6*secs / niter);
@@ -605,15 +686,24 @@ int main(int argc, char **argv)
     int spinor_floats = test_type ? 2*(7*24+24)+24 : 7*24+24;
     if (inv_param.cuda_prec == QUDA_HALF_PRECISION) 
       spinor_floats += test_type ? 2*(7*2 + 2) + 2 : 7*2 + 2; // relative size of norm is twice a short
-    int gauge_floats = (test_type ? 2 : 1) * (gauge_param.gauge_fix ? 6 : 8) * gauge_param.reconstruct;
+    // loadGaugeQuda keeps the host links compressed with 12 and 8 reconstruction of Wilson links
+    QudaReconstructType host_recon = (gauge_param.type == QUDA_WILSON_LINKS &&
+				      (gauge_param.reconstruct == QUDA_RECONSTRUCT_12 ||
+				       gauge_param.reconstruct == QUDA_RECONSTRUCT_8)) ?
+      gauge_param.reconstruct : QUDA_RECONSTRUCT_NO;
+    int gauge_floats = (test_type ? 2 : 1) * (gauge_param.gauge_fix ? 6 : 8) * (host ? host_recon : gauge_param.reconstruct);
     if (dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
       gauge_floats += test_type ? 72*2 : 72;
     }
     printfQuda("GFLOPS = %f\n", 1.0e-9*flops/secs);
     printfQuda("GB/s = %f\n\n", 
-	       (double)Vh*(Ls*spinor_floats+gauge_floats)*inv_param.cuda_prec/((secs/niter)*1e+9));
+	       (double)Vh*((host ? nrhs : 1)*Ls*spinor_floats+gauge_floats)*inv_param.cuda_prec/((secs/niter)*1e+9));
     
-    if (!transfer) {
+    if (host) {
+      double norm2_cpu = norm2(*spinorRef);
+      double norm2_host = norm2(*spinorOut);
+      printfQuda("Results: CPU = %f, host dslash = %f\n", norm2_cpu, norm2_host);
+    } else if (!transfer) {
       double norm2_cpu = norm2(*spinorRef);
       double norm2_cuda= norm2(*cudaSpinorOut);
       double norm2_cpu_cuda= norm2(*spinorOut);
@@ -625,8 +715,38 @@ int main(int argc, char **argv)
     }
     
     cpuColorSpinorField::Compare(*spinorRef, *spinorOut);
+
+    // the hand-written host kernels follow the operation order of the
+    // reference, so with uncompressed links in the reference precision
+    // the results must agree to the last bit (bar the symmetric twisted
+    // mass matpc, whose reference twists and untwists its input)
+    bool bitwise = host && !getHostDslashGenerated() && !hostBlock &&
+      hostSpinorOut->Precision() == spinorRef->Precision() && host_recon == QUDA_RECONSTRUCT_NO &&
+      (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_DOMAIN_WALL_DSLASH ||
+       (dslash_type == QUDA_TWISTED_MASS_DSLASH &&
+	(test_type == 0 || (inv_param.matpc_type != QUDA_MATPC_EVEN_EVEN &&
+			    inv_param.matpc_type != QUDA_MATPC_ODD_ODD))));
+    if (bitwise) {
+      bool equal = (memcmp(spinorRef->V(), spinorOut->V(), spinorRef->Bytes()) == 0);
+      printfQuda("Bitwise comparison with the reference: %s\n", equal ? "PASS" : "FAIL");
+      if (!equal) fail = 1;
+    } else if (host) {
+      // otherwise the sums run in another order, the links may be
+      // rebuilt and the precision may be lower, so allow a few hundred
+      // ulps (in the host precision) of the largest element
+      const int len = spinorRef->RealLength();
+      double ref = (spinorRef->Precision() == QUDA_DOUBLE_PRECISION) ?
+	maxAbs((double*)spinorRef->V(), len) : maxAbs((float*)spinorRef->V(), len);
+      double eps = (hostSpinorOut->Precision() == QUDA_DOUBLE_PRECISION) ? DBL_EPSILON : FLT_EPSILON;
+      double tol = 256*eps*ref;
+      bool close = compare_floats(spinorRef->V(), spinorOut->V(), len, tol, spinorRef->Precision());
+      printfQuda("Comparison with the reference to %e: %s\n", tol, close ? "PASS" : "FAIL");
+      if (!close) fail = 1;
+    }
   }    
   end();
 
   finalizeComms();
+
+  return fail;
 }
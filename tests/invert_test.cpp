@@ -41,6 +41,12 @@ extern QudaReconstructType link_recon;
 extern QudaPrecision prec;
 extern QudaReconstructType link_recon_sloppy;
 extern QudaPrecision  prec_sloppy;
+extern QudaFieldLocation compute_location;
+extern QudaInverterType inv_type;
+extern QudaInverterType precon_type;
+extern QudaSchwarzType schwarz_type;
+extern int nrhs;
+extern bool lanczos;
 
 extern char latfile[];
 
@@ -184,7 +190,30 @@ int main(int argc, char **argv)
     inv_param.inv_type = QUDA_BICGSTAB_INVERTER;
   }
 
+  if (inv_type != QUDA_INVALID_INVERTER) { // solver requested on the command line
+    inv_param.inv_type = inv_type;
+    if (inv_type == QUDA_CG_INVERTER || inv_type == QUDA_PIPELINED_CG_INVERTER ||
+	inv_type == QUDA_SSTEP_CG_INVERTER || inv_type == QUDA_BLOCK_CG_INVERTER ||
+	inv_type == QUDA_EIGCG_INVERTER) 
+      inv_param.solve_type = QUDA_NORMOP_PC_SOLVE;
+  }
+
   inv_param.pipeline = 0;
+  inv_param.s_step = 4;
+  inv_param.num_src = multi_shift ? 1 : nrhs;
+  inv_param.nev = 8;
+  inv_param.max_search_dim = 24;
+  inv_param.deflation_grid = nrhs;
+
+  inv_param.eig_nkrylov = 24;
+  inv_param.eig_poly_deg = 20;
+  inv_param.eig_amin = 0.1;
+  inv_param.eig_amax = 0.0; // estimate the top of the spectrum
+  inv_param.eig_tol = 1e-6;
+  inv_param.eig_max_restarts = 100;
+
+  inv_param.chrono_max_dim = 0; // no chronological initial guess
+  inv_param.chrono_max_gib = 0.0;
 
   inv_param.gcrNkrylov = 10;
   inv_param.tol = 1e-7;
@@ -205,9 +234,9 @@ int main(int argc, char **argv)
   inv_param.reliable_delta = 1e-2; // ignored by multi-shift solver
 
   // domain decomposition preconditioner parameters
-  inv_param.inv_type_precondition = QUDA_INVALID_INVERTER;
-  inv_param.schwarz_type = QUDA_ADDITIVE_SCHWARZ;
-  inv_param.precondition_cycle = 1;
+  inv_param.inv_type_precondition = precon_type;
+  inv_param.schwarz_type = schwarz_type;
+  inv_param.precondition_cycle = (schwarz_type == QUDA_MULTIPLICATIVE_SCHWARZ) ? 2 : 1; // one sweep per colour
   inv_param.tol_precondition = 1e-1;
   inv_param.maxiter_precondition = 10;
   inv_param.verbosity_precondition = QUDA_SILENT;
@@ -223,6 +252,7 @@ int main(int argc, char **argv)
 
   inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
   inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.compute_location = compute_location; // the host solver runs at the host gauge precision
 
   inv_param.tune = tune ? QUDA_TUNE_YES : QUDA_TUNE_NO;
 
@@ -309,7 +339,12 @@ int main(int argc, char **argv)
     }
   }
 
-  void *spinorIn = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
+  // one source (and solution) per right-hand side
+  void **spinorInSrc = (void**)malloc(inv_param.num_src*sizeof(void *));
+  for (int i=0; i<inv_param.num_src; i++) {
+    spinorInSrc[i] = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
+  }
+  void *spinorIn = spinorInSrc[0];
   void *spinorCheck = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
 
   void *spinorOut = NULL, **spinorOutMulti = NULL;
@@ -319,30 +354,38 @@ int main(int argc, char **argv)
       spinorOutMulti[i] = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
     }
   } else {
-    spinorOut = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
+    spinorOutMulti = (void**)malloc(inv_param.num_src*sizeof(void *));
+    for (int i=0; i<inv_param.num_src; i++) {
+      spinorOutMulti[i] = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
+    }
+    spinorOut = spinorOutMulti[0];
   }
 
   // create a point source at 0 (in each subvolume...  FIXME)
 
   // create a point source at 0 (in each subvolume...  FIXME)
   
-  memset(spinorIn, 0, inv_param.Ls*V*spinorSiteSize*sSize);
+  for (int i=0; i<inv_param.num_src; i++) memset(spinorInSrc[i], 0, inv_param.Ls*V*spinorSiteSize*sSize);
   memset(spinorCheck, 0, inv_param.Ls*V*spinorSiteSize*sSize);
   if (multi_shift) {
     for (int i=0; i<inv_param.num_offset; i++) memset(spinorOutMulti[i], 0, inv_param.Ls*V*spinorSiteSize*sSize);    
   } else {
-    memset(spinorOut, 0, inv_param.Ls*V*spinorSiteSize*sSize);
+    for (int i=0; i<inv_param.num_src; i++) memset(spinorOutMulti[i], 0, inv_param.Ls*V*spinorSiteSize*sSize);
   }
 
-  if (inv_param.cpu_prec == QUDA_SINGLE_PRECISION)
-  {
-    ((float*)spinorIn)[0] = 1.0;
-    //for (int i=0; i<inv_param.Ls*V*spinorSiteSize; i++) ((float*)spinorIn)[i] = rand() / (float)RAND_MAX;
-  }
-  else
-  {
-    ((double*)spinorIn)[0] = 1.0;
-    //for (int i=0; i<inv_param.Ls*V*spinorSiteSize; i++) ((double*)spinorIn)[i] = rand() / (double)RAND_MAX;
+  // source i is a point source in spin-color component i%12 of site i/12
+  for (int i=0; i<inv_param.num_src; i++) {
+    int idx = (i/12)*spinorSiteSize + 2*(i%12);
+    if (inv_param.cpu_prec == QUDA_SINGLE_PRECISION)
+    {
+      ((float*)spinorInSrc[i])[idx] = 1.0;
+      //for (int i=0; i<inv_param.Ls*V*spinorSiteSize; i++) ((float*)spinorIn)[i] = rand() / (float)RAND_MAX;
+    }
+    else
+    {
+      ((double*)spinorInSrc[i])[idx] = 1.0;
+      //for (int i=0; i<inv_param.Ls*V*spinorSiteSize; i++) ((double*)spinorIn)[i] = rand() / (double)RAND_MAX;
+    }
   }
 
   // start the timer
@@ -357,9 +400,24 @@ int main(int argc, char **argv)
   // load the clover term, if desired
   if (dslash_type == QUDA_CLOVER_WILSON_DSLASH) loadCloverQuda(clover, clover_inv, &inv_param);
 
+  // compute the low modes, which also seeds the eigCG deflation space
+  if (lanczos && !multi_shift) {
+    // the eigensolver works on the normal operator
+    QudaInvertParam eig_param = inv_param;
+    if (eig_param.solve_type == QUDA_DIRECT_SOLVE) eig_param.solve_type = QUDA_NORMOP_SOLVE;
+    if (eig_param.solve_type == QUDA_DIRECT_PC_SOLVE) eig_param.solve_type = QUDA_NORMOP_PC_SOLVE;
+
+    double *evals = new double[inv_param.nev];
+    eigensolveQuda(NULL, evals, &eig_param);
+    for (int i=0; i<inv_param.nev; i++) printfQuda("eval[%d] = %e\n", i, evals[i]);
+    delete []evals;
+  }
+
   // perform the inversion
   if (multi_shift) {
     invertMultiShiftQuda(spinorOutMulti, spinorIn, &inv_param);
+  } else if (inv_param.num_src > 1) {
+    invertMultiSrcQuda(spinorOutMulti, spinorInSrc, &inv_param);
   } else {
     invertQuda(spinorOut, spinorIn, &inv_param);
   }
@@ -412,75 +470,80 @@ int main(int argc, char **argv)
     free(spinorTmp);
 
   } else {
-    
-    if (inv_param.solution_type == QUDA_MAT_SOLUTION) {
 
-      if (dslash_type == QUDA_TWISTED_MASS_DSLASH) {
-	if(inv_param.twist_flavor == QUDA_TWIST_PLUS || inv_param.twist_flavor == QUDA_TWIST_MINUS)      
-	  tm_mat(spinorCheck, gauge, spinorOut, inv_param.kappa, inv_param.mu, inv_param.twist_flavor, 0, inv_param.cpu_prec, gauge_param);
-	else
-	{
-          int tm_offset = V*spinorSiteSize; //12*spinorRef->Volume(); 	  
-	  void *evenOut = spinorCheck;
-	  void *oddOut  = cpu_prec == sizeof(double) ? (void*)((double*)evenOut + tm_offset): (void*)((float*)evenOut + tm_offset);
+    for (int i=0; i<inv_param.num_src; i++) {
+      spinorIn = spinorInSrc[i];
+      spinorOut = spinorOutMulti[i];
     
-	  void *evenIn  = spinorOut;
-	  void *oddIn   = cpu_prec == sizeof(double) ? (void*)((double*)evenIn + tm_offset): (void*)((float*)evenIn + tm_offset);
+      if (inv_param.solution_type == QUDA_MAT_SOLUTION) {
+
+        if (dslash_type == QUDA_TWISTED_MASS_DSLASH) {
+	  if(inv_param.twist_flavor == QUDA_TWIST_PLUS || inv_param.twist_flavor == QUDA_TWIST_MINUS)      
+	    tm_mat(spinorCheck, gauge, spinorOut, inv_param.kappa, inv_param.mu, inv_param.twist_flavor, 0, inv_param.cpu_prec, gauge_param);
+	  else
+	  {
+            int tm_offset = V*spinorSiteSize; //12*spinorRef->Volume(); 	  
+	    void *evenOut = spinorCheck;
+	    void *oddOut  = cpu_prec == sizeof(double) ? (void*)((double*)evenOut + tm_offset): (void*)((float*)evenOut + tm_offset);
     
-	  tm_ndeg_mat(evenOut, oddOut, gauge, evenIn, oddIn, inv_param.kappa, inv_param.mu, inv_param.epsilon, 0, inv_param.cpu_prec, gauge_param);	
-	}
-      } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
-        wil_mat(spinorCheck, gauge, spinorOut, inv_param.kappa, 0, inv_param.cpu_prec, gauge_param);
-      } else if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
-        dw_mat(spinorCheck, gauge, spinorOut, kappa5, inv_param.dagger, inv_param.cpu_prec, gauge_param, inv_param.mass);
-      } else {
-        printfQuda("Unsupported dslash_type\n");
-        exit(-1);
-      }
-      if (inv_param.mass_normalization == QUDA_MASS_NORMALIZATION) {
-        if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
-          ax(0.5/kappa5, spinorCheck, V*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+	    void *evenIn  = spinorOut;
+	    void *oddIn   = cpu_prec == sizeof(double) ? (void*)((double*)evenIn + tm_offset): (void*)((float*)evenIn + tm_offset);
+    
+	    tm_ndeg_mat(evenOut, oddOut, gauge, evenIn, oddIn, inv_param.kappa, inv_param.mu, inv_param.epsilon, 0, inv_param.cpu_prec, gauge_param);	
+	  }
+        } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
+          wil_mat(spinorCheck, gauge, spinorOut, inv_param.kappa, 0, inv_param.cpu_prec, gauge_param);
+        } else if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
+          dw_mat(spinorCheck, gauge, spinorOut, kappa5, inv_param.dagger, inv_param.cpu_prec, gauge_param, inv_param.mass);
         } else {
-          ax(0.5/inv_param.kappa, spinorCheck, V*spinorSiteSize, inv_param.cpu_prec);
+          printfQuda("Unsupported dslash_type\n");
+          exit(-1);
+        }
+        if (inv_param.mass_normalization == QUDA_MASS_NORMALIZATION) {
+          if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
+            ax(0.5/kappa5, spinorCheck, V*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+          } else {
+            ax(0.5/inv_param.kappa, spinorCheck, V*spinorSiteSize, inv_param.cpu_prec);
+          }
         }
-      }
-
-    } else if(inv_param.solution_type == QUDA_MATPC_SOLUTION) {
-
-      if (dslash_type == QUDA_TWISTED_MASS_DSLASH) {
-	if (inv_param.twist_flavor != QUDA_TWIST_MINUS && inv_param.twist_flavor != QUDA_TWIST_PLUS)
-	  errorQuda("Twisted mass solution type not supported");
-        tm_matpc(spinorCheck, gauge, spinorOut, inv_param.kappa, inv_param.mu, inv_param.twist_flavor, 
-                 inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param);
-      } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
-        wil_matpc(spinorCheck, gauge, spinorOut, inv_param.kappa, inv_param.matpc_type, 0, 
-                  inv_param.cpu_prec, gauge_param);
-      } else if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
-	dw_matpc(spinorCheck, gauge, spinorOut, kappa5, inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param, inv_param.mass);
-      } else {
-        printfQuda("Unsupported dslash_type\n");
-        exit(-1);
-      }
 
-      if (inv_param.mass_normalization == QUDA_MASS_NORMALIZATION) {
-        if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
-          ax(0.25/(kappa5*kappa5), spinorCheck, Vh*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+      } else if(inv_param.solution_type == QUDA_MATPC_SOLUTION) {
+
+        if (dslash_type == QUDA_TWISTED_MASS_DSLASH) {
+	  if (inv_param.twist_flavor != QUDA_TWIST_MINUS && inv_param.twist_flavor != QUDA_TWIST_PLUS)
+	    errorQuda("Twisted mass solution type not supported");
+          tm_matpc(spinorCheck, gauge, spinorOut, inv_param.kappa, inv_param.mu, inv_param.twist_flavor, 
+                   inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param);
+        } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
+          wil_matpc(spinorCheck, gauge, spinorOut, inv_param.kappa, inv_param.matpc_type, 0, 
+                    inv_param.cpu_prec, gauge_param);
+        } else if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
+	  dw_matpc(spinorCheck, gauge, spinorOut, kappa5, inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param, inv_param.mass);
         } else {
-          ax(0.25/(inv_param.kappa*inv_param.kappa), spinorCheck, Vh*spinorSiteSize, inv_param.cpu_prec);
+          printfQuda("Unsupported dslash_type\n");
+          exit(-1);
+        }
+
+        if (inv_param.mass_normalization == QUDA_MASS_NORMALIZATION) {
+          if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
+            ax(0.25/(kappa5*kappa5), spinorCheck, Vh*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+          } else {
+            ax(0.25/(inv_param.kappa*inv_param.kappa), spinorCheck, Vh*spinorSiteSize, inv_param.cpu_prec);
       
-	}
-      }
+	  }
+        }
 
-    }
+      }
 
-    int vol = inv_param.solution_type == QUDA_MAT_SOLUTION ? V : Vh;
-    mxpy(spinorIn, spinorCheck, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
-    double nrm2 = norm_2(spinorCheck, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
-    double src2 = norm_2(spinorIn, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
-    double l2r = sqrt(nrm2 / src2);
+      int vol = inv_param.solution_type == QUDA_MAT_SOLUTION ? V : Vh;
+      mxpy(spinorIn, spinorCheck, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+      double nrm2 = norm_2(spinorCheck, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+      double src2 = norm_2(spinorIn, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+      double l2r = sqrt(nrm2 / src2);
 
-    printfQuda("Residuals: (L2 relative) tol %g, QUDA = %g, host = %g; (heavy-quark) tol %g, QUDA = %g\n",
-	       inv_param.tol, inv_param.true_res, l2r, inv_param.tol_hq, inv_param.true_res_hq);
+      printfQuda("Residuals: (L2 relative) tol %g, QUDA = %g, host = %g; (heavy-quark) tol %g, QUDA = %g\n",
+		 inv_param.tol, inv_param.true_res, l2r, inv_param.tol_hq, inv_param.true_res_hq);
+    }
 
   }
 
@@ -833,6 +833,73 @@ get_dslash_type_str(QudaDslashType type)
     
 }
 
+QudaInverterType
+get_solver_type(char* s)
+{
+  QudaInverterType ret =  QUDA_INVALID_INVERTER;
+  
+  if (strcmp(s, "cg") == 0){
+    ret = QUDA_CG_INVERTER;
+  }else if (strcmp(s, "bicgstab") == 0){
+    ret = QUDA_BICGSTAB_INVERTER;
+  }else if (strcmp(s, "gcr") == 0){
+    ret = QUDA_GCR_INVERTER;
+  }else if (strcmp(s, "mr") == 0){
+    ret = QUDA_MR_INVERTER;
+  }else if (strcmp(s, "pipelined_cg") == 0){
+    ret = QUDA_PIPELINED_CG_INVERTER;
+  }else if (strcmp(s, "sstep_cg") == 0){
+    ret = QUDA_SSTEP_CG_INVERTER;
+  }else if (strcmp(s, "block_cg") == 0){
+    ret = QUDA_BLOCK_CG_INVERTER;
+  }else if (strcmp(s, "eigcg") == 0){
+    ret = QUDA_EIGCG_INVERTER;
+  }else{
+    fprintf(stderr, "Error: invalid solver type\n");	
+    exit(1);
+  }
+  
+  return ret;
+}
+
+const char* 
+get_solver_str(QudaInverterType type)
+{
+  const char* ret;
+  
+  switch( type){	
+  case QUDA_CG_INVERTER:
+    ret = "cg";
+    break;
+  case QUDA_BICGSTAB_INVERTER:
+    ret = "bicgstab";
+    break;
+  case QUDA_GCR_INVERTER:
+    ret = "gcr";
+    break;
+  case QUDA_MR_INVERTER:
+    ret = "mr";
+    break;
+  case QUDA_PIPELINED_CG_INVERTER:
+    ret = "pipelined_cg";
+    break;
+  case QUDA_SSTEP_CG_INVERTER:
+    ret = "sstep_cg";
+    break;
+  case QUDA_BLOCK_CG_INVERTER:
+    ret = "block_cg";
+    break;
+  case QUDA_EIGCG_INVERTER:
+    ret = "eigcg";
+    break;
+  default:
+    ret = "unknown";	
+    break;
+  }
+  
+  return ret;
+}
+
 const char* 
 get_quda_ver_str()
 {
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <iostream>
 
 #include <quda_internal.h>
@@ -196,6 +197,52 @@ void packTest() {
 
   cpuColorSpinorField::Compare(*spinor, *spinor2, 1);
 
+  // round trip through the host AoSoA order, and from it to the GPU
+  {
+    ColorSpinorParam aosoaParam(*spinor);
+    aosoaParam.fieldOrder = QUDA_AOSOA_FIELD_ORDER;
+    aosoaParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuColorSpinorField aosoaSpinor(aosoaParam);
+
+    aosoaSpinor = *spinor;
+    *spinor2 = aosoaSpinor;
+    printf("AoSoA spinor norm check: CPU = %e, AoSoA = %e, CPU = %e\n",
+	   norm2(*spinor), norm2(aosoaSpinor), norm2(*spinor2));
+    cpuColorSpinorField::Compare(*spinor, *spinor2, 1);
+
+    *cudaSpinor = aosoaSpinor;
+    aosoaSpinor.zero();
+    aosoaSpinor = *cudaSpinor;
+    *spinor2 = aosoaSpinor;
+    cpuColorSpinorField::Compare(*spinor, *spinor2, 1);
+  }
+
+#ifdef BUILD_QDP_INTERFACE
+  {
+    construct_gauge_field(qdpCpuGauge_p, 1, param.cpu_prec, &param);
+    param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+    GaugeFieldParam qdpParam(qdpCpuGauge_p, param);
+    cpuGaugeField qdpCpuGauge(qdpParam);
+
+    GaugeFieldParam aosoaParam(qdpParam);
+    aosoaParam.create = QUDA_NULL_FIELD_CREATE;
+    aosoaParam.order = QUDA_AOSOA_GAUGE_ORDER;
+    cpuGaugeField aosoaCpuGauge(aosoaParam);
+    aosoaCpuGauge.copy(qdpCpuGauge);
+
+    aosoaParam.order = QUDA_QDP_GAUGE_ORDER;
+    cpuGaugeField qdpCpuGauge2(aosoaParam);
+    qdpCpuGauge2.copy(aosoaCpuGauge);
+
+    int fail = 0;
+    for (int d=0; d<4; d++) {
+      if (memcmp(((void**)qdpCpuGauge.Gauge_p())[d], ((void**)qdpCpuGauge2.Gauge_p())[d],
+		 V*gaugeSiteSize*param.cpu_prec)) fail++;
+    }
+    printf("AoSoA gauge round trip: %s\n", fail ? "FAILED" : "PASSED");
+  }
+#endif
+
 }
 
 extern void usage(char**);
@@ -40,6 +40,8 @@ cpuGaugeField *cpuFat = NULL;
 cpuGaugeField *cpuLong = NULL;
 
 cpuColorSpinorField *spinor, *spinorOut, *spinorRef;
+cpuColorSpinorField *hostSpinor=0, *hostSpinorOut=0; // used by the host dslash
+cpuColorSpinorField **hostBlock=0, **hostBlockOut=0; // nrhs copies of them for the block host dslash
 cudaColorSpinorField *cudaSpinor, *cudaSpinorOut;
 
 cudaColorSpinorField* tmp;
@@ -56,6 +58,8 @@ const int loops = 100;
 QudaParity parity;
 extern QudaDagType dagger;
 int transfer = 0; // include transfer time in the benchmark?
+extern int nrhs;
+extern QudaFieldLocation compute_location;
 extern int xdim;
 extern int ydim;
 extern int zdim;
@@ -112,6 +116,7 @@ void init()
 
   inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
   inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.compute_location = compute_location;
 
   int tmpint = MAX(X[1]*X[2]*X[3], X[0]*X[2]*X[3]);
   tmpint = MAX(tmpint, X[0]*X[1]*X[3]);
@@ -272,6 +277,27 @@ void init()
 
     dirac = Dirac::create(diracParam);
 
+    if (compute_location == QUDA_CPU_FIELD_LOCATION) {
+      // the host dslash runs in the precision of the host links
+      ColorSpinorParam hostParam(*spinor);
+      hostParam.create = QUDA_NULL_FIELD_CREATE;
+      hostParam.precision = (prec == QUDA_HALF_PRECISION) ? QUDA_SINGLE_PRECISION : prec;
+      hostSpinor = new cpuColorSpinorField(hostParam);
+      hostSpinorOut = new cpuColorSpinorField(hostParam);
+      hostSpinor->copy(*spinor);
+
+      if (nrhs > 1) {
+	hostBlock = new cpuColorSpinorField*[nrhs];
+	hostBlockOut = new cpuColorSpinorField*[nrhs];
+	hostBlock[0] = hostSpinor;
+	hostBlockOut[0] = hostSpinorOut;
+	for (int r=1; r<nrhs; r++) {
+	  hostBlock[r] = new cpuColorSpinorField(*hostSpinor);
+	  hostBlockOut[r] = new cpuColorSpinorField(hostParam);
+	}
+      }
+    }
+
   } else {
     errorQuda("Error not suppported");
   }
@@ -291,6 +317,16 @@ void end(void)
     delete cudaSpinor;
     delete cudaSpinorOut;
     delete tmp;
+    if (hostSpinor) delete hostSpinor;
+    if (hostSpinorOut) delete hostSpinorOut;
+    if (hostBlock) {
+      for (int r=1; r<nrhs; r++) {
+	delete hostBlock[r];
+	delete hostBlockOut[r];
+      }
+      delete []hostBlock;
+      delete []hostBlockOut;
+    }
   }
 
   delete spinor;
@@ -356,6 +392,31 @@ double dslashCUDA(int niter) {
   return secs;
 }
 
+// execute host kernel
+double dslashCPU(int niter) {
+
+  stopwatchStart();
+
+  for (int i = 0; i < niter; i++) {
+    switch (test_type) {
+      case 0:
+        parity = QUDA_EVEN_PARITY;
+        if (hostBlock) dirac->Dslash(hostBlockOut, hostBlock, nrhs, parity);
+        else dirac->Dslash(*hostSpinorOut, *hostSpinor, parity);
+        break;
+      case 1:
+        parity = QUDA_ODD_PARITY;
+        if (hostBlock) dirac->Dslash(hostBlockOut, hostBlock, nrhs, parity);
+        else dirac->Dslash(*hostSpinorOut, *hostSpinor, parity);
+        break;
+      case 2:
+        errorQuda("Staggered operator acting on full-site not supported");
+    }
+  }
+
+  return stopwatchReadSeconds();
+}
+
 void staggeredDslashRef()
 {
 #ifndef MULTI_GPU
@@ -413,35 +474,43 @@ static int dslashTest()
 
   for (int i=0; i<attempts; i++) {
 
-    if (tune) { // warm-up run
+    bool host = (!transfer && compute_location == QUDA_CPU_FIELD_LOCATION);
+
+    if (tune && !host) { // warm-up run
       printfQuda("Tuning...\n");
       setTuning(QUDA_TUNE_YES);
       dslashCUDA(1);
     }
-    printfQuda("Executing %d kernel loops...", loops);	
-    double secs = dslashCUDA(loops);
+    printfQuda("Executing %d %s kernel loops...", loops, host ? "host" : "device");
+    if (!transfer) dirac->Flops();
+    double secs = host ? dslashCPU(loops) : dslashCUDA(loops);
 
-    if (!transfer) *spinorOut = *cudaSpinorOut;
+    if (host) spinorOut->copy(*hostSpinorOut);
+    else if (!transfer) *spinorOut = *cudaSpinorOut;
 
     printfQuda("\n%fms per loop\n", 1000*secs);
     staggeredDslashRef();
 
     unsigned long long flops = dirac->Flops();
-    int link_floats = 8*gaugeParam.reconstruct+8*18;
+    int link_floats = 8*(host ? QUDA_RECONSTRUCT_NO : gaugeParam.reconstruct)+8*18;
     int spinor_floats = 8*6*2 + 6;
-    int link_float_size = prec;
+    int link_float_size = host ? hostSpinor->Precision() : prec;
     int spinor_float_size = 0;
 
     link_floats = test_type ? (2*link_floats) : link_floats;
     spinor_floats = test_type ? (2*spinor_floats) : spinor_floats;
 
     int bytes_for_one_site = link_floats * link_float_size + spinor_floats * spinor_float_size;
-    if (prec == QUDA_HALF_PRECISION) bytes_for_one_site += (8*2 + 1)*4;	
+    if (prec == QUDA_HALF_PRECISION && !host) bytes_for_one_site += (8*2 + 1)*4;	
 
     printfQuda("GFLOPS = %f\n", 1.0e-9*flops/secs);
     printfQuda("GB/s = %f\n\n", 1.0*Vh*bytes_for_one_site/((secs/loops)*1e+9));
 
-    if (!transfer) {
+    if (host) {
+      double spinor_ref_norm2 = norm2(*spinorRef);
+      double spinor_out_norm2 =  norm2(*spinorOut);
+      printfQuda("Results: CPU=%f, host dslash=%f\n", spinor_ref_norm2, spinor_out_norm2);
+    } else if (!transfer) {
       double spinor_ref_norm2 = norm2(*spinorRef);
       double cuda_spinor_out_norm2 =  norm2(*cudaSpinorOut);
       double spinor_out_norm2 =  norm2(*spinorOut);
@@ -13,6 +13,7 @@
 #include "misc.h"
 #include <gauge_field.h>
 #include <blas_quda.h>
+#include <dirac_quda.h>
 
 #if defined(QMP_COMMS)
 #include <qmp.h>
@@ -63,9 +64,32 @@ extern int ydim;
 extern int zdim;
 extern int tdim;
 extern int gridsize_from_cmdline[];
+extern QudaFieldLocation compute_location;
 
 static void end();
 
+// Apply the host staggered operator to the solution and return the
+// L2 relative residual it gives (requires a host-dslash build)
+static double hostResidual(QudaInvertParam *inv_param)
+{
+  ColorSpinorParam hostParam(*in);
+  hostParam.create = QUDA_NULL_FIELD_CREATE;
+  hostParam.precision = (prec == QUDA_HALF_PRECISION) ? QUDA_SINGLE_PRECISION : prec;
+  cpuColorSpinorField hostIn(hostParam), hostOut(hostParam), hostRes(hostParam);
+  hostIn.copy(*in);
+  hostOut.copy(*out);
+
+  DiracParam diracParam;
+  setDiracParam(diracParam, inv_param, true);
+  Dirac *dirac = Dirac::create(diracParam);
+  dirac->MdagM(hostRes, hostOut);
+  delete dirac;
+
+  double src2 = normCpu(hostIn);
+  double res2 = xmyNormCpu(hostIn, hostRes);
+  return sqrt(res2/src2);
+}
+
 template<typename Float>
 void constructSpinorField(Float *res) {
   for(int i = 0; i < Vh; i++) {
@@ -298,6 +322,7 @@ invert_test(void)
 
   double nrm2=0;
   double src2=0;
+  double host_l2r=0;
   int ret = 0;
 
   switch(test_type){
@@ -317,6 +342,7 @@ invert_test(void)
 #else
       matdagmat(ref->V(), qdp_fatlink, qdp_longlink, out->V(), mass, 0, inv_param.cpu_prec, gaugeParam.cpu_prec, tmp->V(), QUDA_EVEN_PARITY);
 #endif
+      if (compute_location == QUDA_CPU_FIELD_LOCATION) host_l2r = hostResidual(&inv_param);
 
       mxpy(in->V(), ref->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
       nrm2 = norm_2(ref->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
@@ -337,6 +363,7 @@ invert_test(void)
 #else
       matdagmat(ref->V(), qdp_fatlink, qdp_longlink, out->V(), mass, 0, inv_param.cpu_prec, gaugeParam.cpu_prec, tmp->V(), QUDA_ODD_PARITY);	
 #endif
+      if (compute_location == QUDA_CPU_FIELD_LOCATION) host_l2r = hostResidual(&inv_param);
       mxpy(in->V(), ref->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
       nrm2 = norm_2(ref->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
       src2 = norm_2(in->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
@@ -448,6 +475,8 @@ invert_test(void)
 
     printfQuda("Residuals: (L2 relative) tol %g, QUDA = %g, host = %g; (heavy-quark) tol %g, QUDA = %g, host = %g\n",
         inv_param.tol, inv_param.true_res, l2r, inv_param.tol_hq, inv_param.true_res_hq, hqr);
+    if (compute_location == QUDA_CPU_FIELD_LOCATION)
+      printfQuda("Residual with the host staggered operator: (L2 relative) %g\n", host_l2r);
 
     printfQuda("done: total time = %g secs, compute time = %g secs, %i iter / %g secs = %g gflops, \n", 
         time0, inv_param.secs, inv_param.iter, inv_param.secs,
@@ -1512,7 +1512,13 @@ QudaDslashType dslash_type = QUDA_WILSON_DSLASH;
 char latfile[256] = "";
 bool tune = true;
 int niter = 10;
+int nrhs = 1;
+bool lanczos = false;
 int test_type = 0;
+QudaFieldLocation compute_location = QUDA_CUDA_FIELD_LOCATION;
+QudaInverterType inv_type = QUDA_INVALID_INVERTER;
+QudaInverterType precon_type = QUDA_INVALID_INVERTER;
+QudaSchwarzType schwarz_type = QUDA_ADDITIVE_SCHWARZ;
 
 static int dim_partitioned[4] = {0,0,0,0};
 
@@ -1550,9 +1556,18 @@ void usage(char** argv )
   printf("    --kernel_pack_t                           # Set T dimension kernel packing to be true (default false)\n");
   printf("    --dslash_type <type>                      # Set the dslash type, the following values are valid\n"
 	 "                                                  wilson/clover/twisted_mass/asqtad/domain_wall\n");
+  printf("    --inv_type <type>                         # Override the test's default solver, the following values are valid\n"
+	 "                                                  cg/bicgstab/gcr/mr/pipelined_cg/sstep_cg/block_cg/eigcg\n");
+  printf("    --precon_type <type>                      # Inner solver of the Schwarz preconditioner for gcr (default none), one of cg/bicgstab/mr\n");
+  printf("    --schwarz <additive/multiplicative>       # Type of Schwarz preconditioning (default additive)\n");
   printf("    --load-gauge file                         # Load gauge field \"file\" for the test (requires QIO)\n");
   printf("    --niter <n>                               # The number of iterations to perform (default 10)\n");
+  printf("    --nrhs <n>                                # The number of fields the host dslash is applied to, or sources solved, at once (default 1)\n");
   printf("    --tune <true/false>                       # Whether to autotune or not (default true)\n");     
+  printf("    --lanczos <true/false>                    # Whether to compute the low eigenpairs with the Lanczos eigensolver first (default false)\n");
+  printf("    --compute <cuda/cpu>                      # Where to apply the Dirac operator (default cuda, cpu requires a host-dslash build)\n");
+  printf("    --host-overlap <true/false>               # Whether the host dslash overlaps the halo exchange with the interior (default true)\n");
+  printf("    --host-generated <true/false>             # Whether the host dslash uses the generated kernels (default true with AVX2/AVX-512)\n");
   printf("    --test                                    # Test method (different for each test)\n");
   printf("    --help                                    # Print out this message\n"); 
   usage_extra(argv); 
@@ -1753,6 +1768,63 @@ int process_command_line_option(int argc, char** argv, int* idx)
   }
 
 
+  if( strcmp(argv[i], "--host-overlap") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "true") == 0){
+      quda::setHostDslashOverlap(true);
+    }else if (strcmp(argv[i+1], "false") == 0){
+      quda::setHostDslashOverlap(false);
+    }else{
+      fprintf(stderr, "ERROR: invalid host overlap type\n");
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--host-generated") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "true") == 0){
+      quda::setHostDslashGenerated(true);
+    }else if (strcmp(argv[i+1], "false") == 0){
+      quda::setHostDslashGenerated(false);
+    }else{
+      fprintf(stderr, "ERROR: invalid host generated type\n");
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--lanczos") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "true") == 0){
+      lanczos = true;
+    }else if (strcmp(argv[i+1], "false") == 0){
+      lanczos = false;
+    }else{
+      fprintf(stderr, "ERROR: invalid lanczos type\n");
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--tune") == 0){
     if (i+1 >= argc){
       usage(argv);
@@ -1772,6 +1844,25 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--compute") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }	    
+
+    if (strcmp(argv[i+1], "cuda") == 0){
+      compute_location = QUDA_CUDA_FIELD_LOCATION;
+    }else if (strcmp(argv[i+1], "cpu") == 0){
+      compute_location = QUDA_CPU_FIELD_LOCATION;
+    }else{
+      fprintf(stderr, "ERROR: invalid compute location\n");	
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--xgridsize") == 0){
     if (i+1 >= argc){ 
       usage(argv);
@@ -1838,6 +1929,45 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
   
+  if( strcmp(argv[i], "--inv_type") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }     
+    inv_type =  get_solver_type(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+  
+  if( strcmp(argv[i], "--precon_type") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }     
+    precon_type =  get_solver_type(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+  
+  if( strcmp(argv[i], "--schwarz") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "additive") == 0){
+      schwarz_type = QUDA_ADDITIVE_SCHWARZ;
+    }else if (strcmp(argv[i+1], "multiplicative") == 0){
+      schwarz_type = QUDA_MULTIPLICATIVE_SCHWARZ;
+    }else{
+      fprintf(stderr, "ERROR: invalid schwarz type\n");
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+  
   if( strcmp(argv[i], "--load-gauge") == 0){
     if (i+1 >= argc){
       usage(argv);
@@ -1872,6 +2002,20 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--nrhs") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+    nrhs = atoi(argv[i+1]);
+    if (nrhs < 1 || nrhs > 1024){
+      printf("ERROR: invalid number of right-hand sides (%d)\n", nrhs);
+      usage(argv);
+    }
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--version") == 0){
     printf("This program is linked with QUDA library, version %s,", 
 	   get_quda_ver_str());